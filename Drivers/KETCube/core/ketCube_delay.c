@@ -0,0 +1,197 @@
+/**
+ * @file    ketCube_delay.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the KETCube low-power delay
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "stm32l0xx_hal.h"
+
+#include "ketCube_delay.h"
+#include "ketCube_mcu.h"
+#include "ketCube_rtc.h"
+
+/* BACKUP_PRIMASK MUST be implemented at the begining of the funtion 
+   that implement a critical section                        
+   PRIMASK is saved on STACK and recovered at the end of the funtion
+   That way RESTORE_PRIMASK ensures critical sections are maintained even in nested calls...*/
+
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
+
+/**
+ * @brief Convert the delay to RTC timer ticks
+ * 
+ * Rounded up, one more tick is counted for the partial tick of the start
+ * 
+ * @param delay delay in ms
+ * 
+ * @retval ticks number of ticks, which take at least the delay
+ */
+static uint32_t delayTicks(uint32_t delay)
+{
+    uint32_t ticks = ketCube_RTC_ms2Tick(delay);
+    
+    if (ketCube_RTC_Tick2ms(ticks) < delay) {
+        ticks++;
+    }
+    
+    return ticks + 1;
+}
+
+/**
+ * @brief Wait in low-power mode until the delay elapses or the flag is set
+ * 
+ * @param delay delay in ms
+ * @param flag flag set by an IRQ handler; NULL if not used
+ * 
+ * @retval TRUE if the flag has been set
+ * @retval FALSE if the delay elapsed
+ */
+static bool lowPowerWait(uint32_t delay, volatile bool * flag)
+{
+    uint32_t start, ticks, elapsed;
+    TimerTime_t remaining;
+    
+    ticks = delayTicks(delay);
+    start = ketCube_RTC_GetTimerValue();
+    
+    if ((delay < KETCUBE_DELAY_LP_MIN_MS)
+        || (ketCube_MCU_IsSleepEnabled() == FALSE)
+        || (__get_IPSR() != 0)
+        || (__get_PRIMASK() != 0)) {
+        while ((ketCube_RTC_GetTimerValue() - start) < ticks) {
+            if ((flag != NULL) && (*flag == TRUE)) {
+                return TRUE;
+            }
+        }
+        return ((flag != NULL) && (*flag == TRUE));
+    }
+    
+    /* WUT period is truncated to its clock, do not wake-up before the last tick */
+    ketCube_RTC_StartWakeUpTimer(ketCube_RTC_Tick2ms(ticks) + 1);
+    
+    while ((elapsed = ketCube_RTC_GetTimerValue() - start) < ticks) {
+        if ((flag != NULL) && (*flag == TRUE)) {
+            break;
+        }
+        
+        if (ketCube_RTC_IsWakeUpTimerElapsed() == TRUE) {
+            /* WUT period is limited; the rest may be too short to sleep */
+            remaining = ketCube_RTC_Tick2ms(ticks - elapsed);
+            if (remaining < KETCUBE_DELAY_LP_MIN_MS) {
+                break;
+            }
+            ketCube_RTC_StartWakeUpTimer(remaining + 1);
+        }
+        
+        {
+            BACKUP_PRIMASK();
+            DISABLE_IRQ();
+            
+            /* The WUT or flag-setting IRQ may have been serviced since the check above */
+            if ((ketCube_RTC_IsWakeUpTimerElapsed() == FALSE)
+                && ((flag == NULL) || (*flag == FALSE))) {
+                ketCube_MCU_WaitForIrq();
+            }
+            
+            /* Service the wake-up IRQ */
+            RESTORE_PRIMASK();
+        }
+        
+        if (ketCube_MCU_IsSleepEnabled() == FALSE) {
+            break;
+        }
+    }
+    
+    ketCube_RTC_StopWakeUpTimer();
+    
+    /* Busy-wait the rest */
+    while ((ketCube_RTC_GetTimerValue() - start) < ticks) {
+        if ((flag != NULL) && (*flag == TRUE)) {
+            return TRUE;
+        }
+    }
+    
+    return ((flag != NULL) && (*flag == TRUE));
+}
+
+/**
+ * @brief Delay in low-power mode
+ * 
+ * The MCU is kept in the low-power mode selected by ketCube_MCU_SetSleepMode()
+ * until the RTC wake-up timer elapses. IRQs waking the MCU earlier (UART,
+ * EXTI, timeServer alarm) are serviced and the MCU is put to low-power mode
+ * again for the rest of the delay.
+ * 
+ * The delay is busy-waited when it is too short, when low-power mode is
+ * disabled (e.g. a timeServer alarm is close) or when called from an IRQ
+ * handler or a critical section.
+ * 
+ * @note Peripherals registered in pwrMan are released during the delay, they
+ *       are restored by ketCube_pwrMan_Acquire() on their next use
+ * @note The delay is never shorter; it is extended by up to 3 ms as it is
+ *       counted in RTC timer ticks (1024 Hz)
+ * 
+ * @param delay delay in ms
+ * 
+ */
+void ketCube_delay_LowPower(uint32_t delay)
+{
+    lowPowerWait(delay, NULL);
+}
+
+/**
+ * @brief Wait in low-power mode for an event signalled by IRQ
+ * 
+ * The same as ketCube_delay_LowPower(), but the wait ends as soon as the
+ * flag is set by an IRQ handler (e.g. a sensor data-ready EXTI).
+ * 
+ * @param timeout maximal wait time in ms
+ * @param flag flag to be set to TRUE by an IRQ handler
+ * 
+ * @retval TRUE if the flag has been set
+ * @retval FALSE in case of timeout
+ */
+bool ketCube_delay_LowPowerUntil(uint32_t timeout, volatile bool * flag)
+{
+    return lowPowerWait(timeout, flag);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file    ketCube_delay.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the KETCube low-power delay defs
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_DELAY_H
+#define __KETCUBE_DELAY_H
+
+#include "ketCube_cfg.h"
+
+/** @defgroup KETCube_delay KETCube delay
+  * @brief KETCube low-power delay
+  * 
+  * Drivers waiting for a sensor conversion, power-up or reset should use
+  * ketCube_delay_LowPower() instead of the busy-waiting HAL_Delay(): the MCU
+  * is kept in the selected low-power mode and it is woken-up by the RTC
+  * wake-up timer when the delay elapses.
+  * 
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+/**
+ * @brief Shorter delays are busy-waited (ms)
+ * 
+ * @note Low-power mode entry and exit (clock switch, driver de-init/init) take
+ *       hundreds of us, the RTC timer resolution is ~1 ms
+ */
+#define KETCUBE_DELAY_LP_MIN_MS        2
+
+/** @defgroup KETCube_delay_fn Public Functions
+* @{
+*/
+
+extern void ketCube_delay_LowPower(uint32_t delay);
+extern bool ketCube_delay_LowPowerUntil(uint32_t timeout,
+                                        volatile bool * flag);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_DELAY_H */
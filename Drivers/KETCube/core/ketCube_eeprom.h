@@ -58,7 +58,7 @@
   */
 
 #define KETCUBE_EEPROM_BASE_ADDR  ((uint32_t)0x08080000)        /* Data EEPROM base address */
-#define KETCUBE_EEPROM_END_ADDR   ((uint32_t)0x080807FF)        /* Data EEPROM end address */
+#define KETCUBE_EEPROM_END_ADDR   ((uint32_t)0x080817FF)        /* Data EEPROM end address (6 kB, both banks) */
 #define KETCUBE_EEPROM_TIMEOUT    0x1000        /*<! Value of Timeout for EEPROM operations */
 
 /**
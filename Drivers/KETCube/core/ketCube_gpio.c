@@ -48,6 +48,7 @@
 #include "ketCube_cfg.h"
 #include "ketCube_gpio.h"
 #include "ketCube_terminal.h"
+#include "ketCube_pwrMan.h"
 
 static volatile ketCube_gpio_descriptor_t pinDescr[3][16] = { {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0} }; ///< PIN descriptor for ports A, B and C
 
@@ -598,6 +599,7 @@ void HAL_GPIO_EXTI_Callback(ketCube_gpio_pin_t pin)
 void EXTI0_1_IRQHandler(void)
 {
     KETCube_eventsProcessed = FALSE; /* Possible pending events */
+    ketCube_pwrMan_WakeEvent(KETCUBE_PWRMAN_WAKE_EXTI);
     
     HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
 
@@ -607,6 +609,7 @@ void EXTI0_1_IRQHandler(void)
 void EXTI2_3_IRQHandler(void)
 {
     KETCube_eventsProcessed = FALSE; /* Possible pending events */
+    ketCube_pwrMan_WakeEvent(KETCUBE_PWRMAN_WAKE_EXTI);
     
     HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
 
@@ -617,6 +620,7 @@ void EXTI2_3_IRQHandler(void)
 void EXTI4_15_IRQHandler(void)
 {
     KETCube_eventsProcessed = FALSE; /* Possible pending events */
+    ketCube_pwrMan_WakeEvent(KETCUBE_PWRMAN_WAKE_EXTI);
     
     HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_4);
 
@@ -65,6 +65,7 @@
 #include "ketCube_spi.h"
 #include "ketCube_uart.h"
 #include "ketCube_radio.h"
+#include "ketCube_pwrMan.h"
 
 /**
  *  @brief Unique Devices IDs register set ( STM32L0xxx )
@@ -172,10 +173,8 @@ static void ketCube_MCU_ExitStopMode(void) {
   /* After wake-up from STOP reconfigure the system clock */
   ketCube_MCU_RunClockConfig();
     
-  /* Init drivers */
-  ketCube_SPI_SleepExit();
-  
-  ketCube_Radio_SleepExit();
+  /* Init drivers; SPI, radio IO, I2C and ADC are restored on first use */
+  ketCube_pwrMan_SleepExit();
   
   ketCube_UART_IoInitAll();
 
@@ -194,9 +193,7 @@ void ketCube_MCU_EnterStopMode(void) {
   DISABLE_IRQ( );
 
   /* DeIntit drivers */
-  ketCube_SPI_SleepEnter();
-  
-  ketCube_Radio_SleepEnter();
+  ketCube_pwrMan_SleepEnter();
   
   ketCube_UART_IoDeInitAll();
   
@@ -221,9 +218,7 @@ void ketCube_MCU_EnterSleepMode(void) {
 
     DISABLE_IRQ();
     /* DeIntit drivers */
-    ketCube_SPI_SleepEnter();
-    
-    ketCube_Radio_SleepEnter();
+    ketCube_pwrMan_SleepEnter();
     
     ketCube_UART_IoDeInitAll();
     
@@ -261,16 +256,24 @@ void ketCube_MCU_ExitSleepMode(void) {
     /* After wake-up from STOP reconfigure the system clock */
     ketCube_MCU_RunClockConfig();
     
-    /* Init drivers */
-    ketCube_SPI_SleepExit();
-    
-    ketCube_Radio_SleepExit();
+    /* Init drivers; SPI, radio IO, I2C and ADC are restored on first use */
+    ketCube_pwrMan_SleepExit();
     
     ketCube_UART_IoInitAll();
     
     RESTORE_PRIMASK();
 }
 
+/**
+  * @brief Enters core sleep
+  * 
+  * @note Clocks and peripherals are kept running, used while a peripheral
+  *       runs a background (IRQ/DMA) transfer
+  */
+static void ketCube_MCU_EnterCoreSleep(void) {
+    HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+}
+
 /**
  * @brief Handle KETCube LowPower mode(s)
  * 
@@ -279,7 +282,9 @@ void ketCube_MCU_Sleep(void) {
 #ifndef LOW_POWER_DISABLE
     if (enableSleep == TRUE) {
         
-        if (ketCube_MCU_LPMode == KETCUBE_MCU_LPMODE_SLEEP) {
+        if (ketCube_pwrMan_IsBusy() == TRUE) {
+            ketCube_MCU_EnterCoreSleep();
+        } else if (ketCube_MCU_LPMode == KETCUBE_MCU_LPMODE_SLEEP) {
             ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_DEBUG, "Entering Sleep Mode");
             
             ketCube_MCU_EnterSleepMode();
@@ -311,6 +316,33 @@ void ketCube_MCU_Sleep(void) {
 #endif  /* LOW_POWER_DISABLE */
 }
 
+/**
+ * @brief Wait for IRQ in the selected low-power mode
+ * 
+ * Unlike ketCube_MCU_Sleep(), no message is printed and the MCU wake-up
+ * time is not re-calibrated -- intended for short driver waits.
+ * 
+ * @note This function must be called with IRQs disabled: the pending IRQ
+ *       wakes the MCU and it is serviced when the caller restores PRIMASK
+ *       (i.e. after the run clock and drivers have been restored)
+ * 
+ */
+void ketCube_MCU_WaitForIrq(void) {
+#ifndef LOW_POWER_DISABLE
+    if (ketCube_pwrMan_IsBusy() == TRUE) {
+        ketCube_MCU_EnterCoreSleep();
+    } else if (ketCube_MCU_LPMode == KETCUBE_MCU_LPMODE_SLEEP) {
+        ketCube_MCU_EnterSleepMode();
+        ketCube_MCU_ExitSleepMode();
+    } else {
+        ketCube_MCU_EnterStopMode();
+        ketCube_MCU_ExitStopMode();
+    }
+#else
+    __WFI();
+#endif  /* LOW_POWER_DISABLE */
+}
+
 /**
   * @brief  Clock Configuration
   *         The system Clock is configured as follows:
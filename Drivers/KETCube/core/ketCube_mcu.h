@@ -198,6 +198,7 @@ extern uint32_t ketCube_MCU_GetRandomSeed(void);
 extern void ketCube_MCU_GetUniqueId(uint8_t *id);
 
 extern void ketCube_MCU_Sleep(void);
+extern void ketCube_MCU_WaitForIrq(void);
 extern void ketCube_MCU_EnableSleep(void);
 extern void ketCube_MCU_DisableSleep(void);
 extern bool ketCube_MCU_IsSleepEnabled(void);
@@ -0,0 +1,363 @@
+/**
+ * @file    ketCube_pwrMan.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the KETCube peripheral power manager
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "stm32l0xx_hal.h"
+
+#include "ketCube_pwrMan.h"
+#include "ketCube_terminal.h"
+
+/* BACKUP_PRIMASK MUST be implemented at the begining of the funtion 
+   that implement a critical section                        
+   PRIMASK is saved on STACK and recovered at the end of the funtion
+   That way RESTORE_PRIMASK ensures critical sections are maintained even in nested calls...*/
+
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
+
+volatile uint8_t ketCube_pwrMan_activeMask = 0;
+volatile uint8_t ketCube_pwrMan_busyMask = 0;
+static volatile uint8_t usedMask = 0;   ///< Peripherals acquired in the current wake-up window
+static volatile ketCube_pwrMan_wakeClass_t wakeClass = KETCUBE_PWRMAN_WAKE_CNT;
+static volatile bool windowOpen = FALSE;  ///< Set on low-power mode exit
+
+static ketCube_pwrMan_periphDescr_t periphList[KETCUBE_PWRMAN_PERIPH_CNT] = {
+    { .name = "SPI" },
+    { .name = "RADIO" },
+    { .name = "I2C" },
+    { .name = "AD" },
+    { .name = "I2S" },
+};
+
+static ketCube_pwrMan_wakeStats_t wakeStats[KETCUBE_PWRMAN_WAKE_CNT];
+
+static const char * wakeClassNames[KETCUBE_PWRMAN_WAKE_CNT] = {
+    "RTC",
+    "UART",
+    "EXTI",
+    "OTHER"
+};
+
+/**
+ * @brief Read the free-running cycle counter
+ * 
+ * @retval cycles current SysTick value (counts down)
+ */
+static inline uint32_t getCycles(void)
+{
+    return SysTick->VAL;
+}
+
+/**
+ * @brief Initialize the power manager
+ * 
+ * SysTick is not used as the HAL time base by KETCube (RTC is used), so it is
+ * configured here as a free-running cycle counter (no IRQ) to measure
+ * peripheral restoration cost.
+ * 
+ */
+void ketCube_pwrMan_Init(void)
+{
+    SysTick->LOAD = KETCUBE_PWRMAN_CYCLES_MASK;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+/**
+ * @brief Register peripheral hooks
+ * 
+ * The peripheral is expected to be initialized (active) when registered.
+ * 
+ * @param periph peripheral
+ * @param fnAcquire restore function
+ * @param fnRelease pre-sleep function; NULL if nothing to be done
+ * 
+ */
+void ketCube_pwrMan_Register(ketCube_pwrMan_periph_t periph,
+                             ketCube_pwrMan_fn_t fnAcquire,
+                             ketCube_pwrMan_fn_t fnRelease)
+{
+    BACKUP_PRIMASK();
+    
+    if (periph >= KETCUBE_PWRMAN_PERIPH_CNT) {
+        return;
+    }
+    
+    DISABLE_IRQ();
+    
+    periphList[periph].fnAcquire = fnAcquire;
+    periphList[periph].fnRelease = fnRelease;
+    
+    ketCube_pwrMan_activeMask |= (1 << periph);
+    usedMask |= (1 << periph);
+    
+    RESTORE_PRIMASK();
+}
+
+/**
+ * @brief Unregister peripheral hooks
+ * 
+ * @param periph peripheral
+ * 
+ */
+void ketCube_pwrMan_UnRegister(ketCube_pwrMan_periph_t periph)
+{
+    BACKUP_PRIMASK();
+    
+    if (periph >= KETCUBE_PWRMAN_PERIPH_CNT) {
+        return;
+    }
+    
+    DISABLE_IRQ();
+    
+    periphList[periph].fnAcquire = NULL;
+    periphList[periph].fnRelease = NULL;
+    
+    ketCube_pwrMan_activeMask &= ~(1 << periph);
+    
+    RESTORE_PRIMASK();
+}
+
+/**
+ * @brief Restore the peripheral
+ * 
+ * @note Use ketCube_pwrMan_Acquire(); this is its slow path
+ * @note This function may be called from IRQ context (e.g. radio DIO handlers)
+ * 
+ * @param periph peripheral
+ * 
+ */
+void ketCube_pwrMan_Restore(ketCube_pwrMan_periph_t periph)
+{
+    uint32_t start;
+    
+    BACKUP_PRIMASK();
+    
+    if ((periph >= KETCUBE_PWRMAN_PERIPH_CNT) || (periphList[periph].fnAcquire == NULL)) {
+        return;
+    }
+    
+    DISABLE_IRQ();
+    
+    /* IRQ may restore the peripheral before we get here */
+    if ((ketCube_pwrMan_activeMask & (1 << periph)) == 0) {
+        start = getCycles();
+        
+        periphList[periph].fnAcquire();
+        
+        periphList[periph].restoreCycles = (start - getCycles()) & KETCUBE_PWRMAN_CYCLES_MASK;
+        periphList[periph].restoreCnt++;
+        
+        ketCube_pwrMan_activeMask |= (1 << periph);
+    }
+    
+    usedMask |= (1 << periph);
+    
+    RESTORE_PRIMASK();
+}
+
+/**
+ * @brief Release the peripheral
+ * 
+ * Drivers may release peripheral when not needed anymore, all peripherals are released before sleep entry.
+ * 
+ * @param periph peripheral
+ * 
+ */
+void ketCube_pwrMan_Release(ketCube_pwrMan_periph_t periph)
+{
+    BACKUP_PRIMASK();
+    
+    if (periph >= KETCUBE_PWRMAN_PERIPH_CNT) {
+        return;
+    }
+    
+    DISABLE_IRQ();
+    
+    if ((ketCube_pwrMan_activeMask & (1 << periph)) != 0) {
+        if (periphList[periph].fnRelease != NULL) {
+            periphList[periph].fnRelease();
+        }
+        ketCube_pwrMan_activeMask &= ~(1 << periph);
+    }
+    
+    RESTORE_PRIMASK();
+}
+
+/**
+ * @brief Mark background transfer start/end
+ * 
+ * @param periph peripheral
+ * @param busy TRUE when a background transfer is started, FALSE when finished
+ * 
+ * @note This function may be called from IRQ context
+ * 
+ */
+void ketCube_pwrMan_SetBusy(ketCube_pwrMan_periph_t periph, bool busy)
+{
+    BACKUP_PRIMASK();
+    
+    if (periph >= KETCUBE_PWRMAN_PERIPH_CNT) {
+        return;
+    }
+    
+    DISABLE_IRQ();
+    
+    if (busy == TRUE) {
+        ketCube_pwrMan_busyMask |= (1 << periph);
+    } else {
+        ketCube_pwrMan_busyMask &= ~(1 << periph);
+    }
+    
+    RESTORE_PRIMASK();
+}
+
+/**
+ * @brief Release all peripherals before low-power mode entry
+ * 
+ * Closes the current wake-up window: each registered peripheral, which has
+ * not been used since the last wake-up, would have been restored in vain by
+ * the eager wake-up code -- its last measured restoration cost is accounted
+ * as saved to the wake-up class.
+ * 
+ * @note This function should be called by KETCube core with IRQs disabled
+ * 
+ */
+void ketCube_pwrMan_SleepEnter(void)
+{
+    uint8_t i;
+    uint32_t savedCycles = 0;
+    ketCube_pwrMan_wakeStats_t * stats = NULL;
+    
+    /* No IRQ has been recorded since the last low-power mode exit */
+    if ((windowOpen == TRUE) && (wakeClass == KETCUBE_PWRMAN_WAKE_CNT)) {
+        wakeClass = KETCUBE_PWRMAN_WAKE_OTHER;
+    }
+    
+    if (wakeClass < KETCUBE_PWRMAN_WAKE_CNT) {
+        stats = &(wakeStats[wakeClass]);
+        stats->wakeCnt++;
+    }
+    
+    for (i = 0; i < KETCUBE_PWRMAN_PERIPH_CNT; i++) {
+        if (periphList[i].fnAcquire == NULL) {
+            continue;
+        }
+        
+        if ((stats != NULL) && ((usedMask & (1 << i)) == 0)) {
+            stats->skipCnt++;
+            savedCycles += periphList[i].restoreCycles;
+        }
+        
+        ketCube_pwrMan_Release((ketCube_pwrMan_periph_t) i);
+    }
+    
+    if (stats != NULL) {
+        stats->savedUs += savedCycles / (SystemCoreClock / 1000000);
+    }
+    
+    /* Start a new window, the first IRQ determines the wake-up class */
+    usedMask = 0;
+    wakeClass = KETCUBE_PWRMAN_WAKE_CNT;
+    windowOpen = FALSE;
+}
+
+/**
+ * @brief Low-power mode exit
+ * 
+ * No peripheral is restored here, see ketCube_pwrMan_Acquire()
+ * 
+ * @note This function should be called by KETCube core
+ * @note The wake-up IRQ may be serviced after this function returns
+ *       (low-power mode entered with IRQs masked), the wake-up class is thus
+ *       resolved when the window is closed by ketCube_pwrMan_SleepEnter()
+ * 
+ */
+void ketCube_pwrMan_SleepExit(void)
+{
+    windowOpen = TRUE;
+}
+
+/**
+ * @brief Record wake-up event
+ * 
+ * @param eventClass wake-up class of the IRQ
+ * 
+ * @note This function should be called from IRQ handlers
+ * 
+ */
+void ketCube_pwrMan_WakeEvent(ketCube_pwrMan_wakeClass_t eventClass)
+{
+    if (wakeClass == KETCUBE_PWRMAN_WAKE_CNT) {
+        wakeClass = eventClass;
+    }
+}
+
+/**
+ * @brief Print power manager statistics
+ * 
+ */
+void ketCube_pwrMan_PrintStats(void)
+{
+    uint8_t i;
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000;
+    
+    for (i = 0; i < KETCUBE_PWRMAN_PERIPH_CNT; i++) {
+        KETCUBE_TERMINAL_PRINTF("%-6s: %s; restored %d times; restore cost %d us",
+                                periphList[i].name,
+                                ((periphList[i].fnAcquire != NULL) ? "registered" : "not registered"),
+                                periphList[i].restoreCnt,
+                                periphList[i].restoreCycles / cyclesPerUs);
+        KETCUBE_TERMINAL_ENDL();
+    }
+    
+    for (i = 0; i < KETCUBE_PWRMAN_WAKE_CNT; i++) {
+        KETCUBE_TERMINAL_PRINTF("%-6s: %d wake-ups; %d restorations avoided; %d us saved",
+                                wakeClassNames[i],
+                                wakeStats[i].wakeCnt,
+                                wakeStats[i].skipCnt,
+                                wakeStats[i].savedUs);
+        KETCUBE_TERMINAL_ENDL();
+    }
+}
@@ -0,0 +1,193 @@
+/**
+ * @file    ketCube_pwrMan.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the KETCube peripheral power manager defs
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_PWRMAN_H
+#define __KETCUBE_PWRMAN_H
+
+#include "ketCube_cfg.h"
+
+/** @defgroup KETCube_pwrMan KETCube pwrMan
+  * @brief KETCube peripheral power manager
+  * 
+  * Drivers register acquire/release hooks here. All acquired peripherals
+  * are released before the MCU enters a low-power mode, but they are not
+  * restored on wake-up: a peripheral is restored (re-clocked and its pins
+  * re-configured) by ketCube_pwrMan_Acquire() when it is used for the first
+  * time after wake-up. Wake-ups which do not touch the peripheral (terminal
+  * bytes, timers, ...) thus do not pay for its restoration.
+  * 
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_PWRMAN_NAME               "pwrMan"         ///< Power manager name
+#define KETCUBE_PWRMAN_CYCLES_MASK        0x00FFFFFF       ///< SysTick is a 24-bit down-counter; free-running cycle counter
+
+/**
+* @brief  Managed peripherals
+*/
+typedef enum ketCube_pwrMan_periph_t {
+    KETCUBE_PWRMAN_PERIPH_SPI = 0,     ///< SPI1 (SX1276 bus)
+    KETCUBE_PWRMAN_PERIPH_RADIO,       ///< SX1276 board IO
+    KETCUBE_PWRMAN_PERIPH_I2C,         ///< I2C1 (sensor bus)
+    KETCUBE_PWRMAN_PERIPH_AD,          ///< ADC1
+    KETCUBE_PWRMAN_PERIPH_I2S,         ///< SPI2 in I2S mode (microphone capture)
+    
+    KETCUBE_PWRMAN_PERIPH_CNT          ///< Number of managed peripherals - do not use as peripheral!
+} ketCube_pwrMan_periph_t;
+
+/**
+* @brief  Wake-up (interrupt) classes
+* 
+* The first interrupt after the low-power mode entry determines the class of the wake-up.
+*/
+typedef enum ketCube_pwrMan_wakeClass_t {
+    KETCUBE_PWRMAN_WAKE_RTC = 0,       ///< RTC alarm (timers)
+    KETCUBE_PWRMAN_WAKE_UART,          ///< UART (e.g. terminal byte)
+    KETCUBE_PWRMAN_WAKE_EXTI,          ///< EXTI line (radio DIOs, sensor IRQs)
+    KETCUBE_PWRMAN_WAKE_OTHER,         ///< Unknown source
+
+    KETCUBE_PWRMAN_WAKE_CNT            ///< Number of wake-up classes - do not use as class!
+} ketCube_pwrMan_wakeClass_t;
+
+/**
+* @brief  Acquire/release hook
+*/
+typedef ketCube_cfg_DrvError_t (*ketCube_pwrMan_fn_t) (void);
+
+/**
+* @brief  Peripheral descriptor
+*/
+typedef struct ketCube_pwrMan_periphDescr_t {
+    const char * name;                 ///< Peripheral name
+    ketCube_pwrMan_fn_t fnAcquire;     ///< Restore the peripheral (clock, pins, enable); NULL if peripheral is not registered
+    ketCube_pwrMan_fn_t fnRelease;     ///< Prepare the peripheral for low-power mode; may be NULL
+    uint32_t restoreCycles;            ///< Last measured duration of fnAcquire in core clock cycles
+    uint32_t restoreCnt;               ///< Number of executed restorations
+} ketCube_pwrMan_periphDescr_t;
+
+/**
+* @brief  Wake-up class statistics
+*/
+typedef struct ketCube_pwrMan_wakeStats_t {
+    uint32_t wakeCnt;                  ///< Number of wake-ups of this class
+    uint32_t skipCnt;                  ///< Number of peripheral restorations avoided
+    uint32_t savedUs;                  ///< Wake-to-sleep time saved by avoided restorations in us
+} ketCube_pwrMan_wakeStats_t;
+
+/**
+* @brief  Bitmask of currently active (restored) peripherals
+* 
+* @note Do not modify outside of the power manager
+*/
+extern volatile uint8_t ketCube_pwrMan_activeMask;
+
+/**
+* @brief  Bitmask of peripherals running a background (IRQ/DMA) transfer
+* 
+* The MCU clock must not be switched and the peripheral must not be released
+* while any bit is set: KETCube core waits in the core sleep only.
+* 
+* @note Do not modify outside of the power manager
+*/
+extern volatile uint8_t ketCube_pwrMan_busyMask;
+
+/** @defgroup KETCube_pwrMan_fn Public Functions
+* @{
+*/
+
+extern void ketCube_pwrMan_Init(void);
+extern void ketCube_pwrMan_Register(ketCube_pwrMan_periph_t periph,
+                                    ketCube_pwrMan_fn_t fnAcquire,
+                                    ketCube_pwrMan_fn_t fnRelease);
+extern void ketCube_pwrMan_UnRegister(ketCube_pwrMan_periph_t periph);
+extern void ketCube_pwrMan_Restore(ketCube_pwrMan_periph_t periph);
+extern void ketCube_pwrMan_Release(ketCube_pwrMan_periph_t periph);
+extern void ketCube_pwrMan_SetBusy(ketCube_pwrMan_periph_t periph, bool busy);
+
+extern void ketCube_pwrMan_SleepEnter(void);
+extern void ketCube_pwrMan_SleepExit(void);
+extern void ketCube_pwrMan_WakeEvent(ketCube_pwrMan_wakeClass_t wakeClass);
+
+extern void ketCube_pwrMan_PrintStats(void);
+
+/**
+ * @brief Acquire the peripheral before use
+ * 
+ * Restores the peripheral if it has not been used since the last wake-up.
+ * This is cheap when the peripheral is already active, so drivers call it
+ * at the beginning of every bus access.
+ * 
+ * @param periph peripheral to be acquired
+ * 
+ */
+static inline void ketCube_pwrMan_Acquire(ketCube_pwrMan_periph_t periph)
+{
+    if ((ketCube_pwrMan_activeMask & (1 << periph)) == 0) {
+        ketCube_pwrMan_Restore(periph);
+    }
+}
+
+/**
+ * @brief Check for background transfers
+ * 
+ * @retval TRUE if any peripheral runs a background transfer
+ * @retval FALSE if low-power modes can be entered
+ * 
+ */
+static inline bool ketCube_pwrMan_IsBusy(void)
+{
+    return (ketCube_pwrMan_busyMask != 0);
+}
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_PWRMAN_H */
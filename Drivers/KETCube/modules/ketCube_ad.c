@@ -47,11 +47,12 @@
 #ifdef KETCUBE_CFG_INC_DRV_AD
 
 #include "stm32l0xx_hal.h"
-#include "stm32l0xx_hal_i2c.h"
 
 #include "ketCube_ad.h"
 #include "ketCube_rtc.h"
 #include "ketCube_terminal.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_mcu.h"
 
 #define KETCUBE_AD_VDDA_VREFINT_CAL       ((uint32_t) 3000)       /*!< Internal voltage reference was calibrated at 3V */
 
@@ -63,12 +64,68 @@
 
 #define KETCUBE_AD_VREFANALOG_TEMPSENSOR_CAL  ((uint32_t) 3000)    /* Analog voltage reference (Vref+) voltage with which temperature sensor has been calibrated in production (+-10 mV) (unit: mV). */
 
-#define KETCUBE_AD_MAX                    ((uint16_t) 4095)       /*!< ADC Resolution */
+#define KETCUBE_AD_MAX                    ((uint32_t) (4095 * 16))    /*!< ADC Resolution: 12-bit, 16x oversampled (sum) */
+#define KETCUBE_AD_OVS                    ((uint32_t) 16)             /*!< Oversampling ratio; calibration values are 12-bit */
+
+#define KETCUBE_AD_DMA_CHANNEL            DMA1_Channel1
+#define KETCUBE_AD_DMA_REQUEST            DMA_REQUEST_0
+#define KETCUBE_AD_DMA_IRQn               DMA1_Channel1_IRQn
+
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
 
 static ADC_HandleTypeDef hadc;
+static DMA_HandleTypeDef hdma;
 
 static uint8_t initRuns = 0;    ///< This driver can be initialized in number of modules. If 0 == not initialized, else initialized
 
+static uint32_t scanChannels = (ADC_CHANNEL_VREFINT | ADC_CHANNEL_TEMPSENSOR) & ADC_CHANNEL_MASK;  ///< Channels (CHSELR bits) included in each scan
+static uint32_t lastChannels = 0;                     ///< Channels of the last scan; 0 if there is no valid scan
+static TimerTime_t lastScan;                          ///< Last scan timestamp
+static uint16_t scanData[KETCUBE_AD_SCAN_MAX];        ///< Last scan results (ascending channel number order)
+static uint16_t vddmV = 0;                            ///< VDDA from the last scan
+static uint32_t calFactor;                            ///< Cached calibration factor
+static bool calValid = FALSE;                         ///< Calibration factor is valid
+static int32_t calTemperature;                        ///< Temperature at calibration (1/256 degC)
+static volatile bool scanDone;
+
+/**
+ * @brief  Restore ADC after wake-up
+ * 
+ * Waits for VREFINT (fast wake-up does not wait for it) and re-clocks the ADC
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ */
+static ketCube_cfg_DrvError_t ketCube_AD_SleepExit(void)
+{
+    TimerTime_t timeout;
+    
+    /* wait the Vrefint used by adc is set */
+    timeout = ketCube_RTC_GetTimerValue();
+    while (__HAL_PWR_GET_FLAG(PWR_FLAG_VREFINTRDY) == RESET) {
+        if ((ketCube_RTC_GetTimerValue() - timeout) > ketCube_RTC_ms2Tick(KETCUBE_AD_VREFINT_MAX_TIMEOUT_MS)) {
+            break;
+        }
+    }
+    
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief  Gate ADC clock before sleep
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ */
+static ketCube_cfg_DrvError_t ketCube_AD_SleepEnter(void)
+{
+    __HAL_RCC_ADC1_CLK_DISABLE();
+    
+    return KETCUBE_CFG_DRV_OK;
+}
+
 /**
  * @brief  initializes ADC
  *
@@ -84,7 +141,11 @@ ketCube_cfg_DrvError_t ketCube_AD_Init(void) {
     
     hadc.Instance  = ADC1;
     
-    hadc.Init.OversamplingMode      = DISABLE;
+    /* 16x oversampling, no shift: 16-bit result */
+    hadc.Init.OversamplingMode      = ENABLE;
+    hadc.Init.Oversample.Ratio         = ADC_OVERSAMPLING_RATIO_16;
+    hadc.Init.Oversample.RightBitShift = ADC_RIGHTBITSHIFT_NONE;
+    hadc.Init.Oversample.TriggeredMode = ADC_TRIGGEREDMODE_SINGLE_TRIGGER;
     
     hadc.Init.ClockPrescaler        = ADC_CLOCK_SYNC_PCLK_DIV4;
     hadc.Init.LowPowerAutoPowerOff  = DISABLE;
@@ -92,20 +153,43 @@ ketCube_cfg_DrvError_t ketCube_AD_Init(void) {
     hadc.Init.LowPowerAutoWait      = DISABLE;
     
     hadc.Init.Resolution            = ADC_RESOLUTION_12B;
-    hadc.Init.SamplingTime          = ADC_SAMPLETIME_160CYCLES_5;
+    hadc.Init.SamplingTime          = ADC_SAMPLETIME_79CYCLES_5;  /* 10 us: min. for VREFINT and temperature sensor */
     hadc.Init.ScanConvMode          = ADC_SCAN_DIRECTION_FORWARD;
     hadc.Init.DataAlign             = ADC_DATAALIGN_RIGHT;
     hadc.Init.ContinuousConvMode    = DISABLE;
     hadc.Init.DiscontinuousConvMode = DISABLE;
     hadc.Init.ExternalTrigConvEdge  = ADC_EXTERNALTRIGCONVEDGE_NONE;
-    hadc.Init.EOCSelection          = ADC_EOC_SINGLE_CONV;
+    hadc.Init.EOCSelection          = ADC_EOC_SEQ_CONV;
     hadc.Init.DMAContinuousRequests = DISABLE;
+    hadc.Init.Overrun               = ADC_OVR_DATA_OVERWRITTEN;
     
     __HAL_RCC_ADC1_CLK_ENABLE();
     
     HAL_ADC_Init(&hadc);
     
-    __HAL_RCC_ADC1_CLK_DISABLE();
+    /* Scan results are moved by DMA */
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    hdma.Instance = KETCUBE_AD_DMA_CHANNEL;
+    hdma.Init.Request = KETCUBE_AD_DMA_REQUEST;
+    hdma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma.Init.MemInc = DMA_MINC_ENABLE;
+    hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma.Init.Mode = DMA_NORMAL;
+    hdma.Init.Priority = DMA_PRIORITY_LOW;
+    HAL_DMA_Init(&hdma);
+    __HAL_LINKDMA(&hadc, DMA_Handle, hdma);
+    
+    HAL_NVIC_SetPriority(KETCUBE_AD_DMA_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(KETCUBE_AD_DMA_IRQn);
+    
+    /* Calibrate on the first scan */
+    calValid = FALSE;
+    lastChannels = 0;
+    
+    /* ADC is clocked on demand and gated before sleep */
+    ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_AD, &ketCube_AD_SleepExit, &ketCube_AD_SleepEnter);
     
     return KETCUBE_CFG_DRV_OK;
 }
@@ -124,69 +208,282 @@ ketCube_cfg_DrvError_t ketCube_AD_UnInit(void) {
         // Run UnInit body once only: (initRuns == 1)
         initRuns = 0;
         // UnInit here ...
+        ketCube_pwrMan_Acquire(KETCUBE_PWRMAN_PERIPH_AD);
+        HAL_NVIC_DisableIRQ(KETCUBE_AD_DMA_IRQn);
+        HAL_DMA_DeInit(&hdma);
         HAL_ADC_DeInit(&hadc);
+        ketCube_pwrMan_Release(KETCUBE_PWRMAN_PERIPH_AD);
+        ketCube_pwrMan_UnRegister(KETCUBE_PWRMAN_PERIPH_AD);
+        lastChannels = 0;
+        vddmV = 0;
     }
 
     return KETCUBE_CFG_DRV_OK;
 }
 
 /**
-  * @brief Read ADC channel single-conversion result
+ * @brief Get index of the channel in scan results
+ * 
+ * Forward scan converts channels in ascending channel number order.
+ * 
+ * @param channels scanned channels (CHSELR bits)
+ * @param channel ADC channel
+ * 
+ * @retval index
+ */
+static uint8_t scanIndex(uint32_t channels, uint32_t channel)
+{
+    uint32_t below = channels & ((channel & ADC_CHANNEL_MASK) - 1);
+    uint8_t index = 0;
+    
+    while (below != 0) {
+        below &= below - 1;
+        index++;
+    }
+    
+    return index;
+}
+
+/**
+ * @brief Compute core temperature
+ * 
+ * Compute temperature based on RAW ADC data and battery voltage
+ * 
+ * @param tempRAW temperature sensor RAW data (16x oversampled)
+ * @param bat battery level in mV
+ * 
+ * @retval temperature in 1/256 degrees of Celsius
+ * 
+ */
+static inline int32_t compute_temperature(uint16_t tempRAW, uint16_t bat) {
+  int32_t deg = 0;
   
-  * @param channel ADC channel
-  * 
-  * @retval value connversion result
-  *
-  */
-uint16_t ketCube_AD_ReadChannel(uint32_t channel) {
-    ADC_ChannelConfTypeDef adcConf;
-    uint16_t adcData = 0;
-    TimerTime_t timeout = 0;
-    
-    if (initRuns > 0) {
-        /* wait the Vrefint used by adc is set */
-        timeout = ketCube_RTC_GetTimerValue( );
-        while (__HAL_PWR_GET_FLAG(PWR_FLAG_VREFINTRDY) == RESET) {
-            if( ((ketCube_RTC_GetTimerValue( ) - timeout)) < ketCube_RTC_ms2Tick(KETCUBE_AD_VREFINT_MAX_TIMEOUT_MS) ) {
-                break;
+  deg = (int32_t) (((uint32_t) tempRAW * bat) / KETCUBE_AD_VREFANALOG_TEMPSENSOR_CAL) - (int32_t) (*KETCUBE_AD_TS_CAL1 * KETCUBE_AD_OVS);
+  deg = deg * (int32_t)(130 - 30);
+  deg = deg << 8;
+  deg = deg / ((int32_t) ((*KETCUBE_AD_TS_CAL2 - *KETCUBE_AD_TS_CAL1) * KETCUBE_AD_OVS));
+  deg = deg + (30 << 8);
+  
+  return deg;
+}
+
+/**
+ * @brief DMA transfer complete: all channels of the scan converted
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * hadcPtr)
+{
+    scanDone = TRUE;
+}
+
+/**
+ * @brief Wait for the end of the scan
+ * 
+ * The core sleeps (the ADC peripheral is marked busy, thus STOP mode is not
+ * used) until the DMA IRQ. When called from an IRQ handler or a critical
+ * section, the DMA IRQ is serviced here.
+ * 
+ * @retval TRUE if the scan completed
+ */
+static bool waitScan(void)
+{
+    TimerTime_t start = ketCube_RTC_GetTimerValue();
+    TimerTime_t timeout = ketCube_RTC_ms2Tick(KETCUBE_AD_SCAN_TIMEOUT_MS);
+    bool sleep = ((__get_IPSR() == 0) && (__get_PRIMASK() == 0));
+    
+    while (scanDone == FALSE) {
+        if ((ketCube_RTC_GetTimerValue() - start) > timeout) {
+            return FALSE;
+        }
+        
+        if (sleep == FALSE) {
+            if (__HAL_DMA_GET_FLAG(&hdma, __HAL_DMA_GET_TC_FLAG_INDEX(&hdma)) != RESET) {
+                HAL_DMA_IRQHandler(&hdma);
             }
+            continue;
         }
-          
-        __HAL_RCC_ADC1_CLK_ENABLE();
         
-        /*calibrate ADC if any calibraiton hardware*/
+        {
+            BACKUP_PRIMASK();
+            DISABLE_IRQ();
+            if (scanDone == FALSE) {
+                ketCube_MCU_WaitForIrq();
+            }
+            RESTORE_PRIMASK();
+        }
+    }
+    
+    return TRUE;
+}
+
+/**
+ * @brief Scan all enabled channels
+ * 
+ * The ADC is calibrated at the first scan after initialization and when
+ * the core temperature changes by KETCUBE_AD_RECAL_DELTA_T; otherwise the
+ * cached calibration factor is restored. All channels (incl. VREFINT and
+ * the temperature sensor) are converted in one 16x oversampled sequence
+ * transferred by DMA.
+ * 
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ * @retval KETCUBE_CFG_DRV_ERROR in case of failure
+ */
+static ketCube_cfg_DrvError_t scan(void)
+{
+    ADC_ChannelConfTypeDef adcConf;
+    uint32_t channels = scanChannels;
+    uint32_t i;
+    uint8_t len = 0;
+    int32_t temperature;
+    bool done;
+    
+    for (i = channels; i != 0; i &= i - 1) {
+        len++;
+    }
+    if (len > KETCUBE_AD_SCAN_MAX) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+    
+    /* VREFINT settling and ADC clock - once per wake-up */
+    ketCube_pwrMan_Acquire(KETCUBE_PWRMAN_PERIPH_AD);
+    
+    if (calValid == FALSE) {
         HAL_ADCEx_Calibration_Start(&hadc, ADC_SINGLE_ENDED);
-        
-        /* Deselects all channels*/
-        adcConf.Channel = ADC_CHANNEL_MASK;
-        adcConf.Rank = ADC_RANK_NONE; 
-        HAL_ADC_ConfigChannel(&hadc, &adcConf);
-          
-        /* configure adc channel */
-        adcConf.Channel = channel;
-        adcConf.Rank = ADC_RANK_CHANNEL_NUMBER;
+        calFactor = HAL_ADCEx_Calibration_GetValue(&hadc, ADC_SINGLE_ENDED);
+    } else {
+        HAL_ADCEx_Calibration_SetValue(&hadc, ADC_SINGLE_ENDED, calFactor);
+    }
+    
+    /* Deselects all channels*/
+    adcConf.Channel = ADC_CHANNEL_MASK;
+    adcConf.Rank = ADC_RANK_NONE; 
+    HAL_ADC_ConfigChannel(&hadc, &adcConf);
+    
+    /* Configure adc channels; VREFINT and TS are passed with their enable bits */
+    adcConf.Rank = ADC_RANK_CHANNEL_NUMBER;
+    for (i = 1; (i & ADC_CHANNEL_MASK) != 0; i <<= 1) {
+        if ((channels & i) == 0) {
+            continue;
+        }
+        if (i == (ADC_CHANNEL_VREFINT & ADC_CHANNEL_MASK)) {
+            adcConf.Channel = ADC_CHANNEL_VREFINT;
+        } else if (i == (ADC_CHANNEL_TEMPSENSOR & ADC_CHANNEL_MASK)) {
+            adcConf.Channel = ADC_CHANNEL_TEMPSENSOR;
+        } else {
+            adcConf.Channel = i;
+        }
         HAL_ADC_ConfigChannel(&hadc, &adcConf);
-        
-        /* Start the conversion process */
-        HAL_ADC_Start(&hadc);
-          
-        /* Wait for the end of conversion */
-        HAL_ADC_PollForConversion( &hadc, HAL_MAX_DELAY );
-        
-        /* Get the converted value of regular channel */
-        adcData = HAL_ADC_GetValue(&hadc);
-        
-        __HAL_ADC_DISABLE(&hadc) ;
-        
-        __HAL_RCC_ADC1_CLK_DISABLE();
     }
     
-    return adcData;
+    ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_AD, TRUE);
+    scanDone = FALSE;
+    
+    if (HAL_ADC_Start_DMA(&hadc, (uint32_t *) &(scanData[0]), len) != HAL_OK) {
+        ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_AD, FALSE);
+        lastChannels = 0;
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+    
+    done = waitScan();
+    
+    HAL_ADC_Stop_DMA(&hadc);
+    ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_AD, FALSE);
+    
+    /* VREFINT and TS buffers are not needed until the next scan */
+    adcConf.Channel = ADC_CHANNEL_VREFINT;
+    adcConf.Rank = ADC_RANK_NONE; 
+    HAL_ADC_ConfigChannel(&hadc, &adcConf);
+    adcConf.Channel = ADC_CHANNEL_TEMPSENSOR;
+    HAL_ADC_ConfigChannel(&hadc, &adcConf);
+    
+    if (done == FALSE) {
+        ketCube_terminal_DriverSeverityPrintln(KETCUBE_AD_NAME, KETCUBE_CFG_SEVERITY_ERROR, "Scan timeout!");
+        lastChannels = 0;
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+    
+    lastChannels = channels;
+    lastScan = ketCube_RTC_GetTimerValue();
+    
+    /* Cache VDDA */
+    i = scanData[scanIndex(channels, ADC_CHANNEL_VREFINT)];
+    if (i == 0) {
+        vddmV = 0;
+    } else {
+        vddmV = (uint16_t) ((KETCUBE_AD_VDDA_VREFINT_CAL * (*KETCUBE_AD_VREFINT_CAL) * KETCUBE_AD_OVS) / i);
+    }
+    
+    /* Re-calibrate on the next scan when temperature changes */
+    temperature = compute_temperature(scanData[scanIndex(channels, ADC_CHANNEL_TEMPSENSOR)], vddmV);
+    if (calValid == FALSE) {
+        calTemperature = temperature;
+        calValid = TRUE;
+    } else if ((temperature > (calTemperature + (KETCUBE_AD_RECAL_DELTA_T << 8)))
+               || (temperature < (calTemperature - (KETCUBE_AD_RECAL_DELTA_T << 8)))) {
+        calValid = FALSE;
+    }
+    
+    ketCube_terminal_DriverSeverityPrintln(KETCUBE_AD_NAME, KETCUBE_CFG_SEVERITY_DEBUG, "Scan: %d channels; VDDA: %d mV", len, vddmV);
+    
+    return KETCUBE_CFG_DRV_OK;
 }
 
+/**
+ * @brief Make scan results available; scan if there is no recent scan of the channel
+ * 
+ * @param channel ADC channel
+ * 
+ * @retval TRUE if the results are valid
+ */
+static bool getScan(uint32_t channel)
+{
+    if (initRuns == 0) {
+        return FALSE;
+    }
+    
+    channel &= ADC_CHANNEL_MASK;
+    scanChannels |= channel;
+    
+    if (((lastChannels & channel) == channel)
+        && ((ketCube_RTC_GetTimerValue() - lastScan) < ketCube_RTC_ms2Tick(KETCUBE_AD_SCAN_VALID_MS))) {
+        return TRUE;
+    }
+    
+    return (scan() == KETCUBE_CFG_DRV_OK);
+}
 
 /**
-  * @brief Read ADC channel single-conversion value in mV
+  * @brief Include channel in each scan
+  * 
+  * Modules should enable their channels at initialization, so all the
+  * values needed in one period are converted by one scan.
+  * 
+  * @param channel ADC channel
+  *
+  */
+void ketCube_AD_EnableChannel(uint32_t channel)
+{
+    scanChannels |= (channel & ADC_CHANNEL_MASK);
+}
+
+/**
+  * @brief Read ADC channel
+  
+  * @param channel ADC channel
+  * 
+  * @retval value 16x oversampled conversion result (16-bit)
+  *
+  */
+uint16_t ketCube_AD_ReadChannel(uint32_t channel) {
+    if (getScan(channel) == FALSE) {
+        return 0;
+    }
+    
+    return scanData[scanIndex(lastChannels, channel)];
+}
+
+
+/**
+  * @brief Read ADC channel value in mV
   
   * @param channel ADC channel
   * 
@@ -195,25 +492,17 @@ uint16_t ketCube_AD_ReadChannel(uint32_t channel) {
   */
 uint16_t ketCube_AD_ReadChannelmV(uint32_t channel)
 {
-    uint32_t vddmv;
-    uint16_t vdd;
     uint16_t vin;
     uint16_t mv;
 
-    vdd = ketCube_AD_ReadChannel(ADC_CHANNEL_VREFINT);
+    vin = ketCube_AD_ReadChannel(channel);
 
-    if (vdd == 0) {
-        return KETCUBE_CFG_MODULE_ERROR;
+    /* VDDA is converted in the same scan */
+    if (vddmV == 0) {
+        return 0;
     }
 
-    vddmv =
-        (((uint32_t) KETCUBE_AD_VDDA_VREFINT_CAL *
-          (*KETCUBE_AD_VREFINT_CAL)) / vdd);
-
-    vin = ketCube_AD_ReadChannel(channel);
-
-    // for 12 bit resolution ...
-    mv = (uint16_t) ((vddmv * vin) / KETCUBE_AD_MAX);
+    mv = (uint16_t) (((uint32_t) vddmV * vin) / KETCUBE_AD_MAX);
     ketCube_terminal_DriverSeverityPrintln(KETCUBE_AD_NAME, KETCUBE_CFG_SEVERITY_DEBUG, "Voltage: %d", mv);
     
     return mv;
@@ -226,43 +515,11 @@ uint16_t ketCube_AD_ReadChannelmV(uint32_t channel)
   * @retval battery level in mV
   */
 uint32_t ketCube_AD_GetBatLevelmV(void) {
-    uint16_t measuredLevel = 0;
-    uint32_t batteryLevelmV;
-
-    measuredLevel = ketCube_AD_ReadChannel(ADC_CHANNEL_VREFINT);
-
-    if (measuredLevel == 0) {
-        batteryLevelmV = 0;
-    } else {
-        batteryLevelmV =
-            (((uint32_t) KETCUBE_AD_VDDA_VREFINT_CAL *
-              (*KETCUBE_AD_VREFINT_CAL)) / measuredLevel);
+    if (getScan(ADC_CHANNEL_VREFINT) == FALSE) {
+        return 0;
     }
     
-    return batteryLevelmV;
-}
-
-/**
- * @brief Compute core temperature
- * 
- * Compute temperature based on RAW ADC data and battery voltage
- * 
- * @param tempRAW temperature sensor RAW data
- * @param bat battery level in mV
- * 
- * @retval temperature in degrees of Celsius
- * 
- */
-static inline int32_t compute_temperature(uint16_t tempRAW, uint16_t bat) {
-  int32_t deg = 0;
-  
-  deg = (int32_t) ((tempRAW * bat) / KETCUBE_AD_VREFANALOG_TEMPSENSOR_CAL) - (int32_t) *KETCUBE_AD_TS_CAL1;
-  deg = deg * (int32_t)(130 - 30);
-  deg = deg << 8;
-  deg = deg / ((int32_t) (*KETCUBE_AD_TS_CAL2 - *KETCUBE_AD_TS_CAL1));
-  deg = deg + (30 << 8);
-  
-  return deg;
+    return vddmV;
 }
 
 /**
@@ -272,7 +529,19 @@ static inline int32_t compute_temperature(uint16_t tempRAW, uint16_t bat) {
   * 
   */
 uint16_t ketCube_AD_GetTemperature(void) {
-    return (uint16_t) compute_temperature(ketCube_AD_ReadChannel(ADC_CHANNEL_TEMPSENSOR), ketCube_AD_GetBatLevelmV());
+    uint16_t raw = ketCube_AD_ReadChannel(ADC_CHANNEL_TEMPSENSOR);
+    
+    return (uint16_t) compute_temperature(raw, vddmV);
+}
+
+/**
+ * @brief  DMA1 channel 1 IRQ handler
+ * 
+ * @note Channel 1 is used by ADC
+ */
+void DMA1_Channel1_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma);
 }
 
 #endif // KETCUBE_CFG_INC_DRV_AD
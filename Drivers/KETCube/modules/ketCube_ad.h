@@ -63,6 +63,11 @@
 
 #define KETCUBE_AD_VREFINT_MAX_TIMEOUT_MS     10              ///< Max timeout to stabilize vrefint
 
+#define KETCUBE_AD_SCAN_MAX                   4               ///< Max. number of channels in one scan
+#define KETCUBE_AD_SCAN_VALID_MS              100             ///< Scan results are reused within this time
+#define KETCUBE_AD_SCAN_TIMEOUT_MS            10              ///< Scan timeout
+#define KETCUBE_AD_RECAL_DELTA_T              10              ///< Re-calibrate when core temperature changes by this value (degC)
+
 /**
 * @}
 */
@@ -76,6 +81,7 @@ extern ketCube_cfg_DrvError_t ketCube_AD_Init(void);
 extern ketCube_cfg_DrvError_t ketCube_AD_UnInit(void);
 
 /* General-purpose functions */
+extern void ketCube_AD_EnableChannel(uint32_t channel);
 extern uint16_t ketCube_AD_ReadChannel(uint32_t channel);
 extern uint16_t ketCube_AD_ReadChannelmV(uint32_t channel);
 
@@ -83,6 +89,8 @@ extern uint16_t ketCube_AD_ReadChannelmV(uint32_t channel);
 extern uint32_t ketCube_AD_GetBatLevelmV(void);
 extern uint16_t ketCube_AD_GetTemperature(void);
 
+extern void DMA1_Channel1_IRQHandler(void);
+
 /**
 * @}
 */
@@ -54,18 +54,253 @@
 
 #include "ketCube_gpio.h"
 #include "ketCube_mainBoard.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_delay.h"
 
 // Local defines
 #define KETCUBE_I2C_CLK_ENABLE()               __I2C1_CLK_ENABLE()
 #define KETCUBE_I2C_FORCE_RESET()              __I2C1_FORCE_RESET()
 #define KETCUBE_I2C_RELEASE_RESET()            __I2C1_RELEASE_RESET()
+#define KETCUBE_I2C_CLK_DISABLE()              __I2C1_CLK_DISABLE()
+#define KETCUBE_I2C_DMA_RX_CHANNEL             DMA1_Channel3
+#define KETCUBE_I2C_DMA_RX_REQUEST             DMA_REQUEST_6
+#define KETCUBE_I2C_DMA_IRQn                   DMA1_Channel2_3_IRQn
+
+/* BACKUP_PRIMASK MUST be implemented at the begining of the funtion 
+   that implement a critical section                        
+   PRIMASK is saved on STACK and recovered at the end of the funtion
+   That way RESTORE_PRIMASK ensures critical sections are maintained even in nested calls...*/
+
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
 
 // local fn declarations
 I2C_HandleTypeDef KETCUBE_I2C_Handle;
+static DMA_HandleTypeDef KETCUBE_I2C_DmaRxHandle;
 static void ketCube_I2C_Error(void);
+static void ketCube_I2C_StartNext(void);
 
 static uint8_t initRuns = 0;    //!< This driver can be initialized in number of modules. If 0 == not initialized, else initialized
 
+/**
+* @brief Per-device bus speed; addr == 0 marks an unused entry
+*/
+static struct {
+    uint8_t addr;
+    ketCube_I2C_SPEED_t speed;
+} devSpeed[KETCUBE_I2C_DEV_SPEED_CNT];
+
+static ketCube_I2C_Xfer_t xferQueue[KETCUBE_I2C_QUEUE_LEN];     //!< Transaction queue; xferHead is the running transaction
+static volatile uint8_t xferHead = 0;
+static volatile uint8_t xferCnt = 0;
+static volatile bool xferActive = FALSE;        //!< Transaction queue is being processed
+static volatile bool busClearPending = FALSE;   //!< Bus error detected in IRQ context
+
+static ketCube_I2C_DevStats_t devStats[KETCUBE_I2C_DEV_STATS_CNT];     //!< Per-device statistics; addr == 0 marks an unused entry
+
+/**
+ * @brief  Find device statistics
+ * 
+ * @param  Addr I2C Address
+ * @param  alloc allocate a new entry if the device is not found
+ * 
+ * @retval pointer to statistics or NULL if not found and not allocated
+ */
+static ketCube_I2C_DevStats_t * ketCube_I2C_GetStats(uint8_t Addr, bool alloc)
+{
+    uint8_t i;
+
+    for (i = 0; i < KETCUBE_I2C_DEV_STATS_CNT; i++) {
+        if (devStats[i].addr == Addr) {
+            return &(devStats[i]);
+        }
+    }
+
+    if (alloc == FALSE) {
+        return NULL;
+    }
+
+    for (i = 0; i < KETCUBE_I2C_DEV_STATS_CNT; i++) {
+        if (devStats[i].addr == 0) {
+            devStats[i].addr = Addr;
+            return &(devStats[i]);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief  Saturated counter increment
+ */
+static inline void ketCube_I2C_CntInc(uint16_t * cnt)
+{
+    if (*cnt < 0xFFFF) {
+        (*cnt)++;
+    }
+}
+
+/**
+ * @brief  Check, if the device has been removed from the poll set
+ * 
+ * Every KETCUBE_I2C_DEV_REPROBE_CNT-th access to a removed device is not
+ * skipped: the device is put back to the poll set if it responds.
+ * 
+ * @param  Addr I2C Address
+ * 
+ * @retval TRUE if the access should be skipped
+ */
+static bool ketCube_I2C_IsSkipped(uint8_t Addr)
+{
+    ketCube_I2C_DevStats_t * stats = ketCube_I2C_GetStats(Addr, FALSE);
+
+    if ((stats == NULL) || (stats->disabled == FALSE)) {
+        return FALSE;
+    }
+
+    ketCube_I2C_CntInc(&(stats->skipCnt));
+
+    return ((stats->skipCnt % KETCUBE_I2C_DEV_REPROBE_CNT) != 0);
+}
+
+/**
+ * @brief  Account the transaction result
+ * 
+ * @param  Addr I2C Address
+ * @param  status HAL status of the transaction
+ * 
+ * @retval TRUE if the bus should be cleared
+ */
+static bool ketCube_I2C_Record(uint8_t Addr, HAL_StatusTypeDef status)
+{
+    bool nack = FALSE;
+    ketCube_I2C_DevStats_t * stats = ketCube_I2C_GetStats(Addr, TRUE);
+
+    if (status == HAL_ERROR) {
+        nack = ((HAL_I2C_GetError(&KETCUBE_I2C_Handle) & HAL_I2C_ERROR_AF) != 0);
+    }
+
+    if (stats != NULL) {
+        if (status == HAL_OK) {
+            ketCube_I2C_CntInc(&(stats->okCnt));
+            stats->failCnt = 0;
+            stats->disabled = FALSE;
+        } else {
+            if (nack == TRUE) {
+                ketCube_I2C_CntInc(&(stats->nackCnt));
+            } else if (status == HAL_ERROR) {
+                ketCube_I2C_CntInc(&(stats->errorCnt));
+            } else {
+                ketCube_I2C_CntInc(&(stats->timeoutCnt));
+            }
+
+            if (stats->failCnt < 0xFF) {
+                stats->failCnt++;
+            }
+            if ((stats->failCnt >= KETCUBE_I2C_DEV_MAX_FAILS) && (stats->disabled == FALSE)) {
+                stats->disabled = TRUE;
+                stats->skipCnt = 0;
+            }
+        }
+    }
+
+    /* NACK is a device-level error, the bus is free */
+    return ((status != HAL_OK) && (nack == FALSE));
+}
+
+/**
+ * @brief  Finish blocking transaction
+ * 
+ * @param  Addr I2C Address
+ * @param  status HAL status of the transaction
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ * @retval KETCUBE_CFG_DRV_ERROR in case of failure
+ */
+static ketCube_cfg_DrvError_t ketCube_I2C_Finish(uint8_t Addr, HAL_StatusTypeDef status)
+{
+    if (ketCube_I2C_Record(Addr, status) == TRUE) {
+        ketCube_I2C_Error();
+    }
+
+    if (status == HAL_OK) {
+        return KETCUBE_CFG_DRV_OK;
+    } else {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+}
+
+/**
+ * @brief  Select bus speed for the device
+ * 
+ * @param  Addr I2C Address
+ * 
+ * @note TIMINGR can be written only when the peripheral is disabled
+ */
+static void ketCube_I2C_SelectSpeed(uint8_t Addr)
+{
+    uint8_t i;
+    uint32_t timing = KETCUBE_I2C_SPEED_100KHZ;
+
+    for (i = 0; i < KETCUBE_I2C_DEV_SPEED_CNT; i++) {
+        if (devSpeed[i].addr == Addr) {
+            timing = devSpeed[i].speed;
+            break;
+        }
+    }
+
+    if (KETCUBE_I2C_Handle.Init.Timing != timing) {
+        __HAL_I2C_DISABLE(&KETCUBE_I2C_Handle);
+        KETCUBE_I2C_Handle.Instance->TIMINGR = timing;
+        KETCUBE_I2C_Handle.Init.Timing = timing;
+        __HAL_I2C_ENABLE(&KETCUBE_I2C_Handle);
+    }
+}
+
+/**
+ * @brief  Prepare I2C for a blocking transaction
+ * 
+ * @param  Addr I2C Address
+ */
+static void ketCube_I2C_Prepare(uint8_t Addr)
+{
+    ketCube_I2C_Flush();
+    ketCube_pwrMan_Acquire(KETCUBE_PWRMAN_PERIPH_I2C);
+    if (busClearPending == TRUE) {
+        ketCube_I2C_Error();
+    }
+    ketCube_I2C_SelectSpeed(Addr);
+}
+
+/**
+ * @brief  Restore I2C after wake-up
+ * 
+ * @note I2C registers are retained while clock is gated, the peripheral just needs to be re-clocked and enabled
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ */
+static ketCube_cfg_DrvError_t ketCube_I2C_SleepExit(void)
+{
+    KETCUBE_I2C_CLK_ENABLE();
+    __HAL_I2C_ENABLE(&KETCUBE_I2C_Handle);
+    
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief  Gate I2C clock before sleep
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ */
+static ketCube_cfg_DrvError_t ketCube_I2C_SleepEnter(void)
+{
+    __HAL_I2C_DISABLE(&KETCUBE_I2C_Handle);
+    KETCUBE_I2C_CLK_DISABLE();
+    
+    return KETCUBE_CFG_DRV_OK;
+}
+
 /**
  * @brief  Configures I2C interface.
  *
@@ -111,15 +346,35 @@ ketCube_cfg_DrvError_t ketCube_I2C_Init(void) {
         /* Release the I2C peripheral clock reset */
         KETCUBE_I2C_RELEASE_RESET();
 
-        // NOTE IRQ is not useful in most I2C master (pooling) applications
-        /* Enable and set I2C_EXPBD Interrupt to the highest priority */
-        // HAL_NVIC_SetPriority(I2C1_IRQn, 0, 0);
-        // HAL_NVIC_EnableIRQ(I2C1_IRQn);
-
         HAL_I2C_Init(&KETCUBE_I2C_Handle);
+
+        /* SCL low timeout ends queued transactions held by a slave */
+        KETCUBE_I2C_Handle.Instance->TIMEOUTR = I2C_TIMEOUTR_TIMOUTEN | KETCUBE_I2C_SCL_LOW_TIMEOUT;
+
+        /* DMA is used by queued register block reads */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        KETCUBE_I2C_DmaRxHandle.Instance = KETCUBE_I2C_DMA_RX_CHANNEL;
+        KETCUBE_I2C_DmaRxHandle.Init.Request = KETCUBE_I2C_DMA_RX_REQUEST;
+        KETCUBE_I2C_DmaRxHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+        KETCUBE_I2C_DmaRxHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+        KETCUBE_I2C_DmaRxHandle.Init.MemInc = DMA_MINC_ENABLE;
+        KETCUBE_I2C_DmaRxHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        KETCUBE_I2C_DmaRxHandle.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        KETCUBE_I2C_DmaRxHandle.Init.Mode = DMA_NORMAL;
+        KETCUBE_I2C_DmaRxHandle.Init.Priority = DMA_PRIORITY_LOW;
+        HAL_DMA_Init(&KETCUBE_I2C_DmaRxHandle);
+        __HAL_LINKDMA(&KETCUBE_I2C_Handle, hdmarx, KETCUBE_I2C_DmaRxHandle);
+
+        /* IRQs are used by queued transactions only, blocking calls poll */
+        HAL_NVIC_SetPriority(KETCUBE_I2C_DMA_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(KETCUBE_I2C_DMA_IRQn);
+        HAL_NVIC_SetPriority(I2C1_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(I2C1_IRQn);
     }
 
     if (HAL_I2C_GetState(&KETCUBE_I2C_Handle) == HAL_I2C_STATE_READY) {
+        /* I2C is restored on demand after wake-up */
+        ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_I2C, &ketCube_I2C_SleepExit, &ketCube_I2C_SleepEnter);
         return KETCUBE_CFG_DRV_OK;
     } else {
         return KETCUBE_CFG_DRV_ERROR;
@@ -140,6 +395,12 @@ ketCube_cfg_DrvError_t ketCube_I2C_UnInit(void)
         initRuns -= 1;
     } else if (initRuns == 1) {
         // UnInit here ...
+        ketCube_I2C_Flush();
+        HAL_NVIC_DisableIRQ(I2C1_IRQn);
+        HAL_NVIC_DisableIRQ(KETCUBE_I2C_DMA_IRQn);
+        HAL_DMA_DeInit(&KETCUBE_I2C_DmaRxHandle);
+        ketCube_pwrMan_UnRegister(KETCUBE_PWRMAN_PERIPH_I2C);
+        KETCUBE_I2C_CLK_ENABLE();
         HAL_I2C_DeInit(&KETCUBE_I2C_Handle);
         ketCube_GPIO_Release(KETCUBE_MAIN_BOARD_PIN_SCL_PORT, KETCUBE_MAIN_BOARD_PIN_SCL_PIN);
         ketCube_GPIO_Release(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN);
@@ -163,20 +424,19 @@ ketCube_cfg_DrvError_t ketCube_I2C_ReadData(uint8_t Addr, uint8_t Reg, uint8_t *
 
     HAL_StatusTypeDef status = HAL_OK;
 
+    if (ketCube_I2C_IsSkipped(Addr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(Addr);
+
     status =
         HAL_I2C_Mem_Read(&KETCUBE_I2C_Handle, Addr, (uint16_t) Reg,
                          I2C_MEMADD_SIZE_8BIT, pBuffer, Size,
                          KETCUBE_I2C_TIMEOUT);
 
     /* Check the communication status */
-    if (status == HAL_OK) {
-        return KETCUBE_CFG_DRV_OK;
-    } else if (status == HAL_ERROR) {
-        ketCube_I2C_Error();
-        return KETCUBE_CFG_DRV_ERROR;
-    } else {
-        return KETCUBE_CFG_DRV_ERROR;
-    }
+    return ketCube_I2C_Finish(Addr, status);
 }
 
 /**
@@ -192,20 +452,19 @@ ketCube_cfg_DrvError_t ketCube_I2C_WriteData(uint8_t Addr, uint8_t Reg, uint8_t
 
     HAL_StatusTypeDef status = HAL_OK;
 
+    if (ketCube_I2C_IsSkipped(Addr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(Addr);
+
     status =
         HAL_I2C_Mem_Write(&KETCUBE_I2C_Handle, Addr, (uint16_t) Reg,
                           I2C_MEMADD_SIZE_8BIT, pBuffer, Size,
                           KETCUBE_I2C_TIMEOUT);
 
     /* Check the communication status */
-    if (status == HAL_OK) {
-        return KETCUBE_CFG_DRV_OK;
-    } else if (status == HAL_ERROR) {
-        ketCube_I2C_Error();
-        return KETCUBE_CFG_DRV_ERROR;
-    } else {
-        return KETCUBE_CFG_DRV_ERROR;
-    }
+    return ketCube_I2C_Finish(Addr, status);
 }
 
 /**
@@ -219,19 +478,18 @@ ketCube_cfg_DrvError_t ketCube_I2C_WriteRawData(uint8_t Addr, uint8_t * pBuffer,
 {
     HAL_StatusTypeDef status = HAL_OK;
 
+    if (ketCube_I2C_IsSkipped(Addr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(Addr);
+
     status =
         HAL_I2C_Master_Transmit(&KETCUBE_I2C_Handle, Addr, pBuffer, Size,
                                 KETCUBE_I2C_TIMEOUT);
 
     /* Check the communication status */
-    if (status == HAL_OK) {
-        return KETCUBE_CFG_DRV_OK;
-    } else if (status == HAL_ERROR) {
-        ketCube_I2C_Error();
-        return KETCUBE_CFG_DRV_ERROR;
-    } else {
-        return KETCUBE_CFG_DRV_ERROR;
-    }
+    return ketCube_I2C_Finish(Addr, status);
 }
 
 /**
@@ -245,40 +503,112 @@ ketCube_cfg_DrvError_t ketCube_I2C_ReadRawData(uint8_t Addr, uint8_t * pBuffer,
 {
     HAL_StatusTypeDef status = HAL_OK;
 
+    if (ketCube_I2C_IsSkipped(Addr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(Addr);
+
     status =
         HAL_I2C_Master_Receive(&KETCUBE_I2C_Handle, Addr, pBuffer, Size,
                                KETCUBE_I2C_TIMEOUT);
 
     /* Check the communication status */
-    if (status == HAL_OK) {
+    return ketCube_I2C_Finish(Addr, status);
+}
+
+/**
+ * @brief  Half of the SCL period for the bus clear (~100 kHz)
+ */
+static void ketCube_I2C_BitDelay(void)
+{
+    volatile uint8_t i;
+
+    for (i = 0; i < KETCUBE_I2C_BIT_DELAY_CNT; i++) {
+        __NOP();
+    }
+}
+
+/**
+ * @brief  Free the bus held by a slave (I2C-bus specification, 3.1.16)
+ * 
+ * SCL is toggled until the slave releases SDA (at most 9 clocks), then
+ * START and STOP are generated and the bus is given back to the reset
+ * peripheral.
+ *
+ * @retval KETCUBE_CFG_DRV_OK if SDA is released
+ * @retval KETCUBE_CFG_DRV_ERROR if SDA is still held low
+ */
+static ketCube_cfg_DrvError_t ketCube_I2C_BusClear(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    uint8_t i;
+    bool sdaReleased;
+
+    /* PE = 0 resets the peripheral state machine */
+    __HAL_I2C_DISABLE(&KETCUBE_I2C_Handle);
+
+    /* Drive the bus lines as open-drain GPIOs, released by default */
+    ketCube_GPIO_Write(KETCUBE_MAIN_BOARD_PIN_SCL_PORT, KETCUBE_MAIN_BOARD_PIN_SCL_PIN, TRUE);
+    ketCube_GPIO_Write(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN, TRUE);
+
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FAST;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    ketCube_GPIO_ReInit(KETCUBE_MAIN_BOARD_PIN_SCL_PORT, KETCUBE_MAIN_BOARD_PIN_SCL_PIN, &GPIO_InitStruct);
+    ketCube_GPIO_ReInit(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN, &GPIO_InitStruct);
+    ketCube_I2C_BitDelay();
+
+    /* Clock out the rest of the byte the slave is transmitting */
+    for (i = 0; (i < KETCUBE_I2C_BUS_CLEAR_CLOCKS)
+         && (ketCube_GPIO_Read(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN) == FALSE); i++) {
+        ketCube_GPIO_Write(KETCUBE_MAIN_BOARD_PIN_SCL_PORT, KETCUBE_MAIN_BOARD_PIN_SCL_PIN, FALSE);
+        ketCube_I2C_BitDelay();
+        ketCube_GPIO_Write(KETCUBE_MAIN_BOARD_PIN_SCL_PORT, KETCUBE_MAIN_BOARD_PIN_SCL_PIN, TRUE);
+        ketCube_I2C_BitDelay();
+    }
+
+    /*
+     * START and STOP while SCL is still high reset the slave; pulling SCL
+     * low would shift out the next bit of the slave, which may be 0
+     */
+    ketCube_GPIO_Write(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN, FALSE);
+    ketCube_I2C_BitDelay();
+    ketCube_GPIO_Write(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN, TRUE);
+    ketCube_I2C_BitDelay();
+
+    sdaReleased = ketCube_GPIO_Read(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN);
+
+    /* Give the bus back to the peripheral */
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_OD;
+    GPIO_InitStruct.Alternate = GPIO_AF4_I2C1;
+    ketCube_GPIO_ReInit(KETCUBE_MAIN_BOARD_PIN_SCL_PORT, KETCUBE_MAIN_BOARD_PIN_SCL_PIN, &GPIO_InitStruct);
+    ketCube_GPIO_ReInit(KETCUBE_MAIN_BOARD_PIN_SDA_PORT, KETCUBE_MAIN_BOARD_PIN_SDA_PIN, &GPIO_InitStruct);
+
+    __HAL_I2C_ENABLE(&KETCUBE_I2C_Handle);
+
+    if (sdaReleased == TRUE) {
         return KETCUBE_CFG_DRV_OK;
-    } else if (status == HAL_ERROR) {
-        ketCube_I2C_Error();
-        return KETCUBE_CFG_DRV_ERROR;
     } else {
         return KETCUBE_CFG_DRV_ERROR;
     }
 }
 
 /**
- * @brief  Manages error callback by re-initializing I2C
+ * @brief  Manages bus error by the bus clear
+ * 
+ * @note The peripheral is not re-initialized: it is reset by PE toggling
+ * 
  * @retval None
  */
 static void ketCube_I2C_Error()
 {
-    uint8_t i;
-    uint8_t tmpInitRuns = initRuns;
+    busClearPending = FALSE;
 
-    ketCube_terminal_DriverSeverityPrintln(KETCUBE_I2C_NAME, KETCUBE_CFG_SEVERITY_DEBUG, "Re-Initialize()");
+    ketCube_terminal_DriverSeverityPrintln(KETCUBE_I2C_NAME, KETCUBE_CFG_SEVERITY_DEBUG, "Bus clear");
 
-    /* De-initialize the I2C comunication bus */
-    for (i = tmpInitRuns; i > 0; i--) {
-        ketCube_I2C_UnInit();
-    }
-
-    /* Re-Initiaize the I2C comunication bus */
-    for (i = tmpInitRuns; i > 0; i--) {
-        ketCube_I2C_Init();
+    if (ketCube_I2C_BusClear() != KETCUBE_CFG_DRV_OK) {
+        ketCube_terminal_DriverSeverityPrintln(KETCUBE_I2C_NAME, KETCUBE_CFG_SEVERITY_ERROR, "SDA held low after bus clear!");
     }
 }
 
@@ -299,18 +629,29 @@ ketCube_cfg_DrvError_t ketCube_I2C_TexasReadReg(uint8_t devAddr,
                                                 uint16_t * data)
 {
     uint8_t buffer[2];
+    HAL_StatusTypeDef status;
+
+    if (ketCube_I2C_IsSkipped(devAddr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(devAddr);
 
-    HAL_StatusTypeDef status =
+    status =
         HAL_I2C_Master_Transmit(&KETCUBE_I2C_Handle, devAddr, &(regAddr),
                                 1, KETCUBE_I2C_TIMEOUT);
-    if (status != HAL_OK) {
+    if (ketCube_I2C_Finish(devAddr, status) != KETCUBE_CFG_DRV_OK) {
         return KETCUBE_CFG_DRV_ERROR;
     }
-    HAL_Delay(50);
+    ketCube_delay_LowPower(50);
+    
+    /* I2C may have been released during the delay */
+    ketCube_I2C_Prepare(devAddr);
+    
     status =
         HAL_I2C_Master_Receive(&KETCUBE_I2C_Handle, devAddr, &(buffer[0]),
                                2, KETCUBE_I2C_TIMEOUT);
-    if (status != HAL_OK) {
+    if (ketCube_I2C_Finish(devAddr, status) != KETCUBE_CFG_DRV_OK) {
         return KETCUBE_CFG_DRV_ERROR;
     }
 
@@ -366,12 +707,18 @@ ketCube_cfg_DrvError_t ketCube_I2C_STMReadSingle(uint8_t devAddr,
 {
     regAddr = regAddr & (~0x80);
 
+    if (ketCube_I2C_IsSkipped(devAddr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(devAddr);
+
     while (try > 0) {
         HAL_StatusTypeDef status =
             HAL_I2C_Master_Transmit(&KETCUBE_I2C_Handle, devAddr,
                                     &(regAddr),
                                     1, KETCUBE_I2C_TIMEOUT);
-        if (status != HAL_OK) {
+        if (ketCube_I2C_Finish(devAddr, status) != KETCUBE_CFG_DRV_OK) {
             try--;
             continue;
         }
@@ -379,7 +726,7 @@ ketCube_cfg_DrvError_t ketCube_I2C_STMReadSingle(uint8_t devAddr,
         status =
             HAL_I2C_Master_Receive(&KETCUBE_I2C_Handle, devAddr, data,
                                    1, KETCUBE_I2C_TIMEOUT);
-        if (status == HAL_OK) {
+        if (ketCube_I2C_Finish(devAddr, status) == KETCUBE_CFG_DRV_OK) {
             return KETCUBE_CFG_DRV_OK;
         }
         try--;
@@ -432,12 +779,18 @@ ketCube_cfg_DrvError_t ketCube_I2C_STMReadBlock(uint8_t devAddr,
 {
     regAddr = regAddr & (~0x80);
 
+    if (ketCube_I2C_IsSkipped(devAddr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Prepare(devAddr);
+
     while (try > 0) {
         HAL_StatusTypeDef status =
             HAL_I2C_Master_Transmit(&KETCUBE_I2C_Handle, devAddr,
                                     &(regAddr),
                                     1, KETCUBE_I2C_TIMEOUT);
-        if (status != HAL_OK) {
+        if (ketCube_I2C_Finish(devAddr, status) != KETCUBE_CFG_DRV_OK) {
             try--;
             continue;
         }
@@ -445,7 +798,7 @@ ketCube_cfg_DrvError_t ketCube_I2C_STMReadBlock(uint8_t devAddr,
         status =
             HAL_I2C_Master_Receive(&KETCUBE_I2C_Handle, devAddr, data,
                                    len, KETCUBE_I2C_TIMEOUT);
-        if (status == HAL_OK) {
+        if (ketCube_I2C_Finish(devAddr, status) == KETCUBE_CFG_DRV_OK) {
             return KETCUBE_CFG_DRV_OK;
         }
         try--;
@@ -482,4 +835,411 @@ ketCube_cfg_DrvError_t ketCube_I2C_STMWriteSingle(uint8_t devAddr,
     return KETCUBE_CFG_DRV_ERROR;
 }
 
+/**
+ * @brief  Set bus speed for the device
+ * 
+ * Sensors supporting the fast mode should be accessed at 400 kHz: the bus
+ * transaction (and thus the MCU run time) is shorter.
+ * 
+ * @param  Addr I2C Address
+ * @param  speed bus speed used for all transactions with the device
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ * @retval KETCUBE_CFG_DRV_ERROR if there is no space for the device
+ */
+ketCube_cfg_DrvError_t ketCube_I2C_SetDeviceSpeed(uint8_t Addr, ketCube_I2C_SPEED_t speed)
+{
+    uint8_t i;
+    uint8_t freeIndex = KETCUBE_I2C_DEV_SPEED_CNT;
+
+    for (i = 0; i < KETCUBE_I2C_DEV_SPEED_CNT; i++) {
+        if (devSpeed[i].addr == Addr) {
+            devSpeed[i].speed = speed;
+            return KETCUBE_CFG_DRV_OK;
+        } else if ((devSpeed[i].addr == 0) && (freeIndex == KETCUBE_I2C_DEV_SPEED_CNT)) {
+            freeIndex = i;
+        }
+    }
+
+    if (freeIndex == KETCUBE_I2C_DEV_SPEED_CNT) {
+        ketCube_terminal_DriverSeverityPrintln(KETCUBE_I2C_NAME, KETCUBE_CFG_SEVERITY_ERROR, "Device speed table full!");
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    devSpeed[freeIndex].speed = speed;
+    devSpeed[freeIndex].addr = Addr;
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief  Print per-device statistics
+ */
+void ketCube_I2C_PrintStats(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < KETCUBE_I2C_DEV_STATS_CNT; i++) {
+        if (devStats[i].addr == 0) {
+            continue;
+        }
+        KETCUBE_TERMINAL_PRINTF("0x%02X: ok %d; NACK %d; timeout %d; error %d; skipped %d%s",
+                                (devStats[i].addr >> 1),
+                                devStats[i].okCnt,
+                                devStats[i].nackCnt,
+                                devStats[i].timeoutCnt,
+                                devStats[i].errorCnt,
+                                devStats[i].skipCnt,
+                                ((devStats[i].disabled == TRUE) ? "; removed from poll set" : ""));
+        KETCUBE_TERMINAL_ENDL();
+    }
+}
+
+/**
+ * @brief  Clear per-device statistics and return all devices to the poll set
+ */
+void ketCube_I2C_ClearStats(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < KETCUBE_I2C_DEV_STATS_CNT; i++) {
+        devStats[i] = (ketCube_I2C_DevStats_t) { 0 };
+    }
+}
+
+/**
+ * @brief  Submit I2C transaction
+ * 
+ * The transaction is queued and executed in background (IRQ, DMA for longer
+ * register reads); the completion callback is executed in IRQ context. 
+ * The MCU is kept in core sleep while transactions are pending.
+ * 
+ * @param  xfer transaction; the descriptor is copied, the buffer is not
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ * @retval KETCUBE_CFG_DRV_ERROR if the driver is not initialized or the queue is full
+ */
+ketCube_cfg_DrvError_t ketCube_I2C_Submit(const ketCube_I2C_Xfer_t * xfer)
+{
+    BACKUP_PRIMASK();
+
+    if ((initRuns == 0) || (xfer == NULL) || (ketCube_I2C_IsSkipped(xfer->addr) == TRUE)) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    DISABLE_IRQ();
+
+    if (xferCnt >= KETCUBE_I2C_QUEUE_LEN) {
+        RESTORE_PRIMASK();
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    xferQueue[(xferHead + xferCnt) % KETCUBE_I2C_QUEUE_LEN] = *xfer;
+    xferCnt++;
+
+    if (xferActive == FALSE) {
+        ketCube_I2C_StartNext();
+    }
+
+    RESTORE_PRIMASK();
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief  Check I2C transaction queue
+ * 
+ * @retval TRUE if there are pending transactions
+ */
+bool ketCube_I2C_IsBusy(void)
+{
+    return xferActive;
+}
+
+/**
+ * @brief  Wait until all queued transactions are completed
+ * 
+ * @note Do not call from IRQ context
+ */
+void ketCube_I2C_Flush(void)
+{
+    while (xferActive == TRUE) {
+        BACKUP_PRIMASK();
+        DISABLE_IRQ();
+
+        /* Pending IRQ wakes the core even if masked */
+        if (xferActive == TRUE) {
+            __WFI();
+        }
+
+        RESTORE_PRIMASK();
+    }
+}
+
+/**
+ * @brief  Store the result of a waited-for transaction
+ * 
+ * @param  result transaction result
+ * @param  context pointer to the result variable
+ */
+static void ketCube_I2C_WaitCplt(ketCube_cfg_DrvError_t result, void * context)
+{
+    *((volatile ketCube_cfg_DrvError_t *) context) = result;
+}
+
+/**
+ * @brief  Read I2C data through the transaction queue
+ * 
+ * The same as ketCube_I2C_ReadData(), but the core sleeps while the
+ * transfer runs in background (IRQ, DMA for longer reads).
+ *
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ * @retval KETCUBE_CFG_DRV_ERROR in case of failure
+ * 
+ * @note Do not call from IRQ context
+ */
+ketCube_cfg_DrvError_t ketCube_I2C_ReadDataQueued(uint8_t Addr, uint8_t Reg, uint8_t * pBuffer,
+                                                  uint16_t Size)
+{
+    volatile ketCube_cfg_DrvError_t result = KETCUBE_CFG_DRV_ERROR;
+    ketCube_I2C_Xfer_t xfer = {
+        .type = KETCUBE_I2C_XFER_MEM_READ,
+        .addr = Addr,
+        .reg = Reg,
+        .pBuffer = pBuffer,
+        .size = Size,
+        .fnCallback = &ketCube_I2C_WaitCplt,
+        .context = (void *) &result,
+    };
+
+    if (ketCube_I2C_IsSkipped(Addr) == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    /* bus clear after a previous queued failure */
+    ketCube_I2C_Prepare(Addr);
+
+    if (ketCube_I2C_Submit(&xfer) != KETCUBE_CFG_DRV_OK) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    ketCube_I2C_Flush();
+
+    return result;
+}
+
+/**
+ * @brief  Finish the running transaction
+ * 
+ * @param  result transaction result
+ */
+static void ketCube_I2C_Complete(ketCube_cfg_DrvError_t result)
+{
+    ketCube_I2C_XferCb_t fnCallback = xferQueue[xferHead].fnCallback;
+    void * context = xferQueue[xferHead].context;
+
+    xferHead = (xferHead + 1) % KETCUBE_I2C_QUEUE_LEN;
+    xferCnt--;
+
+    if (fnCallback != NULL) {
+        fnCallback(result, context);
+    }
+}
+
+/**
+ * @brief  Start the next queued transaction
+ * 
+ * @note Must be called with IRQs disabled or from I2C/DMA IRQ context
+ */
+static void ketCube_I2C_StartNext(void)
+{
+    ketCube_I2C_Xfer_t * xfer;
+    HAL_StatusTypeDef status;
+
+    /* Callbacks of failed transactions may submit, do not re-enter */
+    xferActive = TRUE;
+    ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_I2C, TRUE);
+
+    while (xferCnt > 0) {
+        xfer = &(xferQueue[xferHead]);
+
+        ketCube_pwrMan_Acquire(KETCUBE_PWRMAN_PERIPH_I2C);
+        ketCube_I2C_SelectSpeed(xfer->addr);
+
+        /* Blocking transactions do not handle the timeout */
+        __HAL_I2C_CLEAR_FLAG(&KETCUBE_I2C_Handle, I2C_FLAG_TIMEOUT);
+
+        switch (xfer->type) {
+            case KETCUBE_I2C_XFER_MEM_READ:
+                if (xfer->size >= KETCUBE_I2C_DMA_MIN_LEN) {
+                    status = HAL_I2C_Mem_Read_DMA(&KETCUBE_I2C_Handle, xfer->addr, (uint16_t) xfer->reg,
+                                                  I2C_MEMADD_SIZE_8BIT, xfer->pBuffer, xfer->size);
+                } else {
+                    status = HAL_I2C_Mem_Read_IT(&KETCUBE_I2C_Handle, xfer->addr, (uint16_t) xfer->reg,
+                                                 I2C_MEMADD_SIZE_8BIT, xfer->pBuffer, xfer->size);
+                }
+                break;
+            case KETCUBE_I2C_XFER_MEM_WRITE:
+                status = HAL_I2C_Mem_Write_IT(&KETCUBE_I2C_Handle, xfer->addr, (uint16_t) xfer->reg,
+                                              I2C_MEMADD_SIZE_8BIT, xfer->pBuffer, xfer->size);
+                break;
+            case KETCUBE_I2C_XFER_RAW_READ:
+                status = HAL_I2C_Master_Receive_IT(&KETCUBE_I2C_Handle, xfer->addr, xfer->pBuffer, xfer->size);
+                break;
+            case KETCUBE_I2C_XFER_RAW_WRITE:
+                status = HAL_I2C_Master_Transmit_IT(&KETCUBE_I2C_Handle, xfer->addr, xfer->pBuffer, xfer->size);
+                break;
+            default:
+                status = HAL_ERROR;
+                break;
+        }
+
+        if (status == HAL_OK) {
+            return;
+        }
+
+        /* Transaction cannot be started, e.g. the bus is held */
+        if (ketCube_I2C_Record(xfer->addr, status) == TRUE) {
+            busClearPending = TRUE;
+        }
+        ketCube_I2C_Complete(KETCUBE_CFG_DRV_ERROR);
+    }
+
+    xferActive = FALSE;
+    ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_I2C, FALSE);
+}
+
+/**
+ * @brief  Transaction completed
+ * 
+ * @param  hi2c I2C handle
+ */
+static void ketCube_I2C_XferCplt(I2C_HandleTypeDef * hi2c)
+{
+    if ((hi2c != &KETCUBE_I2C_Handle) || (xferActive == FALSE)) {
+        return;
+    }
+
+    ketCube_I2C_Record(xferQueue[xferHead].addr, HAL_OK);
+    ketCube_I2C_Complete(KETCUBE_CFG_DRV_OK);
+    ketCube_I2C_StartNext();
+}
+
+/**
+ * @brief  I2C master TX complete HAL callback
+ * @param  hi2c I2C handle
+ */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef * hi2c)
+{
+    ketCube_I2C_XferCplt(hi2c);
+}
+
+/**
+ * @brief  I2C master RX complete HAL callback
+ * @param  hi2c I2C handle
+ */
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef * hi2c)
+{
+    ketCube_I2C_XferCplt(hi2c);
+}
+
+/**
+ * @brief  I2C memory TX complete HAL callback
+ * @param  hi2c I2C handle
+ */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef * hi2c)
+{
+    ketCube_I2C_XferCplt(hi2c);
+}
+
+/**
+ * @brief  I2C memory RX complete HAL callback
+ * @param  hi2c I2C handle
+ */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef * hi2c)
+{
+    ketCube_I2C_XferCplt(hi2c);
+}
+
+/**
+ * @brief  I2C error HAL callback
+ * @param  hi2c I2C handle
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef * hi2c)
+{
+    if ((hi2c != &KETCUBE_I2C_Handle) || (xferActive == FALSE)) {
+        return;
+    }
+
+    /* The bus clear is not executed in IRQ context */
+    if (ketCube_I2C_Record(xferQueue[xferHead].addr, HAL_ERROR) == TRUE) {
+        busClearPending = TRUE;
+    }
+    ketCube_I2C_Complete(KETCUBE_CFG_DRV_ERROR);
+    ketCube_I2C_StartNext();
+}
+
+/**
+ * @brief  Abort the running transaction after the SCL low timeout
+ * 
+ * The HAL handles the TIMEOUT flag in SMBus mode only: the transfer is
+ * stopped here and the peripheral is reset by PE toggling.
+ */
+static void ketCube_I2C_Timeout(void)
+{
+    __HAL_I2C_DISABLE_IT(&KETCUBE_I2C_Handle, I2C_IT_ERRI | I2C_IT_TCI | I2C_IT_STOPI
+                         | I2C_IT_NACKI | I2C_IT_RXI | I2C_IT_TXI);
+    __HAL_I2C_CLEAR_FLAG(&KETCUBE_I2C_Handle, I2C_FLAG_TIMEOUT);
+
+    if ((KETCUBE_I2C_Handle.Instance->CR1 & I2C_CR1_RXDMAEN) != 0) {
+        KETCUBE_I2C_Handle.Instance->CR1 &= ~I2C_CR1_RXDMAEN;
+        HAL_DMA_Abort(&KETCUBE_I2C_DmaRxHandle);
+    }
+
+    __HAL_I2C_DISABLE(&KETCUBE_I2C_Handle);
+    KETCUBE_I2C_Handle.XferISR = NULL;
+    KETCUBE_I2C_Handle.ErrorCode = HAL_I2C_ERROR_TIMEOUT;
+    KETCUBE_I2C_Handle.Mode = HAL_I2C_MODE_NONE;
+    KETCUBE_I2C_Handle.State = HAL_I2C_STATE_READY;
+    __HAL_UNLOCK(&KETCUBE_I2C_Handle);
+    __HAL_I2C_ENABLE(&KETCUBE_I2C_Handle);
+
+    /* The bus clear is not executed in IRQ context */
+    if (ketCube_I2C_Record(xferQueue[xferHead].addr, HAL_TIMEOUT) == TRUE) {
+        busClearPending = TRUE;
+    }
+    ketCube_I2C_Complete(KETCUBE_CFG_DRV_ERROR);
+    ketCube_I2C_StartNext();
+}
+
+/**
+ * @brief  I2C1 IRQ handler
+ */
+void I2C1_IRQHandler(void)
+{
+    KETCube_eventsProcessed = FALSE; /* Possible pending events */
+
+    if (__HAL_I2C_GET_FLAG(&KETCUBE_I2C_Handle, I2C_FLAG_TIMEOUT) == SET) {
+        if (xferActive == TRUE) {
+            ketCube_I2C_Timeout();
+        } else {
+            __HAL_I2C_CLEAR_FLAG(&KETCUBE_I2C_Handle, I2C_FLAG_TIMEOUT);
+        }
+        return;
+    }
+
+    HAL_I2C_EV_IRQHandler(&KETCUBE_I2C_Handle);
+    HAL_I2C_ER_IRQHandler(&KETCUBE_I2C_Handle);
+}
+
+/**
+ * @brief  DMA1 channel 2 and 3 IRQ handler
+ * 
+ * @note Channel 3 is used by I2C RX
+ */
+void DMA1_Channel2_3_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&KETCUBE_I2C_DmaRxHandle);
+}
+
 #endif // KETCUBE_CFG_INC_DRV_I2C
@@ -63,6 +63,7 @@
 #define KETCUBE_I2C_ADDRESS                   (uint8_t)0x33     ///< KETCube I2C address (KETCube is normally master and acts on a single-master I2C bus, thus this address has almost no meaning)
 #define KETCUBE_I2C_HANDLE                     I2C1
 #define KETCUBE_I2C_TIMEOUT                    0x5000           ///< The value of the maximal timeout for BUS waiting loops
+#define KETCUBE_I2C_SCL_LOW_TIMEOUT            390              ///< TIMEOUTA: SCL held low for (390 + 1) x 2048 / 32 MHz = 25 ms aborts queued transactions
 
 /**
 * @brief I2C Speed selection
@@ -72,6 +73,63 @@ typedef enum {
     KETCUBE_I2C_SPEED_400KHZ = 0x00B1112E       /*!< Analog Filter ON, Rise Time 250ns, Fall Time 100ns */
 } ketCube_I2C_SPEED_t;
 
+#define KETCUBE_I2C_DEV_SPEED_CNT              4                ///< Max number of devices with non-default bus speed
+#define KETCUBE_I2C_QUEUE_LEN                  8                ///< Transaction queue length
+#define KETCUBE_I2C_DMA_MIN_LEN                4                ///< Shorter register reads are driven by IRQ only, longer by DMA
+
+#define KETCUBE_I2C_BUS_CLEAR_CLOCKS           9                ///< Max number of SCL clocks generated to free SDA
+#define KETCUBE_I2C_BIT_DELAY_CNT              20               ///< Bus clear half-period loop count (~5 us at 32 MHz)
+#define KETCUBE_I2C_DEV_STATS_CNT              8                ///< Max number of devices with statistics
+#define KETCUBE_I2C_DEV_MAX_FAILS              8                ///< Consecutive failures to remove the device from the poll set
+#define KETCUBE_I2C_DEV_REPROBE_CNT            16               ///< Every n-th access to the removed device is executed to re-probe it
+
+/**
+* @brief Per-device statistics
+*/
+typedef struct ketCube_I2C_DevStats_t {
+    uint8_t addr;                       /*!< I2C Address; 0 if unused */
+    bool disabled;                      /*!< Device removed from the poll set */
+    uint8_t failCnt;                    /*!< Consecutive failures */
+    uint16_t okCnt;                     /*!< Successful transactions */
+    uint16_t nackCnt;                   /*!< Transactions not acknowledged by the device */
+    uint16_t timeoutCnt;                /*!< Transactions timed-out (e.g. bus held by a slave) */
+    uint16_t errorCnt;                  /*!< Bus errors and arbitration losses */
+    uint16_t skipCnt;                   /*!< Accesses skipped while removed from the poll set */
+} ketCube_I2C_DevStats_t;
+
+/**
+* @brief I2C transaction type
+*/
+typedef enum {
+    KETCUBE_I2C_XFER_MEM_READ = 0,      /*!< Register read: write register address, repeated start, read data */
+    KETCUBE_I2C_XFER_MEM_WRITE,         /*!< Register write: write register address and data */
+    KETCUBE_I2C_XFER_RAW_READ,          /*!< Plain read */
+    KETCUBE_I2C_XFER_RAW_WRITE          /*!< Plain write */
+} ketCube_I2C_XferType_t;
+
+/**
+* @brief I2C transaction completion callback
+* 
+* @param result KETCUBE_CFG_DRV_OK in case of success
+* @param context context pointer passed in the transaction
+* 
+* @note The callback is executed in IRQ context; it may submit further transactions
+*/
+typedef void (*ketCube_I2C_XferCb_t) (ketCube_cfg_DrvError_t result, void * context);
+
+/**
+* @brief I2C transaction
+*/
+typedef struct ketCube_I2C_Xfer_t {
+    ketCube_I2C_XferType_t type;        /*!< Transaction type */
+    uint8_t addr;                       /*!< I2C Address */
+    uint8_t reg;                        /*!< Register address (MEM transactions only) */
+    uint8_t * pBuffer;                  /*!< Data buffer; must be valid until completion */
+    uint16_t size;                      /*!< Data length */
+    ketCube_I2C_XferCb_t fnCallback;    /*!< Completion callback; may be NULL */
+    void * context;                     /*!< Callback context */
+} ketCube_I2C_Xfer_t;
+
 /**
 * @}
 */
@@ -92,6 +150,20 @@ extern ketCube_cfg_DrvError_t ketCube_I2C_WriteRawData(uint8_t Addr, uint8_t * p
 extern ketCube_cfg_DrvError_t ketCube_I2C_ReadRawData(uint8_t Addr, uint8_t * pBuffer,
                                        uint16_t Size);
 
+extern ketCube_cfg_DrvError_t ketCube_I2C_SetDeviceSpeed(uint8_t Addr, ketCube_I2C_SPEED_t speed);
+
+extern void ketCube_I2C_PrintStats(void);
+extern void ketCube_I2C_ClearStats(void);
+
+extern ketCube_cfg_DrvError_t ketCube_I2C_Submit(const ketCube_I2C_Xfer_t * xfer);
+extern bool ketCube_I2C_IsBusy(void);
+extern void ketCube_I2C_Flush(void);
+extern ketCube_cfg_DrvError_t ketCube_I2C_ReadDataQueued(uint8_t Addr, uint8_t Reg,
+                                                         uint8_t * pBuffer, uint16_t Size);
+
+extern void I2C1_IRQHandler(void);
+extern void DMA1_Channel2_3_IRQHandler(void);
+
 // Deprecated I2C functions are below
 extern ketCube_cfg_DrvError_t ketCube_I2C_TexasWriteReg(uint8_t devAddr,
                                                         uint8_t regAddr,
@@ -50,12 +50,22 @@
 #include "stm32l0xx_hal_i2s.h"
 
 #include "ketCube_i2s.h"
+#include "ketCube_pwrMan.h"
+
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
 
 // local fn declarations
 I2S_HandleTypeDef KETCUBE_I2S_Handle;
+static DMA_HandleTypeDef KETCUBE_I2S_DmaRxHandle;
 
 static uint8_t initRuns = 0;    //< This driver can be initialised only once. If 0 == not initialised, else initialised
 
+static uint16_t dmaBuffer[KETCUBE_I2S_BUFFER_LEN];     ///< Circular double buffer: two blocks
+static volatile ketCube_I2S_BlockFn_t blockFn = NULL;  ///< Block processing function; NULL if capture is stopped
+static volatile ketCube_I2S_Stats_t stats;
+
 /**
  * @brief  Configures I2S interface.
  *
@@ -107,11 +117,24 @@ ketCube_cfg_ModError_t ketCube_I2S_Init(void)
 
         /* Initialise I2S peripheral */
         HAL_I2S_Init(&KETCUBE_I2S_Handle);
-        uint16_t packet;
 
-        /* Start I2S bus clock generation */
-        HAL_I2S_Receive(&KETCUBE_I2S_Handle, &packet, 1, 1000);
-        __HAL_I2S_ENABLE_IT(&KETCUBE_I2S_Handle, I2S_IT_RXNE);
+        /* Samples are moved by DMA into a circular double buffer */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        KETCUBE_I2S_DmaRxHandle.Instance = KETCUBE_I2S_DMA_RX_CHANNEL;
+        KETCUBE_I2S_DmaRxHandle.Init.Request = KETCUBE_I2S_DMA_RX_REQUEST;
+        KETCUBE_I2S_DmaRxHandle.Init.Direction = DMA_PERIPH_TO_MEMORY;
+        KETCUBE_I2S_DmaRxHandle.Init.PeriphInc = DMA_PINC_DISABLE;
+        KETCUBE_I2S_DmaRxHandle.Init.MemInc = DMA_MINC_ENABLE;
+        KETCUBE_I2S_DmaRxHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+        KETCUBE_I2S_DmaRxHandle.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+        KETCUBE_I2S_DmaRxHandle.Init.Mode = DMA_CIRCULAR;
+        KETCUBE_I2S_DmaRxHandle.Init.Priority = DMA_PRIORITY_HIGH;
+        HAL_DMA_Init(&KETCUBE_I2S_DmaRxHandle);
+        __HAL_LINKDMA(&KETCUBE_I2S_Handle, hdmarx, KETCUBE_I2S_DmaRxHandle);
+
+        /* Block processing runs in DMA IRQ context -- keep it below the radio */
+        HAL_NVIC_SetPriority(KETCUBE_I2S_DMA_IRQn, 1, 0);
+        HAL_NVIC_EnableIRQ(KETCUBE_I2S_DMA_IRQn);
     }
 
     if (HAL_I2S_GetState(&KETCUBE_I2S_Handle) == HAL_I2S_STATE_READY) {
@@ -121,5 +144,181 @@ ketCube_cfg_ModError_t ketCube_I2S_Init(void)
     }
 }
 
+/**
+ * @brief  Stop capture and de-initialise I2S interface.
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+ketCube_cfg_ModError_t ketCube_I2S_UnInit(void)
+{
+    if (initRuns == 0) {
+        return KETCUBE_CFG_MODULE_OK;
+    }
+
+    initRuns -= 1;
+    if (initRuns > 0) {
+        return KETCUBE_CFG_MODULE_OK;
+    }
+
+    ketCube_I2S_Stop();
+
+    HAL_NVIC_DisableIRQ(KETCUBE_I2S_DMA_IRQn);
+    HAL_DMA_DeInit(&KETCUBE_I2S_DmaRxHandle);
+
+    if (HAL_I2S_DeInit(&KETCUBE_I2S_Handle) != HAL_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief  Start continuous capture
+ *
+ * Frames are received by DMA into a circular double buffer. Whenever one half
+ * is filled, fn is called with the whole block (@ref KETCUBE_I2S_BLOCK_LEN
+ * frames) from DMA IRQ context, while the other half is being filled.
+ * 
+ * As the I2S clock is stopped in STOP mode, the I2S peripheral is marked busy
+ * for the power manager -- the core uses sleep mode between blocks.
+ * 
+ * @param fn block processing function
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+ketCube_cfg_ModError_t ketCube_I2S_Start(ketCube_I2S_BlockFn_t fn)
+{
+    if ((fn == NULL) || (blockFn != NULL)) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    blockFn = fn;
+    ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_I2S, TRUE);
+
+    /* Master RX starts with the left channel slot, thus the buffer is frame-aligned;
+       size is given in 32-bit slots for 24-bit data format */
+    if (HAL_I2S_Receive_DMA(&KETCUBE_I2S_Handle, &(dmaBuffer[0]),
+                            KETCUBE_I2S_BUFFER_LEN / 2) != HAL_OK) {
+        blockFn = NULL;
+        ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_I2S, FALSE);
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief  Stop continuous capture
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+ketCube_cfg_ModError_t ketCube_I2S_Stop(void)
+{
+    HAL_StatusTypeDef status;
+
+    if (blockFn == NULL) {
+        return KETCUBE_CFG_MODULE_OK;
+    }
+
+    blockFn = NULL;
+    status = HAL_I2S_DMAStop(&KETCUBE_I2S_Handle);
+    ketCube_pwrMan_SetBusy(KETCUBE_PWRMAN_PERIPH_I2S, FALSE);
+
+    if (status != HAL_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief  Get capture statistics
+ *
+ * @param stats statistics output
+ * @param reset reset statistics when TRUE
+ */
+void ketCube_I2S_GetStats(ketCube_I2S_Stats_t * out, bool reset)
+{
+    BACKUP_PRIMASK();
+    DISABLE_IRQ();
+
+    out->blocks = stats.blocks;
+    out->errors = stats.errors;
+    out->cycles = stats.cycles;
+
+    if (reset == TRUE) {
+        stats.blocks = 0;
+        stats.errors = 0;
+        stats.cycles = 0;
+    }
+
+    RESTORE_PRIMASK();
+}
+
+/**
+ * @brief  Process one block of the double buffer
+ *
+ * @param block block to be processed
+ */
+static void processBlock(const uint16_t * block)
+{
+    ketCube_I2S_BlockFn_t fn = blockFn;
+    uint32_t start;
+
+    if (fn == NULL) {
+        return;
+    }
+
+    start = SysTick->VAL;
+    fn(block, KETCUBE_I2S_BLOCK_LEN);
+
+    stats.cycles += (start - SysTick->VAL) & KETCUBE_PWRMAN_CYCLES_MASK;
+    stats.blocks++;
+}
+
+/**
+ * @brief  First half of the DMA buffer is filled
+ */
+void HAL_I2S_RxHalfCpltCallback(I2S_HandleTypeDef * hi2s)
+{
+    processBlock(&(dmaBuffer[0]));
+}
+
+/**
+ * @brief  Second half of the DMA buffer is filled
+ */
+void HAL_I2S_RxCpltCallback(I2S_HandleTypeDef * hi2s)
+{
+    processBlock(&(dmaBuffer[KETCUBE_I2S_BUFFER_LEN / 2]));
+}
+
+/**
+ * @brief  I2S/DMA error -- restart capture to regain frame alignment
+ */
+void HAL_I2S_ErrorCallback(I2S_HandleTypeDef * hi2s)
+{
+    stats.errors++;
+
+    if (blockFn == NULL) {
+        return;
+    }
+
+    HAL_I2S_DMAStop(&KETCUBE_I2S_Handle);
+    HAL_I2S_Receive_DMA(&KETCUBE_I2S_Handle, &(dmaBuffer[0]),
+                        KETCUBE_I2S_BUFFER_LEN / 2);
+}
+
+/**
+ * @brief  DMA1 channel 4, 5, 6 and 7 IRQ handler
+ * 
+ * @note Channel 6 is used by I2S RX
+ */
+void DMA1_Channel4_5_6_7_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&KETCUBE_I2S_DmaRxHandle);
+}
 
 #endif // KETCUBE_CFG_INC_DRV_I2S
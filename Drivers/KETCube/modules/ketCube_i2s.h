@@ -78,6 +78,49 @@
 #define KETCUBE_I2S_SD_PIN                     GPIO_PIN_15
 #define KETCUBE_I2S_EV_IRQn                    SPI2_IRQn
 
+#define KETCUBE_I2S_DMA_RX_CHANNEL             DMA1_Channel6
+#define KETCUBE_I2S_DMA_RX_REQUEST             DMA_REQUEST_2
+#define KETCUBE_I2S_DMA_IRQn                   DMA1_Channel4_5_6_7_IRQn
+
+#define KETCUBE_I2S_FRAME_LEN                  4U       ///< Stereo 24-bit frame length in half-words (2 x 32-bit slot)
+#define KETCUBE_I2S_BLOCK_LEN                  128U     ///< Frames per block (DMA half-buffer): 4 ms at 32 kHz
+#define KETCUBE_I2S_BUFFER_LEN                 (2 * KETCUBE_I2S_BLOCK_LEN * KETCUBE_I2S_FRAME_LEN)  ///< DMA buffer length in half-words
+
+/**
+ * @brief Get the left channel 24-bit sample of the i-th frame in a block
+ */
+#define KETCUBE_I2S_LEFT_SAMPLE(block, i) \
+    (((int32_t) ((((uint32_t) (block)[(i) * KETCUBE_I2S_FRAME_LEN]) << 16) \
+                 | (block)[(i) * KETCUBE_I2S_FRAME_LEN + 1])) >> 8)
+
+/**
+* @}
+*/
+
+/** @defgroup KETCube_I2S_types Public Types
+  * @brief Public types
+  * @{
+  */
+
+/**
+ * @brief Block processing function
+ * 
+ * Called from DMA IRQ context, whenever one half of the DMA buffer is filled.
+ * 
+ * @param block received frames, see @ref KETCUBE_I2S_LEFT_SAMPLE
+ * @param len number of frames in the block
+ */
+typedef void (*ketCube_I2S_BlockFn_t)(const uint16_t * block, uint16_t len);
+
+/**
+ * @brief Capture statistics
+ */
+typedef struct ketCube_I2S_Stats_t {
+    uint32_t blocks;            /*!< Number of processed blocks */
+    uint32_t errors;            /*!< Number of I2S/DMA errors (capture restarts) */
+    uint64_t cycles;            /*!< CPU cycles spent in block processing */
+} ketCube_I2S_Stats_t;
+
 /**
 * @}
 */
@@ -89,6 +132,11 @@
 
 ketCube_cfg_ModError_t ketCube_I2S_Init(void);
 ketCube_cfg_ModError_t ketCube_I2S_UnInit(void);
+ketCube_cfg_ModError_t ketCube_I2S_Start(ketCube_I2S_BlockFn_t fn);
+ketCube_cfg_ModError_t ketCube_I2S_Stop(void);
+void ketCube_I2S_GetStats(ketCube_I2S_Stats_t * stats, bool reset);
+
+extern void DMA1_Channel4_5_6_7_IRQHandler(void);
 
 /**
 * @}
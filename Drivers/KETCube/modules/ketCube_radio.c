@@ -49,6 +49,7 @@
 #include "ketCube_radio.h"
 #include "ketCube_gpio.h"
 #include "ketCube_spi.h"
+#include "ketCube_pwrMan.h"
 
 #include "ketCube_terminal.h"
 
@@ -87,6 +88,9 @@ ketCube_cfg_DrvError_t ketCube_Radio_Init(void) {
     
     initialized = TRUE;
     
+    /* Radio IO is restored on demand after wake-up */
+    ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_RADIO, &ketCube_Radio_SleepExit, &ketCube_Radio_SleepEnter);
+    
     return KETCUBE_CFG_MODULE_OK;
 }
 
@@ -95,6 +99,8 @@ ketCube_cfg_DrvError_t ketCube_Radio_Init(void) {
   */
 ketCube_cfg_DrvError_t ketCube_Radio_DeInit(void) {
     if (initialized == TRUE) {
+        ketCube_pwrMan_UnRegister(KETCUBE_PWRMAN_PERIPH_RADIO);
+        
         // UnInit here ...
         Radio.IoDeInit();
     }
@@ -108,7 +114,7 @@ ketCube_cfg_DrvError_t ketCube_Radio_DeInit(void) {
 /**
  * @brief Set-UP Radio befere sleep enter
  * 
- * @note This function should be called by KETCube core
+ * @note This function is called by the power manager (@see ketCube_pwrMan_SleepEnter)
  * 
  */
 ketCube_cfg_DrvError_t ketCube_Radio_SleepEnter(void) {
@@ -122,7 +128,7 @@ ketCube_cfg_DrvError_t ketCube_Radio_SleepEnter(void) {
 /**
  * @brief Set-UP radio after sleep exit
  * 
- * @note This function should be called by KETCube core
+ * @note This function is called by the power manager before the first SPI transfer after wake-up (@see ketCube_pwrMan_Acquire)
  * 
  */
 ketCube_cfg_DrvError_t ketCube_Radio_SleepExit(void) {
@@ -114,6 +114,9 @@ typedef struct
 #define  DAYS_IN_MONTH_CORRECTION_NORM     ((uint32_t) 0x99AAA0 )
 #define  DAYS_IN_MONTH_CORRECTION_LEAP     ((uint32_t) 0x445550 )
 
+/* Wake-up timer clock (RTCCLK/16) in Hz */
+#define RTC_WUT_CLK_HZ             (LSE_VALUE >> 4)
+
 /* Calculates ceiling(X/N) */
 #define DIVC(X,N)   ( ( (X) + (N) -1 ) / (N) )
 
@@ -146,6 +149,8 @@ static RTC_HandleTypeDef RtcHandle={0};
 
 static RTC_AlarmTypeDef RTC_AlarmStructure;
 
+static volatile bool wakeUpTimerElapsed = FALSE;
+
 /**
  * Keep the value of the RTC timer when the RTC alarm is set
  * Set with the ketCube_RTC_SetTimerContext function
@@ -376,6 +381,56 @@ void ketCube_RTC_IrqHandler(void) {
   ketCube_MCU_EnableSleep();
   
   HAL_RTC_AlarmIRQHandler( &RtcHandle);
+  
+  if (__HAL_RTC_WAKEUPTIMER_GET_IT_SOURCE(&RtcHandle, RTC_IT_WUT) != RESET) {
+    HAL_RTCEx_WakeUpTimerIRQHandler(&RtcHandle);
+  }
+}
+
+/**
+ * @brief Start the RTC wake-up timer
+ * 
+ * The wake-up timer is independent of the Alarm A used by the timeServer,
+ * the elapsed period is signalized by ketCube_RTC_IsWakeUpTimerElapsed()
+ * 
+ * @param delay in ms; the period is limited to KETCUBE_RTC_WUT_MAX_MS
+ * 
+ * @retval none
+ */
+void ketCube_RTC_StartWakeUpTimer(uint32_t delay) {
+  uint32_t counter;
+  
+  if (delay > KETCUBE_RTC_WUT_MAX_MS) {
+    delay = KETCUBE_RTC_WUT_MAX_MS;
+  }
+  
+  counter = (delay * RTC_WUT_CLK_HZ) / MSEC_NUMBER;
+  if (counter > 0) {
+    counter--;
+  }
+  
+  wakeUpTimerElapsed = FALSE;
+  
+  HAL_RTCEx_SetWakeUpTimer_IT(&RtcHandle, counter, RTC_WAKEUPCLOCK_RTCCLK_DIV16);
+}
+
+/**
+ * @brief Stop the RTC wake-up timer
+ * @param none
+ * @retval none
+ */
+void ketCube_RTC_StopWakeUpTimer(void) {
+  HAL_RTCEx_DeactivateWakeUpTimer(&RtcHandle);
+  __HAL_RTC_WAKEUPTIMER_EXTI_CLEAR_FLAG();
+}
+
+/**
+ * @brief Check the RTC wake-up timer
+ * @param none
+ * @retval TRUE if the period set by ketCube_RTC_StartWakeUpTimer() elapsed
+ */
+bool ketCube_RTC_IsWakeUpTimerElapsed(void) {
+  return wakeUpTimerElapsed;
 }
 
 
@@ -647,6 +702,31 @@ void ketCube_RTC_BKUPRead( uint32_t *Data0, uint32_t *Data1)
   *Data1=HAL_RTCEx_BKUPRead(&RtcHandle, RTC_BKP_DR1);
 }
 
+/**
+ * @brief Write a single RTC backup register
+ * 
+ * @note RTC_BKP_DR0 and RTC_BKP_DR1 are used by the LoRa SysTime, see ketCube_RTC_BKUPWrite()
+ * 
+ * @param reg backup register (RTC_BKP_DR2 - RTC_BKP_DR4)
+ * @param data value to be written
+ */
+void ketCube_RTC_BKUPWriteReg(uint32_t reg, uint32_t data)
+{
+  HAL_RTCEx_BKUPWrite(&RtcHandle, reg, data);
+}
+
+/**
+ * @brief Read a single RTC backup register
+ * 
+ * @param reg backup register (RTC_BKP_DR2 - RTC_BKP_DR4)
+ * 
+ * @return register value; backup registers survive MCU resets, but not power loss
+ */
+uint32_t ketCube_RTC_BKUPReadReg(uint32_t reg)
+{
+  return HAL_RTCEx_BKUPRead(&RtcHandle, reg);
+}
+
 TimerTime_t RtcTempCompensation( TimerTime_t period, float temperature )
 {
     float k = RTC_TEMP_COEFFICIENT;
@@ -696,6 +776,16 @@ void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc)
     // TimerIrqHandler( );
 }
 
+/**
+  * @brief  Wake-up timer callback.
+  * @param  hrtc: RTC handle
+  * @retval None
+  */
+void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    wakeUpTimerElapsed = TRUE;
+}
+
 /**
   * @brief  Alarm A callback.
   * @param  hrtc: RTC handle
@@ -87,6 +87,13 @@
  */
 #define RTC_TEMP_DEV_TURNOVER                           ( 5.0 )
 
+/**
+ * @brief Maximal wake-up timer period in ms
+ * 
+ * @note The 16-bit wake-up timer is clocked by RTCCLK/16 (2048 Hz) -- 32 s
+ */
+#define KETCUBE_RTC_WUT_MAX_MS                          30000
+
 
 /** @defgroup KETCube_RTC_fn Public Functions
   * @brief Public functions
@@ -103,6 +110,9 @@ extern uint32_t ketCube_RTC_GetTimerValue(void);
 extern uint32_t ketCube_RTC_SetTimerContext(void);
 extern uint32_t ketCube_RTC_GetTimerContext(void) ;
 extern void ketCube_RTC_DelayMs(uint32_t delay);
+extern void ketCube_RTC_StartWakeUpTimer(uint32_t delay);
+extern void ketCube_RTC_StopWakeUpTimer(void);
+extern bool ketCube_RTC_IsWakeUpTimerElapsed(void);
 extern void ketCube_RTC_setMcuWakeUpTime();
 extern int16_t ketCube_RTC_getMcuWakeUpTime(void);
 extern uint32_t ketCube_RTC_ms2Tick(TimerTime_t timeMicroSec);
@@ -112,6 +122,8 @@ extern uint32_t ketCube_RTC_GetCalendarTime(uint16_t *subSeconds);
 uint32_t ketCube_RTC_GetSysTime(void);
 extern void ketCube_RTC_BKUPWrite( uint32_t Data0, uint32_t Data1);
 extern void ketCube_RTC_BKUPRead( uint32_t *Data0, uint32_t *Data1);
+extern void ketCube_RTC_BKUPWriteReg(uint32_t reg, uint32_t data);
+extern uint32_t ketCube_RTC_BKUPReadReg(uint32_t reg);
 
 extern uint32_t HAL_GetTick(void);
 
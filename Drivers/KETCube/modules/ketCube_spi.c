@@ -52,6 +52,7 @@
 
 #include "ketCube_gpio.h"
 #include "ketCube_spi.h"
+#include "ketCube_pwrMan.h"
 
 #define SPI_CLK_ENABLE()                __HAL_RCC_SPI1_CLK_ENABLE()
 #define SPI1_AF                          GPIO_AF0_SPI1  
@@ -62,6 +63,7 @@ static volatile bool initialized = FALSE; /* disable concurent execution of the
 static SPI_HandleTypeDef hspi;
 
 static void ketCube_SPI_IoInit(void);
+static void ketCube_SPI_IoAfInit(void);
 static void ketCube_SPI_IoDeInit(void);
 
 /**
@@ -113,6 +115,9 @@ ketCube_cfg_DrvError_t ketCube_SPI_Init(void) {
   
   initialized = TRUE;
   
+  /* SPI is restored on demand after wake-up */
+  ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_SPI, &ketCube_SPI_SleepExit, &ketCube_SPI_SleepEnter);
+  
   return KETCUBE_CFG_MODULE_OK;
 }
 
@@ -123,6 +128,8 @@ ketCube_cfg_DrvError_t ketCube_SPI_Init(void) {
  */
 ketCube_cfg_DrvError_t ketCube_SPI_DeInit(void) {
     if (initialized == TRUE) {
+        ketCube_pwrMan_UnRegister(KETCUBE_PWRMAN_PERIPH_SPI);
+        
         // UnInit here ...
         HAL_SPI_DeInit( &hspi);
         
@@ -141,7 +148,7 @@ ketCube_cfg_DrvError_t ketCube_SPI_DeInit(void) {
 /**
  * @brief Set-UP SPI befere sleep enter
  * 
- * @note This function should be called by KETCube core
+ * @note This function is called by the power manager (@see ketCube_pwrMan_SleepEnter)
  * 
  */
 ketCube_cfg_DrvError_t ketCube_SPI_SleepEnter(void) {
@@ -160,12 +167,13 @@ ketCube_cfg_DrvError_t ketCube_SPI_SleepEnter(void) {
 /**
  * @brief Set-UP SPI after sleep exit
  * 
- * @note This function should be called by KETCube core
+ * @note This function is called by the power manager on the first SPI transfer after wake-up (@see ketCube_pwrMan_Acquire)
+ * @note NSS is driven by the SX1276 driver and it may be already asserted here, thus it is not touched
  * 
  */
 ketCube_cfg_DrvError_t ketCube_SPI_SleepExit(void) {
     if (initialized == TRUE) {
-        ketCube_SPI_IoInit();
+        ketCube_SPI_IoAfInit();
         
         __HAL_SPI_ENABLE(&hspi);
     }
@@ -173,7 +181,7 @@ ketCube_cfg_DrvError_t ketCube_SPI_SleepExit(void) {
     return KETCUBE_CFG_MODULE_OK;
 }
 
-static void ketCube_SPI_IoInit(void)
+static void ketCube_SPI_IoAfInit(void)
 {
   GPIO_InitTypeDef initStruct={0};
   
@@ -185,6 +193,13 @@ static void ketCube_SPI_IoInit(void)
   ketCube_GPIO_ReInit(RADIO_SCLK_PORT, RADIO_SCLK_PIN, &initStruct);
   ketCube_GPIO_ReInit(RADIO_MISO_PORT, RADIO_MISO_PIN, &initStruct);
   ketCube_GPIO_ReInit(RADIO_MOSI_PORT, RADIO_MOSI_PIN, &initStruct);
+}
+
+static void ketCube_SPI_IoInit(void)
+{
+  GPIO_InitTypeDef initStruct={0};
+  
+  ketCube_SPI_IoAfInit();
   
   initStruct.Mode = GPIO_MODE_OUTPUT_PP;
   initStruct.Pull = GPIO_NOPULL;
@@ -224,6 +239,10 @@ static void ketCube_SPI_IoDeInit(void) {
 uint16_t ketCube_SPI_InOut(uint16_t txData) {
   uint16_t rxData ;
 
+  /* restore radio IO and SPI after wake-up if not done yet */
+  ketCube_pwrMan_Acquire(KETCUBE_PWRMAN_PERIPH_RADIO);
+  ketCube_pwrMan_Acquire(KETCUBE_PWRMAN_PERIPH_SPI);
+
   HAL_SPI_TransmitReceive( &hspi, ( uint8_t * ) &txData, ( uint8_t* ) &rxData, 1, HAL_MAX_DELAY);	
 
   return rxData;
@@ -47,12 +47,20 @@
 
 #include "ketCube_cfg.h"
 #include "ketCube_timer.h"
+#include "ketCube_gpio.h"
+
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
 
 ketCube_Timer_usage_t timerUsed = { 0, 0, 0, 0, 0, 0, 0 };
 
 TIM_HandleTypeDef KETCube_Timer_Htim2;
 static volatile bool KETCube_Timer_Timer2_IC = FALSE;
 
+static LPTIM_HandleTypeDef KETCube_Timer_Hlptim;
+static volatile uint16_t KETCube_Timer_LPTIM_ARRM = 0;     ///< # of ARR matches handled in the IRQ
+
 /**
  * @brief  Configures Timer(s)
  *
@@ -123,6 +131,195 @@ bool ketCube_Timer_Timer2_IsICEvent(void) {
     return KETCube_Timer_Timer2_IC;
 }
 
+/**
+ * @brief  Start LPTIM1 as a 32-bit pulse counter on LPTIM1_IN1
+ *
+ * The counter runs from the LSE, so it is incremented also in STOP mode;
+ * the MCU is woken up only once per 65536 pulses to extend the counter.
+ *
+ * @param filter digital glitch filter (debounce)
+ * @param edge counted edge(s)
+ * 
+ * @retval KETCUBE_CFG_DRV_OK in case of success
+ * @retval KETCUBE_CFG_DRV_ERROR in case of failure -- LPTIM or PIN already used
+ */
+ketCube_cfg_DrvError_t ketCube_Timer_LPTIM_StartCounter(ketCube_Timer_LPTIM_filter_t filter,
+                                                        ketCube_Timer_LPTIM_edge_t edge)
+{
+    GPIO_InitTypeDef initStruct = { 0 };
+    uint32_t cfgr;
+
+    if (timerUsed.lptim == TRUE) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    /* meter outputs are typically reed contacts or open collectors */
+    initStruct.Mode = GPIO_MODE_AF_PP;
+    initStruct.Pull = GPIO_PULLUP;
+    initStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    initStruct.Alternate = KETCUBE_TIMER_LPTIM_IN1_AF;
+
+    if (ketCube_GPIO_Init(KETCUBE_TIMER_LPTIM_IN1_PORT,
+                          KETCUBE_TIMER_LPTIM_IN1_PIN,
+                          &initStruct) != KETCUBE_CFG_DRV_OK) {
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    /* LSE is running in STOP mode, so is the LPTIM kernel clock */
+    __HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_LSE);
+    __HAL_RCC_LPTIM1_CLK_ENABLE();
+    __HAL_RCC_LPTIM1_CLK_SLEEP_ENABLE();
+
+    KETCube_Timer_Hlptim.Instance = LPTIM1;
+    KETCube_Timer_Hlptim.Init.Clock.Source = LPTIM_CLOCKSOURCE_APBCLOCK_LPOSC;
+    KETCube_Timer_Hlptim.Init.Clock.Prescaler = LPTIM_PRESCALER_DIV1;
+    KETCube_Timer_Hlptim.Init.Trigger.Source = LPTIM_TRIGSOURCE_SOFTWARE;
+    KETCube_Timer_Hlptim.Init.OutputPolarity = LPTIM_OUTPUTPOLARITY_HIGH;
+    KETCube_Timer_Hlptim.Init.UpdateMode = LPTIM_UPDATE_IMMEDIATE;
+    KETCube_Timer_Hlptim.Init.CounterSource = LPTIM_COUNTERSOURCE_EXTERNAL;
+
+    if (HAL_LPTIM_Init(&KETCube_Timer_Hlptim) != HAL_OK) {
+        ketCube_GPIO_Release(KETCUBE_TIMER_LPTIM_IN1_PORT,
+                             KETCUBE_TIMER_LPTIM_IN1_PIN);
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    /* 
+     * HAL sets CKPOL/CKFLT for the ULPTIM clock source only; in the external
+     * counter mode, they select the counted edge and the IN1 glitch filter
+     */
+    cfgr = LPTIM1->CFGR & ~(LPTIM_CFGR_CKPOL | LPTIM_CFGR_CKFLT);
+
+    switch (edge) {
+    case KETCUBE_TIMER_LPTIM_EDGE_FALLING:
+        cfgr |= LPTIM_CLOCKPOLARITY_FALLING;
+        break;
+    case KETCUBE_TIMER_LPTIM_EDGE_BOTH:
+        cfgr |= LPTIM_CLOCKPOLARITY_RISING_FALLING;
+        break;
+    default:
+        cfgr |= LPTIM_CLOCKPOLARITY_RISING;
+        break;
+    }
+
+    switch (filter) {
+    case KETCUBE_TIMER_LPTIM_FILTER_2:
+        cfgr |= LPTIM_CLOCKSAMPLETIME_2TRANSITIONS;
+        break;
+    case KETCUBE_TIMER_LPTIM_FILTER_4:
+        cfgr |= LPTIM_CLOCKSAMPLETIME_4TRANSITIONS;
+        break;
+    case KETCUBE_TIMER_LPTIM_FILTER_8:
+        cfgr |= LPTIM_CLOCKSAMPLETIME_8TRANSITIONS;
+        break;
+    default:
+        cfgr |= LPTIM_CLOCKSAMPLETIME_DIRECTTRANSITION;
+        break;
+    }
+    LPTIM1->CFGR = cfgr;
+
+    KETCube_Timer_LPTIM_ARRM = 0;
+
+    HAL_NVIC_SetPriority(LPTIM1_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+
+    if (HAL_LPTIM_Counter_Start_IT(&KETCube_Timer_Hlptim,
+                                   KETCUBE_TIMER_LPTIM_PERIOD) != HAL_OK) {
+        HAL_NVIC_DisableIRQ(LPTIM1_IRQn);
+        HAL_LPTIM_DeInit(&KETCube_Timer_Hlptim);
+        ketCube_GPIO_Release(KETCUBE_TIMER_LPTIM_IN1_PORT,
+                             KETCUBE_TIMER_LPTIM_IN1_PIN);
+        return KETCUBE_CFG_DRV_ERROR;
+    }
+
+    timerUsed.lptim = TRUE;
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief  Stop the LPTIM1 pulse counter and release its resources
+ */
+void ketCube_Timer_LPTIM_StopCounter(void)
+{
+    if (timerUsed.lptim == FALSE) {
+        return;
+    }
+
+    HAL_LPTIM_Counter_Stop_IT(&KETCube_Timer_Hlptim);
+    HAL_NVIC_DisableIRQ(LPTIM1_IRQn);
+    HAL_LPTIM_DeInit(&KETCube_Timer_Hlptim);
+    __HAL_RCC_LPTIM1_CLK_DISABLE();
+
+    ketCube_GPIO_Release(KETCUBE_TIMER_LPTIM_IN1_PORT,
+                         KETCUBE_TIMER_LPTIM_IN1_PIN);
+
+    timerUsed.lptim = FALSE;
+}
+
+/**
+ * @brief  Get the number of pulses counted since ketCube_Timer_LPTIM_StartCounter()
+ *
+ * @note The 32-bit result wraps around; differences of two readings are always valid
+ *
+ * @retval pulse count
+ */
+uint32_t ketCube_Timer_LPTIM_GetCount(void)
+{
+    uint32_t cnt;
+    uint16_t arrm;
+    bool pending;
+
+    if (timerUsed.lptim == FALSE) {
+        return 0;
+    }
+
+    BACKUP_PRIMASK();
+    DISABLE_IRQ();
+
+    /* CNT is clocked asynchronously -- read until two consecutive reads match */
+    do {
+        cnt = LPTIM1->CNT;
+    } while (cnt != LPTIM1->CNT);
+
+    pending = (__HAL_LPTIM_GET_FLAG(&KETCube_Timer_Hlptim, LPTIM_FLAG_ARRM) != RESET);
+    arrm = KETCube_Timer_LPTIM_ARRM;
+
+    RESTORE_PRIMASK();
+
+    /*
+     * ARRM is set when CNT reaches ARR, the counter wraps on the next pulse:
+     *   - CNT == ARR: the last ARR match has not wrapped yet
+     *   - CNT in the lower half: a pending ARR match has already wrapped
+     *   - otherwise, a pending ARR match was raised after CNT was read
+     */
+    if (pending == TRUE) {
+        if (cnt < ((KETCUBE_TIMER_LPTIM_PERIOD + 1) >> 1)) {
+            arrm++;
+        }
+    } else if (cnt == KETCUBE_TIMER_LPTIM_PERIOD) {
+        arrm--;
+    }
+
+    return (((uint32_t) arrm) << 16) + cnt;
+}
+
+/**
+  * @brief This function handles LPTIM1 global interrupt.
+  */
+void LPTIM1_IRQHandler(void)
+{
+    HAL_LPTIM_IRQHandler(&KETCube_Timer_Hlptim);
+}
+
+/**
+  * @brief  Autoreload match callback -- extends the 16-bit LPTIM counter
+  */
+void HAL_LPTIM_AutoReloadMatchCallback(LPTIM_HandleTypeDef *hlptim)
+{
+    KETCube_Timer_LPTIM_ARRM++;
+}
+
 /**
   * @brief This function handles TIM2 global interrupt.
   */
@@ -47,6 +47,7 @@
 #define __KETCUBE_TIMER_H
 
 #include "ketCube_cfg.h"
+#include "ketCube_gpio.h"
 
 /** @defgroup KETCube_Timer KETCube timer
   * @brief KETCube Timer module
@@ -56,6 +57,39 @@
 
 #define KETCUBE_TIMER_NAME                      "timer_drv"         ///< TIMER driver name
 
+/** @defgroup KETCube_Timer_LPTIM LPTIM pulse counter
+  * @brief LPTIM1 counts edges on LPTIM1_IN1 (PB5, AF2 = mainBoard INT PIN since rev. E);
+  *        it is clocked from the LSE, thus it keeps counting in STOP mode
+  * @{
+  */
+#define KETCUBE_TIMER_LPTIM_IN1_PORT            KETCUBE_GPIO_PB     ///< LPTIM1_IN1 port
+#define KETCUBE_TIMER_LPTIM_IN1_PIN             KETCUBE_GPIO_PIN_5  ///< LPTIM1_IN1 PIN
+#define KETCUBE_TIMER_LPTIM_IN1_AF              GPIO_AF2_LPTIM1     ///< LPTIM1_IN1 alternate function
+#define KETCUBE_TIMER_LPTIM_PERIOD              0xFFFFU             ///< Counter ARR; an ARR match extends the counter to 32 bits
+
+/**
+* @brief LPTIM input glitch filter (debounce); an edge is accepted after N stable LSE clocks (30.5 us each)
+*/
+typedef enum {
+    KETCUBE_TIMER_LPTIM_FILTER_NONE = 0,    ///< No filtering
+    KETCUBE_TIMER_LPTIM_FILTER_2    = 2,    ///< 2 LSE clocks (61 us)
+    KETCUBE_TIMER_LPTIM_FILTER_4    = 4,    ///< 4 LSE clocks (122 us)
+    KETCUBE_TIMER_LPTIM_FILTER_8    = 8,    ///< 8 LSE clocks (244 us)
+} ketCube_Timer_LPTIM_filter_t;
+
+/**
+* @brief LPTIM counted edge(s)
+*/
+typedef enum {
+    KETCUBE_TIMER_LPTIM_EDGE_RISING  = 0,   ///< Count rising edges
+    KETCUBE_TIMER_LPTIM_EDGE_FALLING = 1,   ///< Count falling edges
+    KETCUBE_TIMER_LPTIM_EDGE_BOTH    = 2,   ///< Count both edges
+} ketCube_Timer_LPTIM_edge_t;
+
+/**
+* @}
+*/
+
 extern TIM_HandleTypeDef KETCube_Timer_Htim2;
 
 /**
@@ -96,6 +130,13 @@ extern ketCube_cfg_DrvError_t ketCube_Timer_Init(ketCube_Timer_list_t tim);
 extern bool ketCube_Timer_Timer2_IsICEvent();
 extern void ketCube_Timer_Timer2_ResetICEvent();
 
+extern ketCube_cfg_DrvError_t ketCube_Timer_LPTIM_StartCounter(ketCube_Timer_LPTIM_filter_t filter,
+                                                               ketCube_Timer_LPTIM_edge_t edge);
+extern void ketCube_Timer_LPTIM_StopCounter(void);
+extern uint32_t ketCube_Timer_LPTIM_GetCount(void);
+
+extern void LPTIM1_IRQHandler(void);
+
 /**
 * @}
 */
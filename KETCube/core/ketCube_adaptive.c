@@ -0,0 +1,227 @@
+/**
+ * @file    ketCube_adaptive.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube adaptive sampling period
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "ketCube_adaptive.h"
+#include "ketCube_deadband.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_modules.h"
+#include "ketCube_terminal.h"
+#include "timeServer.h"
+
+static bool valid[ketCube_modules_CNT];  ///< Module signals sampled at least once
+static bool sampled = FALSE;             ///< lastSample is valid
+static TimerTime_t lastSample;           ///< Time of the last period
+static float dt;                         ///< Seconds since the last period; 0 if unknown
+static float desired;                    ///< Desired period in ms; 0 if no active signal
+static bool signals;                     ///< Any signal evaluated in this period
+static uint32_t period = 0;              ///< Current period in ms; 0 if not requested
+
+/**
+ * @brief Square root by Newton iteration; avoids libm
+ */
+static float ketCube_adaptive_Sqrt(float x)
+{
+    float r;
+    uint8_t i;
+
+    if (x <= 0.0f) {
+        return 0.0f;
+    }
+
+    r = (x > 1.0f) ? x : 1.0f;
+    for (i = 0; i < 24; i++) {
+        r = 0.5f * (r + x / r);
+    }
+
+    return r;
+}
+
+/**
+ * @brief Start a period; call before module GetSensorData() functions
+ */
+void ketCube_adaptive_Begin(void)
+{
+    TimerTime_t now = TimerGetCurrentTime();
+
+    dt = 0.0f;
+    if (sampled == TRUE) {
+        dt = (float) (now - lastSample) / 1000.0f;
+    }
+    lastSample = now;
+    sampled = TRUE;
+    desired = 0.0f;
+    signals = FALSE;
+}
+
+/**
+ * @brief Update signal statistics by module record
+ *
+ * @param modId module ID
+ * @param data module record
+ * @param len module record length
+ */
+void ketCube_adaptive_Update(ketCube_cfg_moduleIDs_t modId,
+                             const uint8_t * data, uint8_t len)
+{
+    ketCube_deadband_field_t * f;
+    uint8_t fieldCnt, i;
+    uint8_t pos = 0;
+    int32_t value;
+    float rate, diff, step, activity, sd, t;
+
+    if (ketCube_coreCfg.adaptMaxPeriod == 0) {
+        return;
+    }
+
+    f = ketCube_deadband_GetFields(modId, &fieldCnt);
+    if (f == NULL) {
+        return;
+    }
+
+    for (i = 0; i < fieldCnt; i++, f++) {
+        if ((pos + (f->field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK)) > len) {
+            break;
+        }
+        value = ketCube_tsCodec_GetField(&(data[pos]), f->field);
+        pos += f->field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+
+        if ((valid[modId] == FALSE) || (dt <= 0.0f)) {
+            f->prev = value;
+            f->rate = 0.0f;
+            f->rateVar = 0.0f;
+            continue;
+        }
+
+        rate = ((float) value - (float) f->prev) / dt;
+        f->prev = value;
+        signals = TRUE;
+
+        diff = rate - f->rate;
+        f->rate += KETCUBE_ADAPTIVE_ALPHA * diff;
+        f->rateVar = (1.0f - KETCUBE_ADAPTIVE_ALPHA)
+                     * (f->rateVar + KETCUBE_ADAPTIVE_ALPHA * diff * diff);
+
+        sd = ketCube_adaptive_Sqrt(f->rateVar);
+        activity = ((f->rate < 0.0f) ? -f->rate : f->rate) + sd;
+        if (activity <= 0.0f) {
+            continue;
+        }
+
+        /* time to move by the deadband */
+        step = (float) f->relative * (float) ((value < 0) ? -value : value) / 1000.0f;
+        if (step < (float) f->absolute) {
+            step = (float) f->absolute;
+        }
+        if (step < 1.0f) {
+            step = 1.0f;
+        }
+
+        t = 1000.0f * step / activity;
+        if ((desired == 0.0f) || (t < desired)) {
+            desired = t;
+        }
+    }
+
+    valid[modId] = TRUE;
+}
+
+/**
+ * @brief Finish a period; request the base period
+ */
+void ketCube_adaptive_End(void)
+{
+    uint32_t minPeriod = ketCube_coreCfg.adaptMinPeriod;
+    uint32_t maxPeriod = ketCube_coreCfg.adaptMaxPeriod;
+    uint32_t target;
+
+    if (maxPeriod == 0) {
+        if (period != 0) {
+            period = 0;
+            ketCube_modules_SetPeriod(KETCUBE_LISTS_ID_CORE, 0);
+        }
+        return;
+    }
+
+    /* keep the current period until statistics are available */
+    if (signals == FALSE) {
+        return;
+    }
+
+    if (minPeriod < KETCUBE_CORECFG_MIN_BASEPERIOD) {
+        minPeriod = KETCUBE_CORECFG_MIN_BASEPERIOD;
+    }
+    if (maxPeriod < minPeriod) {
+        maxPeriod = minPeriod;
+    }
+
+    if ((desired == 0.0f) || (desired >= (float) maxPeriod)) {
+        target = maxPeriod;
+    } else if (desired <= (float) minPeriod) {
+        target = minPeriod;
+    } else {
+        target = (uint32_t) desired;
+    }
+
+    if (period == 0) {
+        period = ketCube_modules_GetPeriod();
+    }
+    if (target > (period * KETCUBE_ADAPTIVE_MAX_GROWTH)) {
+        target = period * KETCUBE_ADAPTIVE_MAX_GROWTH;
+    }
+    if (target > maxPeriod) {
+        target = maxPeriod;
+    }
+    if (target < minPeriod) {
+        target = minPeriod;
+    }
+
+    if (target != period) {
+        ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO,
+                                             "Adaptive period: %d -> %d ms (desired %d ms)",
+                                             period, target, (uint32_t) desired);
+    }
+
+    period = target;
+    ketCube_modules_SetPeriod(KETCUBE_LISTS_ID_CORE, period);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file    ketCube_adaptive.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube adaptive sampling period
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_ADAPTIVE_H
+#define __KETCUBE_ADAPTIVE_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+
+/** @defgroup KETCube_adaptive KETCube adaptive sampling
+  * @brief Base period driven by signal activity
+  *
+  * Signals are the module record fields declared by
+  * ketCube_deadband_Declare(). For each signal, an EWMA of the rate of
+  * change and of its variance is tracked. The signal activity is
+  * |mean rate| + standard deviation of the rate. The period is the time,
+  * in which the most active signal is expected to move by its deadband,
+  * clamped to <adaptMinPeriod; adaptMaxPeriod>.
+  *
+  * The period is shortened immediately and lengthened at most
+  * KETCUBE_ADAPTIVE_MAX_GROWTH times per period, so a transient is
+  * followed closely and a single quiet sample does not stretch the period.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_ADAPTIVE_ALPHA          0.25f      ///< EWMA weight of the newest sample
+#define KETCUBE_ADAPTIVE_MAX_GROWTH     2          ///< Max. period growth per period
+
+/** @defgroup KETCube_adaptive_fn Public Functions
+* @{
+*/
+
+extern void ketCube_adaptive_Begin(void);
+extern void ketCube_adaptive_Update(ketCube_cfg_moduleIDs_t modId,
+                                    const uint8_t * data, uint8_t len);
+extern void ketCube_adaptive_End(void);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_ADAPTIVE_H */
@@ -0,0 +1,131 @@
+/**
+ * @file    ketCube_batPolicy.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube battery-aware power policy
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "ketCube_batPolicy.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_modules.h"
+#include "ketCube_terminal.h"
+
+/**
+ * @brief Policy tiers; ordered by decreasing SoC
+ */
+const ketCube_batPolicy_tier_t ketCube_batPolicy_tiers[KETCUBE_BATPOLICY_TIER_CNT] = {
+    { "normal",   101, 1, FALSE, 0, 0 },
+    { "save",      30, 2, FALSE, 0, 1 },
+    { "low",       15, 4, TRUE,  2, 1 },
+    { "critical",   5, 8, TRUE,  4, 1 },
+};
+
+static ketCube_batPolicy_tierId_t tier = KETCUBE_BATPOLICY_TIER_NORMAL;  ///< Current tier
+
+/**
+ * @brief Select tier for the SoC
+ *
+ * @param soc state of charge in %
+ */
+static ketCube_batPolicy_tierId_t ketCube_batPolicy_Select(uint8_t soc)
+{
+    ketCube_batPolicy_tierId_t t = KETCUBE_BATPOLICY_TIER_NORMAL;
+
+    while (((t + 1) < KETCUBE_BATPOLICY_TIER_CNT)
+           && (soc < ketCube_batPolicy_tiers[t + 1].socBelow)) {
+        t++;
+    }
+
+    /* stay in the current tier until the SoC rises beyond the hysteresis */
+    while ((t < tier)
+           && (soc < (ketCube_batPolicy_tiers[t + 1].socBelow + KETCUBE_BATPOLICY_HYSTERESIS))) {
+        t++;
+    }
+
+    return t;
+}
+
+/**
+ * @brief Update tier from the estimated state of charge
+ *
+ * @param soc state of charge in %
+ */
+void ketCube_batPolicy_Update(uint8_t soc)
+{
+    ketCube_batPolicy_tierId_t t = KETCUBE_BATPOLICY_TIER_NORMAL;
+    uint32_t mask;
+
+    if (ketCube_coreCfg.batPolicy != 0) {
+        t = ketCube_batPolicy_Select(soc);
+    }
+
+    if (t == tier) {
+        return;
+    }
+
+    tier = t;
+
+    ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO,
+                                         "Battery policy: %s (SoC %d %%)",
+                                         ketCube_batPolicy_tiers[tier].name,
+                                         soc);
+
+    ketCube_modules_ScalePeriod(ketCube_batPolicy_tiers[tier].periodScale);
+    if (ketCube_batPolicy_tiers[tier].suspendOptional == TRUE) {
+        mask = ketCube_coreCfg.batPolicyOptMods;
+#ifdef KETCUBE_CFG_INC_MOD_BATMEAS
+        /* keep the policy input */
+        mask &= ~(1UL << KETCUBE_LISTS_MODULEID_BATMEAS);
+#endif
+        ketCube_modules_Suspend(mask);
+    } else {
+        ketCube_modules_Suspend(0);
+    }
+}
+
+/**
+ * @brief Get current tier
+ *
+ * @retval current tier definition
+ */
+const ketCube_batPolicy_tier_t * ketCube_batPolicy_GetTier(void)
+{
+    return &(ketCube_batPolicy_tiers[tier]);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file    ketCube_batPolicy.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube battery-aware power policy
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_BATPOLICY_H
+#define __KETCUBE_BATPOLICY_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+
+/** @defgroup KETCube_batPolicy KETCube battery policy
+  * @brief Power policy tiers driven by the battery state of charge
+  *
+  * The battery module feeds the estimated state of charge (SoC) by
+  * ketCube_batPolicy_Update(). When enabled (ketCube_coreCfg_t::batPolicy),
+  * the SoC selects a tier from ketCube_batPolicy_tiers. A tier:
+  *  - stretches the base period by an integer factor,
+  *  - suspends periodic functions of optional modules
+  *    (ketCube_coreCfg_t::batPolicyOptMods),
+  *  - caps the radio TX power and the # of uplink transmissions; these
+  *    are applied by the communication module via ketCube_batPolicy_GetTier().
+  *
+  * A tier is left towards a higher SoC only when the SoC exceeds its
+  * threshold by KETCUBE_BATPOLICY_HYSTERESIS, so a voltage recovering
+  * in a quiet period does not toggle tiers.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_BATPOLICY_HYSTERESIS    10         ///< SoC hysteresis in %
+
+/**
+* @brief  Policy tiers
+*/
+typedef enum {
+    KETCUBE_BATPOLICY_TIER_NORMAL = 0,  ///< Configured behavior
+    KETCUBE_BATPOLICY_TIER_SAVE,        ///< Mild savings
+    KETCUBE_BATPOLICY_TIER_LOW,         ///< Optional functions off
+    KETCUBE_BATPOLICY_TIER_CRITICAL,    ///< Keep-alive only
+
+    KETCUBE_BATPOLICY_TIER_CNT          ///< Number of tiers - do not use as tier!
+} ketCube_batPolicy_tierId_t;
+
+/**
+* @brief  Policy tier definition
+*/
+typedef struct {
+    char *name;                 ///< Tier name
+    uint8_t socBelow;           ///< Tier applies below this SoC in %
+    uint8_t periodScale;        ///< Base period multiplier
+    bool suspendOptional;       ///< Suspend optional modules
+    uint8_t txPowerMin;         ///< Min. LoRaWAN TX power index (a higher index is a lower power); 0 = no cap
+    uint8_t nbTransMax;         ///< Max. # of transmissions of an uplink; 0 = no limit
+} ketCube_batPolicy_tier_t;
+
+extern const ketCube_batPolicy_tier_t ketCube_batPolicy_tiers[KETCUBE_BATPOLICY_TIER_CNT];
+
+/** @defgroup KETCube_batPolicy_fn Public Functions
+* @{
+*/
+
+extern void ketCube_batPolicy_Update(uint8_t soc);
+extern const ketCube_batPolicy_tier_t * ketCube_batPolicy_GetTier(void);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_BATPOLICY_H */
@@ -48,6 +48,7 @@
 
 #include "ketCube_cfg.h"
 #include "ketCube_resetMan.h"
+#include "ketCube_dataLog.h"
 
 /** @defgroup KETCube_coreCfg KETCube CfgCore
   * @brief KETCube Core configuration
@@ -61,6 +62,7 @@
 #define KETCUBE_CORECFG_MAX_STARTDELAY_RND         59000        ///< Maximal random delay; random startDelay falls between MIN an (MIN+RND) constants
 #define KETCUBE_CORECFG_MIN_REPEATDELAY            30000        ///< Minimal delay between the original and repeated/enforced basePeriod - should be equal to KETCUBE_CORECFG_MIN_BASEPERIOD
 #define KETCUBE_CORECFG_DEFAULT_SEVERITY           KETCUBE_CFG_SEVERITY_ERROR   ///< Default KETCube core severity
+#define KETCUBE_CORECFG_LAYOUT                     ((uint16_t) 0x4B01)          ///< Stored module configuration layout: 0x4B ('K') + layout version; older EEPROM contents are migrated by ketCube_modules_Init()
 
 /**
 * @brief  KETCube core configuration
@@ -73,19 +75,28 @@ typedef struct ketCube_coreCfg_t {
     
     uint32_t basePeriod;                 ///< This period is used by KETCube core to run periodic events
     uint32_t startDelay;                 ///< This delay is used instead ketCube_coreCfg_BasePeriod to run periodic events at the first time
-    uint32_t repeatDelay;                 ///< In case of error during the periodic action, the periodic action is repeated after this delay; if 0, it is not applicable
+    uint32_t repeatDelay;                 ///< In case of module GetSensorData() error, the failed modules are retried after this delay; if 0, it is not applicable
     
     ketCube_severity_t severity;         ///< Core messages severity
     ketCube_severity_t driverSeverity;   ///< Driver(s) messages severity
     uint16_t remoteTerminalCounter;      ///< Is currently in remote terminal mode (value > 0)? If so, how many basePeriods to reload?
+    uint32_t reportHeartbeat;            ///< Report-by-exception: max. silence in seconds; 0 = report every period, see @ref KETCube_deadband
+    uint32_t adaptMinPeriod;             ///< Adaptive sampling: min. base period in ms, see @ref KETCube_adaptive
+    uint32_t adaptMaxPeriod;             ///< Adaptive sampling: max. base period in ms; 0 = disabled
+    uint32_t oversamplePeriod;           ///< Oversampling period in ms; 0 = disabled, see @ref KETCube_oversample
+    uint32_t batPolicyOptMods;           ///< Battery policy: optional modules; bit N = module ID N
+    uint8_t batPolicy;                   ///< Battery policy: 0 = disabled, 1 = enabled, see @ref KETCube_batPolicy
+    uint8_t logEnable;                   ///< Data logger: 0 = disabled, 1 = log sensor records each period, see @ref KETCube_dataLog
+    uint8_t logFields[KETCUBE_DATALOG_MAX_FIELDS]; ///< Data logger: record field descriptors, see @ref KETCube_tsCodec
+    uint32_t timeSyncPeriod;             ///< Network time request period in seconds; 0 = disabled, see @ref KETCube_timeSync
+    uint8_t retryCount;                  ///< Max. number of GetSensorData() retries per module and base period, see repeatDelay; 0 is treated as 1
+    uint8_t statusBitmapOff;             ///< 0 = append the module status bitmap to sensor records (default, also after migration), 1 = disabled
+    uint16_t cfgLayout;                  ///< Layout of the module configurations stored in EEPROM, see KETCUBE_CORECFG_LAYOUT
     
     union {
-        uint16_t moduleSendErrorCnt;     ///< Module periodic-send function error counter
-        uint16_t modulePerErrorCnt;      ///< Module periodic-get function error counter
-        
         ketCube_resetMan_t resetInfo;    ///< Reset Reasoning
         
-        uint8_t RFU[111];                ///< This part of EEPROM is RFU, when adding new field into coreCfg, decrease the size of this field to preserve configuration padding for module(s) configuration; 128B is reserved for CORE in total
+        uint8_t RFU[70];                ///< This part of EEPROM is RFU, when adding new field into coreCfg, decrease the size of this field to preserve configuration padding for module(s) configuration; 128B is reserved for CORE in total
     } volatileData;                      ///< This union should aggregate volatile data, whose require no fixed location over KETCube releases
 } ketCube_coreCfg_t;
 
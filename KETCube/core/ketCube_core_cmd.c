@@ -51,8 +51,12 @@
 #include "ketCube_cfg.h"
 #include "ketCube_common.h"
 #include "ketCube_resetMan.h"
+#include "ketCube_dataLog.h"
+#include "ketCube_timeSync.h"
 
 #include "ketCube_rtc.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_i2c.h"
 
 /** @defgroup KETCube_core_CMD KETCube core CMD
   * @brief KETCube core commandline definitions
@@ -61,6 +65,24 @@
   */
 
 
+/**
+ * @brief Drop all logged records
+ * 
+ */
+void ketCube_core_CMD_logClear(void)
+{
+    ketCube_dataLog_Clear();
+}
+
+/**
+ * @brief Show # of logged records
+ * 
+ */
+void ketCube_core_CMD_showLogCount(void)
+{
+    commandIOParams.as_uint32 = ketCube_dataLog_Count();
+}
+
 /**
  * @brief Erase EEPROM configuration - set factory defaults
  * 
@@ -235,8 +257,67 @@ void ketCube_core_CMD_showUptime(void) {
     KETCUBE_TERMINAL_ENDL();
 }
 
+/**
+ * @brief Show local and network time
+ * 
+ */
+void ketCube_core_CMD_showTime(void) {
+    uint32_t now = ketCube_timeSync_Now();
+    uint32_t unixTime;
+    
+    if (ketCube_timeSync_ToUnix(now, &unixTime) == TRUE) {
+        KETCUBE_TERMINAL_PRINTF("Network time: %d s (Unix); ", unixTime);
+    } else {
+        KETCUBE_TERMINAL_PRINTF("Network time: not synchronised; ");
+    }
+    KETCUBE_TERMINAL_PRINTF("local time: %d s; RTC drift correction: %d ppb", now, ketCube_timeSync_GetDrift());
+    KETCUBE_TERMINAL_ENDL();
+}
+
 /* Terminal command definitions */
 ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
+    {
+        .cmd   = "adaptMaxPeriod",
+        .descr = "Adaptive sampling: max. base period in ms (0: disabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, adaptMaxPeriod),
+            .size     = sizeof(uint32_t)
+        }
+    },
+    
+    {
+        .cmd   = "adaptMinPeriod",
+        .descr = "Adaptive sampling: min. base period in ms",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, adaptMinPeriod),
+            .size     = sizeof(uint32_t)
+        }
+    },
+    
     {
         .cmd   = "basePeriod",
         .descr = "KETCube base period",
@@ -258,6 +339,48 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
         }
     },
     
+    {
+        .cmd   = "batPolicy",
+        .descr = "Battery policy: stretch period, suspend optional modules and cap TX power as the battery depletes (0: disabled, 1: enabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, batPolicy),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "batPolicyOptMods",
+        .descr = "Battery policy: optional modules suspended at low battery (bit N: module ID N)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, batPolicyOptMods),
+            .size     = sizeof(uint32_t)
+        }
+    },
+    
     {
         .cmd   = "factoryDefaults",
         .descr = "Erase EEPROM configuration.",
@@ -269,6 +392,95 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
         .settingsPtr.callback = &ketCube_core_CMD_FactoryDefaults,
     },
     
+    {
+        .cmd   = "logClear",
+        .descr = "Drop all records of the data logger",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isRAM     = TRUE,
+            .isSetCmd  = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_NONE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_NONE,
+        .settingsPtr.callback = &ketCube_core_CMD_logClear,
+    },
+    
+    {
+        .cmd   = "logCount",
+        .descr = "# of records in the data logger",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_NONE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.callback = &ketCube_core_CMD_showLogCount,
+    },
+    
+    {
+        .cmd   = "logEnable",
+        .descr = "Data logger: store sensor records into the data EEPROM each period (0: disabled, 1: enabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, logEnable),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "logFields",
+        .descr = "Data logger: record field descriptors (8 bytes HEX, 00-terminated; see LoRa batchFields); clear the log after change",
+        .flags = {
+            .isLocal   = TRUE,
+            .isEEPROM  = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE_ARRAY,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE_ARRAY,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, logFields),
+            .size     = KETCUBE_DATALOG_MAX_FIELDS
+        }
+    },
+    
+    {
+        .cmd   = "oversamplePeriod",
+        .descr = "Oversampling period in ms; modules report min/max/mean/stddev (0: disabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, oversamplePeriod),
+            .size     = sizeof(uint32_t)
+        }
+    },
+    
     {
         .cmd   = "remoteTerminalCounter",
         .descr = "If set to value > 0, no application data is sent through"
@@ -292,6 +504,29 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
         }
     },
     
+    {
+        .cmd   = "reportHeartbeat",
+        .descr = "Report-by-exception: send data only if a module value"
+                 " moved beyond its deadband or after this many seconds"
+                 " (0: send every period)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, reportHeartbeat),
+            .size     = sizeof(uint32_t)
+        }
+    },
+    
     {
         .cmd   = "startBootloader",
         .descr = "Initialize MCU to allow STM bootloader startup.",
@@ -305,7 +540,7 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
     
     {
         .cmd   = "repeatDelay",
-        .descr = "In case of error during the periodic action, the periodic action is repeated after this delay; set to 0 if not applicable",
+        .descr = "In case of module error during the periodic action, the failed modules are retried after this delay; set to 0 if not applicable",
         .flags = {
             .isLocal   = TRUE,
             .isRemote  = TRUE,
@@ -324,6 +559,48 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
         }
     },
     
+    {
+        .cmd   = "retryCount",
+        .descr = "Max. number of retries of a failed module within the base period (see repeatDelay); 0 is treated as 1",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, retryCount),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "statusBitmapOff",
+        .descr = "Disable module status bitmap appended to sensor records: 1 bit per sampled module in module order, set if the module data are missing (0: appended - default, 1: disabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, statusBitmapOff),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
     {
         .cmd   = "startDelay",
         .descr = "First periodic action is delayed after power-up and initialization",
@@ -367,6 +644,40 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
         }
     },
     
+    {
+        .cmd   = "time",
+        .descr = "Show network time and RTC drift correction.",
+        .flags = {
+            .isLocal    = TRUE,
+            .isRemote   = TRUE,
+            .isRAM      = TRUE,
+            .isShowCmd  = TRUE,
+        },
+        
+        .settingsPtr.callback = &ketCube_core_CMD_showTime,
+    },
+    
+    {
+        .cmd   = "timeSyncPeriod",
+        .descr = "Network time request period in seconds (0: disabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_ID_CORE,
+            .offset   = offsetof(ketCube_coreCfg_t, timeSyncPeriod),
+            .size     = sizeof(uint32_t)
+        }
+    },
+    
     {
         .cmd   = "uptime",
         .descr = "Show KETCube uptime.",
@@ -399,6 +710,50 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_core[] = {
 
 /* Terminal command definitions for driver subgroup */
 ketCube_terminal_cmd_t ketCube_terminal_commands_driver[] = {
+#ifdef KETCUBE_CFG_INC_DRV_I2C
+    {
+        .cmd   = "i2c",
+        .descr = "Show I2C per-device statistics: successful, NACK-ed,"
+                 " timed-out, erroneous and skipped transactions.",
+        .flags = {
+            .isLocal    = TRUE,
+            .isRemote   = TRUE,
+            .isRAM      = TRUE,
+            .isShowCmd  = TRUE,
+        },
+        
+        .settingsPtr.callback = &ketCube_I2C_PrintStats,
+    },
+    
+    {
+        .cmd   = "i2cClear",
+        .descr = "Clear I2C per-device statistics and return removed devices"
+                 " to the poll set.",
+        .flags = {
+            .isLocal    = TRUE,
+            .isRemote   = TRUE,
+            .isRAM      = TRUE,
+            .isSetCmd   = TRUE,
+        },
+        
+        .settingsPtr.callback = &ketCube_I2C_ClearStats,
+    },
+#endif
+    
+    {
+        .cmd   = "pwrMan",
+        .descr = "Show peripheral power manager statistics: restoration cost"
+                 " and time saved by on-demand restoration per wake-up class.",
+        .flags = {
+            .isLocal    = TRUE,
+            .isRemote   = TRUE,
+            .isRAM      = TRUE,
+            .isShowCmd  = TRUE,
+        },
+        
+        .settingsPtr.callback = &ketCube_pwrMan_PrintStats,
+    },
+    
     {
         .cmd   = "severity",
         .descr = "Driver(s) messages severity: 0 = NONE, 1 = ERROR; 2 = INFO;"
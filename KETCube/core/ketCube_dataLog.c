@@ -0,0 +1,448 @@
+/**
+ * @file    ketCube_dataLog.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube local data logger
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "ketCube_dataLog.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_eeprom.h"
+#include "ketCube_timeSync.h"
+
+#define KETCUBE_DATALOG_BLOCK_ADDR(block) (KETCUBE_DATALOG_EEPROM_ADDR + ((uint32_t) (block)) * KETCUBE_DATALOG_BLOCK_LEN)
+
+static uint8_t head = 0;                   ///< Block receiving new entries
+static uint32_t headSeq = 0;               ///< Sequence number of the head block; 0 = log empty
+static uint8_t headOffset = 0;             ///< Next entry offset in the head block
+static uint32_t lastTime = 0;              ///< Log clock of the newest entry
+static uint32_t nextSeq = 1;               ///< Sequence number of the next block
+static uint32_t timeBase = 0;              ///< Log clock offset to the RTC
+static ketCube_tsCodec_t codec;            ///< Codec state of the head block
+
+/**
+ * @brief Read block sequence number
+ */
+static uint32_t ketCube_dataLog_ReadSeq(uint8_t block)
+{
+    uint32_t seq;
+
+    ketCube_EEPROM_ReadBuffer(KETCUBE_DATALOG_BLOCK_ADDR(block),
+                              (uint8_t *) &seq, sizeof(seq));
+
+    return seq;
+}
+
+/**
+ * @brief Set block sequence number
+ */
+static ketCube_cfg_ModError_t ketCube_dataLog_WriteSeq(uint8_t block,
+                                                       uint32_t seq)
+{
+    if (ketCube_EEPROM_WriteBuffer(KETCUBE_DATALOG_BLOCK_ADDR(block) +
+                                   offsetof(ketCube_dataLog_block_t, seq),
+                                   (uint8_t *) &seq, sizeof(seq)) != KETCUBE_EEPROM_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Position cursor at the block start
+ */
+static void ketCube_dataLog_CursorAt(ketCube_dataLog_cursor_t * cur,
+                                     uint8_t block, uint32_t seq,
+                                     uint32_t t0)
+{
+    cur->block = block;
+    cur->seq = seq;
+    cur->offset = 0;
+    cur->time = t0;
+    ketCube_tsCodec_Init(&(cur->codec), &(ketCube_coreCfg.logFields[0]),
+                         KETCUBE_DATALOG_MAX_FIELDS);
+}
+
+/**
+ * @brief Recover log state from EEPROM
+ *
+ * The head block entries are decoded to restore the codec state, so new
+ * entries continue the head block.
+ */
+void ketCube_dataLog_Init(void)
+{
+    ketCube_dataLog_cursor_t cur;
+    uint8_t record[KETCUBE_DATALOG_MAX_RECORD_LEN];
+    uint32_t seq, t0;
+    uint8_t len;
+    uint8_t i;
+
+    headSeq = 0;
+    for (i = 0; i < KETCUBE_DATALOG_BLOCKS; i++) {
+        seq = ketCube_dataLog_ReadSeq(i);
+        if (seq == 0) {
+            continue;
+        }
+        if ((headSeq == 0) || ((int32_t) (seq - headSeq) > 0)) {
+            headSeq = seq;
+            head = i;
+        }
+    }
+
+    if (headSeq == 0) {
+        head = KETCUBE_DATALOG_BLOCKS - 1;
+        lastTime = 0;
+        timeBase = 0;
+        return;
+    }
+
+    nextSeq = headSeq + 1;
+    if (nextSeq == 0) {
+        nextSeq = 1;
+    }
+
+    ketCube_EEPROM_ReadBuffer(KETCUBE_DATALOG_BLOCK_ADDR(head) +
+                              offsetof(ketCube_dataLog_block_t, t0),
+                              (uint8_t *) &t0, sizeof(t0));
+    ketCube_dataLog_CursorAt(&cur, head, headSeq, t0);
+    while (ketCube_dataLog_Read(&cur, &(record[0]), &len, &lastTime) == KETCUBE_CFG_MODULE_OK) {
+    }
+
+    headOffset = cur.offset;
+    codec = cur.codec;
+    lastTime = cur.time;
+    timeBase = lastTime - ketCube_timeSync_Now();
+}
+
+/**
+ * @brief Get log clock
+ *
+ * @retval seconds
+ */
+uint32_t ketCube_dataLog_Now(void)
+{
+    return ketCube_timeSync_Now() + timeBase;
+}
+
+/**
+ * @brief Start a new block; the oldest block is overwritten
+ *
+ * @param t0 log clock of the first entry
+ */
+static ketCube_cfg_ModError_t ketCube_dataLog_Open(uint32_t t0)
+{
+    ketCube_dataLog_block_t block;
+    uint8_t next = (head + 1) % KETCUBE_DATALOG_BLOCKS;
+
+    memset(&block, 0, sizeof(block));
+    block.t0 = t0;
+
+    /* invalidate, clear entries, then validate */
+    if ((ketCube_dataLog_WriteSeq(next, 0) != KETCUBE_CFG_MODULE_OK)
+        || (ketCube_EEPROM_WriteBuffer(KETCUBE_DATALOG_BLOCK_ADDR(next) +
+                                       offsetof(ketCube_dataLog_block_t, t0),
+                                       ((uint8_t *) &block) + offsetof(ketCube_dataLog_block_t, t0),
+                                       KETCUBE_DATALOG_BLOCK_LEN - offsetof(ketCube_dataLog_block_t, t0)) != KETCUBE_EEPROM_OK)
+        || (ketCube_dataLog_WriteSeq(next, nextSeq) != KETCUBE_CFG_MODULE_OK)) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    head = next;
+    headSeq = nextSeq;
+    headOffset = 0;
+    lastTime = t0;
+    ketCube_tsCodec_Init(&codec, &(ketCube_coreCfg.logFields[0]),
+                         KETCUBE_DATALOG_MAX_FIELDS);
+
+    nextSeq++;
+    if (nextSeq == 0) {
+        nextSeq = 1;
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Build entry at the head block offset
+ *
+ * @retval entry length; 0 if the entry does not fit into the head block
+ */
+static uint8_t ketCube_dataLog_Entry(const uint8_t * record, uint8_t len,
+                                     uint32_t dt, uint8_t * entry)
+{
+    uint8_t space = KETCUBE_DATALOG_DATA_LEN - headOffset;
+    uint8_t n, m;
+
+    if (space <= KETCUBE_DATALOG_ENTRY_HEADER_LEN) {
+        return 0;
+    }
+
+    n = ketCube_tsCodec_PutVarint(&(entry[KETCUBE_DATALOG_ENTRY_HEADER_LEN]),
+                                  space - KETCUBE_DATALOG_ENTRY_HEADER_LEN, dt);
+    if (n == 0) {
+        return 0;
+    }
+    n += KETCUBE_DATALOG_ENTRY_HEADER_LEN;
+
+    m = ketCube_tsCodec_Encode(&codec, record, len, &(entry[n]), space - n);
+    if (m == 0) {
+        return 0;
+    }
+
+    entry[0] = n + m;
+    entry[1] = len;
+
+    return n + m;
+}
+
+/**
+ * @brief Append record
+ *
+ * @param record record
+ * @param len record length; max. KETCUBE_DATALOG_MAX_RECORD_LEN
+ *
+ * @retval KETCUBE_CFG_MODULE_OK if the record is stored
+ */
+ketCube_cfg_ModError_t ketCube_dataLog_Append(const uint8_t * record,
+                                              uint8_t len)
+{
+    uint8_t entry[KETCUBE_DATALOG_DATA_LEN];
+    uint32_t now = ketCube_dataLog_Now();
+    uint8_t n = 0;
+
+    if ((len == 0) || (len > KETCUBE_DATALOG_MAX_RECORD_LEN)) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    if ((int32_t) (now - lastTime) < 0) {
+        now = lastTime;
+    }
+
+    if (headSeq != 0) {
+        n = ketCube_dataLog_Entry(record, len, now - lastTime, &(entry[0]));
+    }
+
+    if (n == 0) {
+        if (ketCube_dataLog_Open(now) != KETCUBE_CFG_MODULE_OK) {
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+        n = ketCube_dataLog_Entry(record, len, 0, &(entry[0]));
+        if (n == 0) {
+            /* does not fit even into an empty block */
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+    }
+
+    /* content first, entry length commits the entry */
+    if ((ketCube_EEPROM_WriteBuffer(KETCUBE_DATALOG_BLOCK_ADDR(head) +
+                                    offsetof(ketCube_dataLog_block_t, data) + headOffset + 1,
+                                    &(entry[1]), n - 1) != KETCUBE_EEPROM_OK)
+        || (ketCube_EEPROM_WriteBuffer(KETCUBE_DATALOG_BLOCK_ADDR(head) +
+                                       offsetof(ketCube_dataLog_block_t, data) + headOffset,
+                                       &(entry[0]), 1) != KETCUBE_EEPROM_OK)) {
+        /* the codec state is ahead of the stored entries */
+        headOffset = KETCUBE_DATALOG_DATA_LEN;
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    headOffset += n;
+    lastTime = now;
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Remove all records
+ */
+void ketCube_dataLog_Clear(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < KETCUBE_DATALOG_BLOCKS; i++) {
+        if (ketCube_dataLog_ReadSeq(i) != 0) {
+            ketCube_dataLog_WriteSeq(i, 0);
+        }
+    }
+
+    headSeq = 0;
+}
+
+/**
+ * @brief Position cursor at the block holding the given time
+ *
+ * The cursor is set to the start of the newest block, which starts before
+ * from; the oldest block is used if there is no such block.
+ *
+ * @param cur cursor
+ * @param from log clock
+ */
+void ketCube_dataLog_Seek(ketCube_dataLog_cursor_t * cur, uint32_t from)
+{
+    ketCube_dataLog_block_t hdr;
+    bool found = FALSE;
+    uint8_t block;
+    uint8_t i;
+
+    cur->seq = 0;
+    if (headSeq == 0) {
+        return;
+    }
+
+    /* valid blocks precede the head block */
+    for (i = 1; i <= KETCUBE_DATALOG_BLOCKS; i++) {
+        block = (head + i) % KETCUBE_DATALOG_BLOCKS;
+        ketCube_EEPROM_ReadBuffer(KETCUBE_DATALOG_BLOCK_ADDR(block),
+                                  (uint8_t *) &hdr,
+                                  KETCUBE_DATALOG_HEADER_LEN);
+        if ((hdr.seq == 0)
+            || ((uint32_t) (headSeq - hdr.seq) >= KETCUBE_DATALOG_BLOCKS)) {
+            continue;
+        }
+        /* records of the preceding blocks are not newer than t0 */
+        if ((found == FALSE) || (hdr.t0 < from)) {
+            ketCube_dataLog_CursorAt(cur, block, hdr.seq, hdr.t0);
+            found = TRUE;
+        }
+    }
+}
+
+/**
+ * @brief Read the next record
+ *
+ * If the cursor block has been overwritten meanwhile, the cursor skips to
+ * the oldest block.
+ *
+ * @param cur cursor
+ * @param record record; KETCUBE_DATALOG_MAX_RECORD_LEN bytes
+ * @param len record length
+ * @param time log clock of the record
+ *
+ * @retval KETCUBE_CFG_MODULE_ERROR if there are no more records
+ */
+ketCube_cfg_ModError_t ketCube_dataLog_Read(ketCube_dataLog_cursor_t * cur,
+                                            uint8_t * record,
+                                            uint8_t * len,
+                                            uint32_t * time)
+{
+    ketCube_dataLog_block_t block;
+    uint32_t dt;
+    uint32_t seq;
+    uint8_t entryLen;
+    uint8_t n, m;
+
+    while (cur->seq != 0) {
+        ketCube_EEPROM_ReadBuffer(KETCUBE_DATALOG_BLOCK_ADDR(cur->block),
+                                  (uint8_t *) &block,
+                                  KETCUBE_DATALOG_BLOCK_LEN);
+        if (block.seq != cur->seq) {
+            ketCube_dataLog_Seek(cur, 0);
+            continue;
+        }
+
+        if (cur->offset < KETCUBE_DATALOG_DATA_LEN) {
+            entryLen = block.data[cur->offset];
+            if ((entryLen > KETCUBE_DATALOG_ENTRY_HEADER_LEN)
+                && (entryLen <= (KETCUBE_DATALOG_DATA_LEN - cur->offset))
+                && (block.data[cur->offset + 1] <= KETCUBE_DATALOG_MAX_RECORD_LEN)) {
+                n = ketCube_tsCodec_GetVarint(&(block.data[cur->offset + KETCUBE_DATALOG_ENTRY_HEADER_LEN]),
+                                              entryLen - KETCUBE_DATALOG_ENTRY_HEADER_LEN,
+                                              &dt);
+                m = 0;
+                if (n > 0) {
+                    n += KETCUBE_DATALOG_ENTRY_HEADER_LEN;
+                    m = ketCube_tsCodec_Decode(&(cur->codec),
+                                               &(block.data[cur->offset + n]),
+                                               entryLen - n, record,
+                                               block.data[cur->offset + 1]);
+                }
+                if (m > 0) {
+                    *len = block.data[cur->offset + 1];
+                    cur->offset += entryLen;
+                    cur->time += dt;
+                    *time = cur->time;
+                    return KETCUBE_CFG_MODULE_OK;
+                }
+            }
+        }
+
+        /* end of block -- the head block may grow later */
+        if (cur->seq == headSeq) {
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+
+        seq = cur->seq + 1;
+        if (seq == 0) {
+            seq = 1;
+        }
+        ketCube_EEPROM_ReadBuffer(KETCUBE_DATALOG_BLOCK_ADDR((cur->block + 1) % KETCUBE_DATALOG_BLOCKS),
+                                  (uint8_t *) &block,
+                                  KETCUBE_DATALOG_HEADER_LEN);
+        if (block.seq != seq) {
+            ketCube_dataLog_Seek(cur, 0);
+            continue;
+        }
+        ketCube_dataLog_CursorAt(cur, (cur->block + 1) % KETCUBE_DATALOG_BLOCKS,
+                                 block.seq, block.t0);
+    }
+
+    return KETCUBE_CFG_MODULE_ERROR;
+}
+
+/**
+ * @brief Get # of stored records
+ */
+uint16_t ketCube_dataLog_Count(void)
+{
+    ketCube_dataLog_cursor_t cur;
+    uint8_t record[KETCUBE_DATALOG_MAX_RECORD_LEN];
+    uint32_t time;
+    uint16_t cnt = 0;
+    uint8_t len;
+
+    ketCube_dataLog_Seek(&cur, 0);
+    while (ketCube_dataLog_Read(&cur, &(record[0]), &len, &time) == KETCUBE_CFG_MODULE_OK) {
+        cnt++;
+    }
+
+    return cnt;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file    ketCube_dataLog.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube local data logger
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_DATALOG_H
+#define __KETCUBE_DATALOG_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+#include "ketCube_tsCodec.h"
+
+/** @defgroup KETCube_dataLog KETCube data logger
+  * @brief Circular log of compressed, timestamped sensor records in the data EEPROM
+  *
+  * The log follows the store-and-forward queue in the data EEPROM and is
+  * split into blocks, which are filled in a ring; the oldest block is
+  * overwritten when the log is full, so all blocks wear evenly. Each block starts with a sequence
+  * number and the time of its first record; the block holding the highest
+  * sequence number is found by scanning the blocks in ketCube_dataLog_Init().
+  *
+  * Block entry: entry length, record length, time since the previous entry
+  * in seconds (varint) and the record compressed by @ref KETCube_tsCodec
+  * (field descriptors: core logFields). The codec is reset at each block
+  * start, so blocks decode independently. The entry length is written last,
+  * thus an entry interrupted by reset is ignored.
+  *
+  * Timestamps are taken from a log clock, which continues from the newest
+  * entry after reset (the RTC calendar restarts on reset); it runs at the
+  * drift-corrected rate of @ref KETCube_timeSync.
+  *
+  * @note Clear the log after changing logFields; stored records are decoded
+  *       by the current field descriptors.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_DATALOG_EEPROM_ADDR    0x1000     ///< Log base (data EEPROM offset); follows the store-and-forward queue
+#define KETCUBE_DATALOG_EEPROM_LEN     0x0800     ///< Log length in bytes
+#define KETCUBE_DATALOG_BLOCK_LEN      64         ///< Block length in bytes
+#define KETCUBE_DATALOG_HEADER_LEN     8          ///< Block header length in bytes
+#define KETCUBE_DATALOG_DATA_LEN       (KETCUBE_DATALOG_BLOCK_LEN - KETCUBE_DATALOG_HEADER_LEN) ///< Block space for entries
+#define KETCUBE_DATALOG_BLOCKS         (KETCUBE_DATALOG_EEPROM_LEN / KETCUBE_DATALOG_BLOCK_LEN) ///< # of blocks
+#define KETCUBE_DATALOG_ENTRY_HEADER_LEN 2        ///< Entry header: entry length, record length
+#define KETCUBE_DATALOG_MAX_RECORD_LEN 64         ///< Max. record length
+#define KETCUBE_DATALOG_MAX_FIELDS     KETCUBE_TSCODEC_MAX_FIELDS ///< Maximum # of logged record field descriptors
+
+/**
+* @brief Log block header; the EEPROM block layout
+*/
+typedef struct {
+    uint32_t seq;                              ///< Sequence number; 0 = block never written
+    uint32_t t0;                               ///< Log clock of the first entry
+    uint8_t data[KETCUBE_DATALOG_DATA_LEN];    ///< Entries; zero-length entry terminates the block
+} ketCube_dataLog_block_t;
+
+/**
+* @brief Log read cursor
+*/
+typedef struct {
+    uint32_t seq;                 ///< Sequence number of the current block
+    uint32_t time;                ///< Log clock of the last entry read
+    uint8_t block;                ///< Current block
+    uint8_t offset;               ///< Next entry offset in the current block
+    ketCube_tsCodec_t codec;      ///< Codec state of the current block
+} ketCube_dataLog_cursor_t;
+
+/** @defgroup KETCube_dataLog_fn Public Functions
+* @{
+*/
+
+extern void ketCube_dataLog_Init(void);
+extern uint32_t ketCube_dataLog_Now(void);
+extern ketCube_cfg_ModError_t ketCube_dataLog_Append(const uint8_t * record,
+                                                     uint8_t len);
+extern void ketCube_dataLog_Clear(void);
+extern uint16_t ketCube_dataLog_Count(void);
+extern void ketCube_dataLog_Seek(ketCube_dataLog_cursor_t * cur,
+                                 uint32_t from);
+extern ketCube_cfg_ModError_t ketCube_dataLog_Read(ketCube_dataLog_cursor_t * cur,
+                                                   uint8_t * record,
+                                                   uint8_t * len,
+                                                   uint32_t * time);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_DATALOG_H */
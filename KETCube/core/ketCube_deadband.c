@@ -0,0 +1,207 @@
+/**
+ * @file    ketCube_deadband.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube report-by-exception (deadband) service
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "ketCube_deadband.h"
+#include "ketCube_modules.h"
+#include "ketCube_rtc.h"
+
+static ketCube_deadband_field_t * declared[ketCube_modules_CNT];  ///< Module deadbands; NULL if not declared
+static uint8_t declaredCnt[ketCube_modules_CNT];                  ///< # of declared fields
+static bool declaredValid[ketCube_modules_CNT];                   ///< Last reported values are valid
+
+static bool reported = FALSE;           ///< Any report since reset
+static uint32_t lastReport = 0;         ///< RTC time of the last report
+
+/**
+ * @brief Get record length covered by field declarations
+ */
+static uint8_t ketCube_deadband_Len(ketCube_cfg_moduleIDs_t modId)
+{
+    uint8_t i;
+    uint8_t len = 0;
+
+    for (i = 0; i < declaredCnt[modId]; i++) {
+        len += declared[modId][i].field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Declare module field deadbands
+ *
+ * @param modId module ID
+ * @param fields field deadbands; the array must persist (static)
+ * @param fieldCnt # of fields
+ */
+void ketCube_deadband_Declare(ketCube_cfg_moduleIDs_t modId,
+                              ketCube_deadband_field_t * fields,
+                              uint8_t fieldCnt)
+{
+    if (modId >= ketCube_modules_CNT) {
+        return;
+    }
+
+    declared[modId] = fields;
+    declaredCnt[modId] = fieldCnt;
+    declaredValid[modId] = FALSE;
+}
+
+/**
+ * @brief Get module field deadbands
+ *
+ * @param modId module ID
+ * @param fieldCnt # of fields
+ *
+ * @retval field deadbands; NULL if not declared
+ */
+ketCube_deadband_field_t * ketCube_deadband_GetFields(ketCube_cfg_moduleIDs_t modId,
+                                                      uint8_t * fieldCnt)
+{
+    if (modId >= ketCube_modules_CNT) {
+        *fieldCnt = 0;
+        return NULL;
+    }
+
+    *fieldCnt = declaredCnt[modId];
+    return declared[modId];
+}
+
+/**
+ * @brief Check whether module data moved beyond the deadband
+ *
+ * @param modId module ID
+ * @param data module record
+ * @param len module record length
+ *
+ * @retval TRUE if data should be reported
+ */
+bool ketCube_deadband_Changed(ketCube_cfg_moduleIDs_t modId,
+                              const uint8_t * data, uint8_t len)
+{
+    ketCube_deadband_field_t * f;
+    uint32_t diff, mag;
+    int32_t value;
+    uint8_t i;
+    uint8_t pos = 0;
+
+    if ((modId >= ketCube_modules_CNT) || (declared[modId] == NULL)
+        || (declaredValid[modId] == FALSE)
+        || (len < ketCube_deadband_Len(modId))) {
+        return TRUE;
+    }
+
+    for (i = 0; i < declaredCnt[modId]; i++) {
+        f = &(declared[modId][i]);
+        value = ketCube_tsCodec_GetField(&(data[pos]), f->field);
+        pos += f->field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+
+        diff = (value > f->last) ? ((uint32_t) value - (uint32_t) f->last)
+                                 : ((uint32_t) f->last - (uint32_t) value);
+        /* effective deadband is the larger of absolute and relative one */
+        if (diff <= f->absolute) {
+            continue;
+        }
+
+        mag = (f->last < 0) ? (0 - (uint32_t) f->last) : (uint32_t) f->last;
+        if (((uint64_t) diff * 1000) > ((uint64_t) mag * f->relative)) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * @brief Store reported module data as the deadband reference
+ *
+ * @param modId module ID
+ * @param data module record
+ * @param len module record length
+ */
+void ketCube_deadband_Commit(ketCube_cfg_moduleIDs_t modId,
+                             const uint8_t * data, uint8_t len)
+{
+    ketCube_deadband_field_t * f;
+    uint8_t i;
+    uint8_t pos = 0;
+
+    if ((modId >= ketCube_modules_CNT) || (declared[modId] == NULL)
+        || (len < ketCube_deadband_Len(modId))) {
+        return;
+    }
+
+    for (i = 0; i < declaredCnt[modId]; i++) {
+        f = &(declared[modId][i]);
+        f->last = ketCube_tsCodec_GetField(&(data[pos]), f->field);
+        pos += f->field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+    }
+
+    declaredValid[modId] = TRUE;
+}
+
+/**
+ * @brief Check heartbeat
+ *
+ * @param heartbeat max. silence in seconds
+ *
+ * @retval TRUE if there was no report for heartbeat seconds
+ */
+bool ketCube_deadband_HeartbeatDue(uint32_t heartbeat)
+{
+    if (reported == FALSE) {
+        return TRUE;
+    }
+
+    return ((ketCube_RTC_GetSysTime() - lastReport) >= heartbeat);
+}
+
+/**
+ * @brief Restart heartbeat
+ */
+void ketCube_deadband_Reported(void)
+{
+    reported = TRUE;
+    lastReport = ketCube_RTC_GetSysTime();
+}
@@ -0,0 +1,109 @@
+/**
+ * @file    ketCube_deadband.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube report-by-exception (deadband) service
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_DEADBAND_H
+#define __KETCUBE_DEADBAND_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+#include "ketCube_tsCodec.h"
+
+/** @defgroup KETCube_deadband KETCube deadband
+  * @brief Report-by-exception: suppress unchanged periodic data
+  *
+  * Modules declare deadbands for the fields of their SensorBuffer record
+  * by ketCube_deadband_Declare() in Init(). When the core heartbeat
+  * (ketCube_coreCfg_t::reportHeartbeat) is set, the core calls module
+  * SendData() functions only if a field of a declared module moved beyond
+  * its deadband, a module without declaration produced data, or the
+  * heartbeat expired. The decision is made after all GetSensorData() calls
+  * and before any SendData() call, so the radio is not woken up in
+  * suppressed periods.
+  *
+  * Deadbands are evaluated against the last reported value, thus a slow
+  * drift is reported once it accumulates beyond the deadband.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+/**
+* @brief Field deadband
+*/
+typedef struct {
+    uint8_t field;          ///< Field descriptor: width and sign, see @ref KETCube_tsCodec (codec bits are ignored)
+    uint16_t absolute;      ///< Absolute deadband in field units
+    uint16_t relative;      ///< Relative deadband in 0.1 % of the last reported value; the larger deadband applies, any change is reported if both are 0
+    int32_t last;           ///< Last reported value; managed by the core
+    int32_t prev;           ///< Last sampled value; managed by the core, see @ref KETCube_adaptive
+    float rate;             ///< EWMA of the rate of change per second; managed by the core
+    float rateVar;          ///< EWMA of the rate of change variance; managed by the core
+} ketCube_deadband_field_t;
+
+/** @defgroup KETCube_deadband_fn Public Functions
+* @{
+*/
+
+extern void ketCube_deadband_Declare(ketCube_cfg_moduleIDs_t modId,
+                                     ketCube_deadband_field_t * fields,
+                                     uint8_t fieldCnt);
+extern ketCube_deadband_field_t * ketCube_deadband_GetFields(ketCube_cfg_moduleIDs_t modId,
+                                                             uint8_t * fieldCnt);
+extern bool ketCube_deadband_Changed(ketCube_cfg_moduleIDs_t modId,
+                                     const uint8_t * data, uint8_t len);
+extern void ketCube_deadband_Commit(ketCube_cfg_moduleIDs_t modId,
+                                    const uint8_t * data, uint8_t len);
+extern bool ketCube_deadband_HeartbeatDue(uint32_t heartbeat);
+extern void ketCube_deadband_Reported(void);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_DEADBAND_H */
@@ -42,12 +42,21 @@
  * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
  */
 
+#include <stddef.h>
+
 #include "ketCube_cfg.h"
+#include "ketCube_coreCfg.h"
 #include "ketCube_eeprom.h"
 #include "ketCube_common.h"
 #include "ketCube_modules.h"
 #include "ketCube_terminal.h"
 #include "ketCube_resetMan.h"
+#include "ketCube_deadband.h"
+#include "ketCube_adaptive.h"
+#include "ketCube_oversample.h"
+#include "ketCube_dataLog.h"
+#include "ketCube_timeSync.h"
+#include "timeServer.h"
 
 // List of KETCube modules
 #include "../../Projects/src/ketCube_moduleList.c"      // include a project-specific file
@@ -57,6 +66,142 @@ uint8_t SensorBufferSize = 0;                           ///< Sensor data buffer
 
 ketCube_InterModMsg_t **InterModMsgBuffer[ketCube_modules_CNT]; ///< Intra module message pointers; mesasages are stored and managed local-to modules
 
+static uint32_t periodRequest[ketCube_modules_CNT];     ///< Base period requested by modules; 0 if none
+static volatile bool periodRequested = FALSE;           ///< Out-of-period execution requested by a module
+static uint8_t periodScale = 1;                         ///< Base period multiplier
+static uint32_t suspended = 0;                          ///< Modules with suspended periodic functions; bit N = module ID N
+
+static uint16_t modOffset[ketCube_modules_CNT];         ///< Module record offsets in SensorBuffer
+static uint8_t modLen[ketCube_modules_CNT];             ///< Module record lengths; 0 if no data
+static bool modSampled[ketCube_modules_CNT];            ///< GetSensorData() executed in this period
+static bool modFailed[ketCube_modules_CNT];             ///< GetSensorData() failed in this period
+static uint8_t retryLeft[ketCube_modules_CNT];          ///< Remaining GetSensorData() retries in this period
+static bool periodOpen = FALSE;                         ///< Records of this period not reported yet
+static TimerTime_t periodStart = 0;                     ///< Start of the sensor data acquisition in this period
+static TimerEvent_t retryTimer;                         ///< Retry of failed modules
+static volatile bool retryDue = FALSE;                  ///< Retry of failed modules pending
+static bool subPeriodic = FALSE;                        ///< Sub-period sampling in progress
+
+/**
+ * @brief Retry timer callback
+ */
+static void ketCube_modules_RetryTick(void *context)
+{
+    retryDue = TRUE;
+    KETCube_eventsProcessed = FALSE; /* Possible pending events */
+}
+
+/**
+ * @brief Module configurations in the layout preceding KETCUBE_CORECFG_LAYOUT
+ *
+ * len is the stored length (sizeof the legacy configuration), keep is the
+ * number of leading bytes whose meaning did not change. Modules not listed
+ * here kept their configuration. Core: the legacy volatile data overlap the
+ * new fields, only the fields preceding them are kept.
+ */
+static const struct {
+    ketCube_moduleID_t id;
+    uint8_t len;
+    uint8_t keep;
+} ketCube_modules_LegacyCfg[] = {
+    {KETCUBE_MODULEID_CORE_API,  132, 20},
+    {KETCUBE_MODULEID_LORA,      124, 124},
+    {KETCUBE_MODULEID_BMEX80,    1,   1},
+    {KETCUBE_MODULEID_LIS2HH12,  1,   1},
+    {KETCUBE_MODULEID_ICS43432,  1,   1},
+    {KETCUBE_MODULEID_PULSECNT,  0,   0},
+};
+
+/**
+ * @brief Get the legacy configuration of the module
+ * @param i module index in ketCube_modules_List
+ * @param len legacy stored length
+ * @param keep legacy bytes to keep
+ */
+static void ketCube_modules_LegacyCfgLen(uint8_t i, uint8_t *len, uint8_t *keep)
+{
+    uint8_t j;
+
+    for (j = 0; j < (sizeof(ketCube_modules_LegacyCfg) / sizeof(ketCube_modules_LegacyCfg[0])); j++) {
+        if (ketCube_modules_LegacyCfg[j].id == ketCube_modules_List[i].id) {
+            *len = ketCube_modules_LegacyCfg[j].len;
+            *keep = ketCube_modules_LegacyCfg[j].keep;
+            return;
+        }
+    }
+
+    *len = ketCube_modules_List[i].cfgLen;
+    *keep = ketCube_modules_List[i].cfgLen;
+}
+
+/**
+ * @brief Move module configurations stored in the legacy layout to the current offsets
+ *
+ * The configurations only grew, so the modules are moved from the last one;
+ * the bytes not kept are cleared (module defaults).
+ *
+ * @retval KETCUBE_CFG_OK in case of success
+ * @retval ketCube_CFG_ERROR in case of failure
+ */
+ketCube_cfg_Error_t ketCube_modules_MigrateCfg(void)
+{
+    uint8_t buffer[16];
+    uint16_t layout;
+    uint16_t oldAddr = KETCUBE_EEPROM_ALLOC_MODULES;
+    uint16_t newAddr = KETCUBE_EEPROM_ALLOC_MODULES;
+    uint8_t oldLen, keep, len, chunk;
+    uint8_t i;
+
+    if (ketCube_EEPROM_ReadBuffer(KETCUBE_EEPROM_ALLOC_MODULES + offsetof(ketCube_coreCfg_t, cfgLayout),
+                                  (uint8_t *) &layout, sizeof(layout)) != KETCUBE_EEPROM_OK) {
+        return KETCUBE_CFG_ERROR;
+    }
+    if (layout == KETCUBE_CORECFG_LAYOUT) {
+        return KETCUBE_CFG_OK;
+    }
+
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        ketCube_modules_LegacyCfgLen(i, &oldLen, &keep);
+        oldAddr += oldLen;
+        newAddr += ketCube_modules_List[i].cfgLen;
+    }
+
+    i = ketCube_modules_CNT;
+    while (i-- > 0) {
+        ketCube_modules_LegacyCfgLen(i, &oldLen, &keep);
+        oldAddr -= oldLen;
+        newAddr -= ketCube_modules_List[i].cfgLen;
+
+        if (oldAddr != newAddr) {
+            // the destination is never below the source: copy from the end
+            len = keep;
+            while (len > 0) {
+                chunk = (len < sizeof(buffer)) ? len : sizeof(buffer);
+                len -= chunk;
+                if ((ketCube_EEPROM_ReadBuffer(oldAddr + len, &(buffer[0]), chunk) != KETCUBE_EEPROM_OK)
+                    || (ketCube_EEPROM_WriteBuffer(newAddr + len, &(buffer[0]), chunk) != KETCUBE_EEPROM_OK)) {
+                    return KETCUBE_CFG_ERROR;
+                }
+            }
+        }
+
+        if ((keep < ketCube_modules_List[i].cfgLen)
+            && (ketCube_EEPROM_Erase(newAddr + keep, ketCube_modules_List[i].cfgLen - keep) != KETCUBE_EEPROM_OK)) {
+            return KETCUBE_CFG_ERROR;
+        }
+    }
+
+    layout = KETCUBE_CORECFG_LAYOUT;
+    if (ketCube_EEPROM_WriteBuffer(KETCUBE_EEPROM_ALLOC_MODULES + offsetof(ketCube_coreCfg_t, cfgLayout),
+                                   (uint8_t *) &layout, sizeof(layout)) != KETCUBE_EEPROM_OK) {
+        return KETCUBE_CFG_ERROR;
+    }
+
+    ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO, "Configuration migrated to layout 0x%04X", KETCUBE_CORECFG_LAYOUT);
+
+    return KETCUBE_CFG_OK;
+}
+
 /**
  * @brief Load basic module configuration data from EEPROM and execute periodic functions for enabled modules
  * @retval KETCUBE_CFG_OK in case of success
@@ -67,6 +212,11 @@ ketCube_cfg_Error_t ketCube_modules_Init(void)
     uint8_t i;
     uint16_t addr = KETCUBE_EEPROM_ALLOC_MODULES;
 
+    // move configurations stored by older firmware to the current offsets
+    if (ketCube_modules_MigrateCfg() != KETCUBE_CFG_OK) {
+        return KETCUBE_CFG_ERROR;
+    }
+
     for (i = 0; i < ketCube_modules_CNT; i++) {
         ketCube_modules_List[i].EEpromBase = (ketCube_cfg_AllocEEPROM_t) addr;
         
@@ -89,6 +239,9 @@ ketCube_cfg_Error_t ketCube_modules_Init(void)
     // Always enable KETCube core
     ketCube_modules_List[KETCUBE_LISTS_ID_CORE].cfgPtr->enable = TRUE;
 
+    // Record timestamps are used by modules since Init()
+    ketCube_timeSync_Init();
+
     // Run module init functions
     for (i = 0; i < ketCube_modules_CNT; i++) {
         if ((ketCube_modules_List[i].cfgPtr->enable & 0x01) == TRUE) {
@@ -111,6 +264,10 @@ ketCube_cfg_Error_t ketCube_modules_Init(void)
         }
     }
     
+    ketCube_oversample_Init();
+    ketCube_dataLog_Init();
+    TimerInit(&retryTimer, &ketCube_modules_RetryTick);
+
     /* reset remote terminal counter in RAM on init */
     ketCube_coreCfg.remoteTerminalCounter = 0;
 
@@ -119,64 +276,312 @@ ketCube_cfg_Error_t ketCube_modules_Init(void)
 }
 
 
+/**
+ * @brief Check whether module periodic functions are executed
+ *
+ * @param modId module ID
+ *
+ * @retval TRUE if module is enabled and not suspended
+ */
+static bool ketCube_modules_Active(uint8_t modId)
+{
+    if ((ketCube_modules_List[modId].cfgPtr->enable & 0x01) != TRUE) {
+        return FALSE;
+    }
+
+    return ((modId >= 32) || ((suspended & (1UL << modId)) == 0));
+}
+
+/**
+ * @brief Decide whether the sensor data of this period are reported
+ * 
+ * @retval TRUE if SendData() functions should be executed
+ */
+static bool ketCube_modules_Report(void)
+{
+    uint8_t i;
+    bool report;
+    
+    if (ketCube_coreCfg.reportHeartbeat == 0) {
+        return TRUE;
+    }
+    
+    report = ketCube_deadband_HeartbeatDue(ketCube_coreCfg.reportHeartbeat);
+    
+    for (i = 0; (i < ketCube_modules_CNT) && (report == FALSE); i++) {
+        if ((modLen[i] > 0)
+            && (ketCube_deadband_Changed((ketCube_cfg_moduleIDs_t) i,
+                                         &(SensorBuffer[modOffset[i]]),
+                                         modLen[i]) == TRUE)) {
+            ketCube_terminal_CoreSeverityPrintln
+                (KETCUBE_CFG_SEVERITY_DEBUG,
+                 "Module \"%s\" data out of deadband",
+                 ketCube_modules_List[i].name);
+            report = TRUE;
+        }
+    }
+    
+    return report;
+}
+
+/**
+ * @brief Reverse bytes in place
+ */
+static void ketCube_modules_Reverse(uint8_t * buffer, uint16_t len)
+{
+    uint8_t tmp;
+    uint16_t i;
+    
+    for (i = 0; i < (len / 2); i++) {
+        tmp = buffer[i];
+        buffer[i] = buffer[len - 1 - i];
+        buffer[len - 1 - i] = tmp;
+    }
+}
+
+/**
+ * @brief Swap two adjacent byte blocks in place
+ * 
+ * @param buffer first block, followed by the second one
+ * @param firstLen first block length
+ * @param secondLen second block length
+ */
+static void ketCube_modules_Rotate(uint8_t * buffer, uint16_t firstLen, uint16_t secondLen)
+{
+    if ((firstLen == 0) || (secondLen == 0)) {
+        return;
+    }
+    
+    ketCube_modules_Reverse(buffer, firstLen);
+    ketCube_modules_Reverse(&(buffer[firstLen]), secondLen);
+    ketCube_modules_Reverse(buffer, firstLen + secondLen);
+}
+
+/**
+ * @brief Run GetSensorData() of the module
+ * 
+ * Records are kept in SensorBuffer in module order; a record of a retried
+ * module is inserted in front of the records of the following modules.
+ * 
+ * @param modId module ID
+ * 
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_modules_Sample(uint8_t modId)
+{
+    uint8_t * record = &(SensorBuffer[SensorBufferSize]);
+    uint8_t len = 0;
+    uint8_t i;
+    
+    ketCube_terminal_CoreSeverityPrintln
+        (KETCUBE_CFG_SEVERITY_DEBUG,
+         "Module \"%s\" GetSensorData()",
+         ketCube_modules_List[modId].name);
+    
+    if ((ketCube_modules_List[modId].fnGetSensorData) (record, &len) != KETCUBE_CFG_MODULE_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    ketCube_adaptive_Update((ketCube_cfg_moduleIDs_t) modId, record, len);
+    // SensorBufferSize is 8-bit
+    len = ketCube_oversample_Summarize((ketCube_cfg_moduleIDs_t) modId,
+                                       record, len,
+                                       UINT8_MAX - SensorBufferSize);
+    
+    ketCube_modules_Rotate(&(SensorBuffer[modOffset[modId]]),
+                           SensorBufferSize - modOffset[modId], len);
+    for (i = modId + 1; i < ketCube_modules_CNT; i++) {
+        modOffset[i] += len;
+    }
+    modLen[modId] = len;
+    SensorBufferSize += len;
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Append the module status bitmap to SensorBuffer
+ * 
+ * One bit per sampled module in module order, LSB first; the bit is set
+ * if GetSensorData() failed and the module record is missing. Appended
+ * unless ketCube_coreCfg.statusBitmapOff is set, so a decoder can always
+ * parse a partial record.
+ */
+static void ketCube_modules_AppendStatus(void)
+{
+    uint8_t * status = &(SensorBuffer[SensorBufferSize]);
+    uint8_t bit = 0;
+    uint8_t i;
+    
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        if (modSampled[i] == FALSE) {
+            continue;
+        }
+        if ((bit % 8) == 0) {
+            status[bit / 8] = 0;
+        }
+        if (modFailed[i] == TRUE) {
+            status[bit / 8] |= (1 << (bit % 8));
+        }
+        bit++;
+    }
+    
+    if ((SensorBufferSize + ((bit + 7) / 8)) > UINT8_MAX) {
+        ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_ERROR,
+                                             "No space for module status");
+        return;
+    }
+    
+    SensorBufferSize += (bit + 7) / 8;
+}
+
+/**
+ * @brief Finish the base period: log and report the sensor records
+ */
+static void ketCube_modules_Complete(void)
+{
+    uint8_t i;
+    uint8_t sendErrorCnt = 0;
+    ketCube_cfg_ModError_t retval;
+    bool report;
+    
+    TimerStop(&retryTimer);
+    retryDue = FALSE;
+    periodOpen = FALSE;
+    
+    ketCube_adaptive_End();
+    
+    if (ketCube_coreCfg.statusBitmapOff == FALSE) {
+        ketCube_modules_AppendStatus();
+    }
+    
+    // Local log keeps all records, including those not reported
+    if ((ketCube_coreCfg.logEnable == TRUE) && (SensorBufferSize > 0)) {
+        if (ketCube_dataLog_Append(&(SensorBuffer[0]), SensorBufferSize) != KETCUBE_CFG_MODULE_OK) {
+            ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_ERROR,
+                                                 "Unable to log record (%d B)",
+                                                 SensorBufferSize);
+        }
+    }
+    
+    // Report-by-exception: do not touch communication modules when data are within deadbands
+    report = ketCube_modules_Report();
+    if (report == FALSE) {
+        ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO,
+                                             "Data within deadbands; report suppressed");
+    }
+    
+    // Run module communication functions
+    for (i = 0; (i < ketCube_modules_CNT) && (report == TRUE); i++) {
+        if (ketCube_modules_Active(i) == TRUE) {
+            if (ketCube_modules_List[i].fnSendData != NULL) {
+                ketCube_terminal_CoreSeverityPrintln
+                    (KETCUBE_CFG_SEVERITY_DEBUG,
+                     "Module \"%s\" SendData()",
+                     ketCube_modules_List[i].name);
+                
+                retval = (ketCube_modules_List[i].fnSendData) (&(SensorBuffer[0]),
+                                                               &SensorBufferSize);
+                if (retval != KETCUBE_CFG_MODULE_OK) {
+                    sendErrorCnt++;
+                }
+            }
+        }
+    }
+    
+    // Update deadband references when reported
+    if ((report == TRUE) && (sendErrorCnt == 0)) {
+        for (i = 0; i < ketCube_modules_CNT; i++) {
+            if (modLen[i] > 0) {
+                ketCube_deadband_Commit((ketCube_cfg_moduleIDs_t) i,
+                                        &(SensorBuffer[modOffset[i]]),
+                                        modLen[i]);
+            }
+        }
+        ketCube_deadband_Reported();
+    }
+}
+
+/**
+ * @brief Plan retry of the failed modules
+ * 
+ * The retry must finish within the base period; records are reported
+ * without waiting for the next period otherwise.
+ * 
+ * @retval TRUE if the retry is planned
+ * @retval FALSE if there is no time left in this base period
+ */
+static bool ketCube_modules_PlanRetry(void)
+{
+    if ((TimerGetElapsedTime(periodStart) + ketCube_coreCfg.repeatDelay) >= ketCube_modules_GetPeriod()) {
+        return FALSE;
+    }
+    
+    ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO,
+                                         "Module error detected - retry planned after %d ms",
+                                         ketCube_coreCfg.repeatDelay);
+    
+    TimerStop(&retryTimer);
+    TimerSetValue(&retryTimer, ketCube_coreCfg.repeatDelay);
+    TimerStart(&retryTimer);
+    
+    return TRUE;
+}
+
 /**
  * @brief Execute periodic functions for enabled modules
+ * 
+ * If GetSensorData() of a module fails, only the failed modules are
+ * retried (see ketCube_modules_ExecuteRetry()) and the records are
+ * reported once all modules succeeded or run out of retries.
+ * 
  * @retval KETCUBE_CFG_OK in case of success
  * @retval KETCUBE_CFG_ERROR in case of failure
  */
 ketCube_cfg_Error_t ketCube_modules_ExecutePeriodic(void)
 {
-    uint8_t len;
     uint8_t i;
-    ketCube_cfg_ModError_t retval;
+    uint8_t retryCount = (ketCube_coreCfg.retryCount == 0) ? 1 : ketCube_coreCfg.retryCount;
+    bool failed = FALSE;
     
-    /* initialize error indication counters to 0*/
-    ketCube_coreCfg.volatileData.moduleSendErrorCnt = 0;
-    ketCube_coreCfg.volatileData.modulePerErrorCnt = 0;
+    // retries did not finish within the period: report what is available
+    if (periodOpen == TRUE) {
+        ketCube_modules_Complete();
+    }
     
     // remote terminal mode allows silencing sensor modules, and reserves all
     // traffic just for remote terminal
     if (ketCube_coreCfg.remoteTerminalCounter == 0) {
 
         SensorBufferSize = 0;
+        periodStart = TimerGetCurrentTime();
+        ketCube_adaptive_Begin();
+        ketCube_timeSync_Stamp();
 
         // Run module getData functions periodicaly
         for (i = 0; i < ketCube_modules_CNT; i++) {
-            if ((ketCube_modules_List[i].cfgPtr->enable & 0x01) == TRUE) {
+            modOffset[i] = SensorBufferSize;
+            modLen[i] = 0;
+            modSampled[i] = FALSE;
+            modFailed[i] = FALSE;
+            retryLeft[i] = retryCount;
+            if (ketCube_modules_Active(i) == TRUE) {
                 if (ketCube_modules_List[i].fnGetSensorData != NULL) {
-                    ketCube_terminal_CoreSeverityPrintln
-                        (KETCUBE_CFG_SEVERITY_DEBUG,
-                         "Module \"%s\" GetSensorData()",
-                         ketCube_modules_List[i].name);
-
-                    len = 0;
-                    retval = (ketCube_modules_List[i].fnGetSensorData) (&(SensorBuffer[SensorBufferSize]),
-                                                                        &len);
-                    if (retval != KETCUBE_CFG_MODULE_OK) {
-                        ketCube_coreCfg.volatileData.modulePerErrorCnt++;
-                    } else {
-                        SensorBufferSize += len;
+                    modSampled[i] = TRUE;
+                    if (ketCube_modules_Sample(i) != KETCUBE_CFG_MODULE_OK) {
+                        modFailed[i] = TRUE;
+                        failed = TRUE;
                     }
                 }
             }
         }
-
-        // Run module communication functions
-        for (i = 0; i < ketCube_modules_CNT; i++) {
-            if ((ketCube_modules_List[i].cfgPtr->enable & 0x01) == TRUE) {
-                if (ketCube_modules_List[i].fnSendData != NULL) {
-                    ketCube_terminal_CoreSeverityPrintln
-                        (KETCUBE_CFG_SEVERITY_DEBUG,
-                         "Module \"%s\" SendData()",
-                         ketCube_modules_List[i].name);
-
-                    retval = (ketCube_modules_List[i].fnSendData) (&(SensorBuffer[0]),
-                                                                   &SensorBufferSize);
-                    if (retval != KETCUBE_CFG_MODULE_OK) {
-                        ketCube_coreCfg.volatileData.moduleSendErrorCnt++;
-                    }
-                }
-            }
+        
+        if ((failed == TRUE) && (ketCube_coreCfg.repeatDelay != 0)
+            && (ketCube_modules_PlanRetry() == TRUE)) {
+            periodOpen = TRUE;
+        } else {
+            ketCube_modules_Complete();
         }
     }
     else {
@@ -210,6 +615,110 @@ ketCube_cfg_Error_t ketCube_modules_ExecutePeriodic(void)
 }
 
 
+/**
+ * @brief Sample oversampled modules between base periods
+ *
+ * Only GetSensorData() of modules declaring @ref KETCube_oversample fields
+ * is executed, the data are accumulated and summarized in the next base
+ * period.
+ *
+ * @retval KETCUBE_CFG_OK in case of success
+ * @retval KETCUBE_CFG_ERROR in case of failure
+ */
+ketCube_cfg_Error_t ketCube_modules_ExecuteSubPeriodic(void)
+{
+    uint8_t buffer[KETCUBE_MODULES_SUBSAMPLE_BYTES];
+    uint8_t len;
+    uint8_t i;
+
+    if ((ketCube_oversample_Due() == FALSE)
+        || (ketCube_coreCfg.remoteTerminalCounter != 0)) {
+        return KETCUBE_CFG_OK;
+    }
+
+    subPeriodic = TRUE;
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        if ((ketCube_modules_Active(i) == TRUE)
+            && (ketCube_modules_List[i].fnGetSensorData != NULL)
+            && (ketCube_oversample_Declared((ketCube_cfg_moduleIDs_t) i) == TRUE)) {
+            len = 0;
+            if ((ketCube_modules_List[i].fnGetSensorData) (&(buffer[0]), &len) == KETCUBE_CFG_MODULE_OK) {
+                ketCube_oversample_Accumulate((ketCube_cfg_moduleIDs_t) i,
+                                              &(buffer[0]), len);
+            }
+        }
+    }
+    subPeriodic = FALSE;
+
+    return KETCUBE_CFG_OK;
+}
+
+/**
+ * @brief Check whether GetSensorData() is called for a sub-period sample
+ *
+ * Modules should not print measured values in this case: a sub-sample
+ * wakes the MCU from STOP mode and the terminal output would dominate it.
+ *
+ * @retval TRUE during ketCube_modules_ExecuteSubPeriodic()
+ * @retval FALSE otherwise
+ */
+bool ketCube_modules_SubPeriodic(void)
+{
+    return subPeriodic;
+}
+
+
+/**
+ * @brief Check whether the retry of failed modules is pending
+ *
+ * @retval TRUE if ketCube_modules_ExecuteRetry() should be executed
+ * @retval FALSE otherwise
+ */
+bool ketCube_modules_RetryDue(void)
+{
+    return retryDue;
+}
+
+/**
+ * @brief Retry GetSensorData() of modules failed in this base period
+ * 
+ * Each module is retried at most ketCube_coreCfg.retryCount times per
+ * period; the records are reported when no retry is left.
+ *
+ * @retval KETCUBE_CFG_OK in case of success
+ * @retval KETCUBE_CFG_ERROR in case of failure
+ */
+ketCube_cfg_Error_t ketCube_modules_ExecuteRetry(void)
+{
+    uint8_t i;
+    bool pending = FALSE;
+    
+    retryDue = FALSE;
+    
+    if (periodOpen == FALSE) {
+        return KETCUBE_CFG_OK;
+    }
+    
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        if ((modFailed[i] == TRUE) && (retryLeft[i] > 0)
+            && (ketCube_modules_Active(i) == TRUE)) {
+            retryLeft[i]--;
+            if (ketCube_modules_Sample(i) == KETCUBE_CFG_MODULE_OK) {
+                modFailed[i] = FALSE;
+            } else if (retryLeft[i] > 0) {
+                pending = TRUE;
+            }
+        }
+    }
+    
+    if ((pending == FALSE) || (ketCube_modules_PlanRetry() == FALSE)) {
+        ketCube_modules_Complete();
+    }
+    
+    return KETCUBE_CFG_OK;
+}
+
+
 /**
  * @brief Process Intra module messages
  *
@@ -310,3 +819,102 @@ ketCube_cfg_Error_t ketCube_modules_SleepExit(void)
 
     return KETCUBE_CFG_OK;
 }
+
+/**
+ * @brief Request an out-of-period execution of module periodic functions
+ * 
+ * Sensor modules detecting an exceptional event (e.g. a threshold interrupt)
+ * can use this to report immediately instead of waiting for the next base
+ * period. The base period timer is not affected.
+ * 
+ * @note This function can be called from IRQ context
+ */
+void ketCube_modules_RequestPeriod(void)
+{
+    periodRequested = TRUE;
+    KETCube_eventsProcessed = FALSE; /* Possible pending events */
+}
+
+/**
+ * @brief Check and clear the out-of-period execution request
+ *
+ * @retval TRUE if out-of-period execution has been requested
+ * @retval FALSE otherwise
+ */
+bool ketCube_modules_PeriodRequested(void)
+{
+    if (periodRequested == FALSE) {
+        return FALSE;
+    }
+    
+    periodRequested = FALSE;
+    return TRUE;
+}
+
+/**
+ * @brief Request a different base period
+ * 
+ * Modules can stretch (e.g. while the sensed quantity is static) or shorten
+ * the base period. The shortest of all requests is used; if there is no
+ * request, ketCube_coreCfg.basePeriod is used.
+ * 
+ * @param modId module ID
+ * @param period requested base period in ms; 0 to cancel the request
+ */
+void ketCube_modules_SetPeriod(ketCube_cfg_moduleIDs_t modId, uint32_t period)
+{
+    if (modId >= ketCube_modules_CNT) {
+        return;
+    }
+    
+    periodRequest[modId] = period;
+}
+
+/**
+ * @brief Get the effective base period
+ *
+ * @retval period base period in ms
+ */
+uint32_t ketCube_modules_GetPeriod(void)
+{
+    uint8_t i;
+    uint32_t period = 0;
+    
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        if ((periodRequest[i] != 0) && ((period == 0) || (periodRequest[i] < period))) {
+            period = periodRequest[i];
+        }
+    }
+    
+    if (period == 0) {
+        period = ketCube_coreCfg.basePeriod;
+    }
+    
+    return period * periodScale;
+}
+
+/**
+ * @brief Stretch the effective base period
+ * 
+ * Unlike ketCube_modules_SetPeriod(), the factor applies on top of all
+ * period requests (e.g. to save the battery).
+ * 
+ * @param scale base period multiplier; 0 is treated as 1
+ */
+void ketCube_modules_ScalePeriod(uint8_t scale)
+{
+    periodScale = (scale == 0) ? 1 : scale;
+}
+
+/**
+ * @brief Suspend periodic functions of modules
+ * 
+ * GetSensorData() and SendData() of suspended modules are not executed;
+ * the core cannot be suspended.
+ * 
+ * @param mask modules to suspend; bit N = module ID N, 0 to resume all
+ */
+void ketCube_modules_Suspend(uint32_t mask)
+{
+    suspended = mask & ~(1UL << KETCUBE_LISTS_ID_CORE);
+}
@@ -59,16 +59,28 @@
   */
 
 #define KETCUBE_MODULES_SENSOR_BYTES  512       ///< Max number of bytes which can be read from all sensors
+#define KETCUBE_MODULES_SUBSAMPLE_BYTES  64    ///< Max number of bytes read from a single module between base periods
 #define ketCube_modules_CNT  (KETCUBE_LISTS_MODULEID_LAST)
 
 
 
 extern ketCube_cfg_Module_t ketCube_modules_List[ketCube_modules_CNT];
+extern ketCube_cfg_Error_t ketCube_modules_MigrateCfg(void);
 extern ketCube_cfg_Error_t ketCube_modules_Init(void);
 extern ketCube_cfg_Error_t ketCube_modules_ExecutePeriodic(void);
+extern ketCube_cfg_Error_t ketCube_modules_ExecuteSubPeriodic(void);
+extern bool ketCube_modules_SubPeriodic(void);
+extern bool ketCube_modules_RetryDue(void);
+extern ketCube_cfg_Error_t ketCube_modules_ExecuteRetry(void);
 extern ketCube_cfg_Error_t ketCube_modules_ProcessMsgs(void);
 extern ketCube_cfg_Error_t ketCube_modules_SleepEnter(void);
 extern ketCube_cfg_Error_t ketCube_modules_SleepExit(void);
+extern void ketCube_modules_RequestPeriod(void);
+extern bool ketCube_modules_PeriodRequested(void);
+extern void ketCube_modules_SetPeriod(ketCube_cfg_moduleIDs_t modId, uint32_t period);
+extern uint32_t ketCube_modules_GetPeriod(void);
+extern void ketCube_modules_ScalePeriod(uint8_t scale);
+extern void ketCube_modules_Suspend(uint32_t mask);
 
 /**
 * @}
@@ -0,0 +1,342 @@
+/**
+ * @file    ketCube_oversample.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube sub-period oversampling
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "ketCube_oversample.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_modules.h"
+#include "ketCube_terminal.h"
+#include "timeServer.h"
+
+static ketCube_oversample_field_t * declared[ketCube_modules_CNT];  ///< Module fields; NULL if not declared
+static uint8_t declaredCnt[ketCube_modules_CNT];                    ///< # of declared fields
+static uint16_t sampleCnt[ketCube_modules_CNT];                     ///< # of samples in this period
+
+static TimerEvent_t subTimer;                   ///< Oversampling timer
+static volatile bool due = FALSE;               ///< Sub-period sample pending
+
+/**
+ * @brief Get record length covered by field declarations
+ */
+static uint8_t ketCube_oversample_Len(ketCube_cfg_moduleIDs_t modId)
+{
+    uint8_t i;
+    uint8_t len = 0;
+
+    for (i = 0; i < declaredCnt[modId]; i++) {
+        len += declared[modId][i].field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Write MSB-first field
+ */
+static void ketCube_oversample_PutField(uint8_t * data, uint32_t value,
+                                        uint8_t width)
+{
+    while (width > 0) {
+        width--;
+        data[width] = (uint8_t) (value & 0xFF);
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief Integer square root
+ */
+static uint32_t ketCube_oversample_Sqrt(uint64_t x)
+{
+    uint64_t bit = ((uint64_t) 1) << 62;
+    uint64_t r = 0;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (x >= (r + bit)) {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t) r;
+}
+
+/**
+ * @brief Round fixed-point Q8 value to integer
+ */
+static int32_t ketCube_oversample_Round(int32_t q)
+{
+    if (q >= 0) {
+        return (q + 128) / 256;
+    }
+
+    return -((128 - q) / 256);
+}
+
+/**
+ * @brief Oversampling timer expired
+ */
+static void ketCube_oversample_Tick(void *context)
+{
+    due = TRUE;
+    KETCube_eventsProcessed = FALSE; /* Possible pending events */
+
+    TimerStart(&subTimer);
+}
+
+/**
+ * @brief Start oversampling timer if enabled
+ */
+void ketCube_oversample_Init(void)
+{
+    uint32_t period = ketCube_coreCfg.oversamplePeriod;
+
+    if (period == 0) {
+        return;
+    }
+
+    if (period < KETCUBE_OVERSAMPLE_MIN_PERIOD) {
+        period = KETCUBE_OVERSAMPLE_MIN_PERIOD;
+    }
+
+    ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO,
+                                         "Oversampling period: %d ms",
+                                         period);
+
+    TimerInit(&subTimer, &ketCube_oversample_Tick);
+    TimerSetValue(&subTimer, period);
+    TimerStart(&subTimer);
+}
+
+/**
+ * @brief Declare module fields to be oversampled
+ *
+ * @param modId module ID
+ * @param fields field statistics; the array must persist (static)
+ * @param fieldCnt # of fields
+ */
+void ketCube_oversample_Declare(ketCube_cfg_moduleIDs_t modId,
+                                ketCube_oversample_field_t * fields,
+                                uint8_t fieldCnt)
+{
+    if (modId >= ketCube_modules_CNT) {
+        return;
+    }
+
+    declared[modId] = fields;
+    declaredCnt[modId] = fieldCnt;
+    sampleCnt[modId] = 0;
+}
+
+/**
+ * @brief Check whether module is oversampled
+ *
+ * @param modId module ID
+ *
+ * @retval TRUE if module fields are declared and oversampling is enabled
+ */
+bool ketCube_oversample_Declared(ketCube_cfg_moduleIDs_t modId)
+{
+    return ((modId < ketCube_modules_CNT) && (declared[modId] != NULL)
+            && (ketCube_coreCfg.oversamplePeriod != 0));
+}
+
+/**
+ * @brief Check and clear the sub-period sample request
+ *
+ * @retval TRUE if sub-period sample is due
+ */
+bool ketCube_oversample_Due(void)
+{
+    if (due == FALSE) {
+        return FALSE;
+    }
+
+    due = FALSE;
+    return TRUE;
+}
+
+/**
+ * @brief Add module record to running statistics
+ *
+ * @param modId module ID
+ * @param data module record
+ * @param len module record length
+ */
+void ketCube_oversample_Accumulate(ketCube_cfg_moduleIDs_t modId,
+                                   const uint8_t * data, uint8_t len)
+{
+    ketCube_oversample_field_t * f;
+    int64_t diff;
+    int32_t value, q, delta;
+    uint16_t n;
+    uint8_t i;
+    uint8_t pos = 0;
+
+    if ((ketCube_oversample_Declared(modId) == FALSE)
+        || (len < ketCube_oversample_Len(modId))
+        || (sampleCnt[modId] == UINT16_MAX)) {
+        return;
+    }
+
+    n = ++sampleCnt[modId];
+
+    for (i = 0; i < declaredCnt[modId]; i++) {
+        f = &(declared[modId][i]);
+        value = ketCube_tsCodec_GetField(&(data[pos]), f->field);
+        pos += f->field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+
+        if (n == 1) {
+            f->ref = value;
+            f->min = value;
+            f->max = value;
+            f->mean = 0;
+            f->m2 = 0;
+            continue;
+        }
+
+        if (value < f->min) {
+            f->min = value;
+        }
+        if (value > f->max) {
+            f->max = value;
+        }
+
+        /* Welford update of values relative to the first sample */
+        diff = (int64_t) value - f->ref;
+        if (diff > KETCUBE_OVERSAMPLE_MAX_SPREAD) {
+            diff = KETCUBE_OVERSAMPLE_MAX_SPREAD;
+        } else if (diff < -KETCUBE_OVERSAMPLE_MAX_SPREAD) {
+            diff = -KETCUBE_OVERSAMPLE_MAX_SPREAD;
+        }
+        q = (int32_t) diff * 256;
+
+        delta = q - f->mean;
+        f->mean += delta / (int32_t) n;
+        /* both factors have the same sign */
+        f->m2 += (uint64_t) ((int64_t) delta * (q - f->mean));
+    }
+}
+
+/**
+ * @brief Replace module record by the summary of this period
+ *
+ * The record is accumulated as the last sample and the statistics are
+ * restarted. See @ref KETCube_oversample for the summary layout.
+ *
+ * @param modId module ID
+ * @param data module record; the summary is written in place
+ * @param len module record length
+ * @param maxLen space available for the summary
+ *
+ * @retval summary length; len if the module is not oversampled
+ */
+uint8_t ketCube_oversample_Summarize(ketCube_cfg_moduleIDs_t modId,
+                                     uint8_t * data, uint8_t len,
+                                     uint8_t maxLen)
+{
+    ketCube_oversample_field_t * f;
+    uint32_t sd, sdMax;
+    uint16_t n;
+    uint8_t width;
+    uint8_t i;
+    uint8_t pos = 0;
+    uint8_t out = len;
+
+    if (ketCube_oversample_Declared(modId) == FALSE) {
+        return len;
+    }
+
+    ketCube_oversample_Accumulate(modId, data, len);
+    n = sampleCnt[modId];
+    sampleCnt[modId] = 0;
+
+    if (n == 0) {
+        return len;
+    }
+
+    if (((uint16_t) len + KETCUBE_OVERSAMPLE_COUNT_LEN +
+         3 * ketCube_oversample_Len(modId)) > maxLen) {
+        ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_ERROR,
+                                             "Oversampling summary does not fit");
+        return len;
+    }
+
+    ketCube_oversample_PutField(&(data[out]), n,
+                                KETCUBE_OVERSAMPLE_COUNT_LEN);
+    out += KETCUBE_OVERSAMPLE_COUNT_LEN;
+
+    for (i = 0; i < declaredCnt[modId]; i++) {
+        f = &(declared[modId][i]);
+        width = f->field & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+
+        ketCube_oversample_PutField(&(data[pos]),
+                                    (uint32_t) (f->ref +
+                                                ketCube_oversample_Round(f->mean)),
+                                    width);
+        pos += width;
+
+        ketCube_oversample_PutField(&(data[out]), (uint32_t) f->min, width);
+        out += width;
+        ketCube_oversample_PutField(&(data[out]), (uint32_t) f->max, width);
+        out += width;
+
+        /* population standard deviation; Q16 variance gives Q8 deviation */
+        sd = (ketCube_oversample_Sqrt(f->m2 / n) + 128) / 256;
+        sdMax = (width >= 4) ? UINT32_MAX : ((1UL << (width * 8)) - 1);
+        if (sd > sdMax) {
+            sd = sdMax;
+        }
+        ketCube_oversample_PutField(&(data[out]), sd, width);
+        out += width;
+    }
+
+    return out;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file    ketCube_oversample.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube sub-period oversampling
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_OVERSAMPLE_H
+#define __KETCUBE_OVERSAMPLE_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+#include "ketCube_tsCodec.h"
+
+/** @defgroup KETCube_oversample KETCube oversampling
+  * @brief Sub-period sampling summarized into a single record
+  *
+  * Modules declare the fields of their SensorBuffer record by
+  * ketCube_oversample_Declare() in Init(). When the core oversampling period
+  * (ketCube_coreCfg_t::oversamplePeriod) is set, GetSensorData() of such
+  * modules is also called every oversamplePeriod, between base periods.
+  * Samples are accumulated into fixed-point running statistics (Welford);
+  * the base period sample is the last one. The module record is then
+  * replaced by the summary:
+  *  - the original record, declared fields replaced by their mean
+  *  - sample count (uint16_t)
+  *  - for each declared field: min, max and standard deviation
+  *
+  * All summary values are MSB-first, of the declared field width and in
+  * field units; the standard deviation is unsigned. Deadbands and batch
+  * compression thus keep working on the leading (mean) part.
+  *
+  * A sub-sample costs a GetSensorData() call plus one division and one
+  * 32x32 multiplication per field, so it fits to a wake-up from STOP mode;
+  * GetSensorData() should skip terminal output when
+  * ketCube_modules_SubPeriodic() is TRUE.
+  * The spread is tracked up to +-KETCUBE_OVERSAMPLE_MAX_SPREAD field units
+  * from the first sample of the period; samples beyond are clipped.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_OVERSAMPLE_MIN_PERIOD       100         ///< Minimal oversampling period in ms
+#define KETCUBE_OVERSAMPLE_MAX_SPREAD       4194303     ///< Max. tracked distance from the first sample (2^22 - 1)
+#define KETCUBE_OVERSAMPLE_COUNT_LEN        2           ///< Sample count length in the summary
+
+/**
+* @brief Field statistics
+*/
+typedef struct {
+    uint8_t field;          ///< Field descriptor: width and sign, see @ref KETCube_tsCodec (codec bits are ignored)
+    int32_t ref;            ///< First sample of the period; managed by the core
+    int32_t min;            ///< Minimum; managed by the core
+    int32_t max;            ///< Maximum; managed by the core
+    int32_t mean;           ///< Mean relative to ref, fixed-point Q8; managed by the core
+    uint64_t m2;            ///< Sum of squared deviations, fixed-point Q16; managed by the core
+} ketCube_oversample_field_t;
+
+/** @defgroup KETCube_oversample_fn Public Functions
+* @{
+*/
+
+extern void ketCube_oversample_Init(void);
+extern void ketCube_oversample_Declare(ketCube_cfg_moduleIDs_t modId,
+                                       ketCube_oversample_field_t * fields,
+                                       uint8_t fieldCnt);
+extern bool ketCube_oversample_Declared(ketCube_cfg_moduleIDs_t modId);
+extern bool ketCube_oversample_Due(void);
+extern void ketCube_oversample_Accumulate(ketCube_cfg_moduleIDs_t modId,
+                                          const uint8_t * data,
+                                          uint8_t len);
+extern uint8_t ketCube_oversample_Summarize(ketCube_cfg_moduleIDs_t modId,
+                                            uint8_t * data, uint8_t len,
+                                            uint8_t maxLen);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_OVERSAMPLE_H */
@@ -0,0 +1,330 @@
+/**
+ * @file    ketCube_sfQueue.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube persistent store-and-forward uplink queue
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "ketCube_sfQueue.h"
+#include "ketCube_eeprom.h"
+#include "ketCube_timeSync.h"
+
+#define KETCUBE_SFQUEUE_SLOT_ADDR(slot) (KETCUBE_SFQUEUE_EEPROM_ADDR + ((uint32_t) (slot)) * KETCUBE_SFQUEUE_SLOT_LEN)
+#define KETCUBE_SFQUEUE_PARTS(len)      (((len) > KETCUBE_SFQUEUE_SLOT_DATA_LEN) ? (((len) + KETCUBE_SFQUEUE_SLOT_DATA_LEN - 1) / KETCUBE_SFQUEUE_SLOT_DATA_LEN) : 1)
+
+/**
+* @brief EEPROM slot layout; the header is shared with ketCube_sfQueue_record_t
+*/
+typedef struct {
+    uint8_t state;
+    uint8_t port;
+    uint8_t len;
+    uint8_t part;
+    uint32_t seq;
+    uint32_t timestamp;
+    uint8_t data[KETCUBE_SFQUEUE_SLOT_DATA_LEN];
+} ketCube_sfQueue_slot_t;
+
+static uint8_t head = 0;        ///< Oldest pending record
+static uint8_t tail = 0;        ///< Slot for the next record
+static uint8_t count = 0;       ///< # of pending records
+static uint32_t nextSeq = 1;    ///< Sequence number of the next record
+static uint32_t timeBase = 0;   ///< Queue clock offset to the RTC
+
+/**
+ * @brief Read slot header
+ */
+static void ketCube_sfQueue_ReadHeader(uint8_t slot,
+                                       ketCube_sfQueue_slot_t * rec)
+{
+    ketCube_EEPROM_ReadBuffer(KETCUBE_SFQUEUE_SLOT_ADDR(slot),
+                              (uint8_t *) rec, KETCUBE_SFQUEUE_HEADER_LEN);
+}
+
+/**
+ * @brief Get # of free slots
+ */
+static uint8_t ketCube_sfQueue_Free(void)
+{
+    if (count == 0) {
+        return KETCUBE_SFQUEUE_SLOTS;
+    }
+
+    return (head + KETCUBE_SFQUEUE_SLOTS - tail) % KETCUBE_SFQUEUE_SLOTS;
+}
+
+/**
+ * @brief Set slot state
+ */
+static ketCube_cfg_ModError_t ketCube_sfQueue_SetState(uint8_t slot,
+                                                       uint8_t state)
+{
+    if (ketCube_EEPROM_WriteBuffer(KETCUBE_SFQUEUE_SLOT_ADDR(slot) +
+                                   offsetof(ketCube_sfQueue_record_t, state),
+                                   &state, 1) != KETCUBE_EEPROM_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Recover queue state from EEPROM
+ *
+ * Pending records precede the slot with the highest sequence number (the
+ * last part of the newest record); they are contiguous except for slots
+ * interrupted by reset and the following parts of records.
+ */
+void ketCube_sfQueue_Init(void)
+{
+    ketCube_sfQueue_slot_t rec;
+    uint32_t maxSeq = 0;
+    uint32_t lastTs = 0;
+    uint8_t maxSlot = 0;
+    uint8_t maxPart = 0;
+    bool found = FALSE;
+    uint8_t i, slot;
+
+    for (i = 0; i < KETCUBE_SFQUEUE_SLOTS; i++) {
+        ketCube_sfQueue_ReadHeader(i, &rec);
+        if (rec.seq == 0) {
+            continue;
+        }
+        if ((found == FALSE) || ((int32_t) (rec.seq - maxSeq) > 0)
+            || ((rec.seq == maxSeq) && (rec.part > maxPart))) {
+            maxSeq = rec.seq;
+            maxSlot = i;
+            maxPart = rec.part;
+            found = TRUE;
+        }
+    }
+
+    tail = (found == TRUE) ? (maxSlot + 1) % KETCUBE_SFQUEUE_SLOTS : 0;
+    nextSeq = maxSeq + 1;
+    if (nextSeq == 0) {
+        nextSeq = 1;
+    }
+
+    head = tail;
+    count = 0;
+    for (i = 0; i < KETCUBE_SFQUEUE_SLOTS; i++) {
+        slot = (tail + i) % KETCUBE_SFQUEUE_SLOTS;
+        ketCube_sfQueue_ReadHeader(slot, &rec);
+        if (rec.state == KETCUBE_SFQUEUE_STATE_VALID) {
+            if (count == 0) {
+                head = slot;
+            }
+            count++;
+            lastTs = rec.timestamp;
+        }
+    }
+
+    timeBase = 0;
+    if (count > 0) {
+        timeBase = lastTs - ketCube_timeSync_Now();
+    }
+}
+
+/**
+ * @brief Get queue clock
+ *
+ * @retval seconds
+ */
+uint32_t ketCube_sfQueue_Now(void)
+{
+    return ketCube_timeSync_Now() + timeBase;
+}
+
+/**
+ * @brief Store record
+ *
+ * @param port original uplink port
+ * @param data record
+ * @param len record length; max. KETCUBE_SFQUEUE_DATA_LEN
+ * @param age record age in seconds (time since acquisition)
+ * @param policy full-queue policy
+ *
+ * @retval KETCUBE_CFG_MODULE_OK if the record is stored
+ */
+ketCube_cfg_ModError_t ketCube_sfQueue_Push(uint8_t port,
+                                            const uint8_t * data,
+                                            uint8_t len,
+                                            uint32_t age,
+                                            ketCube_sfQueue_policy_t policy)
+{
+    ketCube_sfQueue_slot_t rec;
+    uint8_t parts = KETCUBE_SFQUEUE_PARTS(len);
+    uint8_t part, partLen, skip;
+
+    if ((policy == KETCUBE_SFQUEUE_POLICY_DISABLED)
+        || (len > KETCUBE_SFQUEUE_DATA_LEN)) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    /* full -- the next slots hold the oldest records */
+    while (ketCube_sfQueue_Free() < parts) {
+        if (policy == KETCUBE_SFQUEUE_POLICY_DROP_NEWEST) {
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+        ketCube_sfQueue_Pop();
+    }
+
+    rec.port = port;
+    rec.len = len;
+    rec.seq = nextSeq;
+    rec.timestamp = ketCube_sfQueue_Now() - age;
+
+    /* a failed write consumes the sequence number too */
+    nextSeq++;
+    if (nextSeq == 0) {
+        nextSeq = 1;
+    }
+
+    /* invalidate, write the following parts and the first part, then validate */
+    if (ketCube_sfQueue_SetState(tail, KETCUBE_SFQUEUE_STATE_EMPTY) != KETCUBE_CFG_MODULE_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    part = parts;
+    while (part-- > 0) {
+        partLen = len - part * KETCUBE_SFQUEUE_SLOT_DATA_LEN;
+        if (partLen > KETCUBE_SFQUEUE_SLOT_DATA_LEN) {
+            partLen = KETCUBE_SFQUEUE_SLOT_DATA_LEN;
+        }
+        rec.state = KETCUBE_SFQUEUE_STATE_PART;
+        rec.part = part;
+        memcpy(&(rec.data[0]), &(data[part * KETCUBE_SFQUEUE_SLOT_DATA_LEN]), partLen);
+
+        /* keep the state of the first slot */
+        skip = (part == 0) ? 1 : 0;
+        if (ketCube_EEPROM_WriteBuffer(KETCUBE_SFQUEUE_SLOT_ADDR((tail + part) % KETCUBE_SFQUEUE_SLOTS) + skip,
+                                       ((uint8_t *) &rec) + skip,
+                                       KETCUBE_SFQUEUE_HEADER_LEN - skip + partLen) != KETCUBE_EEPROM_OK) {
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+    }
+    if (ketCube_sfQueue_SetState(tail, KETCUBE_SFQUEUE_STATE_VALID) != KETCUBE_CFG_MODULE_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    if (count == 0) {
+        head = tail;
+    }
+    count++;
+    tail = (tail + parts) % KETCUBE_SFQUEUE_SLOTS;
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Read the oldest record
+ *
+ * @param rec record
+ *
+ * @retval KETCUBE_CFG_MODULE_ERROR if the queue is empty
+ */
+ketCube_cfg_ModError_t ketCube_sfQueue_Peek(ketCube_sfQueue_record_t * rec)
+{
+    uint8_t part, parts, partLen;
+
+    if (count == 0) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    ketCube_EEPROM_ReadBuffer(KETCUBE_SFQUEUE_SLOT_ADDR(head),
+                              (uint8_t *) rec, KETCUBE_SFQUEUE_SLOT_LEN);
+    if (rec->len > KETCUBE_SFQUEUE_DATA_LEN) {
+        rec->len = KETCUBE_SFQUEUE_DATA_LEN;
+    }
+
+    parts = KETCUBE_SFQUEUE_PARTS(rec->len);
+    for (part = 1; part < parts; part++) {
+        partLen = rec->len - part * KETCUBE_SFQUEUE_SLOT_DATA_LEN;
+        if (partLen > KETCUBE_SFQUEUE_SLOT_DATA_LEN) {
+            partLen = KETCUBE_SFQUEUE_SLOT_DATA_LEN;
+        }
+        ketCube_EEPROM_ReadBuffer(KETCUBE_SFQUEUE_SLOT_ADDR((head + part) % KETCUBE_SFQUEUE_SLOTS) + KETCUBE_SFQUEUE_HEADER_LEN,
+                                  &(rec->data[part * KETCUBE_SFQUEUE_SLOT_DATA_LEN]), partLen);
+    }
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Remove the oldest record
+ *
+ * Slots left invalid by an interrupted write are skipped.
+ */
+void ketCube_sfQueue_Pop(void)
+{
+    ketCube_sfQueue_slot_t rec;
+
+    if (count == 0) {
+        return;
+    }
+
+    ketCube_sfQueue_SetState(head, KETCUBE_SFQUEUE_STATE_EMPTY);
+    count--;
+
+    do {
+        head = (head + 1) % KETCUBE_SFQUEUE_SLOTS;
+        ketCube_sfQueue_ReadHeader(head, &rec);
+    } while ((count > 0) && (rec.state != KETCUBE_SFQUEUE_STATE_VALID));
+}
+
+/**
+ * @brief Remove all records
+ */
+void ketCube_sfQueue_Clear(void)
+{
+    while (count > 0) {
+        ketCube_sfQueue_Pop();
+    }
+}
+
+/**
+ * @brief Get # of pending records
+ */
+uint8_t ketCube_sfQueue_Count(void)
+{
+    return count;
+}
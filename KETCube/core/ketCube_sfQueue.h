@@ -0,0 +1,131 @@
+/**
+ * @file    ketCube_sfQueue.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube persistent store-and-forward uplink queue
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_SFQUEUE_H
+#define __KETCUBE_SFQUEUE_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+
+/** @defgroup KETCube_sfQueue KETCube store-and-forward queue
+  * @brief Bounded FIFO of pending uplink records kept in the data EEPROM
+  *
+  * Records, which could not be sent (coverage gap, duty-cycle restriction,
+  * MAC busy), are stored into fixed-size slots of the second data EEPROM
+  * bank, so they survive resets and power loss. Records longer than the slot
+  * data continue in the following slots (parts). Each slot holds a sequence
+  * number; the oldest and the newest record are found by scanning the slots
+  * in ketCube_sfQueue_Init(). The state byte of the first slot of a record
+  * is written last, thus a record interrupted by reset is ignored.
+  *
+  * Record timestamps are taken from a queue clock, which continues from the
+  * newest stored record after reset (the RTC calendar restarts on reset);
+  * it runs at the drift-corrected rate of @ref KETCube_timeSync.
+  * The age of a record stored before reset thus excludes the time between
+  * the newest record and the end of reset.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_SFQUEUE_EEPROM_ADDR    0x0800     ///< Queue base (data EEPROM offset); the first 2 kB are used by the configuration
+#define KETCUBE_SFQUEUE_EEPROM_LEN     0x0800     ///< Queue length in bytes
+#define KETCUBE_SFQUEUE_SLOT_LEN       64         ///< Slot length in bytes
+#define KETCUBE_SFQUEUE_HEADER_LEN     12         ///< Slot header length in bytes
+#define KETCUBE_SFQUEUE_SLOT_DATA_LEN  (KETCUBE_SFQUEUE_SLOT_LEN - KETCUBE_SFQUEUE_HEADER_LEN) ///< Record bytes per slot
+#define KETCUBE_SFQUEUE_DATA_LEN       242        ///< Max. record length (LoRaWAN max. application payload)
+#define KETCUBE_SFQUEUE_SLOTS          (KETCUBE_SFQUEUE_EEPROM_LEN / KETCUBE_SFQUEUE_SLOT_LEN) ///< Queue capacity in slots
+
+#define KETCUBE_SFQUEUE_STATE_EMPTY    0x00       ///< Slot free or record sent/dropped
+#define KETCUBE_SFQUEUE_STATE_VALID    0xA5       ///< Slot holds the first part of a pending record
+#define KETCUBE_SFQUEUE_STATE_PART     0x5A       ///< Slot holds a following part of a record; valid if the first part is
+
+/**
+* @brief Full-queue policy
+*/
+typedef enum {
+    KETCUBE_SFQUEUE_POLICY_DISABLED    = 0,  ///< Do not queue records
+    KETCUBE_SFQUEUE_POLICY_DROP_OLDEST = 1,  ///< Drop the oldest record to store the new one
+    KETCUBE_SFQUEUE_POLICY_DROP_NEWEST = 2,  ///< Keep the queue content; reject the new record
+} ketCube_sfQueue_policy_t;
+
+/**
+* @brief Queued record; the header is the EEPROM slot header
+*/
+typedef struct {
+    uint8_t state;                             ///< Slot state, see KETCUBE_SFQUEUE_STATE_*
+    uint8_t port;                              ///< Original uplink port
+    uint8_t len;                               ///< Record length
+    uint8_t part;                              ///< Part # of the record held by the slot
+    uint32_t seq;                              ///< Sequence number; 0 = slot never written
+    uint32_t timestamp;                        ///< Queue clock of the record acquisition, see ketCube_sfQueue_Now()
+    uint8_t data[KETCUBE_SFQUEUE_DATA_LEN];    ///< Record; a slot holds KETCUBE_SFQUEUE_SLOT_DATA_LEN bytes of it
+} ketCube_sfQueue_record_t;
+
+/** @defgroup KETCube_sfQueue_fn Public Functions
+* @{
+*/
+
+extern void ketCube_sfQueue_Init(void);
+extern uint32_t ketCube_sfQueue_Now(void);
+extern ketCube_cfg_ModError_t ketCube_sfQueue_Push(uint8_t port,
+                                                   const uint8_t * data,
+                                                   uint8_t len,
+                                                   uint32_t age,
+                                                   ketCube_sfQueue_policy_t policy);
+extern ketCube_cfg_ModError_t ketCube_sfQueue_Peek(ketCube_sfQueue_record_t * rec);
+extern void ketCube_sfQueue_Pop(void);
+extern void ketCube_sfQueue_Clear(void);
+extern uint8_t ketCube_sfQueue_Count(void);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_SFQUEUE_H */
@@ -0,0 +1,270 @@
+/**
+ * @file    ketCube_timeSync.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube network-synchronised time
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "ketCube_timeSync.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_rtc.h"
+#include "systime.h"
+
+#define KETCUBE_TIMESYNC_TEMP_COEF_PPB  ((int32_t) (RTC_TEMP_COEFFICIENT * 1000))  ///< Crystal temperature coefficient in ppb/degC^2
+#define KETCUBE_TIMESYNC_TEMP_TURNOVER  ((int32_t) RTC_TEMP_TURNOVER)              ///< Crystal turnover temperature in degC
+#define KETCUBE_TIMESYNC_PPB            1000000000LL
+
+static uint64_t mcuLast = 0;       ///< RTC calendar of the last update in ms
+static int64_t corr = 0;           ///< Local time to RTC calendar offset in ms
+static int64_t corrRem = 0;        ///< Correction remainder in ms * ppb
+static int32_t calPpb = 0;         ///< Calibration term
+static int32_t tempPpb = 0;        ///< Temperature term
+static uint32_t stamp = 0;         ///< Last acquisition time in s
+
+static bool synced = FALSE;        ///< Network time known
+static int64_t sysDelta = 0;       ///< SysTime to RTC calendar offset at the last answer in ms
+static int64_t netOffset = 0;      ///< Network time to local time offset in ms
+static uint64_t calTime = 0;       ///< Local time of the calibration reference in ms
+static int64_t calOffset = 0;      ///< Network time offset of the calibration reference in ms
+static uint32_t syncTime = 0;      ///< Local time of the last answer in s
+static uint32_t reqTime = 0;       ///< Local time of the last request in s
+static bool requested = FALSE;     ///< Time request pending
+
+/**
+ * @brief Convert SysTime to ms
+ */
+static int64_t ketCube_timeSync_Ms(SysTime_t time)
+{
+    return ((int64_t) time.Seconds) * 1000 + time.SubSeconds;
+}
+
+/**
+ * @brief Advance the local time to the RTC calendar
+ *
+ * @retval local time in ms
+ */
+static uint64_t ketCube_timeSync_Advance(void)
+{
+    uint64_t mcu = (uint64_t) ketCube_timeSync_Ms(SysTimeGetMcuTime());
+
+    corrRem += ((int64_t) (mcu - mcuLast)) * (calPpb + tempPpb);
+    corr += corrRem / KETCUBE_TIMESYNC_PPB;
+    corrRem %= KETCUBE_TIMESYNC_PPB;
+    mcuLast = mcu;
+
+    return mcu + corr;
+}
+
+/**
+ * @brief Initialize local time
+ */
+void ketCube_timeSync_Init(void)
+{
+    mcuLast = (uint64_t) ketCube_timeSync_Ms(SysTimeGetMcuTime());
+    corr = 0;
+    corrRem = 0;
+    synced = FALSE;
+    requested = FALSE;
+    stamp = ketCube_timeSync_Now();
+}
+
+/**
+ * @brief Get local time
+ *
+ * @retval seconds
+ */
+uint32_t ketCube_timeSync_Now(void)
+{
+    return (uint32_t) (ketCube_timeSync_Advance() / 1000);
+}
+
+/**
+ * @brief Stamp the record being acquired
+ */
+void ketCube_timeSync_Stamp(void)
+{
+    stamp = ketCube_timeSync_Now();
+}
+
+/**
+ * @brief Get the acquisition time of the last record
+ *
+ * @retval local time in seconds
+ */
+uint32_t ketCube_timeSync_GetStamp(void)
+{
+    return stamp;
+}
+
+/**
+ * @brief Get age of the given local time
+ *
+ * @retval seconds
+ */
+uint32_t ketCube_timeSync_GetAge(uint32_t time)
+{
+    uint32_t now = ketCube_timeSync_Now();
+
+    return ((int32_t) (now - time) > 0) ? (now - time) : 0;
+}
+
+/**
+ * @brief Convert local time to network time
+ *
+ * @param time local time in seconds
+ * @param unixTime network time in seconds since the Unix epoch
+ *
+ * @retval TRUE if the network time is known
+ */
+bool ketCube_timeSync_ToUnix(uint32_t time, uint32_t * unixTime)
+{
+    if (synced == FALSE) {
+        return FALSE;
+    }
+
+    *unixTime = (uint32_t) ((((int64_t) time) * 1000 + netOffset) / 1000);
+
+    return TRUE;
+}
+
+/**
+ * @brief Get RTC drift correction
+ *
+ * @retval ppb; positive if the RTC runs slow
+ */
+int32_t ketCube_timeSync_GetDrift(void)
+{
+    return calPpb + tempPpb;
+}
+
+/**
+ * @brief Set the temperature of the RTC crystal
+ *
+ * The time elapsed so far is corrected by the previous temperature.
+ *
+ * @param temperature degC
+ */
+void ketCube_timeSync_SetTemperature(int8_t temperature)
+{
+    int32_t dT = ((int32_t) temperature) - KETCUBE_TIMESYNC_TEMP_TURNOVER;
+
+    ketCube_timeSync_Advance();
+
+    /* the crystal slows down: the RTC calendar lags */
+    tempPpb = -KETCUBE_TIMESYNC_TEMP_COEF_PPB * dT * dT;
+}
+
+/**
+ * @brief Check whether the network time should be requested
+ *
+ * The request is considered sent when TRUE is returned; it is repeated
+ * after KETCUBE_TIMESYNC_RETRY_S if not answered.
+ *
+ * @retval TRUE if the caller should request the network time
+ */
+bool ketCube_timeSync_RequestDue(void)
+{
+    uint32_t now = ketCube_timeSync_Now();
+
+    if (ketCube_coreCfg.timeSyncPeriod == 0) {
+        return FALSE;
+    }
+
+    if ((synced == TRUE) && ((now - syncTime) < ketCube_coreCfg.timeSyncPeriod)) {
+        return FALSE;
+    }
+
+    if ((requested == TRUE) && ((now - reqTime) < KETCUBE_TIMESYNC_RETRY_S)) {
+        return FALSE;
+    }
+
+    requested = TRUE;
+    reqTime = now;
+
+    return TRUE;
+}
+
+/**
+ * @brief Process a network time answer
+ *
+ * The network time has been applied by SysTimeSet(); calls not preceded
+ * by a new answer are ignored.
+ */
+void ketCube_timeSync_Update(void)
+{
+    int64_t delta = ketCube_timeSync_Ms(SysTimeGet()) - ketCube_timeSync_Ms(SysTimeGetMcuTime());
+    uint64_t local;
+    int64_t offset;
+    int64_t elapsed;
+    int64_t ppb;
+
+    if ((synced == TRUE) && (delta == sysDelta)) {
+        return;
+    }
+
+    local = ketCube_timeSync_Advance();
+    offset = ((int64_t) mcuLast) + delta - ((int64_t) local);
+
+    if (synced == FALSE) {
+        calTime = local;
+        calOffset = offset;
+    } else {
+        elapsed = (int64_t) (local - calTime);
+        if (elapsed >= KETCUBE_TIMESYNC_MIN_CAL_MS) {
+            /* local time lagged by (offset - calOffset) */
+            ppb = ((offset - calOffset) * KETCUBE_TIMESYNC_PPB) / elapsed;
+            ppb = calPpb + ppb / (1 << KETCUBE_TIMESYNC_CAL_SHIFT);
+            if (ppb > KETCUBE_TIMESYNC_MAX_PPB) {
+                ppb = KETCUBE_TIMESYNC_MAX_PPB;
+            } else if (ppb < -KETCUBE_TIMESYNC_MAX_PPB) {
+                ppb = -KETCUBE_TIMESYNC_MAX_PPB;
+            }
+            calPpb = (int32_t) ppb;
+            calTime = local;
+            calOffset = offset;
+        }
+    }
+
+    sysDelta = delta;
+    netOffset = offset;
+    syncTime = (uint32_t) (local / 1000);
+    synced = TRUE;
+    requested = FALSE;
+}
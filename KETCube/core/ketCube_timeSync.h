@@ -0,0 +1,102 @@
+/**
+ * @file    ketCube_timeSync.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube network-synchronised time
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_TIMESYNC_H
+#define __KETCUBE_TIMESYNC_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+
+/** @defgroup KETCube_timeSync KETCube time synchronisation
+  * @brief Drift-corrected local time for record timestamps
+  *
+  * The local time follows the RTC calendar (SysTimeGetMcuTime()), corrected
+  * for the RTC crystal drift. The drift is the sum of:
+  *  - the crystal temperature term (RTC_TEMP_COEFFICIENT parabola around
+  *    RTC_TEMP_TURNOVER, as used by TimerTempCompensation()); the temperature
+  *    is reported by the communication module before uplinks
+  *  - the calibration term learned from consecutive network time answers
+  *    (LoRaWAN DeviceTimeReq), which are at least
+  *    KETCUBE_TIMESYNC_MIN_CAL_MS apart
+  *
+  * The local time never steps; the network time (SysTimeGet(), Unix epoch)
+  * is kept as an offset to the local time. Sensor records are stamped by
+  * ketCube_timeSync_Stamp() at acquisition; uplinks carry the record age,
+  * so the network server restores the acquisition time from the reception
+  * time of the uplink.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_TIMESYNC_MIN_CAL_MS    21600000   ///< Min. time between network time answers used for calibration (6 h); answer latency jitter gives ~2 ppm error
+#define KETCUBE_TIMESYNC_MAX_PPB       200000     ///< Calibration limit (200 ppm)
+#define KETCUBE_TIMESYNC_CAL_SHIFT     1          ///< Calibration filter: each answer corrects 1/2^shift of the observed drift
+#define KETCUBE_TIMESYNC_RETRY_S       3600       ///< Delay before repeating an unanswered time request
+
+/** @defgroup KETCube_timeSync_fn Public Functions
+* @{
+*/
+
+extern void ketCube_timeSync_Init(void);
+extern uint32_t ketCube_timeSync_Now(void);
+extern void ketCube_timeSync_Stamp(void);
+extern uint32_t ketCube_timeSync_GetStamp(void);
+extern uint32_t ketCube_timeSync_GetAge(uint32_t time);
+extern bool ketCube_timeSync_ToUnix(uint32_t time, uint32_t * unixTime);
+extern int32_t ketCube_timeSync_GetDrift(void);
+extern void ketCube_timeSync_SetTemperature(int8_t temperature);
+extern bool ketCube_timeSync_RequestDue(void);
+extern void ketCube_timeSync_Update(void);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_TIMESYNC_H */
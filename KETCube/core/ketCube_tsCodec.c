@@ -0,0 +1,347 @@
+/**
+ * @file    ketCube_tsCodec.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube time-series record codec
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <string.h>
+
+#include "ketCube_tsCodec.h"
+
+/**
+ * @brief Initialize codec
+ *
+ * @param ctx codec state
+ * @param fields field descriptors; the list is terminated by a zero width or by maxFields
+ * @param maxFields field descriptor array length
+ */
+void ketCube_tsCodec_Init(ketCube_tsCodec_t * ctx, const uint8_t * fields,
+                          uint8_t maxFields)
+{
+    uint8_t i;
+    uint8_t width;
+
+    ctx->fieldCnt = 0;
+
+    for (i = 0; (i < maxFields) && (i < KETCUBE_TSCODEC_MAX_FIELDS); i++) {
+        width = fields[i] & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+        if ((width == 0) || (width > 4)) {
+            break;
+        }
+        ctx->field[ctx->fieldCnt++] = fields[i];
+    }
+
+    ketCube_tsCodec_Reset(ctx);
+}
+
+/**
+ * @brief Reset codec state; the next record is encoded without reference
+ *
+ * @param ctx codec state
+ */
+void ketCube_tsCodec_Reset(ketCube_tsCodec_t * ctx)
+{
+    memset(&(ctx->prev[0]), 0, sizeof(ctx->prev));
+    memset(&(ctx->prevDelta[0]), 0, sizeof(ctx->prevDelta));
+}
+
+/**
+ * @brief Write LEB128 varint (7 bits per byte, LSB group first)
+ *
+ * @param out output buffer
+ * @param outLen output buffer space
+ * @param value value to write
+ *
+ * @retval # of bytes written; 0 if out of space
+ */
+uint8_t ketCube_tsCodec_PutVarint(uint8_t * out, uint8_t outLen,
+                                  uint32_t value)
+{
+    uint8_t len = 0;
+
+    do {
+        if (len >= outLen) {
+            return 0;
+        }
+        out[len] = (uint8_t) (value & 0x7F);
+        value >>= 7;
+        if (value != 0) {
+            out[len] |= 0x80;
+        }
+        len++;
+    } while (value != 0);
+
+    return len;
+}
+
+/**
+ * @brief Read LEB128 varint
+ *
+ * @param in input buffer
+ * @param inLen input buffer length
+ * @param value value read
+ *
+ * @retval # of bytes read; 0 if the varint is truncated or too long
+ */
+uint8_t ketCube_tsCodec_GetVarint(const uint8_t * in, uint8_t inLen,
+                                  uint32_t * value)
+{
+    uint8_t len = 0;
+
+    *value = 0;
+
+    do {
+        if ((len >= inLen) || (len >= KETCUBE_TSCODEC_VARINT_MAX_LEN)) {
+            return 0;
+        }
+        *value |= ((uint32_t) (in[len] & 0x7F)) << (7 * len);
+        len++;
+    } while ((in[len - 1] & 0x80) != 0);
+
+    return len;
+}
+
+/**
+ * @brief Read MSB-first field as 32-bit value
+ *
+ * @param data field bytes
+ * @param descr field descriptor
+ *
+ * @retval field value; sign-extended for signed fields
+ */
+int32_t ketCube_tsCodec_GetField(const uint8_t * data, uint8_t descr)
+{
+    uint8_t width = descr & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+    uint32_t value = 0;
+    uint8_t i;
+
+    for (i = 0; i < width; i++) {
+        value = (value << 8) | data[i];
+    }
+
+    if (((descr & KETCUBE_TSCODEC_FIELD_SIGNED) != 0) && (width < 4)
+        && ((value & (0x80UL << ((width - 1) * 8))) != 0)) {
+        value |= 0xFFFFFFFFUL << (width * 8);
+    }
+
+    return (int32_t) value;
+}
+
+/**
+ * @brief Write 32-bit value as MSB-first field
+ *
+ * @param data field bytes
+ * @param descr field descriptor
+ * @param value field value
+ */
+static void ketCube_tsCodec_PutField(uint8_t * data, uint8_t descr,
+                                     int32_t value)
+{
+    uint8_t width = descr & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+    uint8_t i;
+
+    for (i = width; i > 0; i--) {
+        data[i - 1] = (uint8_t) value;
+        value = (int32_t) (((uint32_t) value) >> 8);
+    }
+}
+
+/**
+ * @brief Encode record
+ *
+ * The codec state is updated only if the whole record fits.
+ *
+ * @param ctx codec state
+ * @param record record to encode
+ * @param recordLen record length
+ * @param out output buffer
+ * @param outLen output buffer space
+ *
+ * @retval # of bytes written; 0 if out of space
+ */
+uint8_t ketCube_tsCodec_Encode(ketCube_tsCodec_t * ctx,
+                               const uint8_t * record, uint8_t recordLen,
+                               uint8_t * out, uint8_t outLen)
+{
+    int32_t value[KETCUBE_TSCODEC_MAX_FIELDS];
+    int32_t delta[KETCUBE_TSCODEC_MAX_FIELDS];
+    uint8_t pos = 0;
+    uint8_t len = 0;
+    uint8_t width;
+    uint8_t n;
+    uint8_t i;
+
+    for (i = 0; (i < ctx->fieldCnt) && (pos < recordLen); i++) {
+        width = ctx->field[i] & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+        if ((pos + width) > recordLen) {
+            break;
+        }
+
+        value[i] = ketCube_tsCodec_GetField(&(record[pos]), ctx->field[i]);
+        delta[i] = (int32_t) ((uint32_t) value[i] - (uint32_t) ctx->prev[i]);
+
+        switch ((ctx->field[i] & KETCUBE_TSCODEC_FIELD_CODEC_MASK) >>
+                KETCUBE_TSCODEC_FIELD_CODEC_SHIFT) {
+        case KETCUBE_TSCODEC_DELTA:
+            n = ketCube_tsCodec_PutVarint(&(out[len]), outLen - len,
+                                          ketCube_tsCodec_ZigZag(delta[i]));
+            break;
+        case KETCUBE_TSCODEC_DOD:
+            n = ketCube_tsCodec_PutVarint(&(out[len]), outLen - len,
+                                          ketCube_tsCodec_ZigZag((int32_t)
+                                                                 ((uint32_t) delta[i] - (uint32_t) ctx->prevDelta[i])));
+            break;
+        default:
+            n = ((len + width) <= outLen) ? width : 0;
+            if (n > 0) {
+                memcpy(&(out[len]), &(record[pos]), width);
+            }
+            break;
+        }
+
+        if (n == 0) {
+            return 0;
+        }
+
+        len += n;
+        pos += width;
+    }
+
+    /* trailing bytes not covered by descriptors */
+    if ((len + (recordLen - pos)) > outLen) {
+        return 0;
+    }
+    memcpy(&(out[len]), &(record[pos]), recordLen - pos);
+    len += recordLen - pos;
+
+    /* commit */
+    n = i;
+    for (i = 0; i < n; i++) {
+        ctx->prevDelta[i] = delta[i];
+        ctx->prev[i] = value[i];
+    }
+
+    return len;
+}
+
+/**
+ * @brief Decode record
+ *
+ * The inverse of ketCube_tsCodec_Encode(); the codec state is updated only
+ * if the whole record is decoded.
+ *
+ * @param ctx codec state
+ * @param in encoded record
+ * @param inLen input length available
+ * @param record decoded record
+ * @param recordLen original record length
+ *
+ * @retval # of bytes read; 0 if the input is truncated
+ */
+uint8_t ketCube_tsCodec_Decode(ketCube_tsCodec_t * ctx, const uint8_t * in,
+                               uint8_t inLen, uint8_t * record,
+                               uint8_t recordLen)
+{
+    int32_t value[KETCUBE_TSCODEC_MAX_FIELDS];
+    int32_t delta[KETCUBE_TSCODEC_MAX_FIELDS];
+    uint32_t code;
+    uint8_t pos = 0;
+    uint8_t len = 0;
+    uint8_t width;
+    uint8_t n;
+    uint8_t i;
+
+    for (i = 0; (i < ctx->fieldCnt) && (pos < recordLen); i++) {
+        width = ctx->field[i] & KETCUBE_TSCODEC_FIELD_WIDTH_MASK;
+        if ((pos + width) > recordLen) {
+            break;
+        }
+
+        switch ((ctx->field[i] & KETCUBE_TSCODEC_FIELD_CODEC_MASK) >>
+                KETCUBE_TSCODEC_FIELD_CODEC_SHIFT) {
+        case KETCUBE_TSCODEC_DELTA:
+            n = ketCube_tsCodec_GetVarint(&(in[len]), inLen - len, &code);
+            delta[i] = ketCube_tsCodec_UnZigZag(code);
+            value[i] = (int32_t) ((uint32_t) ctx->prev[i] + (uint32_t) delta[i]);
+            break;
+        case KETCUBE_TSCODEC_DOD:
+            n = ketCube_tsCodec_GetVarint(&(in[len]), inLen - len, &code);
+            delta[i] = (int32_t) ((uint32_t) ctx->prevDelta[i] +
+                                  (uint32_t) ketCube_tsCodec_UnZigZag(code));
+            value[i] = (int32_t) ((uint32_t) ctx->prev[i] + (uint32_t) delta[i]);
+            break;
+        default:
+            n = ((len + width) <= inLen) ? width : 0;
+            if (n > 0) {
+                value[i] = ketCube_tsCodec_GetField(&(in[len]), ctx->field[i]);
+                delta[i] = (int32_t) ((uint32_t) value[i] - (uint32_t) ctx->prev[i]);
+            }
+            break;
+        }
+
+        if (n == 0) {
+            return 0;
+        }
+
+        /* width-truncated value, as seen by the encoder */
+        ketCube_tsCodec_PutField(&(record[pos]), ctx->field[i], value[i]);
+        value[i] = ketCube_tsCodec_GetField(&(record[pos]), ctx->field[i]);
+
+        len += n;
+        pos += width;
+    }
+
+    /* trailing bytes not covered by descriptors */
+    if ((len + (recordLen - pos)) > inLen) {
+        return 0;
+    }
+    memcpy(&(record[pos]), &(in[len]), recordLen - pos);
+    len += recordLen - pos;
+
+    /* commit */
+    n = i;
+    for (i = 0; i < n; i++) {
+        ctx->prevDelta[i] = delta[i];
+        ctx->prev[i] = value[i];
+    }
+
+    return len;
+}
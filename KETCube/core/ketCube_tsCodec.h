@@ -0,0 +1,143 @@
+/**
+ * @file    ketCube_tsCodec.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube time-series record codec
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_TSCODEC_H
+#define __KETCUBE_TSCODEC_H
+
+#include "ketCube_common.h"
+
+/** @defgroup KETCube_tsCodec KETCube time-series codec
+  * @brief Compression of consecutive sensor records for batched uplinks
+  *
+  * A record is a sequence of fixed-width MSB-first fields, as produced by
+  * modules into SensorBuffer. Each field is described by a single byte:
+  *  - bits 0-2: width in bytes (1 - 4); 0 terminates the field list
+  *  - bit 3: signed value
+  *  - bits 4-5: codec (RAW, DELTA, DOD)
+  *
+  * DELTA and DOD (delta-of-delta) fields are emitted as zig-zag varints;
+  * slowly changing values thus take a single byte. The codec state is
+  * zero after ketCube_tsCodec_Reset(), so the first record of a batch is
+  * self-contained. Record bytes not covered by field descriptors are
+  * copied RAW. See supportTools/tsDecode.py for the host decoder;
+  * ketCube_tsCodec_Decode() restores records stored by @ref KETCube_dataLog.
+  *
+  * @ingroup KETCube_Core
+  * @{
+  */
+
+#define KETCUBE_TSCODEC_MAX_FIELDS          8          ///< Maximum number of described fields
+
+#define KETCUBE_TSCODEC_FIELD_WIDTH_MASK    0x07       ///< Field width in bytes
+#define KETCUBE_TSCODEC_FIELD_SIGNED        0x08       ///< Signed field
+#define KETCUBE_TSCODEC_FIELD_CODEC_SHIFT   4          ///< Field codec position
+#define KETCUBE_TSCODEC_FIELD_CODEC_MASK    0x30       ///< Field codec mask
+
+#define KETCUBE_TSCODEC_VARINT_MAX_LEN      5          ///< Maximum varint length (32-bit value)
+
+/**
+* @brief Field codec
+*/
+typedef enum {
+    KETCUBE_TSCODEC_RAW   = 0,  ///< Field copied as-is
+    KETCUBE_TSCODEC_DELTA = 1,  ///< Difference to the previous record
+    KETCUBE_TSCODEC_DOD   = 2,  ///< Difference of the difference to the previous record
+} ketCube_tsCodec_codec_t;
+
+/**
+* @brief Codec state
+*/
+typedef struct {
+    uint8_t fieldCnt;                               ///< # of described fields
+    uint8_t field[KETCUBE_TSCODEC_MAX_FIELDS];      ///< Field descriptors
+    int32_t prev[KETCUBE_TSCODEC_MAX_FIELDS];       ///< Previous field values
+    int32_t prevDelta[KETCUBE_TSCODEC_MAX_FIELDS];  ///< Previous field deltas
+} ketCube_tsCodec_t;
+
+/** @defgroup KETCube_tsCodec_fn Public Functions
+* @{
+*/
+
+/**
+ * @brief Zig-zag map a signed value, so small magnitudes give small codes
+ */
+static inline uint32_t ketCube_tsCodec_ZigZag(int32_t value)
+{
+    return (((uint32_t) value) << 1) ^ ((uint32_t) (value >> 31));
+}
+
+/**
+ * @brief Inverse of ketCube_tsCodec_ZigZag()
+ */
+static inline int32_t ketCube_tsCodec_UnZigZag(uint32_t code)
+{
+    return (int32_t) ((code >> 1) ^ (0 - (code & 1)));
+}
+
+extern void ketCube_tsCodec_Init(ketCube_tsCodec_t * ctx,
+                                 const uint8_t * fields, uint8_t maxFields);
+extern void ketCube_tsCodec_Reset(ketCube_tsCodec_t * ctx);
+extern int32_t ketCube_tsCodec_GetField(const uint8_t * data, uint8_t descr);
+extern uint8_t ketCube_tsCodec_PutVarint(uint8_t * out, uint8_t outLen,
+                                         uint32_t value);
+extern uint8_t ketCube_tsCodec_GetVarint(const uint8_t * in, uint8_t inLen,
+                                         uint32_t * value);
+extern uint8_t ketCube_tsCodec_Encode(ketCube_tsCodec_t * ctx,
+                                      const uint8_t * record,
+                                      uint8_t recordLen, uint8_t * out,
+                                      uint8_t outLen);
+extern uint8_t ketCube_tsCodec_Decode(ketCube_tsCodec_t * ctx,
+                                      const uint8_t * in, uint8_t inLen,
+                                      uint8_t * record, uint8_t recordLen);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_TSCODEC_H */
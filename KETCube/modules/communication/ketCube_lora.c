@@ -63,6 +63,10 @@
 #include "ketCube_spi.h"
 #include "ketCube_ad.h"
 #include "ketCube_batMeas.h"
+#include "ketCube_batPolicy.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_dataLog.h"
+#include "ketCube_timeSync.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_LORA
 
@@ -95,6 +99,21 @@
 #define LORAWAN_REMOTE_TERMINAL_PORT                13
 #define LORAWAN_UART2WAN_PORT                       14
 
+/*!
+ * LoRaWAN port for batched sensor records, see ketCube_lora_Batch()
+ */
+#define LORAWAN_BATCH_PORT                          15
+
+/*!
+ * LoRaWAN port for queued (store-and-forward) records, see ketCube_lora_SfqDrain(); queued batches are resent on LORAWAN_BATCH_PORT
+ */
+#define LORAWAN_SFQ_PORT                            16
+
+/*!
+ * LoRaWAN port for logged records: downlink requests a time range, uplinks stream the records, see ketCube_lora_LogStream()
+ */
+#define LORAWAN_LOG_PORT                            17
+
 /**
  *  LoRa module configuration storage
  */
@@ -117,6 +136,57 @@ static void ketCube_lora_MacProcessNotify(void);
 
 static void ketCube_lora_DataConfirm(void);
 
+static void ketCube_lora_TxDone(TimerTime_t timeOnAir);
+
+static void ketCube_lora_DeviceTimeUpdated(void);
+
+/* Batched records */
+static ketCube_tsCodec_t batchCodec;
+static uint8_t batchBuff[KETCUBE_LORA_BATCH_BUFFER_LEN];
+static uint8_t batchLen = KETCUBE_LORA_BATCH_DATA_OFFSET;
+static uint8_t batchRecLen = 0;
+static uint8_t batchCnt = 0;
+static uint32_t batchFirst = 0;
+static uint32_t batchLast = 0;
+static TimerEvent_t batchTimer;
+static volatile bool evntBatchDeadline = FALSE;
+static uint8_t batchRest[KETCUBE_LORA_BATCH_BUFFER_LEN];
+static uint8_t batchRecord[UINT8_MAX];
+
+static ketCube_cfg_ModError_t ketCube_lora_BatchFlush(bool keepOnError);
+static void ketCube_lora_BatchDeadline(void *context);
+static ketCube_cfg_ModError_t ketCube_lora_Batch(uint8_t * record, uint8_t recLen,
+                                                 uint32_t time);
+
+/* Store-and-forward queue */
+static TimerEvent_t sfqTimer;
+static volatile bool evntSfqDrain = FALSE;
+static uint8_t sfqBuff[1 + KETCUBE_TSCODEC_VARINT_MAX_LEN + KETCUBE_SFQUEUE_DATA_LEN];
+static ketCube_sfQueue_record_t sfqRec;
+
+static void ketCube_lora_SfqSchedule(void);
+static void ketCube_lora_SfqDrainTimer(void *context);
+static void ketCube_lora_SfqDrain(void);
+static ketCube_cfg_ModError_t ketCube_lora_SendOrQueue(lora_AppData_t * AppData,
+                                                        uint32_t age);
+
+/* Logged records */
+static TimerEvent_t logTimer;
+static volatile bool evntLogStream = FALSE;
+static bool logActive = FALSE;
+static bool logRestart = FALSE;
+static uint32_t logFrom = 0;
+static uint32_t logTo = 0;
+static ketCube_dataLog_cursor_t logCursor;
+static uint8_t logBuff[KETCUBE_LORA_BATCH_BUFFER_LEN];
+
+static void ketCube_lora_LogSchedule(void);
+static void ketCube_lora_LogStreamTimer(void *context);
+static void ketCube_lora_LogRequest(uint8_t * buffer, uint8_t len);
+static void ketCube_lora_LogStream(void);
+
+static void ketCube_lora_PowerPolicy(void);
+static void ketCube_lora_TimeSync(void);
 static ketCube_cfg_ModError_t ketCube_lora_SendData(lora_AppData_t * AppData);
 
 /* Events - move println from ISR */
@@ -137,7 +207,9 @@ static LoRaMainCallback_t LoRaMainCallbacks =  {ketCube_batMeas_GetBatteryByte,
                                                 ketCube_lora_ConfirmClass,
                                                 ketCube_lora_TxNeeded,
                                                 ketCube_lora_MacProcessNotify,
-                                                ketCube_lora_DataConfirm};
+                                                ketCube_lora_DataConfirm,
+                                                ketCube_lora_TxDone,
+                                                ketCube_lora_DeviceTimeUpdated};
 
 LoraFlagStatus LoraMacProcessRequest = LORA_RESET;
 
@@ -209,6 +281,18 @@ ketCube_cfg_ModError_t ketCube_lora_Init(ketCube_InterModMsg_t *** msg)
        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Invalid uplink datarate: %d", ketCube_lora_moduleCfg.txDatarate);
     }
     
+    ketCube_tsCodec_Init(&batchCodec, &(ketCube_lora_moduleCfg.batchFields[0]),
+                         KETCUBE_LORA_BATCH_MAX_FIELDS);
+    TimerInit(&batchTimer, &ketCube_lora_BatchDeadline);
+    
+    ketCube_sfQueue_Init();
+    TimerInit(&sfqTimer, &ketCube_lora_SfqDrainTimer);
+    TimerInit(&logTimer, &ketCube_lora_LogStreamTimer);
+    if (ketCube_sfQueue_Count() > 0) {
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Queued records: %d", ketCube_sfQueue_Count());
+        ketCube_lora_SfqSchedule();
+    }
+    
     LORA_Init(&LoRaMainCallbacks, &LoRaParamInit);     
     
     LORA_Join();
@@ -216,6 +300,594 @@ ketCube_cfg_ModError_t ketCube_lora_Init(ketCube_InterModMsg_t *** msg)
     return KETCUBE_CFG_MODULE_OK;
 }
 
+/**
+ * @brief Get batch payload limit
+ * 
+ * The limit is the maximum application payload of the datarate used for the
+ * next uplink (ADR included) less the pending MAC commands.
+ * 
+ * @retval max. batch payload length
+ */
+static uint8_t ketCube_lora_BatchLimit(void)
+{
+    LoRaMacTxInfo_t txInfo;
+    uint8_t limit;
+    
+    if (LoRaMacQueryTxPossible(0, &txInfo) == LORAMAC_STATUS_OK) {
+        limit = txInfo.MaxPossibleApplicationDataSize;
+    } else {
+        /* MAC commands do not fit - they are sent in an empty frame first */
+        limit = txInfo.CurrentPossiblePayloadSize;
+    }
+    
+    if (limit > KETCUBE_LORA_BATCH_BUFFER_LEN) {
+        limit = KETCUBE_LORA_BATCH_BUFFER_LEN;
+    }
+    
+    return limit;
+}
+
+/**
+ * @brief Find the leading batched records, which fit into the given length
+ * 
+ * The records are decoded from the first one.
+ * 
+ * @param dec decoder; its state after the last record fitting
+ * @param end max. end of the records (batchBuff offset)
+ * @param cnt # of records fitting
+ * @param time time of the last record fitting
+ * 
+ * @retval end of the last record fitting (batchBuff offset)
+ */
+static uint8_t ketCube_lora_BatchFit(ketCube_tsCodec_t * dec, uint8_t end,
+                                     uint8_t * cnt, uint32_t * time)
+{
+    ketCube_tsCodec_t next;
+    uint8_t pos = KETCUBE_LORA_BATCH_DATA_OFFSET;
+    uint32_t dt;
+    uint8_t n, m;
+    
+    ketCube_tsCodec_Init(dec, &(ketCube_lora_moduleCfg.batchFields[0]),
+                         KETCUBE_LORA_BATCH_MAX_FIELDS);
+    *cnt = 0;
+    *time = batchFirst;
+    
+    while (*cnt < batchCnt) {
+        next = *dec;
+        n = ketCube_tsCodec_GetVarint(&(batchBuff[pos]), batchLen - pos, &dt);
+        m = 0;
+        if (n > 0) {
+            m = ketCube_tsCodec_Decode(&next, &(batchBuff[pos + n]), batchLen - pos - n,
+                                       &(batchRecord[0]), batchRecLen);
+        }
+        if ((m == 0) || ((pos + n + m) > end)) {
+            break;
+        }
+        *dec = next;
+        *time += dt;
+        pos += n + m;
+        (*cnt)++;
+    }
+    
+    return pos;
+}
+
+/**
+ * @brief Send batched records
+ * 
+ * Payload: record count, record length, age of the first record in seconds
+ * (varint), records; a record is the time since the previous record in
+ * seconds (varint) and the compressed record.
+ * 
+ * The header is placed right before the first record; the age is taken
+ * at send time.
+ * 
+ * If the batch exceeds the max. payload (ADR lowered the DR), it is split
+ * at a record boundary: the leading records are sent, the others are
+ * decoded and batched again.
+ * 
+ * @param keepOnError keep the batch if it cannot be sent now
+ */
+static ketCube_cfg_ModError_t ketCube_lora_BatchFlush(bool keepOnError)
+{
+    static bool splitting = FALSE;
+    lora_AppData_t AppData;
+    ketCube_tsCodec_t dec;
+    ketCube_cfg_ModError_t retval;
+    uint8_t age[KETCUBE_LORA_BATCH_AGE_LEN];
+    uint32_t ageS = ketCube_timeSync_GetAge(batchFirst);
+    uint8_t limit = ketCube_lora_BatchLimit();
+    uint8_t end = batchLen;
+    uint8_t cnt = batchCnt;
+    uint8_t start, restLen, restCnt;
+    uint32_t time = 0;
+    uint32_t dt;
+    uint8_t n, m;
+    
+    if (ageS > KETCUBE_LORA_BATCH_MAX_AGE) {
+        ageS = KETCUBE_LORA_BATCH_MAX_AGE;
+    }
+    n = ketCube_tsCodec_PutVarint(&(age[0]), KETCUBE_LORA_BATCH_AGE_LEN, ageS);
+    start = KETCUBE_LORA_BATCH_AGE_LEN - n;
+    
+    batchBuff[start] = batchCnt;
+    batchBuff[start + 1] = batchRecLen;
+    memcpy(&(batchBuff[start + KETCUBE_LORA_BATCH_HEADER_LEN]), &(age[0]), n);
+    
+    if (((batchLen - start) > limit) && (splitting == FALSE)) {
+        /* LORA_send() would replace the payload by an empty frame */
+        end = ketCube_lora_BatchFit(&dec, start + limit, &cnt, &time);
+        batchBuff[start] = cnt;
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Batch (%d B) exceeds max. payload after DR change; split after %d of %d records",
+                                     batchLen - start, cnt, batchCnt);
+    }
+    
+    AppData.Buff = &(batchBuff[start]);
+    AppData.BuffSize = end - start;
+    AppData.Port = LORAWAN_BATCH_PORT;
+    
+    if ((cnt == 0) || (AppData.BuffSize > limit)) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Batched record exceeds max. payload after DR change; batch dropped");
+        retval = KETCUBE_CFG_MODULE_ERROR;
+        end = batchLen;
+        cnt = batchCnt;
+    } else if (keepOnError == TRUE) {
+        retval = ketCube_lora_SendData(&AppData);
+        if (retval != KETCUBE_CFG_MODULE_OK) {
+            return retval;
+        }
+    } else {
+        retval = ketCube_lora_SendOrQueue(&AppData, 0);
+    }
+    
+    restLen = batchLen - end;
+    restCnt = batchCnt - cnt;
+    memcpy(&(batchRest[0]), &(batchBuff[end]), restLen);
+    
+    TimerStop(&batchTimer);
+    batchLen = KETCUBE_LORA_BATCH_DATA_OFFSET;
+    batchCnt = 0;
+    ketCube_tsCodec_Reset(&batchCodec);
+    
+    /* batch the records, which did not fit, again; the batch is not split twice */
+    if (restCnt > 0) {
+        splitting = TRUE;
+        end = 0;
+        while (restCnt-- > 0) {
+            n = ketCube_tsCodec_GetVarint(&(batchRest[end]), restLen - end, &dt);
+            m = 0;
+            if (n > 0) {
+                m = ketCube_tsCodec_Decode(&dec, &(batchRest[end + n]), restLen - end - n,
+                                           &(batchRecord[0]), batchRecLen);
+            }
+            if (m == 0) {
+                retval = KETCUBE_CFG_MODULE_ERROR;
+                break;
+            }
+            end += n + m;
+            time += dt;
+            if (ketCube_lora_Batch(&(batchRecord[0]), batchRecLen, time) != KETCUBE_CFG_MODULE_OK) {
+                retval = KETCUBE_CFG_MODULE_ERROR;
+            }
+        }
+        splitting = FALSE;
+    }
+    
+    return retval;
+}
+
+/**
+ * @brief Batch latency deadline expired
+ */
+static void ketCube_lora_BatchDeadline(void *context)
+{
+    evntBatchDeadline = TRUE;
+}
+
+/**
+ * @brief Append time delta and compressed record to the batch
+ * 
+ * @retval # of bytes written; 0 if the record does not fit
+ */
+static uint8_t ketCube_lora_BatchEncode(uint8_t * record, uint8_t recLen,
+                                        uint32_t time, uint8_t limit)
+{
+    uint8_t n, m;
+    
+    if (batchLen >= limit) {
+        return 0;
+    }
+    
+    n = ketCube_tsCodec_PutVarint(&(batchBuff[batchLen]), limit - batchLen,
+                                  (batchCnt > 0) ? time - batchLast : 0);
+    if ((n == 0) || ((batchLen + n) >= limit)) {
+        return 0;
+    }
+    
+    m = ketCube_tsCodec_Encode(&batchCodec, record, recLen,
+                               &(batchBuff[batchLen + n]), limit - batchLen - n);
+    if (m == 0) {
+        return 0;
+    }
+    
+    return n + m;
+}
+
+/**
+ * @brief Compress record into batch; send batch when full
+ * 
+ * The batch is sent when the next record would exceed the max. payload
+ * of the current datarate, when batchSize records are collected or when
+ * the oldest record is batchMaxDelay old.
+ * 
+ * @param record sensor record (SensorBuffer)
+ * @param recLen record length
+ * @param time record time, see ketCube_timeSync_GetStamp()
+ */
+static ketCube_cfg_ModError_t ketCube_lora_Batch(uint8_t * record, uint8_t recLen,
+                                                 uint32_t time)
+{
+    ketCube_cfg_ModError_t retval = KETCUBE_CFG_MODULE_OK;
+    uint8_t limit = ketCube_lora_BatchLimit();
+    uint32_t age;
+    uint8_t n = 0;
+    
+    if (recLen == 0) {
+        return KETCUBE_CFG_MODULE_OK;
+    }
+    
+    /* record layout changed */
+    if ((batchCnt > 0) && (recLen != batchRecLen)) {
+        retval = ketCube_lora_BatchFlush(FALSE);
+    }
+    
+    n = ketCube_lora_BatchEncode(record, recLen, time, limit);
+    if ((n == 0) && (batchCnt > 0)) {
+        if (ketCube_lora_BatchFlush(FALSE) != KETCUBE_CFG_MODULE_OK) {
+            retval = KETCUBE_CFG_MODULE_ERROR;
+        }
+        n = ketCube_lora_BatchEncode(record, recLen, time, limit);
+    }
+    if (n == 0) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Record does not fit into batch: %d B (max. %d B)", recLen, limit);
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    if (batchCnt == 0) {
+        batchFirst = time;
+        if (ketCube_lora_moduleCfg.batchMaxDelay > 0) {
+            /* records batched again after a split may be late already */
+            age = ketCube_timeSync_GetAge(time);
+            TimerSetValue(&batchTimer, (age < ketCube_lora_moduleCfg.batchMaxDelay) ?
+                          (ketCube_lora_moduleCfg.batchMaxDelay - age) * 1000 : KETCUBE_LORA_BATCH_RETRY_MS);
+            TimerStart(&batchTimer);
+        }
+    }
+    
+    batchLen += n;
+    batchLast = time;
+    batchRecLen = recLen;
+    batchCnt++;
+    
+    ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LORA, "Batched record %d: %d B -> %d B; batch %d/%d B",
+                                     batchCnt, recLen, n, batchLen, limit);
+    
+    if (batchCnt >= ketCube_lora_moduleCfg.batchSize) {
+        if (ketCube_lora_BatchFlush(FALSE) != KETCUBE_CFG_MODULE_OK) {
+            retval = KETCUBE_CFG_MODULE_ERROR;
+        }
+    }
+    
+    return retval;
+}
+
+/**
+ * @brief Schedule the next queued uplink
+ */
+static void ketCube_lora_SfqSchedule(void)
+{
+    TimerSetValue(&sfqTimer, KETCUBE_LORA_SFQ_DRAIN_MS);
+    TimerStart(&sfqTimer);
+}
+
+/**
+ * @brief Queued uplink timer expired
+ */
+static void ketCube_lora_SfqDrainTimer(void *context)
+{
+    evntSfqDrain = TRUE;
+}
+
+/**
+ * @brief Send the oldest queued record
+ * 
+ * Payload: original port, record age in seconds (varint), record
+ * 
+ * Batches are resent on LORAWAN_BATCH_PORT as they are, the age of the
+ * first record in the batch header is increased by the queueing time;
+ * the batch does not grow as the age varint space is reserved in the batch.
+ * 
+ * A single record is sent per call; the MAC refuses the uplink when busy
+ * or duty-cycle restricted and the record is retried later. Records, which
+ * do not fit into the max. payload of the current DR, wait for a higher DR.
+ */
+static void ketCube_lora_SfqDrain(void)
+{
+    ketCube_sfQueue_record_t *rec = &sfqRec;
+    lora_AppData_t AppData;
+    LoRaMacTxInfo_t txInfo;
+    uint32_t age = 0;
+    uint32_t batchAge = 0;
+    uint8_t len, n;
+    
+    while (ketCube_sfQueue_Peek(rec) == KETCUBE_CFG_MODULE_OK) {
+        age = ketCube_sfQueue_Now() - rec->timestamp;
+        if ((ketCube_lora_moduleCfg.sfqMaxAge == 0)
+            || (age <= ketCube_lora_moduleCfg.sfqMaxAge)) {
+            break;
+        }
+        ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LORA, "Queued record expired: %d s", age);
+        ketCube_sfQueue_Pop();
+    }
+    
+    if (ketCube_sfQueue_Count() == 0) {
+        return;
+    }
+    
+    if (LORA_JoinStatus() != LORA_SET) {
+        ketCube_lora_SfqSchedule();
+        return;
+    }
+    
+    n = 0;
+    if ((rec->port == LORAWAN_BATCH_PORT) && (rec->len > KETCUBE_LORA_BATCH_HEADER_LEN)) {
+        n = ketCube_tsCodec_GetVarint(&(rec->data[KETCUBE_LORA_BATCH_HEADER_LEN]),
+                                      rec->len - KETCUBE_LORA_BATCH_HEADER_LEN, &batchAge);
+    }
+    
+    if (n > 0) {
+        batchAge += age;
+        if (batchAge > KETCUBE_LORA_BATCH_MAX_AGE) {
+            batchAge = KETCUBE_LORA_BATCH_MAX_AGE;
+        }
+        memcpy(&(sfqBuff[0]), &(rec->data[0]), KETCUBE_LORA_BATCH_HEADER_LEN);
+        len = KETCUBE_LORA_BATCH_HEADER_LEN;
+        len += ketCube_tsCodec_PutVarint(&(sfqBuff[len]), KETCUBE_LORA_BATCH_AGE_LEN, batchAge);
+        memcpy(&(sfqBuff[len]), &(rec->data[KETCUBE_LORA_BATCH_HEADER_LEN + n]),
+               rec->len - KETCUBE_LORA_BATCH_HEADER_LEN - n);
+        len += rec->len - KETCUBE_LORA_BATCH_HEADER_LEN - n;
+        AppData.Port = LORAWAN_BATCH_PORT;
+    } else {
+        sfqBuff[0] = rec->port;
+        len = 1 + ketCube_tsCodec_PutVarint(&(sfqBuff[1]), KETCUBE_TSCODEC_VARINT_MAX_LEN, age);
+        memcpy(&(sfqBuff[len]), &(rec->data[0]), rec->len);
+        len += rec->len;
+        AppData.Port = LORAWAN_SFQ_PORT;
+    }
+    
+    if (LoRaMacQueryTxPossible(len, &txInfo) != LORAMAC_STATUS_OK) {
+        ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LORA, "Queued record (%d B) exceeds max. payload (%d B)", len, txInfo.MaxPossibleApplicationDataSize);
+        ketCube_lora_SfqSchedule();
+        return;
+    }
+    
+    AppData.Buff = &(sfqBuff[0]);
+    AppData.BuffSize = len;
+    
+    ketCube_lora_PowerPolicy();
+    ketCube_lora_TimeSync();
+    if (LORA_send(&AppData, LORAWAN_DEFAULT_CONFIRM_MSG_STATE) == LORA_SUCCESS) {
+        ketCube_sfQueue_Pop();
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Transmitting queued data: SUCCESS; %d left", ketCube_sfQueue_Count());
+    }
+    
+    if (ketCube_sfQueue_Count() > 0) {
+        ketCube_lora_SfqSchedule();
+    }
+}
+
+/**
+ * @brief Schedule the next logged-record uplink
+ */
+static void ketCube_lora_LogSchedule(void)
+{
+    TimerSetValue(&logTimer, KETCUBE_LORA_LOG_STREAM_MS);
+    TimerStart(&logTimer);
+}
+
+/**
+ * @brief Logged-record uplink timer expired
+ */
+static void ketCube_lora_LogStreamTimer(void *context)
+{
+    evntLogStream = TRUE;
+}
+
+/**
+ * @brief Process logged-record request
+ * 
+ * Payload: age of the oldest and of the newest requested record in seconds
+ * (varints); the newest age may be omitted (0: up to now). A new request
+ * replaces the one in progress.
+ */
+static void ketCube_lora_LogRequest(uint8_t * buffer, uint8_t len)
+{
+    uint32_t fromAge, toAge = 0;
+    uint32_t now = ketCube_dataLog_Now();
+    uint8_t n;
+    
+    n = ketCube_tsCodec_GetVarint(buffer, len, &fromAge);
+    if (n == 0) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Invalid log request");
+        return;
+    }
+    if (n < len) {
+        if (ketCube_tsCodec_GetVarint(&(buffer[n]), len - n, &toAge) == 0) {
+            ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Invalid log request");
+            return;
+        }
+    }
+    
+    logFrom = (fromAge < now) ? now - fromAge : 0;
+    logTo = (toAge < now) ? now - toAge : 0;
+    logActive = TRUE;
+    logRestart = TRUE;
+    
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Log request: %d s - %d s ago", fromAge, toAge);
+    ketCube_lora_LogSchedule();
+}
+
+/**
+ * @brief Send the next logged records of the requested range
+ * 
+ * Payload: record count (bit 7: more records follow), age of the first
+ * record in seconds (varint), records; a record is the record length, time
+ * since the previous record in seconds (varint) and the record compressed
+ * by @ref KETCube_tsCodec (field descriptors: core logFields; the codec is
+ * reset in each uplink). The last uplink of the range may hold no records.
+ * 
+ * Records are packed up to the max. payload of the current DR. The MAC
+ * refuses the uplink when busy or duty-cycle restricted; the records are
+ * retried later.
+ */
+static void ketCube_lora_LogStream(void)
+{
+    ketCube_dataLog_cursor_t start, prev;
+    ketCube_tsCodec_t codec;
+    lora_AppData_t AppData;
+    uint8_t record[KETCUBE_DATALOG_MAX_RECORD_LEN];
+    uint8_t limit = ketCube_lora_BatchLimit();
+    uint8_t cnt = 0;
+    uint8_t len = 1;
+    uint8_t recLen, n, m;
+    uint32_t time, prevTime = 0;
+    bool more = FALSE;
+    
+    if (logActive == FALSE) {
+        return;
+    }
+    
+    if (LORA_JoinStatus() != LORA_SET) {
+        ketCube_lora_LogSchedule();
+        return;
+    }
+    
+    if (logRestart == TRUE) {
+        logRestart = FALSE;
+        ketCube_dataLog_Seek(&logCursor, logFrom);
+    }
+    
+    start = logCursor;
+    ketCube_tsCodec_Init(&codec, &(ketCube_coreCfg.logFields[0]),
+                         KETCUBE_DATALOG_MAX_FIELDS);
+    
+    while (TRUE) {
+        prev = logCursor;
+        if (ketCube_dataLog_Read(&logCursor, &(record[0]), &recLen, &time) != KETCUBE_CFG_MODULE_OK) {
+            logCursor = prev;
+            break;
+        }
+        if (time < logFrom) {
+            continue;
+        }
+        if (time > logTo) {
+            logCursor = prev;
+            break;
+        }
+        
+        if (cnt == 0) {
+            len += ketCube_tsCodec_PutVarint(&(logBuff[len]), limit - len,
+                                             ketCube_dataLog_Now() - time);
+            prevTime = time;
+        }
+        
+        m = 0;
+        n = (len < limit) ? ketCube_tsCodec_PutVarint(&(logBuff[len + 1]), limit - len - 1, time - prevTime) : 0;
+        if (n > 0) {
+            m = ketCube_tsCodec_Encode(&codec, &(record[0]), recLen,
+                                       &(logBuff[len + 1 + n]), limit - len - 1 - n);
+        }
+        if (m == 0) {
+            if (cnt == 0) {
+                ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Logged record does not fit into max. payload (%d B); skipped", limit);
+                len = 1;
+                continue;
+            }
+            logCursor = prev;
+            more = TRUE;
+            break;
+        }
+        
+        logBuff[len] = recLen;
+        len += 1 + n + m;
+        prevTime = time;
+        cnt++;
+        
+        if (cnt == 0x7F) {
+            more = TRUE;
+            break;
+        }
+    }
+    
+    logBuff[0] = cnt | ((more == TRUE) ? 0x80 : 0x00);
+    
+    AppData.Buff = &(logBuff[0]);
+    AppData.BuffSize = len;
+    AppData.Port = LORAWAN_LOG_PORT;
+    
+    ketCube_lora_PowerPolicy();
+    ketCube_lora_TimeSync();
+    if (LORA_send(&AppData, LORAWAN_DEFAULT_CONFIRM_MSG_STATE) != LORA_SUCCESS) {
+        /* MAC busy or duty-cycle restricted -- resend the same records */
+        logCursor = start;
+        ketCube_lora_LogSchedule();
+        return;
+    }
+    
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Transmitting logged data: %d records", cnt);
+    
+    if (more == TRUE) {
+        ketCube_lora_LogSchedule();
+    } else {
+        logActive = FALSE;
+    }
+}
+
+/**
+ * @brief Send data; store them into the store-and-forward queue on failure
+ * 
+ * @param AppData data
+ * @param age data age in seconds; see ketCube_sfQueue_Push()
+ * 
+ * @retval KETCUBE_CFG_MODULE_OK if data are sent or queued
+ */
+static ketCube_cfg_ModError_t ketCube_lora_SendOrQueue(lora_AppData_t * AppData,
+                                                        uint32_t age)
+{
+    if (ketCube_lora_SendData(AppData) == KETCUBE_CFG_MODULE_OK) {
+        /* link is up -- drain queued records */
+        if (ketCube_sfQueue_Count() > 0) {
+            ketCube_lora_SfqSchedule();
+        }
+        return KETCUBE_CFG_MODULE_OK;
+    }
+    
+    if (ketCube_lora_moduleCfg.sfqPolicy == KETCUBE_SFQUEUE_POLICY_DISABLED) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    if (ketCube_sfQueue_Push(AppData->Port, AppData->Buff, AppData->BuffSize, age,
+                             (ketCube_sfQueue_policy_t) ketCube_lora_moduleCfg.sfqPolicy) != KETCUBE_CFG_MODULE_OK) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LORA, "Unable to queue data");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Data queued; %d pending", ketCube_sfQueue_Count());
+    ketCube_lora_SfqSchedule();
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
 /**
  * @brief Process lora state and prepare data...
  */
@@ -223,11 +895,16 @@ ketCube_cfg_ModError_t ketCube_lora_Send(uint8_t * buffer, uint8_t * len)
 {
     lora_AppData_t AppData;
     
+    if (ketCube_lora_moduleCfg.batchSize > 1) {
+        return ketCube_lora_Batch(buffer, *len, ketCube_timeSync_GetStamp());
+    }
+    
     AppData.Buff = buffer;
     AppData.BuffSize = *len;
     AppData.Port = LORAWAN_APP_PORT;
     
-    return ketCube_lora_SendData(&AppData);
+    return ketCube_lora_SendOrQueue(&AppData,
+                                    ketCube_timeSync_GetAge(ketCube_timeSync_GetStamp()));
 }
 
 /**
@@ -310,6 +987,9 @@ ketCube_cfg_ModError_t ketCube_lora_SleepExit(void)
         evntJoined = FALSE;
         ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Joined");
         isJoined = TRUE;
+        if (ketCube_sfQueue_Count() > 0) {
+            ketCube_lora_SfqSchedule();
+        }
     }
     
     if (evntClassSwitched) {
@@ -329,6 +1009,28 @@ ketCube_cfg_ModError_t ketCube_lora_SleepExit(void)
         evntACKRx = FALSE;
         ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LORA, "Network Server \"ack\" an uplink data confirmed message transmission");
     }
+    
+    if (evntBatchDeadline) {
+        evntBatchDeadline = FALSE;
+        if (batchCnt > 0) {
+            ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LORA, "Batch deadline expired");
+            if (ketCube_lora_BatchFlush(TRUE) != KETCUBE_CFG_MODULE_OK) {
+                /* MAC busy or duty-cycle restricted -- retry later */
+                TimerSetValue(&batchTimer, KETCUBE_LORA_BATCH_RETRY_MS);
+                TimerStart(&batchTimer);
+            }
+        }
+    }
+    
+    if (evntSfqDrain) {
+        evntSfqDrain = FALSE;
+        ketCube_lora_SfqDrain();
+    }
+    
+    if (evntLogStream) {
+        evntLogStream = FALSE;
+        ketCube_lora_LogStream();
+    }
    
    
     return KETCUBE_CFG_MODULE_OK;  
@@ -347,6 +1049,55 @@ __weak void ketCube_lora_processCustomData(uint8_t * buffer, uint8_t len)
 
 }
 
+/**
+ * @brief Apply TX power and transmission caps of the battery policy
+ * 
+ * The caps are re-applied before each uplink, as ADR may raise the TX power
+ * or the # of transmissions in the meantime.
+ */
+static void ketCube_lora_PowerPolicy(void)
+{
+   const ketCube_batPolicy_tier_t * tier = ketCube_batPolicy_GetTier();
+   MibRequestConfirm_t mibReq;
+   
+   if (tier->txPowerMin != 0) {
+      mibReq.Type = MIB_CHANNELS_TX_POWER;
+      if ((LoRaMacMibGetRequestConfirm(&mibReq) == LORAMAC_STATUS_OK)
+          && (mibReq.Param.ChannelsTxPower < tier->txPowerMin)) {
+         mibReq.Param.ChannelsTxPower = tier->txPowerMin;
+         LoRaMacMibSetRequestConfirm(&mibReq);
+      }
+   }
+   
+   if (tier->nbTransMax != 0) {
+      mibReq.Type = MIB_CHANNELS_NB_TRANS;
+      if ((LoRaMacMibGetRequestConfirm(&mibReq) == LORAMAC_STATUS_OK)
+          && (mibReq.Param.ChannelsNbTrans > tier->nbTransMax)) {
+         mibReq.Param.ChannelsNbTrans = tier->nbTransMax;
+         LoRaMacMibSetRequestConfirm(&mibReq);
+      }
+   }
+}
+
+/**
+ * @brief Update the RTC drift model; request the network time when due
+ * 
+ * The DeviceTimeReq MAC command is piggy-backed on the next uplink.
+ */
+static void ketCube_lora_TimeSync(void)
+{
+   MlmeReq_t mlmeReq;
+   
+   ketCube_timeSync_SetTemperature((int8_t) ketCube_AD_GetTemperature());
+   
+   if (ketCube_timeSync_RequestDue() == TRUE) {
+      mlmeReq.Type = MLME_DEVICE_TIME;
+      if (LoRaMacMlmeRequest(&mlmeReq) == LORAMAC_STATUS_OK) {
+         ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LORA, "Network time requested");
+      }
+   }
+}
+
 static ketCube_cfg_ModError_t ketCube_lora_SendData(lora_AppData_t * AppData)
 {
    if (LORA_JoinStatus() != LORA_SET) {
@@ -365,6 +1116,8 @@ static ketCube_cfg_ModError_t ketCube_lora_SendData(lora_AppData_t * AppData)
         }
     }
 
+   ketCube_lora_PowerPolicy();
+   ketCube_lora_TimeSync();
    if (LORA_send(AppData, LORAWAN_DEFAULT_CONFIRM_MSG_STATE) == LORA_SUCCESS) {
       ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LORA, "Transmitting sensor data: SUCCESS");
       return KETCUBE_CFG_MODULE_OK;
@@ -393,6 +1146,9 @@ static void ketCube_lora_RxData(lora_AppData_t * AppData)
       ketCube_remoteTerminal_deferCmd((char*)&(AppData->Buff[0]),
           AppData->BuffSize, &ketCube_lora_RemoteTerminalSend);
       return;
+   } else if (AppData->Port == LORAWAN_LOG_PORT) {
+      ketCube_lora_LogRequest(&(AppData->Buff[0]), AppData->BuffSize);
+      return;
    } else if (AppData->Port == LORAWAN_HEX_DISPLAY_PORT) {
       // NOTE: Continue below this conditional block; do not return!
    } else if (AppData->Port == LORAWAN_STRING_DISPLAY_PORT) {
@@ -490,4 +1246,22 @@ static void ketCube_lora_DataConfirm (void)
     evntACKRx = TRUE;
 }
 
+/**
+ * @brief Network time has been applied by the MAC
+ */
+static void ketCube_lora_DeviceTimeUpdated(void)
+{
+    ketCube_timeSync_Update();
+}
+
+/**
+ * @brief Report the uplink charge to the battery estimator
+ * 
+ * @param timeOnAir time on air in ms
+ */
+static void ketCube_lora_TxDone(TimerTime_t timeOnAir)
+{
+    ketCube_batMeas_AddLoad(timeOnAir * KETCUBE_LORA_TX_CURRENT_MA);
+}
+
 #endif                          /* KETCUBE_CFG_INC_MOD_LORA */
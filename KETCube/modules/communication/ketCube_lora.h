@@ -48,6 +48,8 @@
 
 #include "ketCube_cfg.h"
 #include "ketCube_common.h"
+#include "ketCube_tsCodec.h"
+#include "ketCube_sfQueue.h"
 #ifndef DESKTOP_BUILD
 #include "LoRaMac.h"
 #else
@@ -107,6 +109,17 @@ typedef enum {
    KETCUBE_LORA_CFGLEN_APPSKEY = 16,      /*!< Application session KEY len in bytes */
 } ketCube_lora_cfgLen_t;
 
+#define KETCUBE_LORA_BATCH_MAX_FIELDS      KETCUBE_TSCODEC_MAX_FIELDS  //< Maximum # of batched record field descriptors
+#define KETCUBE_LORA_BATCH_HEADER_LEN      2                           //< Batch header: record count, record length
+#define KETCUBE_LORA_BATCH_AGE_LEN         3                           //< Batch header: space reserved for the age varint
+#define KETCUBE_LORA_BATCH_MAX_AGE         0x1FFFFF                    //< Max. age in the batch header (3-byte varint)
+#define KETCUBE_LORA_BATCH_DATA_OFFSET     (KETCUBE_LORA_BATCH_HEADER_LEN + KETCUBE_LORA_BATCH_AGE_LEN) //< First record in the batch buffer
+#define KETCUBE_LORA_BATCH_BUFFER_LEN      242                         //< Batch buffer length; the DR max. payload limits the batch length
+#define KETCUBE_LORA_BATCH_RETRY_MS        5000                        //< Retry delay, when the batch deadline expires during TX/duty-cycle restriction
+#define KETCUBE_LORA_SFQ_DRAIN_MS          10000                       //< Delay between queued (store-and-forward) uplinks
+#define KETCUBE_LORA_LOG_STREAM_MS         10000                       //< Delay between logged-record uplinks, see @ref KETCube_dataLog
+#define KETCUBE_LORA_TX_CURRENT_MA         44                          //< SX1276 TX supply current at max. power; used to report the TX load to the battery estimator
+
 typedef struct ketCube_lora_cfg_t {
    ketCube_lora_selConnMethod_t connectionType; /*!< Connection type OTAA/ABP */
    ketCube_lora_selDeveui_t     devEUIType;     /*!< devEUI from device or custom devEUI */
@@ -130,6 +143,12 @@ typedef struct ketCube_lora_moduleCfg_t {
    byte appSKey[KETCUBE_LORA_CFGLEN_APPSKEY];          /*!< LoRaWAN Application sesion key */
    DeviceClass_t devClass;                             /*!< Device class  */
    uint8_t txDatarate;                                 /*!< Uplink datarate  */
+   uint8_t batchSize;                                  /*!< Records per batched uplink; 0 or 1 = batching disabled */
+   uint8_t batchFields[KETCUBE_LORA_BATCH_MAX_FIELDS]; /*!< Batched record field descriptors, see @ref KETCube_tsCodec */
+   uint32_t batchMaxDelay;                             /*!< Max. age of the oldest batched record in seconds; 0 = no deadline */
+   uint8_t sfqPolicy;                                  /*!< Store-and-forward queue policy, see ketCube_sfQueue_policy_t; 0 = disabled */
+   uint32_t sfqMaxAge;                                 /*!< Queued records older than this (seconds) are dropped; 0 = no limit */
+   uint8_t RFU[16];                                    /*!< Reserved for future use, decrease size of this field when adding new values to preserve module configuration offsets */
 } ketCube_lora_moduleCfg_t;
 
 extern ketCube_lora_moduleCfg_t ketCube_lora_moduleCfg;
@@ -72,6 +72,24 @@ void ketCube_LoRa_cmd_show_devEUI(void)
     commandIOParams.as_byte_array.length = KETCUBE_LORA_CFGLEN_DEVEUI;
 }
 
+/**
+ * @brief Show # of queued records command callback
+ * 
+ */
+void ketCube_LoRa_cmd_show_sfqCount(void)
+{
+    commandIOParams.as_uint32 = ketCube_sfQueue_Count();
+}
+
+/**
+ * @brief Drop queued records command callback
+ * 
+ */
+void ketCube_LoRa_cmd_set_sfqClear(void)
+{
+    ketCube_sfQueue_Clear();
+}
+
 /**
  * @brief Terminal command definitions 
  */
@@ -385,6 +403,131 @@ ketCube_terminal_cmd_t ketCube_lora_commands[] = {
          .size     = sizeof(uint8_t),
       }
    },
+   
+   {
+      .cmd   = "batchSize",
+      .descr = "Max. records per compressed batch uplink on port 15 (0, 1: disabled); the batch is also sent when full at the current DR",
+      .flags = {
+         .isLocal   = TRUE,
+         .isEEPROM  = TRUE,
+         .isRAM     = TRUE,
+         .isShowCmd = TRUE,
+         .isSetCmd  = TRUE,
+         .isGeneric = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+      .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+         .moduleID = KETCUBE_LISTS_MODULEID_LORA,
+         .offset   = offsetof(ketCube_lora_moduleCfg_t, batchSize),
+         .size     = sizeof(uint8_t),
+      }
+   },
+   
+   {
+      .cmd   = "batchFields",
+      .descr = "Batched record field descriptors (8 bytes HEX, 00-terminated; per byte: bits 0-2 width, bit 3 signed, bits 4-5 codec 0: RAW, 1: DELTA, 2: DOD)",
+      .flags = {
+         .isLocal   = TRUE,
+         .isEEPROM  = TRUE,
+         .isShowCmd = TRUE,
+         .isSetCmd  = TRUE,
+         .isGeneric = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE_ARRAY,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE_ARRAY,
+      .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+         .moduleID = KETCUBE_LISTS_MODULEID_LORA,
+         .offset   = offsetof(ketCube_lora_moduleCfg_t, batchFields),
+         .size     = KETCUBE_LORA_BATCH_MAX_FIELDS,
+      }
+   },
+   
+   {
+      .cmd   = "batchMaxDelay",
+      .descr = "Max. age of the oldest batched record in seconds (0: no deadline)",
+      .flags = {
+         .isLocal   = TRUE,
+         .isEEPROM  = TRUE,
+         .isRAM     = TRUE,
+         .isShowCmd = TRUE,
+         .isSetCmd  = TRUE,
+         .isGeneric = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+      .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+         .moduleID = KETCUBE_LISTS_MODULEID_LORA,
+         .offset   = offsetof(ketCube_lora_moduleCfg_t, batchMaxDelay),
+         .size     = sizeof(uint32_t),
+      }
+   },
+   
+   {
+      .cmd   = "sfqClear",
+      .descr = "Drop all records in the store-and-forward queue",
+      .flags = {
+         .isLocal   = TRUE,
+         .isRAM     = TRUE,
+         .isSetCmd  = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_NONE,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_NONE,
+      .settingsPtr.callback = &ketCube_LoRa_cmd_set_sfqClear,
+   },
+   
+   {
+      .cmd   = "sfqCount",
+      .descr = "# of records in the store-and-forward queue",
+      .flags = {
+         .isLocal   = TRUE,
+         .isRAM     = TRUE,
+         .isShowCmd = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_NONE,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+      .settingsPtr.callback = &ketCube_LoRa_cmd_show_sfqCount,
+   },
+   
+   {
+      .cmd   = "sfqMaxAge",
+      .descr = "Drop queued records older than this (seconds; 0: no limit)",
+      .flags = {
+         .isLocal   = TRUE,
+         .isEEPROM  = TRUE,
+         .isRAM     = TRUE,
+         .isShowCmd = TRUE,
+         .isSetCmd  = TRUE,
+         .isGeneric = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_UINT32,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+      .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+         .moduleID = KETCUBE_LISTS_MODULEID_LORA,
+         .offset   = offsetof(ketCube_lora_moduleCfg_t, sfqMaxAge),
+         .size     = sizeof(uint32_t),
+      }
+   },
+   
+   {
+      .cmd   = "sfqPolicy",
+      .descr = "Store-and-forward queue for unsent uplinks, replayed on port 16, batches on port 15 (0: disabled, 1: drop oldest, 2: drop newest when full)",
+      .flags = {
+         .isLocal   = TRUE,
+         .isEEPROM  = TRUE,
+         .isRAM     = TRUE,
+         .isShowCmd = TRUE,
+         .isSetCmd  = TRUE,
+         .isGeneric = TRUE,
+      },
+      .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+      .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+      .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+         .moduleID = KETCUBE_LISTS_MODULEID_LORA,
+         .offset   = offsetof(ketCube_lora_moduleCfg_t, sfqPolicy),
+         .size     = sizeof(uint8_t),
+      }
+   },
 
    DEF_TERMINATE()
 };
@@ -54,6 +54,7 @@
 #include "ketCube_modules.h"
 
 #include "ketCube_i2c.h"
+#include "ketCube_delay.h"
 #include "ketCube_adc.h"
 #include "ketCube_hdcX080.h"
 #include "ketCube_rxDisplay.h"
@@ -166,9 +167,9 @@ ketCube_cfg_ModError_t ketCube_starNet_SleepEnter(void)
                 // not design-specific ... strange!
                 //
                 
-                HAL_Delay(10);
+                ketCube_delay_LowPower(10);
                 ketCube_starNet_Init(KETCUBE_STARNET_NODE);
-                HAL_Delay(10);
+                ketCube_delay_LowPower(10);
                 
                 moduleState = KETCUBE_STARNET_STATE_TX_READY;
                 break;
@@ -178,7 +179,7 @@ ketCube_cfg_ModError_t ketCube_starNet_SleepEnter(void)
                                  ketCube_common_bytes2Str(&(ketCube_starNet_dataBuff[0]), txBuffer_len));
                 moduleState = KETCUBE_STARNET_STATE_TX_PROGRESS;
                 
-                HAL_Delay(10);
+                ketCube_delay_LowPower(10);
                 
                 Radio.Send(&(ketCube_starNet_dataBuff[0]), txBuffer_len);
                 break;
@@ -52,11 +52,28 @@
 #include "ketCube_adc.h"
 #include "ketCube_ad.h"
 #include "ketCube_terminal.h"
+#include "ketCube_deadband.h"
+#include "ketCube_oversample.h"
+#include "ketCube_modules.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_ADC
 
 ketCube_ADC_moduleCfg_t ketCube_ADC_moduleCfg; /*!< Module configuration storage */
 
+/**
+ * @brief Report-by-exception deadband: 2 %, at least 10 mV
+ */
+static ketCube_deadband_field_t ketCube_ADC_deadband[] = {
+    { .field = 2, .absolute = 10, .relative = 20 },     /* PA4 in mV */
+};
+
+/**
+ * @brief Oversampled fields
+ */
+static ketCube_oversample_field_t ketCube_ADC_oversample[] = {
+    { .field = 2 },                                     /* PA4 in mV */
+};
+
 /**
  * @brief  Configures ADC PIN
  * 
@@ -65,6 +82,11 @@ ketCube_ADC_moduleCfg_t ketCube_ADC_moduleCfg; /*!< Module configuration storage
  */
 ketCube_cfg_ModError_t ketCube_ADC_Init(ketCube_InterModMsg_t *** msg)
 {
+    ketCube_deadband_Declare(KETCUBE_LISTS_MODULEID_ADC,
+                             &(ketCube_ADC_deadband[0]), 1);
+    ketCube_oversample_Declare(KETCUBE_LISTS_MODULEID_ADC,
+                               &(ketCube_ADC_oversample[0]), 1);
+    
     // Init AD driver
     ketCube_AD_Init();
     
@@ -79,6 +101,9 @@ ketCube_cfg_ModError_t ketCube_ADC_Init(ketCube_InterModMsg_t *** msg)
 
     HAL_GPIO_Init(GPIOA, &initStruct);
 
+    // PA4 is converted in the common scan with VREFINT
+    ketCube_AD_EnableChannel(ADC_CHANNEL_4);
+
     return KETCUBE_CFG_MODULE_OK;
 }
 
@@ -103,8 +128,11 @@ ketCube_cfg_ModError_t ketCube_ADC_ReadData(uint8_t * buffer,
     buffer[0] = ((uint8_t) ((mv >> 8) & 0xFF));
     buffer[1] = ((uint8_t) (mv & 0xFF));
 
-    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_ADC,
-                                 "Voltage@PA4: %d", mv);
+    // sub-period samples are summarized in the base period
+    if (ketCube_modules_SubPeriodic() == FALSE) {
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_ADC,
+                                     "Voltage@PA4: %d", mv);
+    }
 
     return KETCUBE_CFG_MODULE_OK;
 }
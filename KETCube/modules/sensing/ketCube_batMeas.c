@@ -52,6 +52,8 @@
 #include "ketCube_batMeas.h"
 #include "ketCube_ad.h"
 #include "ketCube_terminal.h"
+#include "ketCube_deadband.h"
+#include "ketCube_batPolicy.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_BATMEAS
 
@@ -66,12 +68,29 @@ ketCube_batMeas_battery_t ketCube_batMeas_batList[] = {
     {((char *) &("CR2032")),
      ((char *) &("Up to 560mAh battery")),
      3300,
-     2900},
+     2900,
+     {3300, 3100, 3050, 3020, 3000, 2980, 2960, 2940, 2920, 2910, 2900},
+     10000},
 
     {((char *) &("LS33600")),
      ((char *) &("15 Ah battery")),
      3600,
-     2900}
+     2900,
+     {3600, 3590, 3580, 3570, 3560, 3550, 3530, 3500, 3450, 3300, 2900},
+     2000}
+};
+
+static uint32_t filtered = 0;       /*!< Filtered load-compensated battery voltage in 2^-KETCUBE_BATMEAS_FILTER_SHIFT mV; 0 if not measured yet */
+static uint8_t soc = 0;             /*!< Estimated state of charge in % */
+static uint8_t level = 0;           /*!< Cached battery level (1 - 254); 0 if not estimated yet */
+static uint32_t load = 0;           /*!< Recent load charge in uAs at loadTime */
+static TimerTime_t loadTime = 0;    /*!< Time of the last reported load */
+
+/**
+ * @brief Report-by-exception deadband: 2 % of the battery range
+ */
+static ketCube_deadband_field_t ketCube_batMeas_deadband[] = {
+    { .field = 1, .absolute = 5 },      /* battery level 1 - 254 */
 };
 
 /**
@@ -82,6 +101,9 @@ ketCube_batMeas_battery_t ketCube_batMeas_batList[] = {
  */
 ketCube_cfg_ModError_t ketCube_batMeas_Init(ketCube_InterModMsg_t *** msg)
 {
+    ketCube_deadband_Declare(KETCUBE_LISTS_MODULEID_BATMEAS,
+                             &(ketCube_batMeas_deadband[0]), 1);
+    
     // Init AD driver
     ketCube_AD_Init();
     
@@ -109,42 +131,149 @@ ketCube_cfg_ModError_t ketCube_batMeas_DeInit(ketCube_InterModMsg_t ***
     return KETCUBE_CFG_MODULE_OK;
 }
 
+/**
+  * @brief Get the recent load charge decayed to the given time
+  *
+  * @param now current time
+  *
+  * @retval load charge in uAs
+  */
+static uint32_t ketCube_batMeas_Load(TimerTime_t now)
+{
+    TimerTime_t dt = now - loadTime;
+    uint32_t charge = load;
+
+    while ((dt >= KETCUBE_BATMEAS_LOAD_HALFLIFE_MS) && (charge != 0)) {
+        charge >>= 1;
+        dt -= KETCUBE_BATMEAS_LOAD_HALFLIFE_MS;
+    }
+
+    /* linear approximation within a half-life */
+    return charge - (uint32_t) (((uint64_t) charge * dt) /
+                                (2 * KETCUBE_BATMEAS_LOAD_HALFLIFE_MS));
+}
+
+/**
+  * @brief Update the battery estimate
+  *
+  * A sample is taken only if no load was reported for KETCUBE_BATMEAS_QUIET_MS;
+  * the voltage sag still left from the recent load is added to the sample.
+  */
+static void ketCube_batMeas_Estimate(void)
+{
+    TimerTime_t now = TimerGetCurrentTime();
+    uint32_t charge = ketCube_batMeas_Load(now);
+    uint32_t comp;
+    uint32_t mV, filteredmV;
+
+    if ((level != 0) && (charge != 0)
+        && ((now - loadTime) < KETCUBE_BATMEAS_QUIET_MS)) {
+        ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_BATMEAS, "Not quiet; estimate kept");
+        return;
+    }
+
+    mV = ketCube_AD_GetBatLevelmV();
+    if (mV == 0) {
+        return;
+    }
+
+    comp = (uint32_t) (((uint64_t) charge *
+                        ketCube_batMeas_batList[ketCube_batMeas_moduleCfg.selectedBattery].loadGain) / 1000000);
+    mV += comp;
+
+    /* fractional mV are kept, so small steps are not truncated away */
+    if (filtered == 0) {
+        filtered = mV << KETCUBE_BATMEAS_FILTER_SHIFT;
+    } else {
+        filtered = filtered - (filtered >> KETCUBE_BATMEAS_FILTER_SHIFT) + mV;
+    }
+    filteredmV = (filtered + (1 << (KETCUBE_BATMEAS_FILTER_SHIFT - 1))) >> KETCUBE_BATMEAS_FILTER_SHIFT;
+
+    soc = ketCube_batMeas_CurveSoC((uint16_t) filteredmV);
+    level = (uint8_t) (1 + ((uint16_t) soc * 253) / 100);
+
+    ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_BATMEAS, "Value %d mV (+%d mV load), filtered %d mV, SoC %d %%",
+                                     mV - comp, comp, filteredmV, soc);
+
+    ketCube_batPolicy_Update(soc);
+}
+
+/**
+  * @brief Report a load drawn from the battery (e.g. radio TX)
+  *
+  * @param charge load charge in uAs (= ms * mA)
+  */
+void ketCube_batMeas_AddLoad(uint32_t charge)
+{
+    TimerTime_t now = TimerGetCurrentTime();
+
+    load = ketCube_batMeas_Load(now) + charge;
+    loadTime = now;
+}
+
 /**
   * @brief This function returns the battery level
-  * @param none
-  
+  *
+  * The cached estimate is returned (e.g. for the LoRaWAN DevStatusAns);
+  * the battery is measured only if there is no estimate yet.
+  *
   * @retval battery level scaled to 1B - 1 (very low) to 254 (fully charged)
   */
 uint8_t ketCube_batMeas_GetBatteryByte(void)
 {
-    uint8_t batteryLevel = 0;
-    uint32_t batteryLevelmV = ketCube_AD_GetBatLevelmV();
-
-    uint16_t batMax =
-        ketCube_batMeas_batList
-        [ketCube_batMeas_moduleCfg.selectedBattery].batCharged;
-    uint16_t batMin =
-        ketCube_batMeas_batList
-        [ketCube_batMeas_moduleCfg.selectedBattery].batDischarged;
-
-    ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_BATMEAS, "Value %d mV", batteryLevelmV);
-        
-    if (batteryLevelmV > batMax) {
-        batteryLevel = 254;
-    } else if (batteryLevelmV < batMin) {
-        batteryLevel = 0;
-    } else {
-        batteryLevel =
-            (((uint32_t) (batteryLevelmV - batMin) * 254) /
-             (batMax - batMin));
+    if (level == 0) {
+        ketCube_batMeas_Estimate();
+    }
+
+    return level;
+}
+
+/**
+  * @brief Get the estimated state of charge
+  *
+  * @retval state of charge in % (0 - 100)
+  */
+uint8_t ketCube_batMeas_GetSoC(void)
+{
+    return soc;
+}
+
+/**
+  * @brief Estimate state of charge from the discharge curve of the selected battery
+  *
+  * @param mV battery voltage at a light load
+  *
+  * @retval state of charge in % (0 - 100)
+  */
+uint8_t ketCube_batMeas_CurveSoC(uint16_t mV)
+{
+    const uint16_t * curve =
+        &(ketCube_batMeas_batList
+          [ketCube_batMeas_moduleCfg.selectedBattery].curve[0]);
+    uint8_t i;
+
+    if (mV >= curve[0]) {
+        return 100;
+    }
+
+    for (i = 1; i < KETCUBE_BATMEAS_CURVE_POINTS; i++) {
+        if (mV >= curve[i]) {
+            /* linear interpolation between 10 % points */
+            return (uint8_t) (100 - (10 * i) +
+                              ((uint32_t) (mV - curve[i]) * 10) /
+                              (curve[i - 1] - curve[i]));
+        }
     }
 
-    return batteryLevel;
+    return 0;
 }
 
 /**
   * @brief Read battery data
   *
+  * The battery is sampled here, i.e. at the start of the base period before
+  * any uplink of the period.
+  *
   * @param buffer pointer to fuffer for storing the result of milivolt mesurement
   * @param len data len in bytes
   *
@@ -154,9 +283,14 @@ uint8_t ketCube_batMeas_GetBatteryByte(void)
 ketCube_cfg_ModError_t ketCube_batMeas_ReadData(uint8_t * buffer,
                                                 uint8_t * len)
 {
+    ketCube_batMeas_Estimate();
+    if (level == 0) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
     // write to buffer
     *len = 1;
-    buffer[0] = ketCube_batMeas_GetBatteryByte();
+    buffer[0] = level;
 
     ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_BATMEAS, "Encoded value: %d",
                                  buffer[0]);
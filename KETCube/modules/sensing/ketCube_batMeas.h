@@ -50,6 +50,14 @@
 
 /** @defgroup KETCube_batMeas KETCube batMeas
   * @brief KETCube batMeas cnt module
+  *
+  * The battery is sampled at the start of the base period, only if no load
+  * (radio TX) was reported by ketCube_batMeas_AddLoad() for
+  * KETCUBE_BATMEAS_QUIET_MS. The voltage sag still left from the recent
+  * load (decaying with KETCUBE_BATMEAS_LOAD_HALFLIFE_MS) is added, the result
+  * is filtered and converted to the state of charge by the discharge curve.
+  * The estimate is cached for the LoRaWAN DevStatusAns.
+  *
   * @ingroup KETCube_SensMods
   * @{
   */
@@ -80,6 +88,11 @@ typedef enum {
     KETCUBE_BATMEAS_BATLIST_LAST        /*!< Last battery index -- do not modify this line! */
 } ketCube_batMeas_battList_t;
 
+#define KETCUBE_BATMEAS_CURVE_POINTS    11          /*!< Discharge curve points: 100 %, 90 %, ... 0 % SoC */
+#define KETCUBE_BATMEAS_FILTER_SHIFT    4           /*!< Voltage filter: EWMA weight of the newest sample is 2^-SHIFT */
+#define KETCUBE_BATMEAS_QUIET_MS        5000        /*!< Min. time since the last load to sample the battery [ms] */
+#define KETCUBE_BATMEAS_LOAD_HALFLIFE_MS 30000      /*!< Voltage recovery after a load: half-life [ms] */
+
 /**
 * @brief  KETCube battery deffinition
 */
@@ -88,6 +101,8 @@ typedef struct ketCube_batMeas_battery_t {
     char *batDescr;             /*!< Battery description */
     uint16_t batCharged;        /*!< Battery fully charged [mV] */
     uint16_t batDischarged;     /*!< Battery discharged [mV] */
+    uint16_t curve[KETCUBE_BATMEAS_CURVE_POINTS];   /*!< Discharge curve at a light load [mV]; decreasing, in 10 % SoC steps from 100 % */
+    uint16_t loadGain;          /*!< Voltage sag per recent load charge [uV/mAs] */
 } ketCube_batMeas_battery_t;
 
 /**
@@ -115,6 +130,9 @@ extern ketCube_cfg_ModError_t ketCube_batMeas_ReadData(uint8_t * buffer,
                                                        uint8_t * len);
 
 extern uint8_t ketCube_batMeas_GetBatteryByte(void);
+extern uint8_t ketCube_batMeas_GetSoC(void);
+extern uint8_t ketCube_batMeas_CurveSoC(uint16_t mV);
+extern void ketCube_batMeas_AddLoad(uint32_t charge);
 
 /**
 * @}
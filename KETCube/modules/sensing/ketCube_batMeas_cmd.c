@@ -80,6 +80,15 @@ void ketCube_terminal_cmd_show_batMeas_list(void)
     }
 }
 
+/**
+ * @brief Show estimated state of charge
+ * 
+ */
+void ketCube_terminal_cmd_show_batMeas_soc(void)
+{
+    commandIOParams.as_uint32 = ketCube_batMeas_GetSoC();
+}
+
 /**
  * @brief Terminal command definitions 
  */
@@ -118,6 +127,20 @@ ketCube_terminal_cmd_t ketCube_batMeas_commands[] = {
         }
     },
     
+    {
+        .cmd   = "soc",
+        .descr = "Estimated state of charge in %",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_NONE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_UINT32,
+        .settingsPtr.callback = &ketCube_terminal_cmd_show_batMeas_soc,
+    },
+    
     DEF_TERMINATE()
     
 };
@@ -43,29 +43,60 @@
  * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "stm32l0xx_hal.h"
 #include "stm32l0xx_hal_i2c.h"
 
 #include "ketCube_cfg.h"
 #include "ketCube_terminal.h"
 #include "ketCube_i2c.h"
+#include "ketCube_delay.h"
 #include "ketCube_bmeX80.h"
+#include "ketCube_deadband.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_BMEX80
 
 ketCube_bmeX80_moduleCfg_t ketCube_bmeX80_moduleCfg; /*!< Module configuration storage */
 
-static ketCube_cfg_ModError_t getCalibration(ketCube_bmeX80_Calib_t *
-                                             calibration);
-static ketCube_cfg_ModError_t getHumidity(uint32_t * value,
-                                          ketCube_bmeX80_Calib_t *
-                                          calibration);
-static ketCube_cfg_ModError_t getTemperature(int16_t * value,
-                                             ketCube_bmeX80_Calib_t *
-                                             calibration);
-static ketCube_cfg_ModError_t getPressure(uint32_t * value,
-                                          ketCube_bmeX80_Calib_t *
-                                          calibration);
+/**
+ * @brief Report-by-exception deadbands: RH 2 %, temperature 0.5 °C, pressure 1 hPa
+ */
+static ketCube_deadband_field_t ketCube_bmeX80_deadband[] = {
+    { .field = 1, .absolute = 4 },      /* RH in 0.5 % */
+    { .field = 1, .absolute = 1 },      /* temperature in 0.5 °C */
+    { .field = 2, .absolute = 2 },      /* pressure in 0.5 hPa */
+};
+
+/**
+ * @brief Operating profiles
+ * 
+ * Conversion time is the datasheet maximum:
+ * 1.25 + 2.3 * T_os + (2.3 * P_os + 0.575) + (2.3 * H_os + 0.575) ms
+ */
+const ketCube_bmeX80_profile_t ketCube_bmeX80_profiles[] = {
+    {"forced", KETCUBE_BMEX80_MODE_FORCED,
+     KETCUBE_BMEX80_OS_T_X1, KETCUBE_BMEX80_OS_P_X1, KETCUBE_BMEX80_OS_H_X1,
+     KETCUBE_BMEX80_FILTER_OFF, KETCUBE_BMEX80_STANDBY_1000MS, 10, 420},
+    {"forced low-noise", KETCUBE_BMEX80_MODE_FORCED,
+     KETCUBE_BMEX80_OS_T_X2, KETCUBE_BMEX80_OS_P_X16, KETCUBE_BMEX80_OS_H_X1,
+     KETCUBE_BMEX80_FILTER_OFF, KETCUBE_BMEX80_STANDBY_1000MS, 47, 640},
+    {"normal low-power", KETCUBE_BMEX80_MODE_NORMAL,
+     KETCUBE_BMEX80_OS_T_X1, KETCUBE_BMEX80_OS_P_X1, KETCUBE_BMEX80_OS_H_X1,
+     KETCUBE_BMEX80_FILTER_4, KETCUBE_BMEX80_STANDBY_1000MS, 10, 4},
+    {"normal low-noise", KETCUBE_BMEX80_MODE_NORMAL,
+     KETCUBE_BMEX80_OS_T_X2, KETCUBE_BMEX80_OS_P_X16, KETCUBE_BMEX80_OS_H_X1,
+     KETCUBE_BMEX80_FILTER_16, KETCUBE_BMEX80_STANDBY_1000MS, 47, 28},
+};
+
+static const ketCube_bmeX80_profile_t *profile;  /*!< Selected operating profile */
+static ketCube_bmeX80_mode_t mode;              /*!< Selected power mode */
+static ketCube_bmeX80_Calib_t calibration;     /*!< Cached calibration data */
+static uint8_t calibrationCrc;                  /*!< CRC of the cached calibration data */
+static bool calibrationValid = FALSE;           /*!< Calibration data cache is loaded */
+
+static ketCube_cfg_ModError_t configure(void);
+static ketCube_cfg_ModError_t getCalibration(void);
 
 /**
  * @brief Initialize the BMEx80 sensor
@@ -75,6 +106,8 @@ static ketCube_cfg_ModError_t getPressure(uint32_t * value,
  */
 ketCube_cfg_ModError_t ketCube_bmeX80_Init(ketCube_InterModMsg_t *** msg)
 {
+    ketCube_deadband_Declare(KETCUBE_LISTS_MODULEID_BMEX80,
+                             &(ketCube_bmeX80_deadband[0]), 3);
 
     // Init drivers
     if (ketCube_I2C_Init() != KETCUBE_CFG_DRV_OK) {
@@ -82,6 +115,9 @@ ketCube_cfg_ModError_t ketCube_bmeX80_Init(ketCube_InterModMsg_t *** msg)
                                       "I2C Driver initialisation failure!");
         return KETCUBE_CFG_MODULE_ERROR;
     }
+    // BMEx80 supports the fast mode
+    ketCube_I2C_SetDeviceSpeed(KETCUBE_BMEX80_I2C_ADDRESS, KETCUBE_I2C_SPEED_400KHZ);
+
     // Query compatible chip
     uint8_t chipID;
     if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
@@ -96,19 +132,35 @@ ketCube_cfg_ModError_t ketCube_bmeX80_Init(ketCube_InterModMsg_t *** msg)
                                       "Invalid ChipID!");
         return KETCUBE_CFG_MODULE_ERROR;
     }
-    //Configure humidity oversampling
-    uint8_t tempData = KETCUBE_BMEX80_OS_H_X1;
-    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
-                              KETCUBE_BMEX80_CTRL_HUM_REG, &tempData, 1))
+
+    // Select operating profile
+    if (ketCube_bmeX80_moduleCfg.profile >= KETCUBE_BMEX80_PROFILE_LAST) {
+        ketCube_bmeX80_moduleCfg.profile = KETCUBE_BMEX80_PROFILE_FORCED;
+    }
+    profile = &(ketCube_bmeX80_profiles[ketCube_bmeX80_moduleCfg.profile]);
+    mode = profile->mode;
+
+#if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME680)
+    // BME680 supports the forced mode only
+    mode = KETCUBE_BMEX80_MODE_FORCED;
+#endif
+
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_BMEX80,
+                                 "Profile: %s; conversion: %d ms; current: %d uA",
+                                 profile->name, profile->measTimeMs,
+                                 profile->currentUA);
+
+    if (configure() != KETCUBE_CFG_MODULE_OK) {
         return KETCUBE_CFG_MODULE_ERROR;
+    }
 
-    //Configure pressure and temperature oversampling
-    tempData = KETCUBE_BMEX80_OS_T_X1 << 5;
-    tempData |= KETCUBE_BMEX80_OS_P_X1 << 2;
-    tempData |= 1;
-    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
-                              KETCUBE_BMEX80_CTRL_MEAS_REG, &tempData, 1))
+    // Calibration is read once and cached
+    calibrationValid = FALSE;
+    if (getCalibration() != KETCUBE_CFG_MODULE_OK) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_BMEX80,
+                                      "Calibration readout failure!");
         return KETCUBE_CFG_MODULE_ERROR;
+    }
 
     return KETCUBE_CFG_MODULE_OK;
 }
@@ -126,436 +178,86 @@ ketCube_cfg_ModError_t ketCube_bmeX80_UnInit(void)
 }
 
 /**
- * @brief Reads and sorts BMEx80 calibration data
- * @param  calibration pointer to calibration data structure
+ * @brief Configure the selected profile and start the measurement
  *
  * @retval KETCUBE_CFG_MODULE_OK in case of success
  * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
  */
-ketCube_cfg_ModError_t getCalibration(ketCube_bmeX80_Calib_t * calibration)
+static ketCube_cfg_ModError_t configure(void)
 {
-#if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME280)
-    //Read calibration data part 1 from chip
-    uint8_t coeff_array[26] = { 0 };
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_CALIB_1_FIRST_REG,
-                             coeff_array, KETCUBE_BMEX80_CALIB_1_LENGTH))
+    //Enter sleep mode - CONFIG register writes may be ignored otherwise
+    uint8_t tempData = KETCUBE_BMEX80_MODE_SLEEP;
+    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
+                              KETCUBE_BMEX80_CTRL_MEAS_REG, &tempData, 1))
         return KETCUBE_CFG_MODULE_ERROR;
 
-    //Asign data to calibration structure
-
-    /* Temperature related coefficients */
-    calibration->dig_T1 = BME_CONCAT_BYTES(coeff_array[1], coeff_array[0]);
-    calibration->dig_T2 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[3], coeff_array[2]);
-    calibration->dig_T3 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[5], coeff_array[4]);
-
-    /* Pressure related coefficients */
-    calibration->dig_P1 = BME_CONCAT_BYTES(coeff_array[7], coeff_array[6]);
-    calibration->dig_P2 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[9], coeff_array[8]);
-    calibration->dig_P3 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[11], coeff_array[10]);
-    calibration->dig_P4 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[13], coeff_array[12]);
-    calibration->dig_P5 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[15], coeff_array[14]);
-    calibration->dig_P6 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[17], coeff_array[16]);
-    calibration->dig_P7 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[19], coeff_array[18]);
-    calibration->dig_P8 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[21], coeff_array[20]);
-    calibration->dig_P9 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[23], coeff_array[22]);
-
-    /* Humidity related coefficients */
-    calibration->dig_H1 = coeff_array[25];
-    int16_t dig_H4_lsb;
-    int16_t dig_H4_msb;
-    int16_t dig_H5_lsb;
-    int16_t dig_H5_msb;
-
-    //Read calibration data part 2 from chip
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_CALIB_2_FIRST_REG,
-                             coeff_array, KETCUBE_BMEX80_CALIB_2_LENGTH))
+    //Configure IIR filter and normal mode standby time
+    tempData = profile->filter << 2;
+#if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME280)
+    tempData |= profile->standby << 5;
+#endif
+    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
+                              KETCUBE_BMEX80_CONFIG_REG, &tempData, 1))
         return KETCUBE_CFG_MODULE_ERROR;
 
-    calibration->dig_H2 =
-        (int16_t) BME_CONCAT_BYTES(coeff_array[1], coeff_array[0]);
-    calibration->dig_H3 = coeff_array[2];
-
-    dig_H4_msb = (int16_t) (int8_t) coeff_array[3] * 16;
-    dig_H4_lsb = (int16_t) (coeff_array[4] & 0x0F);
-    calibration->dig_H4 = dig_H4_msb | dig_H4_lsb;
-
-    dig_H5_msb = (int16_t) (int8_t) coeff_array[5] * 16;
-    dig_H5_lsb = (int16_t) (coeff_array[4] >> 4);
-    calibration->dig_H5 = dig_H5_msb | dig_H5_lsb;
-    calibration->dig_H6 = (int8_t) coeff_array[6];
-
-    return KETCUBE_CFG_MODULE_OK;
-
-    /* KETCUBE_BMEX80_SENSOR_TYPE_BME280 */
-#elif defined(KETCUBE_BMEX80_SENSOR_TYPE_BME680)
-
-    //Read calibration data from chip
-    uint8_t coeff_array[41] = { 0 };
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_CALIB_1_FIRST_REG, coeff_array,
-                             KETCUBE_BMEX80_CALIB_1_LENGTH))
-        return KETCUBE_CFG_MODULE_ERROR;
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_CALIB_2_FIRST_REG,
-                             &coeff_array[KETCUBE_BMEX80_CALIB_1_LENGTH],
-                             KETCUBE_BMEX80_CALIB_2_LENGTH))
+    //Configure humidity oversampling
+    tempData = profile->osH;
+    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
+                              KETCUBE_BMEX80_CTRL_HUM_REG, &tempData, 1))
         return KETCUBE_CFG_MODULE_ERROR;
 
-    //Asign data to calibration structure
-    /* Temperature related coefficients */
-    calibration->par_t1 =
-        (uint16_t) (BME_CONCAT_BYTES
-                    (coeff_array[BME680_T1_MSB_REG],
-                     coeff_array[BME680_T1_LSB_REG]));
-    calibration->par_t2 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_T2_MSB_REG],
-                    coeff_array[BME680_T2_LSB_REG]));
-    calibration->par_t3 = (int8_t) (coeff_array[BME680_T3_REG]);
-
-    /* Pressure related coefficients */
-    calibration->par_p1 =
-        (uint16_t) (BME_CONCAT_BYTES
-                    (coeff_array[BME680_P1_MSB_REG],
-                     coeff_array[BME680_P1_LSB_REG]));
-    calibration->par_p2 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_P2_MSB_REG],
-                    coeff_array[BME680_P2_LSB_REG]));
-    calibration->par_p3 = (int8_t) coeff_array[BME680_P3_REG];
-    calibration->par_p4 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_P4_MSB_REG],
-                    coeff_array[BME680_P4_LSB_REG]));
-    calibration->par_p5 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_P5_MSB_REG],
-                    coeff_array[BME680_P5_LSB_REG]));
-    calibration->par_p6 = (int8_t) (coeff_array[BME680_P6_REG]);
-    calibration->par_p7 = (int8_t) (coeff_array[BME680_P7_REG]);
-    calibration->par_p8 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_P8_MSB_REG],
-                    coeff_array[BME680_P8_LSB_REG]));
-    calibration->par_p9 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_P9_MSB_REG],
-                    coeff_array[BME680_P9_LSB_REG]));
-    calibration->par_p10 = (uint8_t) (coeff_array[BME680_P10_REG]);
-
-    /* Humidity related coefficients */
-    calibration->par_h1 =
-        (uint16_t) (((uint16_t) coeff_array[BME680_H1_MSB_REG]
-                     << 4) | (coeff_array[BME680_H1_LSB_REG] & 0x0F));
-    calibration->par_h2 =
-        (uint16_t) (((uint16_t) coeff_array[BME680_H2_MSB_REG]
-                     << 4) | ((coeff_array[BME680_H2_LSB_REG]) >> 4));
-    calibration->par_h3 = (int8_t) coeff_array[BME680_H3_REG];
-    calibration->par_h4 = (int8_t) coeff_array[BME680_H4_REG];
-    calibration->par_h5 = (int8_t) coeff_array[BME680_H5_REG];
-    calibration->par_h6 = (uint8_t) coeff_array[BME680_H6_REG];
-    calibration->par_h7 = (int8_t) coeff_array[BME680_H7_REG];
-
-    /* Gas heater related coefficients */
-    calibration->par_gh1 = (int8_t) coeff_array[BME680_GH1_REG];
-    calibration->par_gh2 =
-        (int16_t) (BME_CONCAT_BYTES
-                   (coeff_array[BME680_GH2_MSB_REG],
-                    coeff_array[BME680_GH2_LSB_REG]));
-    calibration->par_gh3 = (int8_t) coeff_array[BME680_GH3_REG];
-
-    return KETCUBE_CFG_MODULE_OK;
-    /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
-#else
-    return KETCUBE_CFG_MODULE_ERROR;
-#endif
-}
-
-/**
- * @brief  Read BMEx80 Humidity output registers, and calculate humidity.
- * @param  value pointer to the returned humidity value that must be divided by 10 to get the value in [%].
- * @param  calibration pointer to calibration data structure
- *
- * @retval KETCUBE_CFG_MODULE_OK if success
- * @retval KETCUBE_CFG_MODULE_ERROR otherwise
- */
-ketCube_cfg_ModError_t getHumidity(uint32_t * value,
-                                   ketCube_bmeX80_Calib_t * calibration)
-{
-    //Read out data
-    uint8_t rawH[2];
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_HUMIDITY_REG, rawH, 2))
+    //Configure pressure and temperature oversampling and start
+    tempData = profile->osT << 5;
+    tempData |= profile->osP << 2;
+    tempData |= mode;
+    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
+                              KETCUBE_BMEX80_CTRL_MEAS_REG, &tempData, 1))
         return KETCUBE_CFG_MODULE_ERROR;
 
-    uint16_t hum_adc = ((uint16_t) rawH[0] << 8) | rawH[1];
-
-    //Calculate calibrated value
-#if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME280)
-    int32_t var1;
-    int32_t var2;
-    int32_t var3;
-    int32_t var4;
-    int32_t var5;
-    uint32_t humidity;
-
-    var1 = calibration->t_fine - ((int32_t) 76800);
-    var2 = (int32_t) (hum_adc * 16384);
-    var3 = (int32_t) (((int32_t) calibration->dig_H4) * 1048576);
-    var4 = ((int32_t) calibration->dig_H5) * var1;
-    var5 = (((var2 - var3) - var4) + (int32_t) 16384) / 32768;
-    var2 = (var1 * ((int32_t) calibration->dig_H6)) / 1024;
-    var3 = (var1 * ((int32_t) calibration->dig_H3)) / 2048;
-    var4 = ((var2 * (var3 + (int32_t) 32768)) / 1024) + (int32_t) 2097152;
-    var2 = ((var4 * ((int32_t) calibration->dig_H2)) + 8192) / 16384;
-    var3 = var5 * var2;
-    var4 = ((var3 / 32768) * (var3 / 32768)) / 128;
-    var5 = var3 - ((var4 * ((int32_t) calibration->dig_H1)) / 16);
-    var5 = (var5 < 0 ? 0 : var5);
-    var5 = (var5 > 419430400 ? 419430400 : var5);
-    humidity = (uint32_t) (var5 / 4096);
-
-    if (humidity > 102400)
-        humidity = 102400;
-
-    *value = humidity;
-    return KETCUBE_CFG_MODULE_OK;
-#elif defined(KETCUBE_BMEX80_SENSOR_TYPE_BME680)
-    int32_t var1;
-    int32_t var2;
-    int32_t var3;
-    int32_t var4;
-    int32_t var5;
-    int32_t var6;
-    int32_t temp_scaled;
-    int32_t calc_hum;
-
-    temp_scaled = (((int32_t) calibration->t_fine * 5) + 128) >> 8;
-    var1 =
-        (int32_t) (hum_adc
-                   - ((int32_t) ((int32_t) calibration->par_h1 * 16)))
-        - (((temp_scaled * (int32_t) calibration->par_h3)
-            / ((int32_t) 100)) >> 1);
-    var2 = ((int32_t) calibration->par_h2
-            *
-            (((temp_scaled * (int32_t) calibration->par_h4) /
-              ((int32_t) 100))
-             +
-             (((temp_scaled *
-                ((temp_scaled * (int32_t) calibration->par_h5)
-                 / ((int32_t) 100))) >> 6) / ((int32_t) 100))
-             + (int32_t) (1 << 14))) >> 10;
-    var3 = var1 * var2;
-    var4 = (int32_t) calibration->par_h6 << 7;
-    var4 = ((var4)
-            +
-            ((temp_scaled * (int32_t) calibration->par_h7) /
-             ((int32_t) 100)))
-        >> 4;
-    var5 = ((var3 >> 14) * (var3 >> 14)) >> 10;
-    var6 = (var4 * var5) >> 1;
-    calc_hum = (((var3 + var6) >> 10) * ((int32_t) 1000)) >> 12;
-
-    if (calc_hum > 100000)      /* Cap at 100%rH */
-        calc_hum = 100000;
-    else if (calc_hum < 0)
-        calc_hum = 0;
-
-    *value = (uint32_t) calc_hum;
     return KETCUBE_CFG_MODULE_OK;
-#else                           /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
-    return KETCUBE_CFG_MODULE_ERROR;
-#endif
 }
 
 /**
- * @brief  Read BMEx80 temperature output registers, and calculate temperature.
- * @param  value a pointer to the returned temperature value that must be divided by 10 to get the value in ['C].
- * @param  calibration pointer to calibration data structure
+ * @brief Reads and sorts BMEx80 calibration data into the cache
  *
- * @retval KETCUBE_CFG_MODULE_OK if success
- * @retval KETCUBE_CFG_MODULE_ERROR otherwise
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
  */
-ketCube_cfg_ModError_t getTemperature(int16_t * value,
-                                      ketCube_bmeX80_Calib_t * calibration)
+static ketCube_cfg_ModError_t getCalibration(void)
 {
+    uint8_t coeff_array[KETCUBE_BMEX80_CALIB_1_LENGTH +
+                        KETCUBE_BMEX80_CALIB_2_LENGTH] = { 0 };
 
-    //Read out data
-    uint8_t rawT[3];
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_TEMPERATURE_REG, rawT, 3))
+    calibrationValid = FALSE;
+
+    //Read calibration data from chip
+    if (ketCube_I2C_ReadDataQueued(KETCUBE_BMEX80_I2C_ADDRESS,
+                                   KETCUBE_BMEX80_CALIB_1_FIRST_REG, coeff_array,
+                                   KETCUBE_BMEX80_CALIB_1_LENGTH))
+        return KETCUBE_CFG_MODULE_ERROR;
+    if (ketCube_I2C_ReadDataQueued(KETCUBE_BMEX80_I2C_ADDRESS,
+                                   KETCUBE_BMEX80_CALIB_2_FIRST_REG,
+                                   &coeff_array[KETCUBE_BMEX80_CALIB_1_LENGTH],
+                                   KETCUBE_BMEX80_CALIB_2_LENGTH))
         return KETCUBE_CFG_MODULE_ERROR;
 
-    uint32_t temp_adc = (uint32_t) rawT[0] << 12 | (uint32_t) rawT[1] << 4
-        | rawT[2] >> 4;
+    // Clear also the padding - the whole structure is covered by CRC
+    memset(&calibration, 0, sizeof(ketCube_bmeX80_Calib_t));
 
-    //Calculate calibrated value
 #if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME280)
-    int32_t var1;
-    int32_t var2;
-    int32_t temperature;
-    int32_t temperature_min = -4000;
-    int32_t temperature_max = 8500;
-
-    var1 =
-        (int32_t) ((temp_adc / 8) - ((int32_t) calibration->dig_T1 * 2));
-    var1 = (var1 * ((int32_t) calibration->dig_T2)) / 2048;
-    var2 = (int32_t) ((temp_adc / 16) - ((int32_t) calibration->dig_T1));
-    var2 =
-        (((var2 * var2) / 4096) * ((int32_t) calibration->dig_T3)) / 16384;
-    calibration->t_fine = var1 + var2;
-    temperature = (calibration->t_fine * 5 + 128) / 256;
-
-    if (temperature < temperature_min)
-        temperature = temperature_min;
-    else if (temperature > temperature_max)
-        temperature = temperature_max;
-
-    *value = (int16_t) temperature;
-    return KETCUBE_CFG_MODULE_OK;
+    ketCube_bme280_ParseCalib(&calibration, coeff_array,
+                              &coeff_array[KETCUBE_BMEX80_CALIB_1_LENGTH]);
 #elif defined(KETCUBE_BMEX80_SENSOR_TYPE_BME680)
-    int64_t var1;
-    int64_t var2;
-    int64_t var3;
-    int16_t calc_temp;
-
-    var1 =
-        ((int32_t) temp_adc >> 3) - ((int32_t) calibration->par_t1 << 1);
-    var2 = (var1 * (int32_t) calibration->par_t2) >> 11;
-    var3 = ((var1 >> 1) * (var1 >> 1)) >> 12;
-    var3 = ((var3) * ((int32_t) calibration->par_t3 << 4)) >> 14;
-    calibration->t_fine = (int32_t) (var2 + var3);
-    calc_temp = (int16_t) (((calibration->t_fine * 5) + 128) >> 8);
-
-    *value = calc_temp;
-    return KETCUBE_CFG_MODULE_OK;
-#else                           /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
+    ketCube_bme680_ParseCalib(&calibration, coeff_array);
+#else
     return KETCUBE_CFG_MODULE_ERROR;
 #endif
-}
 
-/**
- * @brief  Read BMEx80 pressure output registers, and calculate pressure.
- * @param  value a pointer to the returned pressure value in [hPa].
- * @param  calibration pointer to calibration data structure
- *
- * @retval KETCUBE_CFG_MODULE_OK if success
- * @retval KETCUBE_CFG_MODULE_ERROR otherwise
- */
-ketCube_cfg_ModError_t getPressure(uint32_t * value,
-                                   ketCube_bmeX80_Calib_t * calibration)
-{
+    calibrationCrc = ketCube_bmeX80_Crc8((uint8_t *) & calibration,
+                                         sizeof(ketCube_bmeX80_Calib_t));
+    calibrationValid = TRUE;
 
-    //Read out data
-    uint8_t rawP[3] = { 0 };
-    if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                             KETCUBE_BMEX80_PRESSURE_REG, rawP, 3)) {
-        return KETCUBE_CFG_MODULE_ERROR;
-    }
-
-    uint32_t pres_adc = (uint32_t) rawP[0] << 12 | (uint32_t) rawP[1] << 4
-        | rawP[2] >> 4;
-
-    //Calculate calibrated value
-#if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME280)
-    int64_t var1;
-    int64_t var2;
-    int64_t var3;
-    int64_t var4;
-    uint32_t pressure;
-    uint32_t pressure_min = 3000000;
-    uint32_t pressure_max = 11000000;
-
-    var1 = ((int64_t) calibration->t_fine) - 128000;
-    var2 = var1 * var1 * (int64_t) calibration->dig_P6;
-    var2 = var2 + ((var1 * (int64_t) calibration->dig_P5) * 131072);
-    var2 = var2 + (((int64_t) calibration->dig_P4) * 34359738368);
-    var1 = ((var1 * var1 * (int64_t) calibration->dig_P3) / 256)
-        + ((var1 * ((int64_t) calibration->dig_P2) * 4096));
-    var3 = ((int64_t) 1) * 140737488355328;
-    var1 = (var3 + var1) * ((int64_t) calibration->dig_P1) / 8589934592;
-
-    /* To avoid divide by zero exception */
-    if (var1 != 0) {
-        var4 = 1048576 - pres_adc;
-        var4 = (((var4 * 2147483648) - var2) * 3125) / var1;
-        var1 =
-            (((int64_t) calibration->dig_P9) * (var4 / 8192) *
-             (var4 / 8192))
-            / 33554432;
-        var2 = (((int64_t) calibration->dig_P8) * var4) / 524288;
-        var4 = ((var4 + var1 + var2) / 256)
-            + (((int64_t) calibration->dig_P7) * 16);
-        pressure = (uint32_t) (((var4 / 2) * 100) / 128);
-
-        if (pressure < pressure_min)
-            pressure = pressure_min;
-        else if (pressure > pressure_max)
-            pressure = pressure_max;
-    } else {
-        pressure = pressure_min;
-    }
-
-    *value = pressure / 100;
-    return KETCUBE_CFG_MODULE_OK;
-#elif defined(KETCUBE_BMEX80_SENSOR_TYPE_BME680)
-    int32_t var1 = 0;
-    int32_t var2 = 0;
-    int32_t var3 = 0;
-    int32_t pressure_comp = 0;
-
-    var1 = (((int32_t) calibration->t_fine) >> 1) - 64000;
-    var2 =
-        ((((var1 >> 2) * (var1 >> 2)) >> 11) *
-         (int32_t) calibration->par_p6)
-        >> 2;
-    var2 = var2 + ((var1 * (int32_t) calibration->par_p5) << 1);
-    var2 = (var2 >> 2) + ((int32_t) calibration->par_p4 << 16);
-    var1 = (((((var1 >> 2) * (var1 >> 2)) >> 13)
-             * ((int32_t) calibration->par_p3 << 5)) >> 3)
-        + (((int32_t) calibration->par_p2 * var1) >> 1);
-    var1 = var1 >> 18;
-    var1 = ((32768 + var1) * (int32_t) calibration->par_p1) >> 15;
-    pressure_comp = 1048576 - pres_adc;
-    pressure_comp = (int32_t) ((pressure_comp - (var2 >> 12))
-                               * ((uint32_t) 3125));
-    if (pressure_comp >= 0x40000000)
-        pressure_comp = ((pressure_comp / (uint32_t) var1) << 1);
-    else
-        pressure_comp = ((pressure_comp << 1) / (uint32_t) var1);
-    var1 = ((int32_t) calibration->par_p9
-            *
-            (int32_t) (((pressure_comp >> 3) *
-                        (pressure_comp >> 3)) >> 13))
-        >> 12;
-    var2 = ((int32_t) (pressure_comp >> 2) * (int32_t) calibration->par_p8)
-        >> 13;
-    var3 = ((int32_t) (pressure_comp >> 8) * (int32_t) (pressure_comp >> 8)
-            * (int32_t) (pressure_comp >> 8) *
-            (int32_t) calibration->par_p10)
-        >> 17;
-
-    pressure_comp = (int32_t) (pressure_comp)
-        + ((var1 + var2 + var3
-            + ((int32_t) calibration->par_p7 << 7)) >> 4);
-
-    *value = (uint32_t) (pressure_comp);
     return KETCUBE_CFG_MODULE_OK;
-#else                           /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
-    return KETCUBE_CFG_MODULE_ERROR;
-#endif
 }
 
 /**
@@ -572,9 +274,12 @@ ketCube_cfg_ModError_t ketCube_bmeX80_ReadData(uint8_t * buffer,
 {
 
     uint8_t i = 0;
-    int16_t temperature = 0;
+    int32_t temperature = 0;
     uint32_t humidity = 0;
     uint32_t pressure = 0;
+    int32_t tFine;
+    uint8_t raw[KETCUBE_BMEX80_DATA_LENGTH];
+    bool started = FALSE;
     char chipType;
 
     // Query compatible chip
@@ -603,32 +308,100 @@ ketCube_cfg_ModError_t ketCube_bmeX80_ReadData(uint8_t * buffer,
                              KETCUBE_BMEX80_CTRL_MEAS_REG, &tempData, 1)) {
         return KETCUBE_CFG_MODULE_ERROR;
     }
-    //Switch mode to Forced - one shot measurement
-    tempData |= 1;
-    //Write back configuration data
-    if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
-                              KETCUBE_BMEX80_CTRL_MEAS_REG, &tempData,
-                              1)) {
+
+    if ((tempData & KETCUBE_BMEX80_CTRL_MEAS_OS_MASK) == 0) {
+        // Oversampling reads back as skipped - the sensor has been reset
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_BMEX80,
+                                     "Sensor reset detected!");
+        calibrationValid = FALSE;
+        //Reconfigure and start the measurement
+        if (configure() != KETCUBE_CFG_MODULE_OK) {
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+        started = TRUE;
+    } else if (mode == KETCUBE_BMEX80_MODE_FORCED) {
+        //Switch mode to Forced - one shot measurement
+        tempData |= KETCUBE_BMEX80_MODE_FORCED;
+        //Write back configuration data
+        if (ketCube_I2C_WriteData(KETCUBE_BMEX80_I2C_ADDRESS,
+                                  KETCUBE_BMEX80_CTRL_MEAS_REG, &tempData,
+                                  1)) {
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+        started = TRUE;
+    }
+
+    //Reload calibration if not loaded yet or corrupted in RAM
+    if ((calibrationValid == FALSE)
+        || (ketCube_bmeX80_Crc8((uint8_t *) & calibration,
+                                sizeof(ketCube_bmeX80_Calib_t)) !=
+            calibrationCrc)) {
+        if (getCalibration() != KETCUBE_CFG_MODULE_OK) {
+            ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_BMEX80,
+                                          "Calibration readout failure!");
+            return KETCUBE_CFG_MODULE_ERROR;
+        }
+    }
+
+    //Normal mode: the last result is read from the shadowed data registers
+    if (started == TRUE) {
+        //Wait for the measurement in low-power mode
+        ketCube_delay_LowPower(profile->measTimeMs);
+
+        //Read status register - check data ready
+        uint8_t tick = 0;
+        do {
+            if (tick >= KETCUBE_BMEX80_MEAS_POLL_CNT) {
+                ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_BMEX80,
+                                              "Measurement timeout!");
+                return KETCUBE_CFG_MODULE_ERROR;
+            }
+            if (tick > 0) {
+                ketCube_delay_LowPower(1);
+            }
+            if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
+                                     KETCUBE_BMEX80_STATUS_REG, &tempData,
+                                     1))
+                return KETCUBE_CFG_MODULE_ERROR;
+            tick += 1;
+        } while (tempData & (1 << KETCUBE_BMEX80_MEASURING_SHIFT));
+    }
+
+    //Read out pressure, temperature and humidity in a single burst (DMA)
+    if (ketCube_I2C_ReadDataQueued(KETCUBE_BMEX80_I2C_ADDRESS,
+                                   KETCUBE_BMEX80_PRESSURE_REG, raw,
+                                   KETCUBE_BMEX80_DATA_LENGTH)) {
         return KETCUBE_CFG_MODULE_ERROR;
     }
 
-    ketCube_bmeX80_Calib_t calibration = { 0 };
-    getCalibration(&calibration);
+    uint32_t pres_adc = (uint32_t) raw[0] << 12 | (uint32_t) raw[1] << 4
+        | raw[2] >> 4;
+    uint32_t temp_adc = (uint32_t) raw[3] << 12 | (uint32_t) raw[4] << 4
+        | raw[5] >> 4;
+    uint16_t hum_adc = ((uint16_t) raw[6] << 8) | raw[7];
 
-    //Read status register - check data ready
-    uint32_t tick = 0;
-    do {
-        if (ketCube_I2C_ReadData(KETCUBE_BMEX80_I2C_ADDRESS,
-                                 KETCUBE_BMEX80_STATUS_REG, &tempData, 1))
-            return KETCUBE_CFG_MODULE_ERROR;
-        tick += 1;
-    } while ((tempData & (1 << KETCUBE_BMEX80_MEASURING_SHIFT))
-             && tick != 0);
-
-    /* Process temperature FIRST! as it is needed to calculate calibration->t_fine */
-    getTemperature(&temperature, &calibration); /* in °C * 100   */
-    getHumidity(&humidity, &calibration);       /* in % * 1000   */
-    getPressure(&pressure, &calibration);       /* in hPa* 100     */
+    /* Process temperature FIRST! as it is needed to calculate tFine */
+#if defined(KETCUBE_BMEX80_SENSOR_TYPE_BME280)
+    /* in °C * 100 */
+    temperature =
+        ketCube_bme280_CompTemperature(&calibration, temp_adc, &tFine);
+    /* in % * 1024 -> in % * 1000 */
+    humidity = ketCube_bme280_CompHumidity(&calibration, hum_adc, tFine);
+    humidity = (humidity * 1000) >> 10;
+    /* in Pa * 100 -> in hPa * 100 */
+    pressure = ketCube_bme280_CompPressure(&calibration, pres_adc, tFine);
+    pressure = pressure / 100;
+#elif defined(KETCUBE_BMEX80_SENSOR_TYPE_BME680)
+    /* in °C * 100 */
+    temperature =
+        ketCube_bme680_CompTemperature(&calibration, temp_adc, &tFine);
+    /* in % * 1000 */
+    humidity = ketCube_bme680_CompHumidity(&calibration, hum_adc, tFine);
+    /* in hPa * 100 */
+    pressure = ketCube_bme680_CompPressure(&calibration, pres_adc, tFine);
+#else
+    return KETCUBE_CFG_MODULE_ERROR;
+#endif
 
     buffer[i++] = (uint8_t) (humidity / 500);           // Relative humidity in 0.5*%
     buffer[i++] = (uint8_t) (80 + temperature / 50);    // Temperature in 0.5*°C with 40°C offset
@@ -47,6 +47,7 @@
 
 #include "ketCube_cfg.h"
 #include "ketCube_common.h"
+#include "ketCube_bmeX80_comp.h"
 
 #define KETCUBE_BMEX80_SENSOR_TYPE_BME280
 //#define KETCUBE_BMEX80_SENSOR_TYPE_BME680
@@ -57,11 +58,24 @@
   * @{
   */
 
+/**
+* @brief  BMEx80 operating profiles
+*/
+typedef enum {
+    KETCUBE_BMEX80_PROFILE_FORCED = 0,          /*!< Forced mode, x1 oversampling, filter off */
+    KETCUBE_BMEX80_PROFILE_FORCED_LOW_NOISE,    /*!< Forced mode, P x16, T x2, H x1, filter off */
+    KETCUBE_BMEX80_PROFILE_NORMAL_LOW_POWER,    /*!< Normal mode, x1 oversampling, IIR 4, standby 1 s */
+    KETCUBE_BMEX80_PROFILE_NORMAL_LOW_NOISE,    /*!< Normal mode, P x16, T x2, H x1, IIR 16, standby 1 s */
+    KETCUBE_BMEX80_PROFILE_LAST                 /*!< Last profile - do not modify! */
+} ketCube_bmeX80_profileList_t;
+
 /**
 * @brief  KETCube module configuration
 */
 typedef struct ketCube_bmeX80_moduleCfg_t {
     ketCube_cfg_ModuleCfgByte_t coreCfg;           /*!< KETCube core cfg byte */
+    ketCube_bmeX80_profileList_t profile;          /*!< Operating profile */
+    uint8_t RFU[6];                                /*!< Reserved for future use, decrease size of this field when adding new values to preserve module configuration offsets */
 } ketCube_bmeX80_moduleCfg_t;
 
 extern ketCube_bmeX80_moduleCfg_t ketCube_bmeX80_moduleCfg;
@@ -107,107 +121,68 @@ typedef enum {
     KETCUBE_BMEX80_OS_P_X16 = (uint8_t) 0x05,   /*!<  20 bit resolution, 16 samples */
 } ketCube_bmeX80_OS_P_t;
 
-#ifdef KETCUBE_BMEX80_SENSOR_TYPE_BME280
 /**
-* @brief  Calibration data structure.
+* @brief  IIR filter coefficient.
 */
-typedef struct {
-    uint16_t dig_T1;
-    int16_t dig_T2;
-    int16_t dig_T3;
-    uint16_t dig_P1;
-    int16_t dig_P2;
-    int16_t dig_P3;
-    int16_t dig_P4;
-    int16_t dig_P5;
-    int16_t dig_P6;
-    int16_t dig_P7;
-    int16_t dig_P8;
-    int16_t dig_P9;
-    uint8_t dig_H1;
-    int16_t dig_H2;
-    uint8_t dig_H3;
-    int16_t dig_H4;
-    int16_t dig_H5;
-    int8_t dig_H6;
-    int32_t t_fine;
-} ketCube_bmeX80_Calib_t;
-#endif                          /* KETCUBE_BMEX80_SENSOR_TYPE_BME280 */
+typedef enum {
+    KETCUBE_BMEX80_FILTER_OFF = (uint8_t) 0x00, /*!<  filter off */
+    KETCUBE_BMEX80_FILTER_2 = (uint8_t) 0x01,   /*!<  filter coefficient 2 */
+    KETCUBE_BMEX80_FILTER_4 = (uint8_t) 0x02,   /*!<  filter coefficient 4 */
+    KETCUBE_BMEX80_FILTER_8 = (uint8_t) 0x03,   /*!<  filter coefficient 8 */
+    KETCUBE_BMEX80_FILTER_16 = (uint8_t) 0x04,  /*!<  filter coefficient 16 */
+} ketCube_bmeX80_filter_t;
 
-#ifdef KETCUBE_BMEX80_SENSOR_TYPE_BME680
 /**
-* @brief  Calibration data structure.
+* @brief  Normal mode standby time (BME280 only).
 */
-typedef struct {
-    uint16_t par_h1;
-    uint16_t par_h2;
-    int8_t par_h3;
-    int8_t par_h4;
-    int8_t par_h5;
-    uint8_t par_h6;
-    int8_t par_h7;
-    int8_t par_gh1;
-    int16_t par_gh2;
-    int8_t par_gh3;
-    uint16_t par_t1;
-    int16_t par_t2;
-    int8_t par_t3;
-    uint16_t par_p1;
-    int16_t par_p2;
-    int8_t par_p3;
-    int16_t par_p4;
-    int16_t par_p5;
-    int8_t par_p6;
-    int8_t par_p7;
-    int16_t par_p8;
-    int16_t par_p9;
-    uint8_t par_p10;
-    int32_t t_fine;
-} ketCube_bmeX80_Calib_t;
-#endif                          /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
+typedef enum {
+    KETCUBE_BMEX80_STANDBY_0_5MS = (uint8_t) 0x00,      /*!<  0.5 ms */
+    KETCUBE_BMEX80_STANDBY_62_5MS = (uint8_t) 0x01,     /*!<  62.5 ms */
+    KETCUBE_BMEX80_STANDBY_125MS = (uint8_t) 0x02,      /*!<  125 ms */
+    KETCUBE_BMEX80_STANDBY_250MS = (uint8_t) 0x03,      /*!<  250 ms */
+    KETCUBE_BMEX80_STANDBY_500MS = (uint8_t) 0x04,      /*!<  500 ms */
+    KETCUBE_BMEX80_STANDBY_1000MS = (uint8_t) 0x05,     /*!<  1000 ms */
+    KETCUBE_BMEX80_STANDBY_10MS = (uint8_t) 0x06,       /*!<  10 ms */
+    KETCUBE_BMEX80_STANDBY_20MS = (uint8_t) 0x07,       /*!<  20 ms */
+} ketCube_bmeX80_standby_t;
 
 /**
-* @brief  Macro to combine two 8 bit data's to form a 16 bit data
+* @brief  Power mode.
 */
-#define BME_CONCAT_BYTES(msb, lsb)	(((uint16_t)msb << 8) | (uint16_t)lsb)
+typedef enum {
+    KETCUBE_BMEX80_MODE_SLEEP = (uint8_t) 0x00,         /*!<  sleep mode */
+    KETCUBE_BMEX80_MODE_FORCED = (uint8_t) 0x01,        /*!<  forced mode - one shot measurement */
+    KETCUBE_BMEX80_MODE_NORMAL = (uint8_t) 0x03,        /*!<  normal mode - periodic measurement (BME280 only) */
+} ketCube_bmeX80_mode_t;
 
 /**
-* @brief  Array Index to Field data mapping for Calibration Data of BME680
+* @brief  Operating profile definition.
+* 
+* @note currentUA is the supply current during the conversion for the forced
+*       mode profiles and the average supply current for the normal mode
+*       profiles (BME280 datasheet typical values)
 */
-#define BME680_T2_LSB_REG	1
-#define BME680_T2_MSB_REG	2
-#define BME680_T3_REG		3
-#define BME680_P1_LSB_REG	5
-#define BME680_P1_MSB_REG	6
-#define BME680_P2_LSB_REG	7
-#define BME680_P2_MSB_REG	8
-#define BME680_P3_REG		9
-#define BME680_P4_LSB_REG	11
-#define BME680_P4_MSB_REG	12
-#define BME680_P5_LSB_REG	13
-#define BME680_P5_MSB_REG	14
-#define BME680_P7_REG		15
-#define BME680_P6_REG		16
-#define BME680_P8_LSB_REG	19
-#define BME680_P8_MSB_REG	20
-#define BME680_P9_LSB_REG	21
-#define BME680_P9_MSB_REG	22
-#define BME680_P10_REG		23
-#define BME680_H2_MSB_REG	25
-#define BME680_H2_LSB_REG	26
-#define BME680_H1_LSB_REG	26
-#define BME680_H1_MSB_REG	27
-#define BME680_H3_REG		28
-#define BME680_H4_REG		29
-#define BME680_H5_REG		30
-#define BME680_H6_REG		31
-#define BME680_H7_REG		32
-#define BME680_T1_LSB_REG	33
-#define BME680_T1_MSB_REG	34
-#define BME680_GH2_LSB_REG	35
-#define BME680_GH2_MSB_REG	36
-#define BME680_GH1_REG		37
-#define BME680_GH3_REG		38
+typedef struct {
+    char *name;                         /*!< Profile name */
+    ketCube_bmeX80_mode_t mode;         /*!< Power mode */
+    ketCube_bmeX80_OS_T_t osT;          /*!< Temperature oversampling */
+    ketCube_bmeX80_OS_P_t osP;          /*!< Pressure oversampling */
+    ketCube_bmeX80_OS_H_t osH;          /*!< Humidity oversampling */
+    ketCube_bmeX80_filter_t filter;     /*!< IIR filter coefficient */
+    ketCube_bmeX80_standby_t standby;   /*!< Normal mode standby time */
+    uint16_t measTimeMs;                /*!< Maximal conversion time (ms) */
+    uint16_t currentUA;                 /*!< Supply current (uA) */
+} ketCube_bmeX80_profile_t;
+
+extern const ketCube_bmeX80_profile_t ketCube_bmeX80_profiles[];
+
+#ifdef KETCUBE_BMEX80_SENSOR_TYPE_BME280
+typedef ketCube_bme280_Calib_t ketCube_bmeX80_Calib_t;    ///< Calibration data structure
+#endif                          /* KETCUBE_BMEX80_SENSOR_TYPE_BME280 */
+
+#ifdef KETCUBE_BMEX80_SENSOR_TYPE_BME680
+typedef ketCube_bme680_Calib_t ketCube_bmeX80_Calib_t;    ///< Calibration data structure
+#endif                          /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
 
 /**
 * @brief  I2C address.
@@ -215,19 +190,36 @@ typedef struct {
 //#define KETCUBE_BMEX80_I2C_ADDRESS  (uint8_t) (0x77 << 1)     /* SDO pin HIGH */
 #define KETCUBE_BMEX80_I2C_ADDRESS  (uint8_t) (0x76 << 1)       /* SDO pin LOW  */
 
-#define KETCUBE_BMEX80_CALIB_2_LENGTH	16
+/**
+* @brief  Burst read length of the measurement data: P(3), T(3), H(2)
+*/
+#define KETCUBE_BMEX80_DATA_LENGTH	8
 
 #ifdef KETCUBE_BMEX80_SENSOR_TYPE_BME280
 #define KETCUBE_BMEX80_CHIP_ID			0x60
-#define KETCUBE_BMEX80_CALIB_1_LENGTH	26
+#define KETCUBE_BMEX80_CALIB_1_LENGTH	KETCUBE_BME280_CALIB_1_LENGTH
+#define KETCUBE_BMEX80_CALIB_2_LENGTH	KETCUBE_BME280_CALIB_2_LENGTH
 #define KETCUBE_BMEX80_MEASURING_SHIFT	3
 #endif                          /* KETCUBE_BMEX80_SENSOR_TYPE_BME280 */
 
 #ifdef KETCUBE_BMEX80_SENSOR_TYPE_BME680
 #define KETCUBE_BMEX80_CHIP_ID			0x61
 #define KETCUBE_BMEX80_CALIB_1_LENGTH	25
+#define KETCUBE_BMEX80_CALIB_2_LENGTH	16
 #define KETCUBE_BMEX80_MEASURING_SHIFT	5
 #endif                          /* KETCUBE_BMEX80_SENSOR_TYPE_BME680 */
+
+/**
+* @brief  CTRL_MEAS temperature and pressure oversampling bits
+* 
+* @note Both read back as skipped (0) after the sensor reset
+*/
+#define KETCUBE_BMEX80_CTRL_MEAS_OS_MASK    0xFC
+
+/**
+* @brief  Maximal number of STATUS register polls after the measurement time
+*/
+#define KETCUBE_BMEX80_MEAS_POLL_CNT    10
 /**
 * @}
 */
@@ -244,6 +236,7 @@ typedef struct {
 #define KETCUBE_BMEX80_HUMIDITY_REG			0XFD
 #define KETCUBE_BMEX80_TEMPERATURE_REG		0XFA
 #define KETCUBE_BMEX80_PRESSURE_REG			0XF7
+#define KETCUBE_BMEX80_CONFIG_REG			0XF5
 #define KETCUBE_BMEX80_CTRL_MEAS_REG		0XF4
 #define KETCUBE_BMEX80_STATUS_REG			0XF3
 #define KETCUBE_BMEX80_CTRL_HUM_REG			0XF2
@@ -254,6 +247,7 @@ typedef struct {
 #define KETCUBE_BMEX80_HUMIDITY_REG			0X25
 #define KETCUBE_BMEX80_TEMPERATURE_REG		0X22
 #define KETCUBE_BMEX80_PRESSURE_REG			0X1F
+#define KETCUBE_BMEX80_CONFIG_REG			0X75
 #define KETCUBE_BMEX80_CTRL_MEAS_REG		0X74
 #define KETCUBE_BMEX80_CTRL_HUM_REG			0X72
 #define KETCUBE_BMEX80_CALIB_1_FIRST_REG	0x89
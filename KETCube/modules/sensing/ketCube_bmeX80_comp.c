@@ -0,0 +1,448 @@
+/**
+ * @file    ketCube_bmeX80_comp.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the BMEx80 compensation library
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include "ketCube_bmeX80_comp.h"
+
+/**
+ * @brief BME680 gas range constants (Bosch Sensortec BME680 API)
+ */
+static const uint32_t bme680_gasLookup1[16] = {
+    2147483647UL, 2147483647UL, 2147483647UL, 2147483647UL,
+    2147483647UL, 2126008810UL, 2147483647UL, 2130303777UL,
+    2147483647UL, 2147483647UL, 2143188679UL, 2136746228UL,
+    2147483647UL, 2126008810UL, 2147483647UL, 2147483647UL
+};
+
+static const uint32_t bme680_gasLookup2[16] = {
+    4096000000UL, 2048000000UL, 1024000000UL, 512000000UL,
+    255744255UL, 127110228UL, 64000000UL, 32258064UL,
+    16016016UL, 8000000UL, 4000000UL, 2000000UL,
+    1000000UL, 500000UL, 250000UL, 125000UL
+};
+
+/**
+ * @brief CRC-8 (polynomial 0x31, init 0xFF)
+ * 
+ * Used to check integrity of the calibration data cached in RAM
+ *
+ * @param data data
+ * @param len data length in bytes
+ * 
+ * @retval CRC
+ */
+uint8_t ketCube_bmeX80_Crc8(const uint8_t * data, uint16_t len)
+{
+    uint8_t crc = 0xFF;
+    uint8_t bit;
+
+    while (len > 0) {
+        crc ^= *data;
+        for (bit = 0; bit < 8; bit++) {
+            if ((crc & 0x80) != 0) {
+                crc = (uint8_t) ((crc << 1) ^ 0x31);
+            } else {
+                crc = (uint8_t) (crc << 1);
+            }
+        }
+        data++;
+        len--;
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Sort BME280 calibration data
+ *
+ * @param calib calibration data structure
+ * @param regs1 KETCUBE_BME280_CALIB_1_LENGTH bytes read from 0x88
+ * @param regs2 KETCUBE_BME280_CALIB_2_LENGTH bytes read from 0xE1
+ */
+void ketCube_bme280_ParseCalib(ketCube_bme280_Calib_t * calib,
+                               const uint8_t * regs1,
+                               const uint8_t * regs2)
+{
+    int16_t dig_H4_lsb;
+    int16_t dig_H4_msb;
+    int16_t dig_H5_lsb;
+    int16_t dig_H5_msb;
+
+    /* Temperature related coefficients */
+    calib->dig_T1 = BME_CONCAT_BYTES(regs1[1], regs1[0]);
+    calib->dig_T2 = (int16_t) BME_CONCAT_BYTES(regs1[3], regs1[2]);
+    calib->dig_T3 = (int16_t) BME_CONCAT_BYTES(regs1[5], regs1[4]);
+
+    /* Pressure related coefficients */
+    calib->dig_P1 = BME_CONCAT_BYTES(regs1[7], regs1[6]);
+    calib->dig_P2 = (int16_t) BME_CONCAT_BYTES(regs1[9], regs1[8]);
+    calib->dig_P3 = (int16_t) BME_CONCAT_BYTES(regs1[11], regs1[10]);
+    calib->dig_P4 = (int16_t) BME_CONCAT_BYTES(regs1[13], regs1[12]);
+    calib->dig_P5 = (int16_t) BME_CONCAT_BYTES(regs1[15], regs1[14]);
+    calib->dig_P6 = (int16_t) BME_CONCAT_BYTES(regs1[17], regs1[16]);
+    calib->dig_P7 = (int16_t) BME_CONCAT_BYTES(regs1[19], regs1[18]);
+    calib->dig_P8 = (int16_t) BME_CONCAT_BYTES(regs1[21], regs1[20]);
+    calib->dig_P9 = (int16_t) BME_CONCAT_BYTES(regs1[23], regs1[22]);
+
+    /* Humidity related coefficients */
+    calib->dig_H1 = regs1[25];
+    calib->dig_H2 = (int16_t) BME_CONCAT_BYTES(regs2[1], regs2[0]);
+    calib->dig_H3 = regs2[2];
+
+    dig_H4_msb = (int16_t) (int8_t) regs2[3] * 16;
+    dig_H4_lsb = (int16_t) (regs2[4] & 0x0F);
+    calib->dig_H4 = dig_H4_msb | dig_H4_lsb;
+
+    dig_H5_msb = (int16_t) (int8_t) regs2[5] * 16;
+    dig_H5_lsb = (int16_t) (regs2[4] >> 4);
+    calib->dig_H5 = dig_H5_msb | dig_H5_lsb;
+    calib->dig_H6 = (int8_t) regs2[6];
+}
+
+/**
+ * @brief BME280 temperature compensation
+ *
+ * @param calib calibration data structure
+ * @param adcT raw 20-bit temperature
+ * @param tFine fine temperature needed by pressure and humidity compensation
+ * 
+ * @retval temperature in 0.01 degC (-4000 to 8500)
+ */
+int32_t ketCube_bme280_CompTemperature(const ketCube_bme280_Calib_t * calib,
+                                       uint32_t adcT, int32_t * tFine)
+{
+    int32_t var1;
+    int32_t var2;
+    int32_t temperature;
+    int32_t temperature_min = -4000;
+    int32_t temperature_max = 8500;
+
+    var1 = (int32_t) ((adcT / 8) - ((int32_t) calib->dig_T1 * 2));
+    var1 = (var1 * ((int32_t) calib->dig_T2)) / 2048;
+    var2 = (int32_t) ((adcT / 16) - ((int32_t) calib->dig_T1));
+    var2 = (((var2 * var2) / 4096) * ((int32_t) calib->dig_T3)) / 16384;
+    *tFine = var1 + var2;
+    temperature = (*tFine * 5 + 128) / 256;
+
+    if (temperature < temperature_min)
+        temperature = temperature_min;
+    else if (temperature > temperature_max)
+        temperature = temperature_max;
+
+    return temperature;
+}
+
+/**
+ * @brief BME280 pressure compensation (64-bit)
+ *
+ * @param calib calibration data structure
+ * @param adcP raw 20-bit pressure
+ * @param tFine fine temperature @see ketCube_bme280_CompTemperature
+ * 
+ * @retval pressure in 0.01 Pa (30000 to 110000 Pa)
+ */
+uint32_t ketCube_bme280_CompPressure(const ketCube_bme280_Calib_t * calib,
+                                     uint32_t adcP, int32_t tFine)
+{
+    int64_t var1;
+    int64_t var2;
+    int64_t var3;
+    int64_t var4;
+    uint32_t pressure;
+    uint32_t pressure_min = 3000000;
+    uint32_t pressure_max = 11000000;
+
+    var1 = ((int64_t) tFine) - 128000;
+    var2 = var1 * var1 * (int64_t) calib->dig_P6;
+    var2 = var2 + ((var1 * (int64_t) calib->dig_P5) * 131072);
+    var2 = var2 + (((int64_t) calib->dig_P4) * 34359738368);
+    var1 = ((var1 * var1 * (int64_t) calib->dig_P3) / 256)
+        + ((var1 * ((int64_t) calib->dig_P2) * 4096));
+    var3 = ((int64_t) 1) * 140737488355328;
+    var1 = (var3 + var1) * ((int64_t) calib->dig_P1) / 8589934592;
+
+    /* To avoid divide by zero exception */
+    if (var1 != 0) {
+        var4 = 1048576 - adcP;
+        var4 = (((var4 * 2147483648) - var2) * 3125) / var1;
+        var1 = (((int64_t) calib->dig_P9) * (var4 / 8192) * (var4 / 8192))
+            / 33554432;
+        var2 = (((int64_t) calib->dig_P8) * var4) / 524288;
+        var4 = ((var4 + var1 + var2) / 256) + (((int64_t) calib->dig_P7) * 16);
+        pressure = (uint32_t) (((var4 / 2) * 100) / 128);
+
+        if (pressure < pressure_min)
+            pressure = pressure_min;
+        else if (pressure > pressure_max)
+            pressure = pressure_max;
+    } else {
+        pressure = pressure_min;
+    }
+
+    return pressure;
+}
+
+/**
+ * @brief BME280 humidity compensation
+ *
+ * @param calib calibration data structure
+ * @param adcH raw 16-bit humidity
+ * @param tFine fine temperature @see ketCube_bme280_CompTemperature
+ * 
+ * @retval relative humidity in 1/1024 % (0 to 102400)
+ */
+uint32_t ketCube_bme280_CompHumidity(const ketCube_bme280_Calib_t * calib,
+                                     uint16_t adcH, int32_t tFine)
+{
+    int32_t var1;
+    int32_t var2;
+    int32_t var3;
+    int32_t var4;
+    int32_t var5;
+    uint32_t humidity;
+
+    var1 = tFine - ((int32_t) 76800);
+    var2 = (int32_t) (adcH * 16384);
+    var3 = (int32_t) (((int32_t) calib->dig_H4) * 1048576);
+    var4 = ((int32_t) calib->dig_H5) * var1;
+    var5 = (((var2 - var3) - var4) + (int32_t) 16384) / 32768;
+    var2 = (var1 * ((int32_t) calib->dig_H6)) / 1024;
+    var3 = (var1 * ((int32_t) calib->dig_H3)) / 2048;
+    var4 = ((var2 * (var3 + (int32_t) 32768)) / 1024) + (int32_t) 2097152;
+    var2 = ((var4 * ((int32_t) calib->dig_H2)) + 8192) / 16384;
+    var3 = var5 * var2;
+    var4 = ((var3 / 32768) * (var3 / 32768)) / 128;
+    var5 = var3 - ((var4 * ((int32_t) calib->dig_H1)) / 16);
+    var5 = (var5 < 0 ? 0 : var5);
+    var5 = (var5 > 419430400 ? 419430400 : var5);
+    humidity = (uint32_t) (var5 / 4096);
+
+    if (humidity > 102400)
+        humidity = 102400;
+
+    return humidity;
+}
+
+/**
+ * @brief Sort BME680 calibration data
+ *
+ * @param calib calibration data structure
+ * @param regs KETCUBE_BME680_CALIB_LENGTH bytes: 25 bytes read from 0x89
+ *        followed by 16 bytes read from 0xE1
+ */
+void ketCube_bme680_ParseCalib(ketCube_bme680_Calib_t * calib,
+                               const uint8_t * regs)
+{
+    /* Temperature related coefficients */
+    calib->par_t1 = (uint16_t) (BME_CONCAT_BYTES(regs[BME680_T1_MSB_REG], regs[BME680_T1_LSB_REG]));
+    calib->par_t2 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_T2_MSB_REG], regs[BME680_T2_LSB_REG]));
+    calib->par_t3 = (int8_t) (regs[BME680_T3_REG]);
+
+    /* Pressure related coefficients */
+    calib->par_p1 = (uint16_t) (BME_CONCAT_BYTES(regs[BME680_P1_MSB_REG], regs[BME680_P1_LSB_REG]));
+    calib->par_p2 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_P2_MSB_REG], regs[BME680_P2_LSB_REG]));
+    calib->par_p3 = (int8_t) regs[BME680_P3_REG];
+    calib->par_p4 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_P4_MSB_REG], regs[BME680_P4_LSB_REG]));
+    calib->par_p5 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_P5_MSB_REG], regs[BME680_P5_LSB_REG]));
+    calib->par_p6 = (int8_t) (regs[BME680_P6_REG]);
+    calib->par_p7 = (int8_t) (regs[BME680_P7_REG]);
+    calib->par_p8 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_P8_MSB_REG], regs[BME680_P8_LSB_REG]));
+    calib->par_p9 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_P9_MSB_REG], regs[BME680_P9_LSB_REG]));
+    calib->par_p10 = (uint8_t) (regs[BME680_P10_REG]);
+
+    /* Humidity related coefficients */
+    calib->par_h1 = (uint16_t) (((uint16_t) regs[BME680_H1_MSB_REG] << 4)
+                                | (regs[BME680_H1_LSB_REG] & 0x0F));
+    calib->par_h2 = (uint16_t) (((uint16_t) regs[BME680_H2_MSB_REG] << 4)
+                                | ((regs[BME680_H2_LSB_REG]) >> 4));
+    calib->par_h3 = (int8_t) regs[BME680_H3_REG];
+    calib->par_h4 = (int8_t) regs[BME680_H4_REG];
+    calib->par_h5 = (int8_t) regs[BME680_H5_REG];
+    calib->par_h6 = (uint8_t) regs[BME680_H6_REG];
+    calib->par_h7 = (int8_t) regs[BME680_H7_REG];
+
+    /* Gas heater related coefficients */
+    calib->par_gh1 = (int8_t) regs[BME680_GH1_REG];
+    calib->par_gh2 = (int16_t) (BME_CONCAT_BYTES(regs[BME680_GH2_MSB_REG], regs[BME680_GH2_LSB_REG]));
+    calib->par_gh3 = (int8_t) regs[BME680_GH3_REG];
+}
+
+/**
+ * @brief BME680 temperature compensation
+ *
+ * @param calib calibration data structure
+ * @param adcT raw 20-bit temperature
+ * @param tFine fine temperature needed by pressure and humidity compensation
+ * 
+ * @retval temperature in 0.01 degC
+ */
+int32_t ketCube_bme680_CompTemperature(const ketCube_bme680_Calib_t * calib,
+                                       uint32_t adcT, int32_t * tFine)
+{
+    int64_t var1;
+    int64_t var2;
+    int64_t var3;
+
+    var1 = ((int32_t) adcT >> 3) - ((int32_t) calib->par_t1 << 1);
+    var2 = (var1 * (int32_t) calib->par_t2) >> 11;
+    var3 = ((var1 >> 1) * (var1 >> 1)) >> 12;
+    var3 = ((var3) * ((int32_t) calib->par_t3 << 4)) >> 14;
+    *tFine = (int32_t) (var2 + var3);
+
+    return (int16_t) (((*tFine * 5) + 128) >> 8);
+}
+
+/**
+ * @brief BME680 pressure compensation
+ *
+ * @param calib calibration data structure
+ * @param adcP raw 20-bit pressure
+ * @param tFine fine temperature @see ketCube_bme680_CompTemperature
+ * 
+ * @retval pressure in Pa
+ */
+uint32_t ketCube_bme680_CompPressure(const ketCube_bme680_Calib_t * calib,
+                                     uint32_t adcP, int32_t tFine)
+{
+    int32_t var1 = 0;
+    int32_t var2 = 0;
+    int32_t var3 = 0;
+    int32_t pressure_comp = 0;
+
+    var1 = (((int32_t) tFine) >> 1) - 64000;
+    var2 = ((((var1 >> 2) * (var1 >> 2)) >> 11) * (int32_t) calib->par_p6) >> 2;
+    var2 = var2 + ((var1 * (int32_t) calib->par_p5) << 1);
+    var2 = (var2 >> 2) + ((int32_t) calib->par_p4 << 16);
+    var1 = (((((var1 >> 2) * (var1 >> 2)) >> 13)
+             * ((int32_t) calib->par_p3 << 5)) >> 3)
+        + (((int32_t) calib->par_p2 * var1) >> 1);
+    var1 = var1 >> 18;
+    var1 = ((32768 + var1) * (int32_t) calib->par_p1) >> 15;
+    pressure_comp = 1048576 - adcP;
+    pressure_comp = (int32_t) ((pressure_comp - (var2 >> 12)) * ((uint32_t) 3125));
+    if (pressure_comp >= 0x40000000)
+        pressure_comp = ((pressure_comp / (uint32_t) var1) << 1);
+    else
+        pressure_comp = ((pressure_comp << 1) / (uint32_t) var1);
+    var1 = ((int32_t) calib->par_p9
+            * (int32_t) (((pressure_comp >> 3) * (pressure_comp >> 3)) >> 13)) >> 12;
+    var2 = ((int32_t) (pressure_comp >> 2) * (int32_t) calib->par_p8) >> 13;
+    /* 64-bit: the 32-bit product of the Bosch API overflows above ~105 kPa */
+    var3 = (int32_t) (((int64_t) (pressure_comp >> 8) * (pressure_comp >> 8)
+                       * (pressure_comp >> 8) * calib->par_p10) >> 17);
+
+    pressure_comp = (int32_t) (pressure_comp)
+        + ((var1 + var2 + var3 + ((int32_t) calib->par_p7 << 7)) >> 4);
+
+    return (uint32_t) (pressure_comp);
+}
+
+/**
+ * @brief BME680 humidity compensation
+ *
+ * @param calib calibration data structure
+ * @param adcH raw 16-bit humidity
+ * @param tFine fine temperature @see ketCube_bme680_CompTemperature
+ * 
+ * @retval relative humidity in 0.001 % (0 to 100000)
+ */
+uint32_t ketCube_bme680_CompHumidity(const ketCube_bme680_Calib_t * calib,
+                                     uint16_t adcH, int32_t tFine)
+{
+    int32_t var1;
+    int32_t var2;
+    int32_t var3;
+    int32_t var4;
+    int32_t var5;
+    int32_t var6;
+    int32_t temp_scaled;
+    int32_t calc_hum;
+
+    temp_scaled = (((int32_t) tFine * 5) + 128) >> 8;
+    var1 = (int32_t) (adcH - ((int32_t) ((int32_t) calib->par_h1 * 16)))
+        - (((temp_scaled * (int32_t) calib->par_h3) / ((int32_t) 100)) >> 1);
+    var2 = ((int32_t) calib->par_h2
+            * (((temp_scaled * (int32_t) calib->par_h4) / ((int32_t) 100))
+               + (((temp_scaled * ((temp_scaled * (int32_t) calib->par_h5)
+                                   / ((int32_t) 100))) >> 6) / ((int32_t) 100))
+               + (int32_t) (1 << 14))) >> 10;
+    var3 = var1 * var2;
+    var4 = (int32_t) calib->par_h6 << 7;
+    var4 = ((var4) + ((temp_scaled * (int32_t) calib->par_h7) / ((int32_t) 100))) >> 4;
+    var5 = ((var3 >> 14) * (var3 >> 14)) >> 10;
+    var6 = (var4 * var5) >> 1;
+    calc_hum = (((var3 + var6) >> 10) * ((int32_t) 1000)) >> 12;
+
+    if (calc_hum > 100000)      /* Cap at 100%rH */
+        calc_hum = 100000;
+    else if (calc_hum < 0)
+        calc_hum = 0;
+
+    return (uint32_t) calc_hum;
+}
+
+/**
+ * @brief BME680 gas resistance compensation
+ *
+ * @param adcG raw 10-bit gas resistance
+ * @param gasRange gas range (GAS_R_LSB<3:0>)
+ * @param rangeSwErr range switching error (RANGE_SW_ERR<7:4>, signed)
+ * 
+ * @retval gas resistance in Ohm
+ */
+uint32_t ketCube_bme680_CompGasResistance(uint16_t adcG, uint8_t gasRange,
+                                          int8_t rangeSwErr)
+{
+    int64_t var1;
+    int64_t var2;
+    int64_t var3;
+
+    gasRange &= 0x0F;
+
+    var1 = (int64_t) ((1340 + (5 * (int64_t) rangeSwErr))
+                      * ((int64_t) bme680_gasLookup1[gasRange])) >> 16;
+    var2 = (((int64_t) ((int64_t) adcG << 15) - (int64_t) (16777216)) + var1);
+    var3 = (((int64_t) bme680_gasLookup2[gasRange] * (int64_t) var1) >> 9);
+
+    return (uint32_t) ((var3 + ((int64_t) var2 >> 1)) / (int64_t) var2);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file    ketCube_bmeX80_comp.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the BMEx80 compensation library defs
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#ifndef __KETCUBE_BMEX80_COMP_H
+#define __KETCUBE_BMEX80_COMP_H
+
+#include <stdint.h>
+
+/** @defgroup KETCube_BMEx80_comp KETCube BMEx80 compensation
+  * @brief BME280/BME680 integer compensation library
+  * 
+  * Calibration parsing and fixed-point compensation formulas published by
+  * Bosch Sensortec. The library depends on <stdint.h> only: it can be built
+  * and verified on a host against the Bosch reference values.
+  * 
+  * @ingroup KETCube_BMEx80
+  * @{
+  */
+
+/**
+* @brief  Macro to combine two 8 bit data's to form a 16 bit data
+*/
+#define BME_CONCAT_BYTES(msb, lsb)	(((uint16_t)msb << 8) | (uint16_t)lsb)
+
+#define KETCUBE_BME280_CALIB_1_LENGTH	26      ///< Calibration block 0x88 - 0xA1
+#define KETCUBE_BME280_CALIB_2_LENGTH	7       ///< Calibration block 0xE1 - 0xE7
+#define KETCUBE_BME680_CALIB_LENGTH	41      ///< Calibration blocks 0x89 - 0xA1 and 0xE1 - 0xF0
+
+/**
+* @brief  Array Index to Field data mapping for Calibration Data of BME680
+*/
+#define BME680_T2_LSB_REG	1
+#define BME680_T2_MSB_REG	2
+#define BME680_T3_REG		3
+#define BME680_P1_LSB_REG	5
+#define BME680_P1_MSB_REG	6
+#define BME680_P2_LSB_REG	7
+#define BME680_P2_MSB_REG	8
+#define BME680_P3_REG		9
+#define BME680_P4_LSB_REG	11
+#define BME680_P4_MSB_REG	12
+#define BME680_P5_LSB_REG	13
+#define BME680_P5_MSB_REG	14
+#define BME680_P7_REG		15
+#define BME680_P6_REG		16
+#define BME680_P8_LSB_REG	19
+#define BME680_P8_MSB_REG	20
+#define BME680_P9_LSB_REG	21
+#define BME680_P9_MSB_REG	22
+#define BME680_P10_REG		23
+#define BME680_H2_MSB_REG	25
+#define BME680_H2_LSB_REG	26
+#define BME680_H1_LSB_REG	26
+#define BME680_H1_MSB_REG	27
+#define BME680_H3_REG		28
+#define BME680_H4_REG		29
+#define BME680_H5_REG		30
+#define BME680_H6_REG		31
+#define BME680_H7_REG		32
+#define BME680_T1_LSB_REG	33
+#define BME680_T1_MSB_REG	34
+#define BME680_GH2_LSB_REG	35
+#define BME680_GH2_MSB_REG	36
+#define BME680_GH1_REG		37
+#define BME680_GH3_REG		38
+
+/**
+* @brief  BME280 calibration data structure.
+*/
+typedef struct {
+    uint16_t dig_T1;
+    int16_t dig_T2;
+    int16_t dig_T3;
+    uint16_t dig_P1;
+    int16_t dig_P2;
+    int16_t dig_P3;
+    int16_t dig_P4;
+    int16_t dig_P5;
+    int16_t dig_P6;
+    int16_t dig_P7;
+    int16_t dig_P8;
+    int16_t dig_P9;
+    uint8_t dig_H1;
+    int16_t dig_H2;
+    uint8_t dig_H3;
+    int16_t dig_H4;
+    int16_t dig_H5;
+    int8_t dig_H6;
+} ketCube_bme280_Calib_t;
+
+/**
+* @brief  BME680 calibration data structure.
+*/
+typedef struct {
+    uint16_t par_h1;
+    uint16_t par_h2;
+    int8_t par_h3;
+    int8_t par_h4;
+    int8_t par_h5;
+    uint8_t par_h6;
+    int8_t par_h7;
+    int8_t par_gh1;
+    int16_t par_gh2;
+    int8_t par_gh3;
+    uint16_t par_t1;
+    int16_t par_t2;
+    int8_t par_t3;
+    uint16_t par_p1;
+    int16_t par_p2;
+    int8_t par_p3;
+    int16_t par_p4;
+    int16_t par_p5;
+    int8_t par_p6;
+    int8_t par_p7;
+    int16_t par_p8;
+    int16_t par_p9;
+    uint8_t par_p10;
+} ketCube_bme680_Calib_t;
+
+/** @defgroup KETCube_BMEx80_comp_fn Public Functions
+  * @brief Public functions
+  * @{
+  */
+
+extern uint8_t ketCube_bmeX80_Crc8(const uint8_t * data, uint16_t len);
+
+extern void ketCube_bme280_ParseCalib(ketCube_bme280_Calib_t * calib,
+                                      const uint8_t * regs1,
+                                      const uint8_t * regs2);
+extern int32_t ketCube_bme280_CompTemperature(const ketCube_bme280_Calib_t * calib,
+                                              uint32_t adcT, int32_t * tFine);
+extern uint32_t ketCube_bme280_CompPressure(const ketCube_bme280_Calib_t * calib,
+                                            uint32_t adcP, int32_t tFine);
+extern uint32_t ketCube_bme280_CompHumidity(const ketCube_bme280_Calib_t * calib,
+                                            uint16_t adcH, int32_t tFine);
+
+extern void ketCube_bme680_ParseCalib(ketCube_bme680_Calib_t * calib,
+                                      const uint8_t * regs);
+extern int32_t ketCube_bme680_CompTemperature(const ketCube_bme680_Calib_t * calib,
+                                              uint32_t adcT, int32_t * tFine);
+extern uint32_t ketCube_bme680_CompPressure(const ketCube_bme680_Calib_t * calib,
+                                            uint32_t adcP, int32_t tFine);
+extern uint32_t ketCube_bme680_CompHumidity(const ketCube_bme680_Calib_t * calib,
+                                            uint16_t adcH, int32_t tFine);
+extern uint32_t ketCube_bme680_CompGasResistance(uint16_t adcG, uint8_t gasRange,
+                                                 int8_t rangeSwErr);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_BMEX80_COMP_H */
@@ -55,15 +55,31 @@
 #include "ketCube_cfg.h"
 #include "ketCube_terminal.h"
 #include "ketCube_i2c.h"
+#include "ketCube_delay.h"
+#include "ketCube_gpio.h"
+#include "ketCube_modules.h"
 #include "ketCube_hdcX080.h"
+#include "ketCube_deadband.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_HDCX080
 
 ketCube_hdcX080_moduleCfg_t ketCube_hdcX080_moduleCfg; /*!< Module configuration storage */
 
+/**
+ * @brief Report-by-exception deadbands: temperature 0.5 °C, RH 2 %
+ */
+static ketCube_deadband_field_t ketCube_hdcX080_deadband[] = {
+    { .field = 2, .absolute = 5 },      /* temperature in 0.1 °C */
+    { .field = 2, .absolute = 20 },     /* RH in 0.1 % */
+};
+
 ketCube_cfg_ModError_t getHumidity(uint16_t * value);
 ketCube_cfg_ModError_t getTemperature(int16_t * value);
 
+static volatile bool intPending = FALSE;    /*!< HDC2080 DRDY/INT pin asserted */
+static bool intUsed = FALSE;                /*!< HDC2080 DRDY/INT pin is connected to EXTI */
+static uint8_t intEnable = 0;               /*!< HDC2080 INT_ENABLE register value */
+
 /**
  * @brief  Write TexasInstruments I2C periph 16-bit register
  * @param  devAddr I2C Address
@@ -106,7 +122,7 @@ static ketCube_cfg_DrvError_t ketCube_I2C_HDC1080ReadReg(uint8_t devAddr,
     
     /* Wait conversion time */ 
     if ((regAddr == KETCUBE_HDC1080_HUMIDITY_REG) || (regAddr == KETCUBE_HDC1080_TEMPERATURE_REG)) {
-        HAL_Delay(10);
+        ketCube_delay_LowPower(10);
     }
     
     /* Read data */
@@ -187,6 +203,104 @@ ketCube_cfg_ModError_t ketCube_hdc1080_Init(void)
     return KETCUBE_CFG_MODULE_OK;
 }
 
+/**
+ * @brief HDC2080 DRDY/INT pin IRQ handler
+ * 
+ * @param context unused
+ */
+static void ketCube_hdc2080_IrqHandler(void *context)
+{
+    intPending = TRUE;
+    
+    /* Threshold interrupt - report by exception */
+    if (ketCube_hdcX080_moduleCfg.autoMode != KETCUBE_HDC2080_AMM_DIS) {
+        ketCube_modules_RequestPeriod();
+    }
+}
+
+/**
+ * @brief Connect the HDC2080 DRDY/INT pin to EXTI
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_hdc2080_InitIrq(void)
+{
+    GPIO_InitTypeDef initStruct = { 0 };
+    
+    if (intUsed == TRUE) {
+        return KETCUBE_CFG_MODULE_OK;
+    }
+    
+    initStruct.Mode = GPIO_MODE_IT_RISING;
+    initStruct.Pull = GPIO_PULLDOWN;
+    initStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    
+    if (ketCube_GPIO_Init(KETCUBE_HDC2080_DRDY_PORT, KETCUBE_HDC2080_DRDY_PIN,
+                          &initStruct) != KETCUBE_CFG_DRV_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    if (ketCube_GPIO_SetIrq(KETCUBE_HDC2080_DRDY_PORT, KETCUBE_HDC2080_DRDY_PIN,
+                            KETCUBE_HDC2080_DRDY_PRIO,
+                            &ketCube_hdc2080_IrqHandler) != KETCUBE_CFG_DRV_OK) {
+        ketCube_GPIO_Release(KETCUBE_HDC2080_DRDY_PORT, KETCUBE_HDC2080_DRDY_PIN);
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    intUsed = TRUE;
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Convert temperature to HDC2080 8-bit threshold
+ * 
+ * @param temp temperature in 'C + 40
+ * 
+ * @retval threshold register value
+ */
+static uint8_t ketCube_hdc2080_TempThr(uint8_t temp)
+{
+    uint32_t thr = (((uint32_t) temp) * 256) / 165;
+    
+    return (thr > 0xFF) ? 0xFF : (uint8_t) thr;
+}
+
+/**
+ * @brief Convert relative humidity to HDC2080 8-bit threshold
+ * 
+ * @param hum relative humidity in %
+ * 
+ * @retval threshold register value
+ */
+static uint8_t ketCube_hdc2080_HumThr(uint8_t hum)
+{
+    uint32_t thr = (((uint32_t) hum) * 256) / 100;
+    
+    return (thr > 0xFF) ? 0xFF : (uint8_t) thr;
+}
+
+/**
+ * @brief Read (and clear) the HDC2080 interrupt status
+ * 
+ * @param status interrupt status @see ketCube_hdc2080_Int_t
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_hdc2080_GetIntStatus(uint8_t * status)
+{
+    intPending = FALSE;
+    
+    if (ketCube_I2C_HDC2080ReadReg
+        (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_INT_DRDY_REG, status)) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
 /**
  * @brief Initialize the HDC2080 sensor
  *
@@ -195,18 +309,66 @@ ketCube_cfg_ModError_t ketCube_hdc1080_Init(void)
  */
 ketCube_cfg_ModError_t ketCube_hdc2080_Init(void)
 {
-    ketCube_hdc2080_Init_t pxInit;
+    ketCube_hdc2080_Init_t pxInit = { 0 };
+    uint8_t status;
     
     pxInit.TemperatureMeasurementResolution = KETCUBE_HDC2080_TRES_14BIT;
     pxInit.HumidityMeasurementResolution = KETCUBE_HDCX080_HRES_14BIT;
     pxInit.MeasCfg = KETCUBE_HDC2080_MEASCFG_RHT;
     pxInit.MeasTrig = KETCUBE_HDC2080_MEASTRIG_START;
     
+    if (ketCube_hdcX080_moduleCfg.autoMode > KETCUBE_HDC2080_AMM_5_0) {
+        ketCube_hdcX080_moduleCfg.autoMode = KETCUBE_HDC2080_AMM_DIS;
+    }
+    
     pxInit.SoftwareReset = KETCUBE_HDCX080_RST_NONE;
-    pxInit.AutoMeasMode = KETCUBE_HDC2080_AMM_DIS;
+    pxInit.AutoMeasMode = (ketCube_hdc2080_AMM_t) ketCube_hdcX080_moduleCfg.autoMode;
     pxInit.Heater = KETCUBE_HDCX080_HTR_OFF;
     pxInit.IntEn = KETCUBE_HDC2080_INTEN_HZ;
     
+    /* One-shot mode: DRDY wakes-up MCU; auto mode: thresholds trigger report */
+    intEnable = 0;
+    if (ketCube_hdcX080_moduleCfg.autoMode == KETCUBE_HDC2080_AMM_DIS) {
+        intEnable = KETCUBE_HDC2080_INT_DRDY;
+    } else {
+        intEnable = ketCube_hdcX080_moduleCfg.thrEnable & KETCUBE_HDC2080_INT_THR_MASK;
+    }
+    
+    if (intEnable != 0) {
+        if (ketCube_hdc2080_InitIrq() == KETCUBE_CFG_MODULE_OK) {
+            pxInit.IntEn = KETCUBE_HDC2080_INTEN_EN;
+            pxInit.IntPol = KETCUBE_HDC2080_INTPOL_HIGH;
+            pxInit.IntMode = KETCUBE_HDC2080_INTPOL_LS;
+        } else {
+            ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
+                                          "HDC2080 DRDY/INT pin setup failed!");
+            intEnable = 0;
+        }
+    }
+    
+    if ((ketCube_I2C_HDC2080WriteReg
+         (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_TEMP_THR_H_REG,
+          ketCube_hdc2080_TempThr(ketCube_hdcX080_moduleCfg.thrTempHigh)))
+        || (ketCube_I2C_HDC2080WriteReg
+            (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_TEMP_THR_L_REG,
+             ketCube_hdc2080_TempThr(ketCube_hdcX080_moduleCfg.thrTempLow)))
+        || (ketCube_I2C_HDC2080WriteReg
+            (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_RH_THR_H_REG,
+             ketCube_hdc2080_HumThr(ketCube_hdcX080_moduleCfg.thrHumHigh)))
+        || (ketCube_I2C_HDC2080WriteReg
+            (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_RH_THR_L_REG,
+             ketCube_hdc2080_HumThr(ketCube_hdcX080_moduleCfg.thrHumLow)))
+        || (ketCube_I2C_HDC2080WriteReg
+            (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_INT_ENABLE_REG,
+             intEnable))) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
+                                      "HDC2080 initialization failed!");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    /* Clear pending interrupt */
+    ketCube_hdc2080_GetIntStatus(&status);
+    
     if (ketCube_I2C_HDC2080WriteReg
         (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_CFG_REG,
          ((uint8_t *) &pxInit)[0] )) {
@@ -223,6 +385,12 @@ ketCube_cfg_ModError_t ketCube_hdc2080_Init(void)
         return KETCUBE_CFG_MODULE_ERROR;
     }
     
+    if (ketCube_hdcX080_moduleCfg.autoMode != KETCUBE_HDC2080_AMM_DIS) {
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
+                                     "HDC2080 auto mode %d; thresholds: 0x%02X",
+                                     ketCube_hdcX080_moduleCfg.autoMode,
+                                     intEnable);
+    }
     
     return KETCUBE_CFG_MODULE_OK;
 }
@@ -235,6 +403,8 @@ ketCube_cfg_ModError_t ketCube_hdc2080_Init(void)
  */
 ketCube_cfg_ModError_t ketCube_hdcX080_Init(ketCube_InterModMsg_t *** msg)
 {
+    ketCube_deadband_Declare(KETCUBE_LISTS_MODULEID_HDCX080,
+                             &(ketCube_hdcX080_deadband[0]), 2);
 
     // Init drivers
     if (ketCube_I2C_Init() != KETCUBE_CFG_DRV_OK) {
@@ -242,6 +412,9 @@ ketCube_cfg_ModError_t ketCube_hdcX080_Init(ketCube_InterModMsg_t *** msg)
                                       "I2C initialization failed!");
         return KETCUBE_CFG_MODULE_ERROR;
     }
+    
+    /* Both HDC1080 and HDC2080 support the fast mode */
+    ketCube_I2C_SetDeviceSpeed(KETCUBE_HDC1080_I2C_ADDRESS, KETCUBE_I2C_SPEED_400KHZ);
 
     switch (ketCube_hdcX080_moduleCfg.sensType) {
         case KETCUBE_HDCX080_TYPE_AUTODETECT:
@@ -304,17 +477,10 @@ ketCube_cfg_ModError_t getHumidity(uint16_t * value)
             }
             break;
         case KETCUBE_HDCX080_TYPE_HDC2080:
-            /* Read LSB first! */
-            if (ketCube_I2C_HDC2080ReadReg
+            /* Read LSB first! The register address auto-increments */
+            if (ketCube_I2C_ReadDataQueued
                 (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_HUMIDITY_REG_L,
-                 &(((uint8_t *) &rawH)[0]))) {
-                ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
-                                              "Read humidity failed!");
-                return KETCUBE_CFG_MODULE_ERROR;
-            }
-            if (ketCube_I2C_HDC2080ReadReg
-                (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_HUMIDITY_REG_H,
-                 &(((uint8_t *) &rawH)[1]))) {
+                 (uint8_t *) &rawH, 2)) {
                 ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
                                               "Read humidity failed!");
                 return KETCUBE_CFG_MODULE_ERROR;
@@ -351,17 +517,10 @@ ketCube_cfg_ModError_t getTemperature(int16_t * value)
             }
             break;
         case KETCUBE_HDCX080_TYPE_HDC2080:
-            /* Read LSB first! */
-            if (ketCube_I2C_HDC2080ReadReg
+            /* Read LSB first! The register address auto-increments */
+            if (ketCube_I2C_ReadDataQueued
                 (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_TEMPERATURE_REG_L,
-                 &(((uint8_t *) (&rawT))[0]))) {
-                ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
-                                              "Read temperature failed!");
-                return KETCUBE_CFG_MODULE_ERROR;
-            }
-            if (ketCube_I2C_HDC2080ReadReg
-                (KETCUBE_HDC2080_I2C_ADDRESS, KETCUBE_HDC2080_TEMPERATURE_REG_H,
-                 &(((uint8_t *) &rawT)[1]))) {
+                 (uint8_t *) &rawT, 2)) {
                 ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
                                               "Read temperature failed!");
                 return KETCUBE_CFG_MODULE_ERROR;
@@ -396,9 +555,32 @@ ketCube_cfg_ModError_t ketCube_hdcX080_ReadData(uint8_t * buffer,
     uint16_t humidity = 0;
     
     ketCube_hdc2080_Init_t pxInit = { 0 };
+    uint8_t status;
     
     switch (ketCube_hdcX080_moduleCfg.sensType) {
         case KETCUBE_HDCX080_TYPE_HDC2080:
+            if (ketCube_hdcX080_moduleCfg.autoMode != KETCUBE_HDC2080_AMM_DIS) {
+                /* Auto mode: read the last result */
+                if ((intEnable == 0) || (ketCube_hdc2080_GetIntStatus(&status) != KETCUBE_CFG_MODULE_OK)) {
+                    break;
+                }
+                
+                status &= KETCUBE_HDC2080_INT_THR_MASK;
+                if (status != 0) {
+                    /* Mask threshold interrupts until the next read - one report by exception per base period */
+                    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
+                                                 "HDC2080 threshold event: 0x%02X", status);
+                    ketCube_I2C_HDC2080WriteReg(KETCUBE_HDC2080_I2C_ADDRESS,
+                                                KETCUBE_HDC2080_INT_ENABLE_REG, 0);
+                } else {
+                    /* (Re-)arm threshold interrupts */
+                    ketCube_I2C_HDC2080WriteReg(KETCUBE_HDC2080_I2C_ADDRESS,
+                                                KETCUBE_HDC2080_INT_ENABLE_REG,
+                                                intEnable);
+                }
+                break;
+            }
+            
             /* Initiate measurement */
             pxInit.TemperatureMeasurementResolution = KETCUBE_HDC2080_TRES_14BIT;
             pxInit.HumidityMeasurementResolution = KETCUBE_HDCX080_HRES_14BIT;
@@ -412,8 +594,17 @@ ketCube_cfg_ModError_t ketCube_hdcX080_ReadData(uint8_t * buffer,
                                               "HDC2080 measurement initialization failed!");
                 return KETCUBE_CFG_MODULE_ERROR;
             }
+            if (intEnable == KETCUBE_HDC2080_INT_DRDY) {
+                /* sleep until DRDY */
+                if (ketCube_delay_LowPowerUntil(KETCUBE_HDC2080_MEAS_TIMEOUT, &intPending) == FALSE) {
+                    ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_HDCX080,
+                                                  "HDC2080 DRDY timeout!");
+                }
+                ketCube_hdc2080_GetIntStatus(&status);
+            } else {
+                ketCube_delay_LowPower(2); // wait for conversion (~1.3 ms for 14-bit RH + T)
+            }
             break;
-            HAL_Delay(1); // wait for conversion
         case KETCUBE_HDCX080_TYPE_HDC1080:
             break;
         default:
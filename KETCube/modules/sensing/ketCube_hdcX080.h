@@ -54,6 +54,7 @@
 
 #include "ketCube_cfg.h"
 #include "ketCube_common.h"
+#include "ketCube_mainBoard.h"
 
 /** @defgroup KETCube_HDCx080 KETCube HDCx080
   * @brief KETCube HDCx080 module
@@ -82,7 +83,12 @@ typedef enum {
 typedef struct ketCube_hdcX080_moduleCfg_t {
     ketCube_cfg_ModuleCfgByte_t coreCfg;           /*!< KETCube core cfg byte */
     ketCube_hdcX080_sensType_t sensType;           /*!< Used sensor type */
-    uint8_t RFU[6];                                /*!< Reserved for future use, decrease size of this field when adding new values to preserve module configuration offsets */
+    uint8_t autoMode;                              /*!< HDC2080 auto measurement mode @see ketCube_hdc2080_AMM_t */
+    uint8_t thrEnable;                             /*!< HDC2080 threshold interrupts enabled @see ketCube_hdc2080_Int_t */
+    uint8_t thrTempHigh;                           /*!< HDC2080 temperature high threshold in 'C + 40 */
+    uint8_t thrTempLow;                            /*!< HDC2080 temperature low threshold in 'C + 40 */
+    uint8_t thrHumHigh;                            /*!< HDC2080 humidity high threshold in % */
+    uint8_t thrHumLow;                             /*!< HDC2080 humidity low threshold in % */
 } ketCube_hdcX080_moduleCfg_t;
 
 extern ketCube_hdcX080_moduleCfg_t ketCube_hdcX080_moduleCfg;
@@ -240,9 +246,18 @@ typedef enum {
     KETCUBE_HDC2080_TEMPERATURE_REG_H    = 0x01,
     KETCUBE_HDC2080_HUMIDITY_REG_L       = 0x02,
     KETCUBE_HDC2080_HUMIDITY_REG_H       = 0x03,
+    KETCUBE_HDC2080_INT_DRDY_REG         = 0x04,
     
     /* Registers UNUSED in this module */
     
+    KETCUBE_HDC2080_INT_ENABLE_REG       = 0x07,
+    
+    /* Registers UNUSED in this module */
+    
+    KETCUBE_HDC2080_TEMP_THR_L_REG       = 0x0A,
+    KETCUBE_HDC2080_TEMP_THR_H_REG       = 0x0B,
+    KETCUBE_HDC2080_RH_THR_L_REG         = 0x0C,
+    KETCUBE_HDC2080_RH_THR_H_REG         = 0x0D,
     KETCUBE_HDC2080_CFG_REG              = 0x0E,
     KETCUBE_HDC2080_MEASCFG_REG          = 0x0F,
     
@@ -302,6 +317,31 @@ typedef enum {
     KETCUBE_HDC2080_INTPOL_CMP = (uint8_t) 0x1     /*!< Comparator mode */
 } ketCube_hdc2080_IntMode_t;
 
+/**
+* @brief Interrupt sources (INT_DRDY status and INT_ENABLE register bits)
+*/
+typedef enum {
+    KETCUBE_HDC2080_INT_DRDY = (uint8_t) 0x80,    /*!< Data ready */
+    KETCUBE_HDC2080_INT_TH   = (uint8_t) 0x40,    /*!< Temperature high threshold */
+    KETCUBE_HDC2080_INT_TL   = (uint8_t) 0x20,    /*!< Temperature low threshold */
+    KETCUBE_HDC2080_INT_HH   = (uint8_t) 0x10,    /*!< Humidity high threshold */
+    KETCUBE_HDC2080_INT_HL   = (uint8_t) 0x08,    /*!< Humidity low threshold */
+} ketCube_hdc2080_Int_t;
+
+#define KETCUBE_HDC2080_INT_THR_MASK  (KETCUBE_HDC2080_INT_TH | KETCUBE_HDC2080_INT_TL | KETCUBE_HDC2080_INT_HH | KETCUBE_HDC2080_INT_HL)
+
+/**
+* @brief  DRDY/INT pin connection
+*/
+#define KETCUBE_HDC2080_DRDY_PORT     KETCUBE_MAIN_BOARD_PIN_INT_PORT
+#define KETCUBE_HDC2080_DRDY_PIN      KETCUBE_MAIN_BOARD_PIN_INT_PIN
+#define KETCUBE_HDC2080_DRDY_PRIO     0             ///< NVIC priority; the EXTI IRQ is shared with the radio DIO lines
+
+/**
+* @brief  Maximal one-shot conversion time (ms)
+*/
+#define KETCUBE_HDC2080_MEAS_TIMEOUT  10
+
 /**
 * @brief Measurement Configuration
 */
@@ -77,6 +77,132 @@ ketCube_terminal_cmd_t ketCube_hdcX080_commands[] = {
         }
     },
     
+    {
+        .cmd   = "autoMode",
+        .descr = "HDC2080 auto measurement mode (0: disabled/one-shot; 1: 1/120 Hz; 2: 1/60 Hz; 3: 0.1 Hz; 4: 0.2 Hz; 5: 1 Hz; 6: 2 Hz; 7: 5 Hz)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_HDCX080,
+            .offset   = offsetof(ketCube_hdcX080_moduleCfg_t, autoMode),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "thrEnable",
+        .descr = "HDC2080 threshold interrupts in auto mode (bitmask; 0x40: T high; 0x20: T low; 0x10: RH high; 0x08: RH low)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_HDCX080,
+            .offset   = offsetof(ketCube_hdcX080_moduleCfg_t, thrEnable),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "thrTempHigh",
+        .descr = "HDC2080 high temperature threshold ('C + 40)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_HDCX080,
+            .offset   = offsetof(ketCube_hdcX080_moduleCfg_t, thrTempHigh),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "thrTempLow",
+        .descr = "HDC2080 low temperature threshold ('C + 40)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_HDCX080,
+            .offset   = offsetof(ketCube_hdcX080_moduleCfg_t, thrTempLow),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "thrHumHigh",
+        .descr = "HDC2080 high relative humidity threshold (%)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_HDCX080,
+            .offset   = offsetof(ketCube_hdcX080_moduleCfg_t, thrHumHigh),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "thrHumLow",
+        .descr = "HDC2080 low relative humidity threshold (%)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_HDCX080,
+            .offset   = offsetof(ketCube_hdcX080_moduleCfg_t, thrHumLow),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
     DEF_TERMINATE()
     
 };
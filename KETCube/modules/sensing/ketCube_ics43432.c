@@ -42,21 +42,66 @@
  * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "ketCube_cfg.h"
 #include "ketCube_terminal.h"
 #include "ketCube_i2s.h"
 #include "ketCube_ics43432.h"
+#include "ketCube_ics43432_spl.h"
 #include "ketCube_gpio.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_ICS43432
 
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
+
 ketCube_ics43432_moduleCfg_t ketCube_ics43432_moduleCfg; /*!< Module configuration storage */
 
-static volatile uint32_t noiseCnt = 0;
+static ketCube_ics43432_spl_acc_t splAcc;                   /*!< Accumulated energies; updated in DMA IRQ context */
+static int32_t splInput[KETCUBE_I2S_BLOCK_LEN];             /*!< Q31 filter input */
+
+/**
+ * @brief Process one block of samples
+ * 
+ * Called by the I2S driver from DMA IRQ context.
+ * 
+ * @param block received frames
+ * @param len number of frames in the block
+ */
+static void processBlock(const uint16_t * block, uint16_t len)
+{
+    uint16_t i;
+    uint64_t shortEnergy;
+
+    for (i = 0; i < len; i++) {
+        splInput[i] = (int32_t) (((uint32_t) KETCUBE_I2S_LEFT_SAMPLE(block, i))
+                                 << KETCUBE_ICS43432_SPL_INPUT_SHIFT);
+    }
+
+    shortEnergy = ketCube_ics43432_spl_AddBlock(&splAcc, &(splInput[0]), len);
+    if (shortEnergy == 0) {
+        return;
+    }
+
+    /* LED is active low */
+    ketCube_GPIO_Write(KETCUBE_ICS43432_NOISE_LED_PORT,
+                       KETCUBE_ICS43432_NOISE_LED_PIN,
+                       ((ketCube_ics43432_spl_Level(shortEnergy, KETCUBE_ICS43432_SPL_SHORT_BLOCKS)
+                         + ketCube_ics43432_moduleCfg.calOffset) < KETCUBE_ICS43432_NOISE_LEVEL));
+}
 
 ketCube_cfg_ModError_t ketCube_ics43432_Init(ketCube_InterModMsg_t *** msg)
 {
-    /* Initialise I2S bus and start synchronization */
+    if (KETCUBE_I2S_SAMPLE_RATE != KETCUBE_ICS43432_SPL_FS) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                      "Filters require %d Hz sampling rate!",
+                                      KETCUBE_ICS43432_SPL_FS);
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    /* Initialise I2S bus */
     if (ketCube_I2S_Init() != KETCUBE_CFG_MODULE_OK) {
         ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
                                       "I2S bus initialisation failed!");
@@ -73,85 +118,132 @@ ketCube_cfg_ModError_t ketCube_ics43432_Init(ketCube_InterModMsg_t *** msg)
     ketCube_GPIO_ReInit(KETCUBE_ICS43432_NOISE_LED_PORT,
                         KETCUBE_ICS43432_NOISE_LED_PIN, &initStruct);
 
-    /* Enable and set I2S Interrupt to lower priority */
-    HAL_NVIC_SetPriority(KETCUBE_I2S_EV_IRQn, 1, 0);
-    HAL_NVIC_EnableIRQ(KETCUBE_I2S_EV_IRQn);
+    ketCube_ics43432_spl_Init((ketCube_ics43432_moduleCfg.bands != 0));
+    memset(&splAcc, 0, sizeof(splAcc));
+    ketCube_ics43432_spl_Reset(&splAcc);
+
+    /* Start continuous block capture */
+    if (ketCube_I2S_Start(&processBlock) != KETCUBE_CFG_MODULE_OK) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                      "I2S capture start failed!");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
 
     return KETCUBE_CFG_MODULE_OK;
 }
 
 ketCube_cfg_ModError_t ketCube_ics43432_UnInit(void)
 {
-    return KETCUBE_CFG_MODULE_OK;
+    ketCube_I2S_Stop();
+
+    return ketCube_I2S_UnInit();
 }
 
-ketCube_cfg_ModError_t ketCube_ics43432_ReadData(uint8_t * buffer,
-                                                 uint8_t * len)
+/**
+ * @brief Print capture CPU load and energy estimate
+ * 
+ * CPU load is the ratio of block processing cycles to the block duration.
+ * Energy per second of capture is estimated from typical supply currents:
+ * the MCU sleeps between blocks and runs during block processing.
+ */
+static void printProfile(void)
 {
-    uint8_t i = 0;
+    ketCube_I2S_Stats_t stats;
+    uint64_t available;
+    uint32_t load;              // per mille
+    uint32_t currentUA;
 
-    // Fraction of samples over threshold scaled to byte
-    buffer[i++] =
-        (uint8_t) (255 * KETCUBE_ICS43432_MAX_SAMPLE_COUNT / noiseCnt);
-    *len = i;
+    ketCube_I2S_GetStats(&stats, TRUE);
 
-    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
-                                 "Noise counter: %5d", noiseCnt);
+    if (stats.blocks == 0) {
+        return;
+    }
 
-    noiseCnt = 0;
+    available = ((uint64_t) stats.blocks) * KETCUBE_I2S_BLOCK_LEN
+        * SystemCoreClock / KETCUBE_I2S_SAMPLE_RATE;
+    load = (uint32_t) ((stats.cycles * 1000) / available);
+
+    currentUA = KETCUBE_ICS43432_MIC_UA + KETCUBE_ICS43432_MCU_SLEEP_UA
+        + (load * (KETCUBE_ICS43432_MCU_RUN_UA - KETCUBE_ICS43432_MCU_SLEEP_UA)) / 1000;
+
+    ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                     "Blocks: %d; errors: %d; cycles/block: %d; filter RAM: %d B",
+                                     stats.blocks, stats.errors,
+                                     (uint32_t) (stats.cycles / stats.blocks),
+                                     ketCube_ics43432_spl_RamSize());
+    ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                     "CPU load: %d.%d %%; energy: %d uJ per second of capture",
+                                     load / 10, load % 10,
+                                     (currentUA * KETCUBE_ICS43432_SUPPLY_MV) / 1000);
+}
 
-    return KETCUBE_CFG_MODULE_OK;
+/**
+ * @brief Append a level to the payload
+ */
+static void writeLevel(uint8_t * buffer, uint8_t * len, int32_t level)
+{
+    if (level < 0) {
+        level = 0;
+    } else if (level > UINT16_MAX) {
+        level = UINT16_MAX;
+    }
+
+    buffer[(*len)++] = (uint8_t) ((level >> 8) & 0xFF);
+    buffer[(*len)++] = (uint8_t) (level & 0xFF);
 }
 
 /**
- * @brief I2S interrupt handler
+ * @brief Report sound levels accumulated since the last call
+ * 
+ * Payload: LAeq, LAmax, LAmin and optionally 1/1-octave band Leq
+ * (125 Hz ... 8 kHz); all in 0.1 dB SPL, 2 bytes, MSB first. Bands are
+ * measured in turn; a band not measured since the last call reads 0.
  */
-void SPI2_IRQHandler()
+ketCube_cfg_ModError_t ketCube_ics43432_ReadData(uint8_t * buffer,
+                                                 uint8_t * len)
 {
-    //Read data register to clear interrupt flag
-    uint16_t temp = SPI2->DR;
-    static uint16_t tempH;
-    static uint32_t U32;
-    static int32_t I32;
-    static bool sync = false;
-
-    /**
-      * Synchronization flag is set false in right
-      * side words and true after first word of
-      * left channel.
-      * Thus it is used to determine order of recieved
-      * words.
-      */
-
-    if (SPI2->SR & SPI_SR_CHSIDE) {
-        /* CHSIDE == 1 => Right Channel */
-        sync = false;
-    } else {
-        /* CHSIDE == 0 => Left Channel */
-        if (SPI2->SR & SPI_SR_OVR) {
-            sync = false;
-        } else {
-            if (sync == false) {
-                tempH = temp;
-                sync = true;
-            } else {
-                U32 = (((uint32_t) tempH) << 16) | temp;
-                I32 = (*((int32_t *) (&U32))) >> 8;
-                if (abs(I32) > 30000) {
-                    if (noiseCnt < UINT32_MAX) {
-                        noiseCnt += 1;
-                    }
-                    ketCube_GPIO_Write(KETCUBE_ICS43432_NOISE_LED_PORT,
-                                       KETCUBE_ICS43432_NOISE_LED_PIN,
-                                       FALSE);
-                } else {
-                    ketCube_GPIO_Write(KETCUBE_ICS43432_NOISE_LED_PORT,
-                                       KETCUBE_ICS43432_NOISE_LED_PIN,
-                                       TRUE);
-                }
-            }
+    ketCube_ics43432_spl_acc_t acc;
+    ketCube_ics43432_spl_levels_t levels;
+    int32_t cal = ketCube_ics43432_moduleCfg.calOffset;
+    uint8_t i;
+
+    BACKUP_PRIMASK();
+    DISABLE_IRQ();
+    acc = splAcc;
+    ketCube_ics43432_spl_Reset(&splAcc);
+    RESTORE_PRIMASK();
+
+    *len = 0;
+
+    if (acc.blocks == 0) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                      "No samples captured!");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    ketCube_ics43432_spl_Levels(&acc, &levels);
+
+    writeLevel(buffer, len, levels.leq + cal);
+    writeLevel(buffer, len, levels.max + cal);
+    writeLevel(buffer, len, levels.min + cal);
+
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                 "LAeq: %d; LAmax: %d; LAmin: %d (0.1 dB)",
+                                 levels.leq + cal, levels.max + cal,
+                                 levels.min + cal);
+
+    if (ketCube_ics43432_moduleCfg.bands != 0) {
+        for (i = 0; i < KETCUBE_ICS43432_SPL_BANDS; i++) {
+            writeLevel(buffer, len, levels.bands[i] + cal);
+            ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_ICS43432,
+                                             "Band %d Hz: %d (0.1 dB)",
+                                             125 << i, levels.bands[i] + cal);
         }
     }
+
+    printProfile();
+
+    return KETCUBE_CFG_MODULE_OK;
 }
 
 #endif                          // KETCUBE_CFG_INC_MOD_ICS43432
@@ -52,6 +52,9 @@
 */
 typedef struct ketCube_ics43432_moduleCfg_t {
     ketCube_cfg_ModuleCfgByte_t coreCfg;           /*!< KETCube core cfg byte */
+    uint8_t bands;                                 /*!< Report 1/1-octave band levels (0: disabled) */
+    uint8_t RFU[10];                               /*!< Reserved for future use, decrease size of this field when adding new values to preserve module configuration offsets */
+    int32_t calOffset;                             /*!< Calibration offset (0.1 dB) */
 } ketCube_ics43432_moduleCfg_t;
 
 extern ketCube_ics43432_moduleCfg_t ketCube_ics43432_moduleCfg;
@@ -73,13 +76,18 @@ extern ketCube_ics43432_moduleCfg_t ketCube_ics43432_moduleCfg;
 #define KETCUBE_ICS43432_NOISE_LED_PORT       KETCUBE_GPIO_PB
 #define KETCUBE_ICS43432_NOISE_LED_PIN        GPIO_PIN_2
 
-#define KETCUBE_ICS43432_MAX_SAMPLE_COUNT     KETCUBE_I2S_SAMPLE_RATE * KETCUBE_CORECFG_MIN_BASEPERIOD / 1000
+#define KETCUBE_ICS43432_NOISE_LEVEL          700       ///< Noise LED threshold: short LAeq (0.1 dB)
+
+/* Typical supply currents used for capture energy estimate */
+#define KETCUBE_ICS43432_SUPPLY_MV            3300U     ///< Supply voltage
+#define KETCUBE_ICS43432_MIC_UA               1000U     ///< ICS43432 active
+#define KETCUBE_ICS43432_MCU_RUN_UA           5600U     ///< STM32L0 run mode, 32 MHz
+#define KETCUBE_ICS43432_MCU_SLEEP_UA         1500U     ///< STM32L0 sleep mode, 32 MHz, DMA active
 
 extern ketCube_cfg_ModError_t ketCube_ics43432_Init(ketCube_InterModMsg_t
                                                     *** msg);
 extern ketCube_cfg_ModError_t ketCube_ics43432_UnInit(void);
 extern ketCube_cfg_ModError_t ketCube_ics43432_ReadData(uint8_t * buffer,
                                                         uint8_t * len);
-extern void SPI2_IRQHandler(void);
 
 #endif                          /* __KETCUBE_ICS43432_H_ */
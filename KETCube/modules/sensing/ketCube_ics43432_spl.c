@@ -0,0 +1,325 @@
+/**
+ * @file    ketCube_ics43432_spl.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains the ICS43432 sound level engine
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <string.h>
+
+#include "ketCube_cfg.h"
+#include "arm_math.h"
+#include "ketCube_ics43432_spl.h"
+
+#ifdef KETCUBE_CFG_INC_MOD_ICS43432
+
+#define KETCUBE_ICS43432_SPL_A_STAGES     3     ///< A-weighting biquad stages
+#define KETCUBE_ICS43432_SPL_POST_SHIFT   1     ///< Coefficients are scaled by 1/2
+#define KETCUBE_ICS43432_SPL_OUT_SHIFT    11    ///< Output scaling before squaring: full-scale peak is 2^19
+#define KETCUBE_ICS43432_SPL_FS_MS_LOG2   37    ///< log2 of the full-scale sine mean square: (2^19)^2 / 2
+
+/**
+ * @brief A-weighting cascade for 32 kHz: {b0, b1, b2, -a1, -a2} / 2
+ * 
+ * Stages 1, 2: bilinear transform of the 20.6 Hz, 107.7 Hz and 737.9 Hz
+ * poles (pre-warped); stage 3: 12.2 kHz poles fitted to the analog response;
+ * unity gain at 1 kHz.
+ */
+static const q31_t aWeightCoefs[5 * KETCUBE_ICS43432_SPL_A_STAGES] = {
+    1073741824, INT32_MIN, 1073741824, 2138815446, -1065091116,
+    1073741824, INT32_MIN, 1073741824, 1979732008, -909029292,
+    847076224, 185674581, -5643099, 194461173, -9175105,
+};
+
+/**
+ * @brief Octave band-pass filters for 32 kHz: {b0, b1, b2, -a1, -a2} / 2
+ * 
+ * Second-order band-pass, Q = sqrt(2), 0 dB at the centre frequency.
+ */
+static const q31_t bandCoefs[KETCUBE_ICS43432_SPL_BANDS][5] = {
+    { 9236325, 0, -9236325, 2128369779, -1055269174 },        // 125 Hz
+    { 18309682, 0, -18309682, 2108321656, -1037122460 },      // 250 Hz
+    { 35963474, 0, -35963474, 2065562327, -1001814875 },      // 500 Hz
+    { 69282431, 0, -69282431, 1970317975, -935176962 },       // 1 kHz
+    { 127962958, 0, -127962958, 1747571472, -817815907 },     // 2 kHz
+    { 214748365, 0, -214748365, 1214800200, -644245094 },     // 4 kHz
+    { 280465525, 0, -280465525, 0, -512810774 },              // 8 kHz
+};
+
+static arm_biquad_casd_df1_inst_q31 aWeight;                                /*!< A-weighting instance */
+static q31_t aWeightState[4 * KETCUBE_ICS43432_SPL_A_STAGES];               /*!< A-weighting state */
+static arm_biquad_casd_df1_inst_q31 band[KETCUBE_ICS43432_SPL_BANDS];       /*!< Octave band instances */
+static q31_t bandState[KETCUBE_ICS43432_SPL_BANDS][4];                      /*!< Octave band states */
+static q31_t out[KETCUBE_ICS43432_SPL_MAX_BLOCK];                           /*!< Filter output */
+static bool bandsEnabled = FALSE;
+static uint8_t activeBand;                                                   /*!< Band measured in turn */
+static uint32_t activeBlocks;                                                /*!< Blocks of the active band */
+
+/**
+ * @brief Block mean square of the filter output
+ */
+static uint64_t meanSquare(const q31_t * y, uint16_t len)
+{
+    uint16_t i;
+    int32_t s;
+    uint64_t sum = 0;
+
+    for (i = 0; i < len; i++) {
+        s = y[i] >> KETCUBE_ICS43432_SPL_OUT_SHIFT;
+        sum += (uint64_t) ((int64_t) s * s);
+    }
+
+    return sum / len;
+}
+
+/**
+ * @brief Base-2 logarithm
+ * 
+ * @param x argument; must not be 0
+ * 
+ * @retval log2(x) in Q16
+ */
+static int32_t log2Q16(uint64_t x)
+{
+    int32_t res = 31 << 16;
+    uint64_t sq;
+    uint32_t m;
+    uint8_t i;
+
+    /* Normalize to Q31 mantissa in [1, 2) */
+    while (x >= ((uint64_t) 1 << 32)) {
+        x >>= 1;
+        res += 1 << 16;
+    }
+    while (x < ((uint64_t) 1 << 31)) {
+        x <<= 1;
+        res -= 1 << 16;
+    }
+    m = (uint32_t) x;
+
+    /* Fractional bits by repeated squaring */
+    for (i = 0; i < 16; i++) {
+        sq = ((uint64_t) m * m) >> 31;
+        if (sq >= ((uint64_t) 1 << 32)) {
+            sq >>= 1;
+            res += 1 << (15 - i);
+        }
+        m = (uint32_t) sq;
+    }
+
+    return res;
+}
+
+/**
+ * @brief Initialize filters
+ * 
+ * @param bands enable octave band filters
+ */
+void ketCube_ics43432_spl_Init(bool bands)
+{
+    uint8_t i;
+
+    arm_biquad_cascade_df1_init_q31(&aWeight, KETCUBE_ICS43432_SPL_A_STAGES,
+                                    (q31_t *) & (aWeightCoefs[0]),
+                                    &(aWeightState[0]),
+                                    KETCUBE_ICS43432_SPL_POST_SHIFT);
+
+    for (i = 0; i < KETCUBE_ICS43432_SPL_BANDS; i++) {
+        arm_biquad_cascade_df1_init_q31(&(band[i]), 1,
+                                        (q31_t *) & (bandCoefs[i][0]),
+                                        &(bandState[i][0]),
+                                        KETCUBE_ICS43432_SPL_POST_SHIFT);
+    }
+
+    bandsEnabled = bands;
+    activeBand = 0;
+    activeBlocks = 0;
+}
+
+/**
+ * @brief Reset accumulated energies
+ * 
+ * The running short interval is kept.
+ * 
+ * @param acc accumulator
+ */
+void ketCube_ics43432_spl_Reset(ketCube_ics43432_spl_acc_t * acc)
+{
+    acc->energy = 0;
+    memset(&(acc->bands[0]), 0, sizeof(acc->bands));
+    memset(&(acc->bandBlocks[0]), 0, sizeof(acc->bandBlocks));
+    acc->shortMax = 0;
+    acc->shortMin = UINT64_MAX;
+    acc->blocks = 0;
+    acc->shorts = 0;
+}
+
+/**
+ * @brief Process a block of samples
+ * 
+ * @param acc accumulator
+ * @param x samples (24-bit << KETCUBE_ICS43432_SPL_INPUT_SHIFT)
+ * @param len number of samples; max. KETCUBE_ICS43432_SPL_MAX_BLOCK
+ * 
+ * @retval energy of the just completed short interval; 0 if not completed
+ */
+uint64_t ketCube_ics43432_spl_AddBlock(ketCube_ics43432_spl_acc_t * acc,
+                                       int32_t * x, uint16_t len)
+{
+    uint64_t ms, bandMs, shortEnergy;
+
+    if (len > KETCUBE_ICS43432_SPL_MAX_BLOCK) {
+        len = KETCUBE_ICS43432_SPL_MAX_BLOCK;
+    }
+
+    arm_biquad_cascade_df1_q31(&aWeight, x, &(out[0]), len);
+    ms = meanSquare(&(out[0]), len);
+
+    if (bandsEnabled == TRUE) {
+        /* next band starts from the zero state */
+        if (activeBlocks >= KETCUBE_ICS43432_SPL_BAND_BLOCKS) {
+            activeBand = (activeBand + 1) % KETCUBE_ICS43432_SPL_BANDS;
+            activeBlocks = 0;
+            memset(&(bandState[activeBand][0]), 0, sizeof(bandState[activeBand]));
+        }
+        activeBlocks++;
+
+        arm_biquad_cascade_df1_q31(&(band[activeBand]), x, &(out[0]), len);
+        bandMs = meanSquare(&(out[0]), len);
+        if (activeBlocks > KETCUBE_ICS43432_SPL_BAND_SETTLE) {
+            acc->bands[activeBand] += bandMs;
+            acc->bandBlocks[activeBand]++;
+        }
+    }
+
+    acc->energy += ms;
+    acc->blocks++;
+
+    acc->shortEnergy += ms;
+    acc->shortBlocks++;
+    if (acc->shortBlocks < KETCUBE_ICS43432_SPL_SHORT_BLOCKS) {
+        return 0;
+    }
+
+    shortEnergy = acc->shortEnergy;
+    if (shortEnergy > acc->shortMax) {
+        acc->shortMax = shortEnergy;
+    }
+    if (shortEnergy < acc->shortMin) {
+        acc->shortMin = shortEnergy;
+    }
+    acc->shorts++;
+
+    acc->shortEnergy = 0;
+    acc->shortBlocks = 0;
+
+    /* Keep 0 reserved for "not completed" */
+    return (shortEnergy == 0) ? 1 : shortEnergy;
+}
+
+/**
+ * @brief Convert energy to level
+ * 
+ * @param energy sum of block mean squares
+ * @param blocks number of blocks
+ * 
+ * @retval level in 0.1 dB re KETCUBE_ICS43432_SPL_FS_LEVEL; 0 if there is no energy
+ */
+int32_t ketCube_ics43432_spl_Level(uint64_t energy, uint32_t blocks)
+{
+    int64_t log;
+
+    if ((energy == 0) || (blocks == 0)) {
+        return 0;
+    }
+
+    /* log2(ms / ms_FS) in Q16; 100 * log10(2) = 30.103 */
+    log = (int64_t) log2Q16(energy) - log2Q16(blocks)
+        - ((int64_t) KETCUBE_ICS43432_SPL_FS_MS_LOG2 << 16);
+    log = log * 30103;
+    if (log < 0) {
+        log -= 32768000;
+    } else {
+        log += 32768000;
+    }
+
+    return KETCUBE_ICS43432_SPL_FS_LEVEL + (int32_t) (log / 65536000);
+}
+
+/**
+ * @brief Compute levels from accumulated energies
+ * 
+ * @param acc accumulator
+ * @param levels output levels
+ */
+void ketCube_ics43432_spl_Levels(const ketCube_ics43432_spl_acc_t * acc,
+                                 ketCube_ics43432_spl_levels_t * levels)
+{
+    uint8_t i;
+
+    levels->leq = ketCube_ics43432_spl_Level(acc->energy, acc->blocks);
+
+    if (acc->shorts == 0) {
+        levels->max = levels->leq;
+        levels->min = levels->leq;
+    } else {
+        levels->max = ketCube_ics43432_spl_Level(acc->shortMax,
+                                                 KETCUBE_ICS43432_SPL_SHORT_BLOCKS);
+        levels->min = ketCube_ics43432_spl_Level(acc->shortMin,
+                                                 KETCUBE_ICS43432_SPL_SHORT_BLOCKS);
+    }
+
+    for (i = 0; i < KETCUBE_ICS43432_SPL_BANDS; i++) {
+        levels->bands[i] = ketCube_ics43432_spl_Level(acc->bands[i], acc->bandBlocks[i]);
+    }
+}
+
+/**
+ * @brief Get RAM used by filters
+ * 
+ * @retval size in bytes
+ */
+uint32_t ketCube_ics43432_spl_RamSize(void)
+{
+    return sizeof(aWeight) + sizeof(aWeightState) + sizeof(band)
+        + sizeof(bandState) + sizeof(out);
+}
+
+#endif                          // KETCUBE_CFG_INC_MOD_ICS43432
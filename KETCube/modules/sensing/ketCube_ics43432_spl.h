@@ -0,0 +1,127 @@
+/**
+ * @file    ketCube_ics43432_spl.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   This file contains definitions for the ICS43432 sound level engine
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#ifndef __KETCUBE_ICS43432_SPL_H
+#define __KETCUBE_ICS43432_SPL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @defgroup KETCube_ICS43432_spl KETCube ICS43432 sound level
+  * @brief Fixed-point sound level meter
+  * 
+  * Blocks of Q31 samples are filtered by an A-weighting IIR biquad cascade
+  * (CMSIS-DSP arm_biquad_cascade_df1_q31()) and the mean-square energy is
+  * accumulated to the equivalent continuous level (LAeq). LAmax/LAmin are the
+  * extremes of short (~125 ms) Leq intervals. Optional 1/1-octave band levels
+  * use one second-order band-pass biquad per band (unweighted).
+  * 
+  * All the band filters do not fit the block period of a Cortex-M0+ at 32 MHz,
+  * thus one band filter runs at a time: bands are measured in turn for
+  * KETCUBE_ICS43432_SPL_BAND_BLOCKS blocks, the first
+  * KETCUBE_ICS43432_SPL_BAND_SETTLE blocks of which are discarded. Band levels
+  * need a reporting period of at least 7 x 128 ms and are a time-sampled
+  * estimate for non-stationary sound.
+  * 
+  * Filters are designed for 32 kHz sampling rate; the A-weighting cascade
+  * (bilinear transform, optimized HF section) is within 0.05 dB of the
+  * IEC 61672 curve up to 10 kHz. Octave band filters are not IEC 61260
+  * compliant -- broadband noise reads ~2 dB above the ideal band level.
+  * 
+  * Levels are reported in 0.1 dB, referenced to the full-scale sine level.
+  * 
+  * @ingroup KETCube_ICS43432
+  * @{
+  */
+
+#define KETCUBE_ICS43432_SPL_FS               32000U    ///< Sampling rate the filters are designed for
+#define KETCUBE_ICS43432_SPL_INPUT_SHIFT      7         ///< 24-bit sample to Q31 input shift; 6 dB headroom for A-weighting gain
+#define KETCUBE_ICS43432_SPL_MAX_BLOCK        128U      ///< Max. block length (samples)
+#define KETCUBE_ICS43432_SPL_SHORT_BLOCKS     32U       ///< Short Leq interval for LAmax/LAmin: 32 x 128 samples = 128 ms
+#define KETCUBE_ICS43432_SPL_BANDS            7         ///< Octave bands: 125 Hz ... 8 kHz
+#define KETCUBE_ICS43432_SPL_BAND_BLOCKS      32U       ///< Blocks a band is measured in turn: 128 ms
+#define KETCUBE_ICS43432_SPL_BAND_SETTLE      8U        ///< Band filter settling blocks discarded: 32 ms
+#define KETCUBE_ICS43432_SPL_FS_LEVEL         1200      ///< Full-scale sine level (0.1 dB SPL): ICS43432 sensitivity is -26 dBFS at 94 dB SPL
+
+/**
+* @brief  Energy accumulator
+* 
+* Energies are sums of block mean squares (LSB^2 of the >> 11 scaled output).
+*/
+typedef struct ketCube_ics43432_spl_acc_t {
+    uint64_t energy;                                /*!< A-weighted energy */
+    uint64_t bands[KETCUBE_ICS43432_SPL_BANDS];     /*!< Octave band energies */
+    uint32_t bandBlocks[KETCUBE_ICS43432_SPL_BANDS];/*!< Number of accumulated blocks per band */
+    uint64_t shortMax;                              /*!< Max. short interval energy */
+    uint64_t shortMin;                              /*!< Min. short interval energy */
+    uint32_t blocks;                                /*!< Number of accumulated blocks */
+    uint32_t shorts;                                /*!< Number of completed short intervals */
+    uint64_t shortEnergy;                           /*!< Running short interval energy */
+    uint32_t shortBlocks;                           /*!< Running short interval blocks */
+} ketCube_ics43432_spl_acc_t;
+
+/**
+* @brief  Sound levels (0.1 dB)
+*/
+typedef struct ketCube_ics43432_spl_levels_t {
+    int32_t leq;                                    /*!< LAeq */
+    int32_t max;                                    /*!< LAmax (short Leq) */
+    int32_t min;                                    /*!< LAmin (short Leq) */
+    int32_t bands[KETCUBE_ICS43432_SPL_BANDS];      /*!< Octave band Leq (unweighted); 0 if not measured */
+} ketCube_ics43432_spl_levels_t;
+
+extern void ketCube_ics43432_spl_Init(bool bands);
+extern void ketCube_ics43432_spl_Reset(ketCube_ics43432_spl_acc_t * acc);
+extern uint64_t ketCube_ics43432_spl_AddBlock(ketCube_ics43432_spl_acc_t * acc,
+                                              int32_t * x, uint16_t len);
+extern int32_t ketCube_ics43432_spl_Level(uint64_t energy, uint32_t blocks);
+extern void ketCube_ics43432_spl_Levels(const ketCube_ics43432_spl_acc_t * acc,
+                                        ketCube_ics43432_spl_levels_t * levels);
+extern uint32_t ketCube_ics43432_spl_RamSize(void);
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_ICS43432_SPL_H */
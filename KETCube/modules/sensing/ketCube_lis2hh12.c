@@ -43,48 +43,169 @@
  * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE.
  */
 
+
 #include "ketCube_cfg.h"
 #include "ketCube_terminal.h"
 #include "ketCube_i2c.h"
+#include "ketCube_gpio.h"
+#include "ketCube_delay.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_modules.h"
 #include "ketCube_lis2hh12.h"
+#include "ketCube_lis2hh12_fft.h"
 
 #ifdef KETCUBE_CFG_INC_MOD_LIS2HH12
 
+#define BACKUP_PRIMASK()  uint32_t primask_bit= __get_PRIMASK()
+#define DISABLE_IRQ() __disable_irq()
+#define RESTORE_PRIMASK() __set_PRIMASK(primask_bit)
+
 ketCube_lis2hh12_moduleCfg_t ketCube_lis2hh12_moduleCfg;    /*!< Module configuration storage */
 
 /**
- * @brief Initialize the LIS2HH12 sensor
+* @brief Vibration feature accumulator (per axis)
+*/
+typedef struct ketCube_lis2hh12_axisAcc_t {
+    int32_t dc;                 /*!< DC level estimate (LSB) for zero-crossing detection */
+    int32_t sum;                /*!< Sum of samples */
+    uint64_t sumSq;             /*!< Sum of squared samples */
+    int16_t min;                /*!< Minimal sample */
+    int16_t max;                /*!< Maximal sample */
+    uint16_t zc;                /*!< Zero (DC level) crossings */
+    bool above;                 /*!< Last sample state relative to the DC level */
+} ketCube_lis2hh12_axisAcc_t;
+
+static const uint16_t ketCube_lis2hh12_odrHz[] = { 0, 10, 50, 100, 200, 400, 800 };
+
+static volatile bool fifoPending = FALSE;   /*!< FIFO watermark reached */
+static volatile uint16_t motionCnt = 0;     /*!< Motion events since the last report */
+static volatile bool motionReported = FALSE; /*!< Moving state already reported; further events are reported in base period */
+static bool intUsed = FALSE;                /*!< INT1 is connected to EXTI */
+static int16_t fifoData[2][KETCUBE_LIS2HH12_FIFO_SIZE][3]; /*!< FIFO burst buffers; a burst is processed while the next one is read */
+static uint8_t fifoSrc;                                     /*!< FIFO_SRC of the last drain */
+static volatile uint8_t fifoCnt;                            /*!< Samples read by the last drain; 0 in case of failure */
+static uint8_t fifoBuf;                                     /*!< Buffer of the last drain */
+
+static ketCube_lis2hh12_fft_acc_t fftAcc;                   /*!< Averaged spectrum */
+static int16_t fftBlock[KETCUBE_LIS2HH12_FFT_LEN];          /*!< Spectrum input block */
+static uint8_t fftFill;                                     /*!< Samples in fftBlock */
+static uint32_t fftCycles;                                  /*!< Max. cycles per spectrum block */
+
+/**
+ * @brief LIS2HH12 INT1 IRQ handler
+ * 
+ * @param context unused
+ */
+static void ketCube_lis2hh12_IrqHandler(void *context)
+{
+    if (ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_MOTION) {
+        if (motionCnt < UINT16_MAX) {
+            motionCnt++;
+        }
+        /* report start of motion immediately */
+        if (motionReported == FALSE) {
+            motionReported = TRUE;
+            ketCube_modules_RequestPeriod();
+        }
+        return;
+    }
+    
+    fifoPending = TRUE;
+}
+
+/**
+ * @brief Write LIS2HH12 register
+ *
+ * @param reg register address
+ * @param value value to write
  *
  * @retval KETCUBE_CFG_MODULE_OK in case of success
  * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
  */
-ketCube_cfg_ModError_t ketCube_lis2hh12_Init(ketCube_InterModMsg_t *** msg)
+static ketCube_cfg_ModError_t ketCube_lis2hh12_WriteReg(uint8_t reg, uint8_t value)
 {
-
-    // Init drivers
-    if (ketCube_I2C_Init() != KETCUBE_CFG_DRV_OK) {
-        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
-                                      "Initialisation failure! - I2C Driver");
+    if (ketCube_I2C_WriteData(KETCUBE_LIS2HH12_I2C_ADDRESS, reg, &value, 1)) {
         return KETCUBE_CFG_MODULE_ERROR;
     }
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
 
-    uint8_t i2cByte;
-
-    // Query compatible chip
-    if (ketCube_I2C_ReadData(KETCUBE_LIS2HH12_I2C_ADDRESS,
-                             KETCUBE_LIS2HH12_WHO_AM_I_REG, &i2cByte, 1)) {
-        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
-                                      "Initialisation failure! - WhoAmI Readout");
+/**
+ * @brief Connect LIS2HH12 INT1 to EXTI
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_InitIrq(void)
+{
+    GPIO_InitTypeDef initStruct = { 0 };
+    
+    if (intUsed == TRUE) {
+        return KETCUBE_CFG_MODULE_OK;
+    }
+    
+    initStruct.Mode = GPIO_MODE_IT_RISING;
+    initStruct.Pull = GPIO_PULLDOWN;
+    initStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    
+    if (ketCube_GPIO_Init(KETCUBE_LIS2HH12_INT_PORT, KETCUBE_LIS2HH12_INT_PIN,
+                          &initStruct) != KETCUBE_CFG_DRV_OK) {
         return KETCUBE_CFG_MODULE_ERROR;
     }
-    //Check LIS2HH12 identificator
-    if (!(i2cByte == KETCUBE_LIS2HH12_WHO_AM_I)) {
-        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
-                                      "Invalid Who Am I! Got %X expected %X",
-                                      i2cByte, KETCUBE_LIS2HH12_WHO_AM_I);
+    
+    if (ketCube_GPIO_SetIrq(KETCUBE_LIS2HH12_INT_PORT, KETCUBE_LIS2HH12_INT_PIN,
+                            KETCUBE_LIS2HH12_INT_PRIO,
+                            &ketCube_lis2hh12_IrqHandler) != KETCUBE_CFG_DRV_OK) {
+        ketCube_GPIO_Release(KETCUBE_LIS2HH12_INT_PORT, KETCUBE_LIS2HH12_INT_PIN);
         return KETCUBE_CFG_MODULE_ERROR;
     }
+    
+    intUsed = TRUE;
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
 
+/**
+ * @brief Integer square root
+ *
+ * @param x input value
+ *
+ * @retval floor(sqrt(x))
+ */
+static uint32_t ketCube_lis2hh12_Sqrt(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+    
+    while (bit > x) {
+        bit >>= 2;
+    }
+    
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief Initialize the orientation mode
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_InitOrientation(void)
+{
+    uint8_t i2cByte;
+    
     i2cByte = 0
         | KETCUBE_LIS2HH12_RESOLUTION_NORMAL
         | KETCUBE_LIS2HH12_ODR_10Hz
@@ -139,6 +260,158 @@ ketCube_cfg_ModError_t ketCube_lis2hh12_Init(ketCube_InterModMsg_t *** msg)
     return KETCUBE_CFG_MODULE_OK;
 }
 
+/**
+ * @brief Initialize the vibration mode
+ * 
+ * The accelerometer is powered-down between measurement windows,
+ * FIFO is configured in stream mode with the watermark routed to INT1.
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_InitVibration(void)
+{
+    if ((ketCube_lis2hh12_moduleCfg.odr < (KETCUBE_LIS2HH12_ODR_100Hz >> 4))
+        || (ketCube_lis2hh12_moduleCfg.odr > (KETCUBE_LIS2HH12_ODR_800Hz >> 4))) {
+        ketCube_lis2hh12_moduleCfg.odr = KETCUBE_LIS2HH12_VIB_ODR_DEF;
+    }
+    if (ketCube_lis2hh12_moduleCfg.bursts == 0) {
+        ketCube_lis2hh12_moduleCfg.bursts = KETCUBE_LIS2HH12_VIB_BURSTS_DEF;
+    }
+    if (ketCube_lis2hh12_moduleCfg.fftAxis > 2) {
+        ketCube_lis2hh12_moduleCfg.fftAxis = KETCUBE_LIS2HH12_FFT_AXIS_DEF;
+    }
+    
+    if (ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_SPECTRUM) {
+        ketCube_lis2hh12_fft_Init();
+    }
+    
+    if (ketCube_lis2hh12_InitIrq() != KETCUBE_CFG_MODULE_OK) {
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                     "INT1 not available, polling FIFO status");
+    }
+    
+    if ((ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG1, KETCUBE_LIS2HH12_ODR_0_PDN))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG4,
+                                      KETCUBE_LIS2HH12_FS_8G | KETCUBE_LIS2HH12_IF_ADD_INC))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_INT1_CFG, 0))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG3,
+                                      KETCUBE_LIS2HH12_FIFO_EN | KETCUBE_LIS2HH12_INT1_FTH_EN))) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Initialize the wake-on-motion mode
+ * 
+ * Interrupt generator 1 compares high-pass filtered acceleration (gravity
+ * removed) with the threshold on all axes (OR); the event is routed to INT1.
+ * The event is not latched: INT1 follows the motion, so every motion event
+ * gives a rising edge without re-arming the latch over I2C.
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_InitMotion(void)
+{
+    uint8_t i2cByte;
+    
+    if ((ketCube_lis2hh12_moduleCfg.odr < (KETCUBE_LIS2HH12_ODR_10Hz >> 4))
+        || (ketCube_lis2hh12_moduleCfg.odr > (KETCUBE_LIS2HH12_ODR_800Hz >> 4))) {
+        ketCube_lis2hh12_moduleCfg.odr = KETCUBE_LIS2HH12_MOTION_ODR_DEF;
+    }
+    if (ketCube_lis2hh12_moduleCfg.motionThr == 0) {
+        ketCube_lis2hh12_moduleCfg.motionThr = KETCUBE_LIS2HH12_MOTION_THR_DEF;
+    }
+    
+    if (ketCube_lis2hh12_InitIrq() != KETCUBE_CFG_MODULE_OK) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                      "INT1 not available, motion detected on base period only");
+    }
+    
+    i2cByte = 0
+        | KETCUBE_LIS2HH12_RESOLUTION_NORMAL
+        | (ketCube_lis2hh12_moduleCfg.odr << 4)
+        | KETCUBE_LIS2HH12_DATA_LATCH
+        | KETCUBE_LIS2HH12_X_ENABLE
+        | KETCUBE_LIS2HH12_Y_ENABLE | KETCUBE_LIS2HH12_Z_ENABLE;
+    
+    if ((ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG1, i2cByte))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG2,
+                                      KETCUBE_LIS2HH12_HPM_NORMAL | KETCUBE_LIS2HH12_HPIS1))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG4,
+                                      KETCUBE_LIS2HH12_FS_2G | KETCUBE_LIS2HH12_IF_ADD_INC))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG7, 0x00))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_INT1_TSH_X1, ketCube_lis2hh12_moduleCfg.motionThr))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_INT1_TSH_Y1, ketCube_lis2hh12_moduleCfg.motionThr))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_INT1_TSH_Z1, ketCube_lis2hh12_moduleCfg.motionThr))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_INT1_DURATION,
+                                      ketCube_lis2hh12_moduleCfg.motionDur & 0x7F))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_INT1_CFG,
+                                      KETCUBE_LIS2HH12_AOI_DIS
+                                      | KETCUBE_LIS2HH12_6D_DIS
+                                      | KETCUBE_LIS2HH12_ZHIGH_EN
+                                      | KETCUBE_LIS2HH12_YHIGH_EN
+                                      | KETCUBE_LIS2HH12_XHIGH_EN))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG3, KETCUBE_LIS2HH12_INT1_IG1_EN))) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    /* clear event left by a previous (latched) configuration */
+    ketCube_lis2h12_Get_Int();
+    motionCnt = 0;
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Initialize the LIS2HH12 sensor
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+ketCube_cfg_ModError_t ketCube_lis2hh12_Init(ketCube_InterModMsg_t *** msg)
+{
+
+    // Init drivers
+    if (ketCube_I2C_Init() != KETCUBE_CFG_DRV_OK) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                      "Initialisation failure! - I2C Driver");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    /* LIS2HH12 supports the fast mode */
+    ketCube_I2C_SetDeviceSpeed(KETCUBE_LIS2HH12_I2C_ADDRESS, KETCUBE_I2C_SPEED_400KHZ);
+
+    uint8_t i2cByte;
+
+    // Query compatible chip
+    if (ketCube_I2C_ReadData(KETCUBE_LIS2HH12_I2C_ADDRESS,
+                             KETCUBE_LIS2HH12_WHO_AM_I_REG, &i2cByte, 1)) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                      "Initialisation failure! - WhoAmI Readout");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    //Check LIS2HH12 identificator
+    if (!(i2cByte == KETCUBE_LIS2HH12_WHO_AM_I)) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                      "Invalid Who Am I! Got %X expected %X",
+                                      i2cByte, KETCUBE_LIS2HH12_WHO_AM_I);
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    if ((ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_VIBRATION)
+        || (ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_SPECTRUM)) {
+        return ketCube_lis2hh12_InitVibration();
+    } else if (ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_MOTION) {
+        return ketCube_lis2hh12_InitMotion();
+    }
+    
+    return ketCube_lis2hh12_InitOrientation();
+}
+
 /**
  * @brief Initialise the LIS2HH12 sensor
  *
@@ -151,7 +424,262 @@ ketCube_cfg_ModError_t ketCube_lis2hh12_UnInit(void)
 }
 
 /**
- * @brief Read data from LIS2HH12 sensor
+ * @brief Wait for the FIFO watermark
+ *
+ * @param timeout max wait time in ms
+ */
+static void ketCube_lis2hh12_WaitFifo(uint32_t timeout)
+{
+    if (intUsed == TRUE) {
+        ketCube_delay_LowPowerUntil(timeout, &fifoPending);
+        fifoPending = FALSE;
+    } else {
+        ketCube_delay_LowPower(timeout);
+    }
+}
+
+/**
+ * @brief FIFO samples read
+ *
+ * @param result transaction result
+ * @param context unused
+ *
+ * @note Executed in IRQ context
+ */
+static void ketCube_lis2hh12_FifoDataCplt(ketCube_cfg_DrvError_t result, void * context)
+{
+    if (result != KETCUBE_CFG_DRV_OK) {
+        fifoCnt = 0;
+    }
+}
+
+/**
+ * @brief FIFO_SRC read; read the FIFO samples in a single burst
+ *
+ * @param result transaction result
+ * @param context unused
+ *
+ * @note Executed in IRQ context
+ */
+static void ketCube_lis2hh12_FifoSrcCplt(ketCube_cfg_DrvError_t result, void * context)
+{
+    ketCube_I2C_Xfer_t xfer;
+    uint8_t cnt = 0;
+    
+    if ((result == KETCUBE_CFG_DRV_OK)
+        && ((fifoSrc & KETCUBE_LIS2HH12_FIFO_SRC_EMPTY) == 0)) {
+        /* FSS counts unread samples; 0 with EMPTY cleared means full FIFO */
+        cnt = fifoSrc & KETCUBE_LIS2HH12_FIFO_SRC_FSS_MASK;
+        if (cnt == 0) {
+            cnt = KETCUBE_LIS2HH12_FIFO_SIZE;
+        }
+    }
+    
+    fifoCnt = cnt;
+    if (cnt == 0) {
+        return;
+    }
+    
+    /* The register address rolls back from OUT_Z_H to OUT_X_L while FIFO is enabled */
+    xfer.type = KETCUBE_I2C_XFER_MEM_READ;
+    xfer.addr = KETCUBE_LIS2HH12_I2C_ADDRESS;
+    xfer.reg = KETCUBE_LIS2HH12_OUT_X_L;
+    xfer.pBuffer = (uint8_t *) &(fifoData[fifoBuf][0][0]);
+    xfer.size = ((uint16_t) cnt) * 6;
+    xfer.fnCallback = &ketCube_lis2hh12_FifoDataCplt;
+    xfer.context = NULL;
+    
+    if (ketCube_I2C_Submit(&xfer) != KETCUBE_CFG_DRV_OK) {
+        fifoCnt = 0;
+    }
+}
+
+/**
+ * @brief Start reading the FIFO into the given buffer
+ * 
+ * The FIFO_SRC and the sample reads run in background; use
+ * ketCube_I2C_Flush() to wait for fifoCnt.
+ *
+ * @param buf fifoData buffer index
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_DrainFifo(uint8_t buf)
+{
+    ketCube_I2C_Xfer_t xfer;
+    
+    fifoBuf = buf;
+    fifoCnt = 0;
+    fifoSrc = 0;
+    
+    xfer.type = KETCUBE_I2C_XFER_MEM_READ;
+    xfer.addr = KETCUBE_LIS2HH12_I2C_ADDRESS;
+    xfer.reg = KETCUBE_LIS2HH12_FIFO_SRC;
+    xfer.pBuffer = &fifoSrc;
+    xfer.size = 1;
+    xfer.fnCallback = &ketCube_lis2hh12_FifoSrcCplt;
+    xfer.context = NULL;
+    
+    if (ketCube_I2C_Submit(&xfer) != KETCUBE_CFG_DRV_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Accumulate FIFO burst into feature accumulators
+ *
+ * @param acc per-axis accumulators
+ * @param data FIFO burst
+ * @param cnt number of samples in data
+ * @param first first burst of the measurement window - estimate DC level
+ */
+static void ketCube_lis2hh12_Accumulate(ketCube_lis2hh12_axisAcc_t * acc,
+                                        int16_t (*data)[3],
+                                        uint8_t cnt, bool first)
+{
+    uint8_t axis, i;
+    int32_t x;
+    
+    for (axis = 0; axis < 3; axis++) {
+        if (first == TRUE) {
+            x = 0;
+            for (i = 0; i < cnt; i++) {
+                x += data[i][axis];
+            }
+            acc[axis].dc = x / cnt;
+            acc[axis].above = (data[0][axis] > acc[axis].dc);
+        }
+        
+        for (i = 0; i < cnt; i++) {
+            x = data[i][axis];
+            
+            acc[axis].sum += x;
+            acc[axis].sumSq += (uint64_t) (x * x);
+            if (x < acc[axis].min) {
+                acc[axis].min = x;
+            }
+            if (x > acc[axis].max) {
+                acc[axis].max = x;
+            }
+            
+            if ((acc[axis].above == TRUE)
+                && (x < (acc[axis].dc - KETCUBE_LIS2HH12_VIB_ZC_HYST))) {
+                acc[axis].above = FALSE;
+                acc[axis].zc++;
+            } else if ((acc[axis].above == FALSE)
+                       && (x > (acc[axis].dc + KETCUBE_LIS2HH12_VIB_ZC_HYST))) {
+                acc[axis].above = TRUE;
+                acc[axis].zc++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Collect FIFO burst samples into spectrum blocks
+ * 
+ * Full blocks are transformed immediately; the cycle count of the
+ * transform is measured by the SysTick cycle counter.
+ *
+ * @param data FIFO burst
+ * @param cnt number of samples in data
+ */
+static void ketCube_lis2hh12_Spectrum(int16_t (*data)[3], uint8_t cnt)
+{
+    uint8_t i;
+    uint32_t start, cycles;
+    
+    for (i = 0; i < cnt; i++) {
+        fftBlock[fftFill++] = data[i][ketCube_lis2hh12_moduleCfg.fftAxis];
+        
+        if (fftFill == KETCUBE_LIS2HH12_FFT_LEN) {
+            fftFill = 0;
+            
+            start = SysTick->VAL;
+            ketCube_lis2hh12_fft_AddBlock(&fftAcc, &(fftBlock[0]));
+            cycles = (start - SysTick->VAL) & KETCUBE_PWRMAN_CYCLES_MASK;
+            
+            if (cycles > fftCycles) {
+                fftCycles = cycles;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Process a FIFO burst
+ *
+ * @param acc per-axis accumulators
+ * @param buf fifoData buffer index
+ * @param cnt number of samples
+ * @param first first burst of the measurement window
+ */
+static void ketCube_lis2hh12_ProcessFifo(ketCube_lis2hh12_axisAcc_t * acc,
+                                         uint8_t buf, uint8_t cnt, bool first)
+{
+    ketCube_lis2hh12_Accumulate(acc, fifoData[buf], cnt, first);
+    if (ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_SPECTRUM) {
+        ketCube_lis2hh12_Spectrum(fifoData[buf], cnt);
+    }
+}
+
+/**
+ * @brief Append spectrum peaks and band energies
+ * 
+ * Peaks (big endian, Hz, 2 bytes each) sorted by decreasing power,
+ * followed by band RMS values (big endian, mg, 2 bytes each).
+ *
+ * @param buffer pointer to buffer for storing the result
+ * @param len data len in bytes; incremented
+ * @param odrHz output data rate
+ */
+static void ketCube_lis2hh12_SpectrumResult(uint8_t * buffer, uint8_t * len,
+                                            uint16_t odrHz)
+{
+    uint8_t bins[KETCUBE_LIS2HH12_FFT_PEAKS];
+    uint32_t meanSq[KETCUBE_LIS2HH12_FFT_BANDS];
+    uint32_t val, budget;
+    uint8_t i;
+    
+    ketCube_lis2hh12_fft_Peaks(&fftAcc, &(bins[0]), KETCUBE_LIS2HH12_FFT_PEAKS);
+    ketCube_lis2hh12_fft_Bands(&fftAcc, &(meanSq[0]), KETCUBE_LIS2HH12_FFT_BANDS);
+    
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_PEAKS; i++) {
+        val = (((uint32_t) bins[i]) * odrHz) / KETCUBE_LIS2HH12_FFT_LEN;
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                     "Peak %d: %d Hz", i, (int) val);
+        buffer[(*len)++] = (uint8_t) ((val >> 8) & 0xFF);
+        buffer[(*len)++] = (uint8_t) (val & 0xFF);
+    }
+    
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_BANDS; i++) {
+        val = ketCube_lis2hh12_Sqrt(meanSq[i]);
+        val = (val * KETCUBE_LIS2HH12_VIB_MG_NUM) / KETCUBE_LIS2HH12_VIB_MG_DEN;
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                     "Band %d: %d mg", i, (int) val);
+        buffer[(*len)++] = (uint8_t) ((val >> 8) & 0xFF);
+        buffer[(*len)++] = (uint8_t) (val & 0xFF);
+    }
+    
+    /* Profiling: cycles per block vs. block acquisition time at SystemCoreClock */
+    budget = (SystemCoreClock / odrHz) * KETCUBE_LIS2HH12_FFT_LEN;
+    ketCube_terminal_NewDebugPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                     "FFT %d blocks; %d cycles/block (%d.%02d %% of block time); RAM %d B",
+                                     fftAcc.blocks, (int) fftCycles,
+                                     (int) ((fftCycles * 100) / budget),
+                                     (int) (((fftCycles * 10000) / budget) % 100),
+                                     (int) (ketCube_lis2hh12_fft_RamSize() + sizeof(fftAcc) + sizeof(fftBlock)));
+}
+
+/**
+ * @brief Read vibration features
+ * 
+ * Per axis (big endian): AC RMS (mg, 2 bytes), peak deviation from mean
+ * (mg, 2 bytes), crest factor (peak/RMS in 1/16, 1 byte), zero-crossing
+ * rate (Hz, 2 bytes; crossings of the DC level / 2 per second).
  *
  * @param buffer pointer to buffer for storing the result of mesurement
  * @param len data len in bytes
@@ -159,13 +687,160 @@ ketCube_cfg_ModError_t ketCube_lis2hh12_UnInit(void)
  * @retval KETCUBE_CFG_MODULE_OK in case of success
  * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
  */
-ketCube_cfg_ModError_t ketCube_lis2hh12_ReadData(uint8_t * buffer,
-                                                 uint8_t * len)
+static ketCube_cfg_ModError_t ketCube_lis2hh12_ReadVibration(uint8_t * buffer,
+                                                             uint8_t * len)
+{
+    ketCube_lis2hh12_axisAcc_t acc[3];
+    uint16_t odrHz;
+    uint32_t timeout;
+    uint16_t n = 0;
+    uint8_t bursts, cnt, axis;
+    int32_t mean, peak;
+    uint64_t meanSq;
+    uint32_t rms, crest, zcr;
+    ketCube_cfg_ModError_t ret = KETCUBE_CFG_MODULE_OK;
+    
+    /* Mode changed at runtime - not initialized */
+    if ((ketCube_lis2hh12_moduleCfg.odr < (KETCUBE_LIS2HH12_ODR_100Hz >> 4))
+        || (ketCube_lis2hh12_moduleCfg.odr > (KETCUBE_LIS2HH12_ODR_800Hz >> 4))) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    odrHz = ketCube_lis2hh12_odrHz[ketCube_lis2hh12_moduleCfg.odr];
+    timeout = ((KETCUBE_LIS2HH12_FIFO_WTM + 1) * 1000) / odrHz + 2;
+    
+    ketCube_lis2hh12_fft_Reset(&fftAcc);
+    fftFill = 0;
+    fftCycles = 0;
+    
+    for (axis = 0; axis < 3; axis++) {
+        acc[axis].sum = 0;
+        acc[axis].sumSq = 0;
+        acc[axis].min = INT16_MAX;
+        acc[axis].max = INT16_MIN;
+        acc[axis].zc = 0;
+    }
+    
+    /* Flush FIFO (bypass), start stream mode and power-up */
+    fifoPending = FALSE;
+    if ((ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_FIFO_CTRL, KETCUBE_LIS2HH12_FMODE_BYPASS))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_FIFO_CTRL,
+                                      KETCUBE_LIS2HH12_FMODE_STREAM
+                                      | (KETCUBE_LIS2HH12_FIFO_WTM & KETCUBE_LIS2HH12_FTH_MASK)))
+        || (ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG1,
+                                      KETCUBE_LIS2HH12_RESOLUTION_HIGH
+                                      | (ketCube_lis2hh12_moduleCfg.odr << 4)
+                                      | KETCUBE_LIS2HH12_DATA_LATCH
+                                      | KETCUBE_LIS2HH12_X_ENABLE
+                                      | KETCUBE_LIS2HH12_Y_ENABLE
+                                      | KETCUBE_LIS2HH12_Z_ENABLE))) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    /* The FIFO is read in background while the previous burst is processed */
+    cnt = 0;
+    for (bursts = 0; bursts < ketCube_lis2hh12_moduleCfg.bursts; bursts++) {
+        ketCube_lis2hh12_WaitFifo(timeout);
+        
+        if (ketCube_lis2hh12_DrainFifo(bursts % 2) != KETCUBE_CFG_MODULE_OK) {
+            ret = KETCUBE_CFG_MODULE_ERROR;
+            break;
+        }
+        
+        if (cnt > 0) {
+            ketCube_lis2hh12_ProcessFifo(&(acc[0]), (bursts + 1) % 2, cnt, (n == 0));
+            n += cnt;
+        }
+        
+        ketCube_I2C_Flush();
+        
+        if ((fifoSrc & KETCUBE_LIS2HH12_FIFO_SRC_OVR) != 0) {
+            ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                         "FIFO overrun");
+        }
+        
+        cnt = fifoCnt;
+        if (cnt == 0) {
+            ret = KETCUBE_CFG_MODULE_ERROR;
+            break;
+        }
+    }
+    
+    if ((ret == KETCUBE_CFG_MODULE_OK) && (cnt > 0)) {
+        ketCube_lis2hh12_ProcessFifo(&(acc[0]), (bursts + 1) % 2, cnt, (n == 0));
+        n += cnt;
+    }
+    
+    /* Power-down between measurement windows */
+    ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_CTRL_REG1, KETCUBE_LIS2HH12_ODR_0_PDN);
+    ketCube_lis2hh12_WriteReg(KETCUBE_LIS2HH12_FIFO_CTRL, KETCUBE_LIS2HH12_FMODE_BYPASS);
+    
+    if ((ret != KETCUBE_CFG_MODULE_OK) || (n == 0)) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                      "FIFO readout failed!");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    *len = 0;
+    for (axis = 0; axis < 3; axis++) {
+        mean = acc[axis].sum / n;
+        meanSq = (uint64_t) (mean * mean);
+        rms = 0;
+        if ((acc[axis].sumSq / n) > meanSq) {
+            rms = ketCube_lis2hh12_Sqrt((uint32_t) ((acc[axis].sumSq / n) - meanSq));
+        }
+        peak = acc[axis].max - mean;
+        if ((mean - acc[axis].min) > peak) {
+            peak = mean - acc[axis].min;
+        }
+        
+        crest = (rms == 0) ? 0 : ((((uint32_t) peak) << 4) / rms);
+        if (crest > 0xFF) {
+            crest = 0xFF;
+        }
+        zcr = (((uint32_t) acc[axis].zc) * odrHz) / (2 * n);
+        
+        rms = (rms * KETCUBE_LIS2HH12_VIB_MG_NUM) / KETCUBE_LIS2HH12_VIB_MG_DEN;
+        peak = (peak * KETCUBE_LIS2HH12_VIB_MG_NUM) / KETCUBE_LIS2HH12_VIB_MG_DEN;
+        
+        ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                     "%c: RMS = %d mg; peak = %d mg; crest = %d/16; ZCR = %d Hz",
+                                     'X' + axis, (int) rms, (int) peak,
+                                     (int) crest, (int) zcr);
+        
+        buffer[(*len)++] = (uint8_t) ((rms >> 8) & 0xFF);
+        buffer[(*len)++] = (uint8_t) (rms & 0xFF);
+        buffer[(*len)++] = (uint8_t) ((peak >> 8) & 0xFF);
+        buffer[(*len)++] = (uint8_t) (peak & 0xFF);
+        buffer[(*len)++] = (uint8_t) crest;
+        buffer[(*len)++] = (uint8_t) ((zcr >> 8) & 0xFF);
+        buffer[(*len)++] = (uint8_t) (zcr & 0xFF);
+    }
+    
+    if (ketCube_lis2hh12_moduleCfg.mode == KETCUBE_LIS2HH12_MODE_SPECTRUM) {
+        ketCube_lis2hh12_SpectrumResult(buffer, len, odrHz);
+    }
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Read orientation class
+ *
+ * @param buffer pointer to buffer for storing the result of mesurement
+ * @param len data len in bytes
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_ReadOrientation(uint8_t * buffer,
+                                                               uint8_t * len)
 {
 
     int16_t data[3] = { 0 };
-    ketCube_I2C_ReadData(KETCUBE_LIS2HH12_I2C_ADDRESS,
-                         KETCUBE_LIS2HH12_OUT_X_L, (uint8_t *) & data, 6);
+    
+    ketCube_I2C_ReadDataQueued(KETCUBE_LIS2HH12_I2C_ADDRESS,
+                               KETCUBE_LIS2HH12_OUT_X_L, (uint8_t *) & data, 6);
     ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
                                  "X = %6.4f; Y = %6.4f; Z = %6.4f",
                                  (float) (data[0] / 16383.5),
@@ -207,6 +882,85 @@ ketCube_cfg_ModError_t ketCube_lis2hh12_ReadData(uint8_t * buffer,
     return KETCUBE_CFG_MODULE_OK;
 }
 
+/**
+ * @brief Report motion state
+ * 
+ * Orientation class (1 byte), moving flag (1 byte) and the number of motion
+ * events since the last report (big endian, 2 bytes). While static, the
+ * base period is stretched by motionStretch; the first motion event
+ * restores the base period.
+ *
+ * @param buffer pointer to buffer for storing the result of mesurement
+ * @param len data len in bytes
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+static ketCube_cfg_ModError_t ketCube_lis2hh12_ReadMotion(uint8_t * buffer,
+                                                          uint8_t * len)
+{
+    uint16_t events;
+    bool moving;
+    BACKUP_PRIMASK();
+    
+    /* event still active: moving now */
+    moving = ((ketCube_lis2h12_Get_Int() & KETCUBE_LIS2HH12_INT1_SRC_IA) != 0);
+    
+    DISABLE_IRQ();
+    events = motionCnt;
+    motionCnt = 0;
+    if (events > 0) {
+        moving = TRUE;
+    }
+    motionReported = moving;
+    RESTORE_PRIMASK();
+    
+    if (ketCube_lis2hh12_ReadOrientation(buffer, len) != KETCUBE_CFG_MODULE_OK) {
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+    
+    if ((moving == FALSE) && (ketCube_lis2hh12_moduleCfg.motionStretch > 1)) {
+        ketCube_modules_SetPeriod(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                  ketCube_coreCfg.basePeriod * ketCube_lis2hh12_moduleCfg.motionStretch);
+    } else {
+        ketCube_modules_SetPeriod(KETCUBE_LISTS_MODULEID_LIS2HH12, 0);
+    }
+    
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_LIS2HH12,
+                                 "%s; motion events: %d",
+                                 (moving == TRUE) ? "Moving" : "Static",
+                                 events);
+    
+    buffer[(*len)++] = (uint8_t) moving;
+    buffer[(*len)++] = (uint8_t) ((events >> 8) & 0xFF);
+    buffer[(*len)++] = (uint8_t) (events & 0xFF);
+    
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+ * @brief Read data from LIS2HH12 sensor
+ *
+ * @param buffer pointer to buffer for storing the result of mesurement
+ * @param len data len in bytes
+ *
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+ketCube_cfg_ModError_t ketCube_lis2hh12_ReadData(uint8_t * buffer,
+                                                 uint8_t * len)
+{
+    switch (ketCube_lis2hh12_moduleCfg.mode) {
+        case KETCUBE_LIS2HH12_MODE_VIBRATION:
+        case KETCUBE_LIS2HH12_MODE_SPECTRUM:
+            return ketCube_lis2hh12_ReadVibration(buffer, len);
+        case KETCUBE_LIS2HH12_MODE_MOTION:
+            return ketCube_lis2hh12_ReadMotion(buffer, len);
+        default:
+            return ketCube_lis2hh12_ReadOrientation(buffer, len);
+    }
+}
+
 /**
  * @brief Read Interrupt source from LIS2HH12 sensor
  *
@@ -47,17 +47,38 @@
 #ifndef __KETCUBE_LIS2HH12_H_
 #define __KETCUBE_LIS2HH12_H_
 
+#include "ketCube_mainBoard.h"
+
 /** @defgroup KETCube_LIS2HH12 KETCube LIS2HH12
   * @brief KETCube LIS2HH12 module
   * @ingroup KETCube_SensMods
   * @{
   */
 
+/**
+* @brief  LIS2HH12 operating mode
+*/
+typedef enum {
+    KETCUBE_LIS2HH12_MODE_ORIENTATION = 0,      /*!< Single sample at 10 Hz ODR reduced to orientation class (1 byte) */
+    KETCUBE_LIS2HH12_MODE_VIBRATION   = 1,      /*!< FIFO burst acquisition reduced to vibration features */
+    KETCUBE_LIS2HH12_MODE_SPECTRUM    = 2,      /*!< Vibration features followed by spectrum peaks and band energies */
+    KETCUBE_LIS2HH12_MODE_MOTION      = 3,      /*!< Wake-on-motion: INT1 reports movement, base period stretched while static */
+    KETCUBE_LIS2HH12_MODE_LAST                  /*!< Last mode - do not modify! */
+} ketCube_lis2hh12_mode_t;
+
 /**
 * @brief  KETCube module configuration
 */
 typedef struct ketCube_lis2hh12_moduleCfg_t {
     ketCube_cfg_ModuleCfgByte_t coreCfg;           /*!< KETCube core cfg byte */
+    uint8_t mode;                                  /*!< Operating mode @see ketCube_lis2hh12_mode_t */
+    uint8_t odr;                                   /*!< Vibration/motion mode ODR (CTRL1 ODR field value; 1: 10 Hz ... 6: 800 Hz) */
+    uint8_t bursts;                                /*!< Vibration mode FIFO bursts per measurement window */
+    uint8_t fftAxis;                               /*!< Spectrum mode axis (0: X; 1: Y; 2: Z) */
+    uint8_t motionThr;                             /*!< Motion mode threshold (high-pass filtered; 1 LSB = 8 mg) */
+    uint8_t motionDur;                             /*!< Motion mode min. event duration (1/ODR) */
+    uint8_t motionStretch;                         /*!< Motion mode base period multiplier while static; 0: disabled */
+    uint8_t RFU[8];                                /*!< Reserved for future use, decrease size of this field when adding new values to preserve module configuration offsets */
 } ketCube_lis2hh12_moduleCfg_t;
 
 extern ketCube_lis2hh12_moduleCfg_t ketCube_lis2hh12_moduleCfg;
@@ -70,6 +91,23 @@ extern ketCube_lis2hh12_moduleCfg_t ketCube_lis2hh12_moduleCfg;
 
 #define KETCUBE_LIS2HH12_WHO_AM_I          0x41
 
+#define KETCUBE_LIS2HH12_INT_PORT          KETCUBE_MAIN_BOARD_PIN_INT_PORT   ///< INT1 is routed to the mainBoard INT pin
+#define KETCUBE_LIS2HH12_INT_PIN           KETCUBE_MAIN_BOARD_PIN_INT_PIN
+#define KETCUBE_LIS2HH12_INT_PRIO          0                                 ///< NVIC priority; the EXTI IRQ is shared with the radio DIO lines
+
+#define KETCUBE_LIS2HH12_FIFO_SIZE         32           ///< FIFO levels
+#define KETCUBE_LIS2HH12_FIFO_WTM          24           ///< FIFO watermark (samples); leave space for samples arriving during the burst read
+#define KETCUBE_LIS2HH12_VIB_ODR_DEF       6            ///< Default vibration mode ODR (800 Hz)
+#define KETCUBE_LIS2HH12_VIB_BURSTS_DEF    8            ///< Default number of FIFO bursts per measurement window
+#define KETCUBE_LIS2HH12_VIB_MG_NUM        244          ///< Sensitivity at +-8 g: 0.244 mg/LSB
+#define KETCUBE_LIS2HH12_VIB_MG_DEN        1000
+#define KETCUBE_LIS2HH12_VIB_ZC_HYST       8            ///< Zero-crossing hysteresis (LSB) to reject noise around the DC level
+#define KETCUBE_LIS2HH12_VIB_AXIS_LEN      7            ///< Uplink bytes per axis: RMS (2), peak (2), crest factor (1), ZCR (2)
+#define KETCUBE_LIS2HH12_FFT_AXIS_DEF      2            ///< Default spectrum axis (Z)
+#define KETCUBE_LIS2HH12_MOTION_ODR_DEF    1            ///< Default motion mode ODR (10 Hz)
+#define KETCUBE_LIS2HH12_MOTION_THR_DEF    8            ///< Default motion threshold (~63 mg)
+#define KETCUBE_LIS2HH12_MOTION_LEN        4            ///< Uplink bytes: orientation (1), moving (1), motion events (2)
+
 /** @defgroup KETCube_LIS2HH12_defs Public Defines
   * @brief Public defines
   * @{
@@ -81,7 +119,8 @@ typedef enum {
     KETCUBE_LIS2HH12_INT1_SRC_YLOW = 0x02U,
     KETCUBE_LIS2HH12_INT1_SRC_YHIGH = 0x04U,
     KETCUBE_LIS2HH12_INT1_SRC_ZLOW = 0x08U,
-    KETCUBE_LIS2HH12_INT1_SRC_ZHIGH = 0x10U
+    KETCUBE_LIS2HH12_INT1_SRC_ZHIGH = 0x10U,
+    KETCUBE_LIS2HH12_INT1_SRC_IA = 0x40U        /*!< Interrupt active */
 } ketCube_lis2hh12_Int1_Src_t;
 
 /**
@@ -176,6 +215,56 @@ typedef enum {
 * @}
 */
 
+/**
+* @addtogroup KETCube_LIS2HH12_CTRL2 LIS2HH12 CTRL2 flags
+* @{
+*/
+#define KETCUBE_LIS2HH12_HPM_NORMAL        0x00U
+#define KETCUBE_LIS2HH12_FDS               0x01U << 2   ///< High-pass filtered data to output registers and FIFO
+#define KETCUBE_LIS2HH12_HPIS2             0x01U << 1   ///< High-pass filtered data to interrupt generator 2
+#define KETCUBE_LIS2HH12_HPIS1             0x01U        ///< High-pass filtered data to interrupt generator 1
+/**
+* @}
+*/
+
+/**
+* @addtogroup KETCube_LIS2HH12_CTRL4 LIS2HH12 CTRL4 flags
+* @{
+*/
+#define KETCUBE_LIS2HH12_FS_2G             0x00U
+#define KETCUBE_LIS2HH12_FS_4G             0x02U << 4
+#define KETCUBE_LIS2HH12_FS_8G             0x03U << 4
+#define KETCUBE_LIS2HH12_IF_ADD_INC        0x01U << 2
+/**
+* @}
+*/
+
+/**
+* @addtogroup KETCube_LIS2HH12_CTRL7 LIS2HH12 CTRL7 flags
+* @{
+*/
+#define KETCUBE_LIS2HH12_LIR2              0x01U << 3   ///< Latch interrupt generator 2 (cleared by reading IG_SRC2)
+#define KETCUBE_LIS2HH12_LIR1              0x01U << 2   ///< Latch interrupt generator 1 (cleared by reading IG_SRC1)
+/**
+* @}
+*/
+
+/**
+* @addtogroup KETCube_LIS2HH12_FIFO LIS2HH12 FIFO_CTRL and FIFO_SRC flags
+* @{
+*/
+#define KETCUBE_LIS2HH12_FMODE_BYPASS      0x00U
+#define KETCUBE_LIS2HH12_FMODE_FIFO        0x01U << 5
+#define KETCUBE_LIS2HH12_FMODE_STREAM      0x02U << 5
+#define KETCUBE_LIS2HH12_FTH_MASK          0x1FU
+#define KETCUBE_LIS2HH12_FIFO_SRC_FTH      0x01U << 7
+#define KETCUBE_LIS2HH12_FIFO_SRC_OVR      0x01U << 6
+#define KETCUBE_LIS2HH12_FIFO_SRC_EMPTY    0x01U << 5
+#define KETCUBE_LIS2HH12_FIFO_SRC_FSS_MASK 0x1FU
+/**
+* @}
+*/
+
 /**
 * @addtogroup KETCube_LIS2HH12_IG_CFG1 LIS2HH12 IG_CFG1 flags
 * @{
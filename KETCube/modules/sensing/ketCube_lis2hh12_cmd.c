@@ -0,0 +1,209 @@
+/**
+ * @file    ketCube_lis2hh12_cmd.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   The command definitions for LIS2HH12 accelerometer
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#ifndef __KETCUBE_LIS2HH12_CMD_H
+#define __KETCUBE_LIS2HH12_CMD_H
+
+#include "ketCube_cfg.h"
+#include "ketCube_common.h"
+#include "ketCube_terminal.h"
+#include "ketCube_lis2hh12.h"
+
+
+/**
+ * @brief Terminal command definitions 
+ */
+ketCube_terminal_cmd_t ketCube_lis2hh12_commands[] = {
+    {
+        .cmd   = "mode",
+        .descr = "Operating mode (0: orientation; 1: vibration features; 2: vibration features and spectrum; 3: wake-on-motion)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, mode),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "odr",
+        .descr = "Vibration/motion mode output data rate (1: 10 Hz; 2: 50 Hz; 3: 100 Hz; 4: 200 Hz; 5: 400 Hz; 6: 800 Hz); vibration modes require 3 - 6",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, odr),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "bursts",
+        .descr = "Vibration mode FIFO bursts per measurement window (24 samples each)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, bursts),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "fftAxis",
+        .descr = "Spectrum mode axis (0: X; 1: Y; 2: Z)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, fftAxis),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "motionThr",
+        .descr = "Motion mode threshold of high-pass filtered acceleration (1 LSB = 8 mg)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, motionThr),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "motionDur",
+        .descr = "Motion mode min. event duration (1/ODR)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, motionDur),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    {
+        .cmd   = "motionStretch",
+        .descr = "Motion mode base period multiplier while static (0 or 1: disabled)",
+        .flags = {
+            .isLocal   = TRUE,
+            .isRemote  = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isGeneric = TRUE,
+        },
+        .paramSetType  = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .outputSetType = KETCUBE_TERMINAL_PARAMS_BYTE,
+        .settingsPtr.cfgVarPtr = &(ketCube_cfg_varDescr_t) {
+            .moduleID = KETCUBE_LISTS_MODULEID_LIS2HH12,
+            .offset   = offsetof(ketCube_lis2hh12_moduleCfg_t, motionStretch),
+            .size     = sizeof(uint8_t)
+        }
+    },
+    
+    DEF_TERMINATE()
+    
+};
+
+#endif                          /* __KETCUBE_LIS2HH12_CMD_H */
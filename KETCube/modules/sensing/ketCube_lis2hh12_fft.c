@@ -0,0 +1,239 @@
+/**
+ * @file    ketCube_lis2hh12_fft.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Fixed-point vibration spectrum for LIS2HH12 FIFO blocks
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <string.h>
+
+#include "ketCube_cfg.h"
+#include "arm_math.h"
+#include "arm_const_structs.h"
+#include "ketCube_lis2hh12_fft.h"
+
+#ifdef KETCUBE_CFG_INC_MOD_LIS2HH12
+
+static arm_rfft_instance_q15 rfft;                                  /*!< Real FFT instance */
+static q15_t splitA[KETCUBE_LIS2HH12_FFT_LEN];                      /*!< Split table A for KETCUBE_LIS2HH12_FFT_LEN */
+static q15_t splitB[KETCUBE_LIS2HH12_FFT_LEN];                      /*!< Split table B for KETCUBE_LIS2HH12_FFT_LEN */
+static q15_t fftIn[KETCUBE_LIS2HH12_FFT_LEN];                       /*!< FFT input; used as scratch by arm_rfft_q15() */
+static q15_t fftOut[2 * KETCUBE_LIS2HH12_FFT_LEN];                  /*!< FFT output (interleaved re, im) */
+
+/**
+ * @brief Saturate to Q15
+ */
+static q15_t sat15(int32_t x)
+{
+    if (x > INT16_MAX) {
+        return INT16_MAX;
+    } else if (x < INT16_MIN) {
+        return INT16_MIN;
+    }
+    
+    return (q15_t) x;
+}
+
+/**
+ * @brief Initialize the real FFT instance
+ * 
+ * Split tables follow the CMSIS realCoefAQ15/realCoefBQ15 definition for
+ * the real FFT length N, thus twidCoefRModifier is 1:
+ * A[2i] = (1 - sin(2*pi*i/N)) / 2, A[2i+1] = -cos(2*pi*i/N) / 2,
+ * B[2i] = (1 + sin(2*pi*i/N)) / 2, B[2i+1] = cos(2*pi*i/N) / 2.
+ */
+void ketCube_lis2hh12_fft_Init(void)
+{
+    uint16_t i;
+    q15_t angle, s, c;
+    
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_LEN / 2; i++) {
+        /* Q15 angle: 0 ... 0x7FFF maps to 0 ... 2*pi */
+        angle = (q15_t) ((((uint32_t) i) << 15) / KETCUBE_LIS2HH12_FFT_LEN);
+        s = arm_sin_q15(angle);
+        c = arm_cos_q15(angle);
+        
+        splitA[2 * i]     = sat15((32768 - (int32_t) s) / 2);
+        splitA[2 * i + 1] = sat15(-((int32_t) c) / 2);
+        splitB[2 * i]     = sat15((32768 + (int32_t) s) / 2);
+        splitB[2 * i + 1] = sat15(((int32_t) c) / 2);
+    }
+    
+    rfft.fftLenReal = KETCUBE_LIS2HH12_FFT_LEN;
+    rfft.ifftFlagR = 0;
+    rfft.bitReverseFlagR = 1;
+    rfft.twidCoefRModifier = 1;
+    rfft.pTwiddleAReal = &(splitA[0]);
+    rfft.pTwiddleBReal = &(splitB[0]);
+    rfft.pCfft = &KETCUBE_LIS2HH12_FFT_CFFT;
+}
+
+/**
+ * @brief Clear the averaged spectrum
+ * 
+ * @param acc spectrum accumulator
+ */
+void ketCube_lis2hh12_fft_Reset(ketCube_lis2hh12_fft_acc_t * acc)
+{
+    memset(acc, 0, sizeof(ketCube_lis2hh12_fft_acc_t));
+}
+
+/**
+ * @brief Transform one block and accumulate its power spectrum
+ * 
+ * The block mean (gravity) is removed before the transform.
+ * 
+ * @param acc spectrum accumulator
+ * @param block KETCUBE_LIS2HH12_FFT_LEN raw samples
+ */
+void ketCube_lis2hh12_fft_AddBlock(ketCube_lis2hh12_fft_acc_t * acc,
+                                   const int16_t * block)
+{
+    uint16_t i;
+    int32_t mean = 0;
+    int32_t re, im;
+    
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_LEN; i++) {
+        mean += block[i];
+    }
+    mean /= KETCUBE_LIS2HH12_FFT_LEN;
+    
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_LEN; i++) {
+        fftIn[i] = sat15(block[i] - mean);
+    }
+    
+    arm_rfft_q15(&rfft, &(fftIn[0]), &(fftOut[0]));
+    
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_BINS; i++) {
+        re = fftOut[2 * i];
+        im = fftOut[2 * i + 1];
+        acc->power[i] += (uint32_t) (re * re) + (uint32_t) (im * im);
+    }
+    
+    acc->blocks++;
+}
+
+/**
+ * @brief Find the strongest spectral peaks
+ * 
+ * A peak is a local maximum of the averaged spectrum; DC is excluded.
+ * Unused entries are set to 0.
+ * 
+ * @param acc spectrum accumulator
+ * @param bins peak bin indexes, sorted by decreasing power
+ * @param cnt number of peaks to find
+ */
+void ketCube_lis2hh12_fft_Peaks(const ketCube_lis2hh12_fft_acc_t * acc,
+                                uint8_t * bins, uint8_t cnt)
+{
+    uint8_t i, j, k;
+    uint64_t left, right;
+    
+    for (j = 0; j < cnt; j++) {
+        bins[j] = 0;
+    }
+    
+    for (i = 1; i < KETCUBE_LIS2HH12_FFT_BINS; i++) {
+        left = acc->power[i - 1];
+        right = (i < (KETCUBE_LIS2HH12_FFT_BINS - 1)) ? acc->power[i + 1] : 0;
+        
+        if ((acc->power[i] == 0) || (acc->power[i] < left) || (acc->power[i] <= right)) {
+            continue;
+        }
+        
+        /* insert into sorted list */
+        for (j = 0; j < cnt; j++) {
+            if ((bins[j] == 0) || (acc->power[i] > acc->power[bins[j]])) {
+                for (k = cnt - 1; k > j; k--) {
+                    bins[k] = bins[k - 1];
+                }
+                bins[j] = i;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compute band energies
+ * 
+ * Bins 1 ... KETCUBE_LIS2HH12_FFT_BINS - 1 are split into cnt bands of
+ * (nearly) equal width.
+ * 
+ * @param acc spectrum accumulator
+ * @param meanSq mean-square acceleration per band (LSB^2)
+ * @param cnt number of bands
+ */
+void ketCube_lis2hh12_fft_Bands(const ketCube_lis2hh12_fft_acc_t * acc,
+                                uint32_t * meanSq, uint8_t cnt)
+{
+    uint8_t band, i;
+    uint8_t first, last;
+    uint64_t sum;
+    
+    for (band = 0; band < cnt; band++) {
+        first = 1 + (band * (KETCUBE_LIS2HH12_FFT_BINS - 1)) / cnt;
+        last = 1 + ((band + 1) * (KETCUBE_LIS2HH12_FFT_BINS - 1)) / cnt;
+        
+        sum = 0;
+        for (i = first; i < last; i++) {
+            sum += acc->power[i];
+        }
+        
+        if (acc->blocks != 0) {
+            sum = sum / (2 * (uint64_t) acc->blocks);
+        }
+        
+        meanSq[band] = (sum > UINT32_MAX) ? UINT32_MAX : (uint32_t) sum;
+    }
+}
+
+/**
+ * @brief Static RAM used by the spectrum kernel
+ * 
+ * @retval RAM in bytes (accumulator excluded)
+ */
+uint32_t ketCube_lis2hh12_fft_RamSize(void)
+{
+    return sizeof(rfft) + sizeof(splitA) + sizeof(splitB)
+        + sizeof(fftIn) + sizeof(fftOut);
+}
+
+#endif                          // KETCUBE_CFG_INC_MOD_LIS2HH12
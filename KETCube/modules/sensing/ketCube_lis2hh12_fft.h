@@ -0,0 +1,108 @@
+/**
+ * @file    ketCube_lis2hh12_fft.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Fixed-point vibration spectrum for LIS2HH12 FIFO blocks
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#ifndef __KETCUBE_LIS2HH12_FFT_H
+#define __KETCUBE_LIS2HH12_FFT_H
+
+#include <stdint.h>
+
+/** @defgroup KETCube_LIS2HH12_fft KETCube LIS2HH12 spectrum
+  * @brief Q15 real FFT based vibration spectrum
+  * 
+  * Blocks of raw acceleration samples are transformed by the CMSIS-DSP
+  * arm_rfft_q15(), squared magnitudes are averaged over the measurement
+  * window and reduced to the top-N peak frequencies and band energies.
+  * 
+  * The real FFT instance is built from the CMSIS complex FFT structure
+  * of the selected length and locally generated split tables, as
+  * arm_rfft_init_q15() would link ~60 kB of twiddle tables for all the
+  * supported lengths.
+  * 
+  * The peak search and band energy functions depend on <stdint.h> only.
+  * 
+  * @ingroup KETCube_LIS2HH12
+  * @{
+  */
+
+#define KETCUBE_LIS2HH12_FFT_LEN      64                        ///< Real FFT length (samples)
+#define KETCUBE_LIS2HH12_FFT_CFFT     arm_cfft_sR_q15_len32     ///< CMSIS complex FFT instance of KETCUBE_LIS2HH12_FFT_LEN/2 length
+#define KETCUBE_LIS2HH12_FFT_BINS     (KETCUBE_LIS2HH12_FFT_LEN / 2)    ///< One-sided spectrum bins (DC ... fs/2 - 1 bin)
+#define KETCUBE_LIS2HH12_FFT_PEAKS    3                         ///< Number of reported peaks
+#define KETCUBE_LIS2HH12_FFT_BANDS    4                         ///< Number of reported bands
+
+/**
+* @brief  Averaged power spectrum
+* 
+* arm_rfft_q15() output is X[k] / (N/2) for any supported length N, thus
+* (re^2 + im^2) / 2 of a bin is its mean-square contribution in LSB^2.
+*/
+typedef struct ketCube_lis2hh12_fft_acc_t {
+    uint64_t power[KETCUBE_LIS2HH12_FFT_BINS];    /*!< Accumulated re^2 + im^2 per bin */
+    uint16_t blocks;                              /*!< Number of accumulated blocks */
+} ketCube_lis2hh12_fft_acc_t;
+
+/** @defgroup KETCube_LIS2HH12_fft_fn Public Functions
+  * @brief Public functions
+  * @{
+  */
+
+extern void ketCube_lis2hh12_fft_Init(void);
+extern void ketCube_lis2hh12_fft_Reset(ketCube_lis2hh12_fft_acc_t * acc);
+extern void ketCube_lis2hh12_fft_AddBlock(ketCube_lis2hh12_fft_acc_t * acc,
+                                          const int16_t * block);
+extern void ketCube_lis2hh12_fft_Peaks(const ketCube_lis2hh12_fft_acc_t * acc,
+                                       uint8_t * bins, uint8_t cnt);
+extern void ketCube_lis2hh12_fft_Bands(const ketCube_lis2hh12_fft_acc_t * acc,
+                                       uint32_t * meanSq, uint8_t cnt);
+extern uint32_t ketCube_lis2hh12_fft_RamSize(void);
+
+/**
+* @}
+*/
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_LIS2HH12_FFT_H */
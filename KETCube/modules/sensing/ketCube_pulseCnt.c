@@ -0,0 +1,200 @@
+/**
+ * @file    ketCube_pulseCnt.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube LPTIM pulse counter module
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stddef.h>
+
+#include "stm32l0xx_hal.h"
+
+#include "ketCube_common.h"
+#include "ketCube_pulseCnt.h"
+#include "ketCube_timer.h"
+#include "ketCube_rtc.h"
+#include "ketCube_terminal.h"
+
+#ifdef KETCUBE_CFG_INC_MOD_PULSECNT
+
+ketCube_pulseCnt_moduleCfg_t ketCube_pulseCnt_moduleCfg; /*!< Module configuration storage */
+
+static uint32_t base;           ///< Total at counter start
+static uint32_t lastCount;      ///< LPTIM count at the last ReadData()
+static uint32_t lastTick;       ///< RTC timer value at the last ReadData()
+static uint32_t savedTotal;     ///< Total last written to EEPROM
+static uint8_t readCnt;         ///< # of ReadData() calls since the last EEPROM write
+
+/**
+ * @brief Store total in RTC backup registers
+ */
+static void backupTotal(uint32_t total)
+{
+    ketCube_RTC_BKUPWriteReg(KETCUBE_PULSECNT_BKP_TOTAL, total);
+    ketCube_RTC_BKUPWriteReg(KETCUBE_PULSECNT_BKP_CHECK,
+                             total ^ KETCUBE_PULSECNT_BKP_MAGIC);
+}
+
+/**
+ * @brief Restore total after reset
+ * 
+ * The EEPROM total is written rarely to save EEPROM endurance; pulses
+ * counted since are recovered from RTC backup registers, which survive
+ * MCU resets. The backup is used only if the EEPROM total has not been
+ * changed since (e.g. by the "set pulseCnt total" command).
+ * 
+ * @retval restored total
+ */
+static uint32_t restoreTotal(void)
+{
+    uint32_t bkpTotal =
+        ketCube_RTC_BKUPReadReg(KETCUBE_PULSECNT_BKP_TOTAL);
+
+    if ((ketCube_RTC_BKUPReadReg(KETCUBE_PULSECNT_BKP_CHECK) ==
+         (bkpTotal ^ KETCUBE_PULSECNT_BKP_MAGIC))
+        && (ketCube_RTC_BKUPReadReg(KETCUBE_PULSECNT_BKP_SAVED) ==
+            ketCube_pulseCnt_moduleCfg.total)) {
+        return bkpTotal;
+    }
+
+    return ketCube_pulseCnt_moduleCfg.total;
+}
+
+/**
+ * @brief  Start LPTIM pulse counter and restore total
+ * 
+ * @retval KETCUBE_CFG_MODULE_OK in case of success
+ * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+ */
+ketCube_cfg_ModError_t ketCube_pulseCnt_Init(ketCube_InterModMsg_t *** msg)
+{
+    if (ketCube_Timer_LPTIM_StartCounter((ketCube_Timer_LPTIM_filter_t)
+                                         ketCube_pulseCnt_moduleCfg.filter,
+                                         (ketCube_Timer_LPTIM_edge_t)
+                                         ketCube_pulseCnt_moduleCfg.edge) !=
+        KETCUBE_CFG_DRV_OK) {
+        ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_PULSECNT,
+                                      "LPTIM/LPTIM1_IN1 not available!");
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    base = restoreTotal();
+    savedTotal = ketCube_pulseCnt_moduleCfg.total;
+    backupTotal(base);
+    ketCube_RTC_BKUPWriteReg(KETCUBE_PULSECNT_BKP_SAVED, savedTotal);
+
+    lastCount = 0;
+    lastTick = ketCube_RTC_GetTimerValue();
+    readCnt = 0;
+
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_PULSECNT,
+                                 "Total restored: %u", base);
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+/**
+  * @brief Get pulse total and mean frequency since the last call
+  *
+  * @param buffer pointer to fuffer for storing the result
+  * @param len data len in bytes
+  *
+  * @retval KETCUBE_CFG_MODULE_OK in case of success
+  * @retval KETCUBE_CFG_MODULE_ERROR in case of failure
+  */
+ketCube_cfg_ModError_t ketCube_pulseCnt_ReadData(uint8_t * buffer,
+                                                 uint8_t * len)
+{
+    uint32_t count = ketCube_Timer_LPTIM_GetCount();
+    uint32_t tick = ketCube_RTC_GetTimerValue();
+    uint32_t delta = count - lastCount;
+    uint32_t ms = ketCube_RTC_Tick2ms(tick - lastTick);
+    uint32_t total = base + count;
+    uint32_t freq = 0;          // mHz
+    uint8_t saveEvery = ketCube_pulseCnt_moduleCfg.saveEvery;
+
+    lastCount = count;
+    lastTick = tick;
+
+    if (ms > 0) {
+        freq = (uint32_t) (((uint64_t) delta * 1000000ULL) / ms);
+    }
+
+    backupTotal(total);
+
+    if (saveEvery == 0) {
+        saveEvery = KETCUBE_PULSECNT_SAVE_EVERY_DEFAULT;
+    }
+    if ((total != savedTotal) && (++readCnt >= saveEvery)) {
+        if (ketCube_cfg_Save((uint8_t *) & total,
+                             KETCUBE_LISTS_MODULEID_PULSECNT,
+                             (ketCube_cfg_AllocEEPROM_t)
+                             offsetof(ketCube_pulseCnt_moduleCfg_t, total),
+                             (ketCube_cfg_LenEEPROM_t) sizeof(uint32_t)) ==
+            KETCUBE_CFG_OK) {
+            ketCube_pulseCnt_moduleCfg.total = total;
+            ketCube_RTC_BKUPWriteReg(KETCUBE_PULSECNT_BKP_SAVED, total);
+            savedTotal = total;
+            readCnt = 0;
+        } else {
+            ketCube_terminal_ErrorPrintln(KETCUBE_LISTS_MODULEID_PULSECNT,
+                                          "Total EEPROM write failed!");
+        }
+    }
+
+    // write to buffer
+    *len = 8;
+    buffer[0] = ((uint8_t) ((total >> 24) & 0xFF));
+    buffer[1] = ((uint8_t) ((total >> 16) & 0xFF));
+    buffer[2] = ((uint8_t) ((total >> 8) & 0xFF));
+    buffer[3] = ((uint8_t) (total & 0xFF));
+    buffer[4] = ((uint8_t) ((freq >> 24) & 0xFF));
+    buffer[5] = ((uint8_t) ((freq >> 16) & 0xFF));
+    buffer[6] = ((uint8_t) ((freq >> 8) & 0xFF));
+    buffer[7] = ((uint8_t) (freq & 0xFF));
+
+    ketCube_terminal_InfoPrintln(KETCUBE_LISTS_MODULEID_PULSECNT,
+                                 "Total: %u; +%u pulses; f = %u mHz",
+                                 total, delta, freq);
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+#endif                          /* KETCUBE_CFG_INC_MOD_PULSECNT */
@@ -0,0 +1,104 @@
+/**
+ * @file    ketCube_pulseCnt.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   KETCube LPTIM pulse counter module
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __KETCUBE_PULSECNT_H
+#define __KETCUBE_PULSECNT_H
+
+#include "ketCube_cfg.h"
+
+/** @defgroup KETCube_pulseCnt KETCube pulseCnt
+  * @brief KETCube pulse counter module
+  * 
+  * Counts water/gas/energy meter pulses on LPTIM1_IN1 (mainBoard INT PIN, PB5).
+  * LPTIM1 is clocked from the LSE, so pulses are counted in STOP mode and
+  * the MCU is not woken up by individual pulses. The hardware glitch filter
+  * suppresses bounce up to 244 us; use an RC filter for longer bounce.
+  * 
+  * @ingroup KETCube_SensMods
+  * @{
+  */
+
+#define KETCUBE_PULSECNT_SAVE_EVERY_DEFAULT     60U               ///< Default # of ReadData() calls between EEPROM writes of the total
+
+/* RTC backup registers -- these survive MCU resets; RTC_BKP_DR0/1 are used by LoRa SysTime */
+#define KETCUBE_PULSECNT_BKP_TOTAL              RTC_BKP_DR2       ///< Last reported total
+#define KETCUBE_PULSECNT_BKP_CHECK              RTC_BKP_DR3       ///< Total XOR KETCUBE_PULSECNT_BKP_MAGIC
+#define KETCUBE_PULSECNT_BKP_SAVED              RTC_BKP_DR4       ///< Total last written to EEPROM
+#define KETCUBE_PULSECNT_BKP_MAGIC              0x50554C53U       ///< Backup check word seed
+
+/**
+* @brief  KETCube module configuration
+*/
+typedef struct ketCube_pulseCnt_moduleCfg_t {
+    ketCube_cfg_ModuleCfgByte_t coreCfg;           /*!< KETCube core cfg byte */
+    uint8_t filter;                                /*!< Debounce filter: 0, 2, 4 or 8 LSE clocks */
+    uint8_t edge;                                  /*!< Counted edge: 0 = rising, 1 = falling, 2 = both */
+    uint8_t saveEvery;                             /*!< # of ReadData() calls between EEPROM writes of the total; 0 = default */
+    uint32_t total;                                /*!< Persistent pulse total */
+} ketCube_pulseCnt_moduleCfg_t;
+
+extern ketCube_pulseCnt_moduleCfg_t ketCube_pulseCnt_moduleCfg;
+
+
+/** @defgroup KETCube_pulseCnt_fn Public Functions
+* @{
+*/
+
+extern ketCube_cfg_ModError_t ketCube_pulseCnt_Init(ketCube_InterModMsg_t ***
+                                                    msg);
+extern ketCube_cfg_ModError_t ketCube_pulseCnt_ReadData(uint8_t * buffer,
+                                                        uint8_t * len);
+
+
+/**
+* @}
+*/
+
+
+/**
+* @}
+*/
+
+#endif                          /* __KETCUBE_PULSECNT_H */
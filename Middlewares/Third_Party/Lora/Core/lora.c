@@ -168,6 +168,10 @@ static void McpsConfirm(McpsConfirm_t *mcpsConfirm)
    );
 
    lora_config.McpsConfirm = mcpsConfirm;
+   if (LoRaMainCallbacks->LORA_McpsTxDone != NULL)
+   {
+      LoRaMainCallbacks->LORA_McpsTxDone(mcpsConfirm->TxTimeOnAir);
+   }
    if(mcpsConfirm->Status == LORAMAC_EVENT_INFO_STATUS_OK)
    {
       switch( mcpsConfirm->McpsRequest )
@@ -379,16 +383,24 @@ static void MlmeConfirm( MlmeConfirm_t *mlmeConfirm )
                }
                break;
          }
-   #if defined( USE_DEVICE_TIMING )        
+   #endif /* LORAMAC_CLASSB_ENABLED */
          case MLME_DEVICE_TIME:
          {        
-               if( mlmeConfirm->Status != LORAMAC_EVENT_INFO_STATUS_OK )
+               if( mlmeConfirm->Status == LORAMAC_EVENT_INFO_STATUS_OK )
+               {
+                  if (LoRaMainCallbacks->LORA_DeviceTimeUpdated != NULL)
+                  {
+                     LoRaMainCallbacks->LORA_DeviceTimeUpdated();
+                  }
+               }
+   #if defined( LORAMAC_CLASSB_ENABLED ) && defined( USE_DEVICE_TIMING )
+               else
                {
                   LORA_DeviceTimeReq();
-               }  
-         }              
-   #endif /* USE_DEVICE_TIMING */
-   #endif /* LORAMAC_CLASSB_ENABLED */
+               }
+   #endif /* LORAMAC_CLASSB_ENABLED && USE_DEVICE_TIMING */
+               break;
+         }
          default:
                break;
    }
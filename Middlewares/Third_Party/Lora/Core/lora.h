@@ -219,6 +219,21 @@ typedef struct sLoRaMainCallback
     * @param [IN] None
     */
     void ( *LORA_McpsDataConfirm) ( void);   
+    
+    /*!
+    * @brief callback indicating an uplink has been transmitted
+    *
+    * @param [IN] timeOnAir time on air of the uplink in ms
+    */
+    void ( *LORA_McpsTxDone) ( TimerTime_t timeOnAir );
+    
+    /*!
+    * @brief callback indicating the system time has been set by the
+    *        network (DeviceTimeAns)
+    *
+    * @param [IN] None
+    */
+    void ( *LORA_DeviceTimeUpdated) ( void );
 } LoRaMainCallback_t;
 
 
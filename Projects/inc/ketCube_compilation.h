@@ -112,6 +112,7 @@
 #define KETCUBE_CFG_INC_MOD_ICS43432    ///< Include ICS43432 module; undef to disable module
 #define KETCUBE_CFG_INC_MOD_TEST_RADIO  ///< Include testRadio module; undef to disable module
 #define KETCUBE_CFG_INC_MOD_UART2WAN    ///< Include uart2WAN module; undef to disable module
+#define KETCUBE_CFG_INC_MOD_PULSECNT    ///< Include pulseCnt module; undef to disable module
 //#define KETCUBE_CFG_INC_MOD_DUMMY     ///< Autogenerated modules will be included here
 
 #define KETCUBE_CFG_INC_DRV_AD          ///< Include KET's ADC driver; undef to disable driver
@@ -190,6 +191,10 @@ typedef enum {
     KETCUBE_LISTS_MODULEID_UART2WAN,              /*!< Module uart2WAN */
 #endif
 
+#ifdef KETCUBE_CFG_INC_MOD_PULSECNT
+    KETCUBE_LISTS_MODULEID_PULSECNT,              /*!< Module pulseCnt */
+#endif
+
     KETCUBE_LISTS_MODULEID_LAST                   /*!< Last module index - do not modify! */
 } ketCube_cfg_moduleIDs_t;
 
@@ -67,6 +67,22 @@
 #include "ketCube_hdcX080_cmd.c"
 #endif
 
+#ifdef KETCUBE_CFG_INC_MOD_BMEX80
+#include "ketCube_bmeX80_cmd.c"
+#endif
+
+#ifdef KETCUBE_CFG_INC_MOD_LIS2HH12
+#include "ketCube_lis2hh12_cmd.c"
+#endif
+
+#ifdef KETCUBE_CFG_INC_MOD_ICS43432
+#include "ketCube_ics43432_cmd.c"
+#endif
+
+#ifdef KETCUBE_CFG_INC_MOD_PULSECNT
+#include "ketCube_pulseCnt_cmd.c"
+#endif
+
 #ifdef KETCUBE_CFG_INC_MOD_LORA
 #include "ketCube_lora_cmd.c"
 #endif
@@ -150,6 +166,82 @@ ketCube_terminal_cmd_t ketCube_terminal_commands_setShow[] = {
         .moduleId = KETCUBE_MODULEID_HDCX080
     },
 #endif /* KETCUBE_CFG_INC_MOD_HDCX080 */
+
+#ifdef KETCUBE_CFG_INC_MOD_BMEX80
+    {
+        .cmd   = "BMEx80",
+        .descr = "BMEx80 parameters",
+        .flags = {
+            .isGroup   = TRUE,
+            .isLocal   = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isGeneric = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isEnvCmd  = TRUE,
+        },
+        .settingsPtr.subCmdList = ketCube_bmeX80_commands,
+        .moduleId = KETCUBE_MODULEID_BMEX80
+    },
+#endif /* KETCUBE_CFG_INC_MOD_BMEX80 */
+
+#ifdef KETCUBE_CFG_INC_MOD_LIS2HH12
+    {
+        .cmd   = "LIS2HH12",
+        .descr = "LIS2HH12 parameters",
+        .flags = {
+            .isGroup   = TRUE,
+            .isLocal   = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isGeneric = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isEnvCmd  = TRUE,
+        },
+        .settingsPtr.subCmdList = ketCube_lis2hh12_commands,
+        .moduleId = KETCUBE_MODULEID_LIS2HH12
+    },
+#endif /* KETCUBE_CFG_INC_MOD_LIS2HH12 */
+
+#ifdef KETCUBE_CFG_INC_MOD_ICS43432
+    {
+        .cmd   = "ICS43432",
+        .descr = "ICS43432 parameters",
+        .flags = {
+            .isGroup   = TRUE,
+            .isLocal   = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isGeneric = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isEnvCmd  = TRUE,
+        },
+        .settingsPtr.subCmdList = ketCube_ics43432_commands,
+        .moduleId = KETCUBE_MODULEID_ICS43432
+    },
+#endif /* KETCUBE_CFG_INC_MOD_ICS43432 */
+
+#ifdef KETCUBE_CFG_INC_MOD_PULSECNT
+    {
+        .cmd   = "pulseCnt",
+        .descr = "pulseCnt parameters",
+        .flags = {
+            .isGroup   = TRUE,
+            .isLocal   = TRUE,
+            .isEEPROM  = TRUE,
+            .isRAM     = TRUE,
+            .isGeneric = TRUE,
+            .isShowCmd = TRUE,
+            .isSetCmd  = TRUE,
+            .isEnvCmd  = TRUE,
+        },
+        .settingsPtr.subCmdList = ketCube_pulseCnt_commands,
+        .moduleId = KETCUBE_MODULEID_PULSECNT
+    },
+#endif /* KETCUBE_CFG_INC_MOD_PULSECNT */
      
 #ifdef KETCUBE_CFG_INC_MOD_LORA
     {
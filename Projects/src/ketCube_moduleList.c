@@ -68,6 +68,7 @@
 #include "ketCube_lis2hh12.h"
 #include "ketCube_testRadio.h"
 #include "ketCube_uart2WAN.h"
+#include "ketCube_pulseCnt.h"
 
 // AUTOGEN_INSERT_INCLUDE - Autogenerated module-includes will be inserted here
 
@@ -339,5 +340,20 @@ ketCube_cfg_Module_t ketCube_modules_List[ketCube_modules_CNT] = {
     ),
 #endif
 
+#ifdef KETCUBE_CFG_INC_MOD_PULSECNT
+    DEF_MODULE("pulseCnt",
+               "LPTIM pulse counter (STOP mode)",
+               KETCUBE_MODULEID_PULSECNT,
+               &ketCube_pulseCnt_Init,      /* Init() */
+               NULL,                        /* SleepEnter() */
+               NULL,                        /* SleepExit() */
+               &ketCube_pulseCnt_ReadData,  /* GetSensorData() */
+               NULL,                        /* SendData() */
+               NULL,                        /* ReceiveData() */
+               NULL,                        /* ProcessData() */
+               ketCube_pulseCnt_moduleCfg   /* Module cfg struct */
+              ),
+#endif
+
 // AUTOGEN_INSERT_MODULE_DEF - Autogenerated modules will be inserted here
 };
@@ -56,8 +56,10 @@
 #include "ketCube_remote_terminal.h"
 #include "ketCube_mcu.h"
 #include "ketCube_rtc.h"
+#include "ketCube_pwrMan.h"
 
 static TimerEvent_t KETCube_PeriodTimer;
+static uint32_t KETCube_PeriodLoaded;           /* Base period currently loaded in KETCube_PeriodTimer */
 
 
 volatile static bool KETCube_PeriodTimerElapsed = FALSE;
@@ -73,35 +75,29 @@ void KETCube_PeriodElapsed(void* context)
 
     KETCube_PeriodTimerElapsed = TRUE;
 
-    TimerSetValue(&KETCube_PeriodTimer, ketCube_coreCfg.basePeriod);
+    KETCube_PeriodLoaded = ketCube_modules_GetPeriod();
+    TimerSetValue(&KETCube_PeriodTimer, KETCube_PeriodLoaded);
 
     TimerStart(&KETCube_PeriodTimer);
 }
 
 /*!
- * @brief Repeat base period if error ocured during last basePeriod
+ * @brief Restart base period if modules requested a different period length
  * 
  */
-void KETCube_PeriodRepeatIfNeeded(void)
+void KETCube_PeriodUpdate(void)
 {
-    if (ketCube_coreCfg.repeatDelay == 0) {
+    if (ketCube_modules_GetPeriod() == KETCube_PeriodLoaded) {
         return;
     }
     
-    if (ketCube_coreCfg.repeatDelay > ketCube_coreCfg.basePeriod) {
-        return;
-    }
+    KETCube_PeriodLoaded = ketCube_modules_GetPeriod();
+    
+    ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO, "basePeriod changed to %d ms", KETCube_PeriodLoaded);
     
-    if ((ketCube_coreCfg.volatileData.moduleSendErrorCnt == 0) &&
-        (ketCube_coreCfg.volatileData.modulePerErrorCnt == 0)) {
-        return;        
-    }
-        
-    ketCube_terminal_CoreSeverityPrintln(KETCUBE_CFG_SEVERITY_INFO, "Module error detected - basePeriod repeat planed after %d ms", ketCube_coreCfg.repeatDelay);
-        
     TimerStop(&KETCube_PeriodTimer);
 
-    TimerSetValue(&KETCube_PeriodTimer, ketCube_coreCfg.repeatDelay);
+    TimerSetValue(&KETCube_PeriodTimer, KETCube_PeriodLoaded);
 
     TimerStart(&KETCube_PeriodTimer);
 }
@@ -168,6 +164,9 @@ int main(void)
     /* Configure the system clock */
     ketCube_MCU_ClockConfig();
     
+    /* Peripheral power manager */
+    ketCube_pwrMan_Init();
+    
     /* Configure the debug mode */
     DBG_Init();
 
@@ -228,6 +227,20 @@ int main(void)
         /* process pending remote terminal commands */
         ketCube_remoteTerminal_ProcessCMD();
 
+        /* accumulate samples of oversampled modules */
+        ketCube_modules_ExecuteSubPeriodic();
+
+        /* retry modules failed in this base period */
+        if (ketCube_modules_RetryDue() == TRUE) {
+            ketCube_modules_ExecuteRetry();
+            KETCube_PeriodUpdate();
+        }
+
+        /* execute out-of-period request (e.g. report-by-exception) */
+        if (ketCube_modules_PeriodRequested() == TRUE) {
+            KETCube_PeriodTimerElapsed = TRUE;
+        }
+
         /* execute periodic function for enabled modules */
 #if (KETCUBE_CORECFG_SKIP_SLEEP_PERIOD != TRUE)
         if (KETCube_PeriodTimerElapsed == TRUE) {
@@ -241,8 +254,8 @@ int main(void)
 
             ketCube_modules_ExecutePeriodic();
             
-            /* check if we should repeat "last" basePeriod */
-            KETCube_PeriodRepeatIfNeeded();
+            /* apply base period stretched/shortened by modules */
+            KETCube_PeriodUpdate();
 
 #if (KETCUBE_CORECFG_SKIP_SLEEP_PERIOD != TRUE)
         }
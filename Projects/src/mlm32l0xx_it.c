@@ -54,6 +54,7 @@
 #include "ketCube_uart.h"
 #include "ketCube_timer.h"
 #include "ketCube_rtc.h"
+#include "ketCube_pwrMan.h"
 
 
 /**
@@ -122,6 +123,7 @@ void SysTick_Handler(void)
 #define DEFINE_USART_IRQ_HANDLER(channel) void USART##channel##_IRQHandler(void)\
 {\
     KETCube_eventsProcessed = FALSE; /* Possible pending events */ \
+    ketCube_pwrMan_WakeEvent(KETCUBE_PWRMAN_WAKE_UART); \
 	UART_HandleTypeDef* huart = ketCube_UART_GetHandle(KETCUBE_UART_CHANNEL_##channel );\
 	if (huart != NULL)\
 	{\
@@ -249,6 +251,7 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef *huart)
 void RTC_IRQHandler( void )
 {
      KETCube_eventsProcessed = FALSE; /* Possible pending events */
+     ketCube_pwrMan_WakeEvent(KETCUBE_PWRMAN_WAKE_RTC);
     
      ketCube_RTC_IrqHandler();
 }
@@ -0,0 +1,187 @@
+/**
+ * @file    stub_cmsis_dsp.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test stub: reference implementations of the used CMSIS-DSP functions
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * The firmware links the prebuilt Cortex-M0 library
+ * (Drivers/CMSIS/Lib/GCC/libarm_cortexM0l_math.a); these plain C versions
+ * follow the same fixed-point arithmetic.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+#include "stub.h"
+
+void (*stub_biquadHook)(uint32_t stageSamples, uint32_t samples) = NULL;
+
+/* the real FFT uses only the length of the complex FFT instance */
+const arm_cfft_instance_q15 arm_cfft_sR_q15_len32 = { 32, NULL, NULL, 0 };
+
+q15_t arm_sin_q15(q15_t x)
+{
+    return (q15_t) lrint(fmin(32767.0, 32768.0 * sin(2.0 * M_PI * x / 32768.0)));
+}
+
+q15_t arm_cos_q15(q15_t x)
+{
+    return (q15_t) lrint(fmin(32767.0, 32768.0 * cos(2.0 * M_PI * x / 32768.0)));
+}
+
+/**
+ * @brief Forward real FFT
+ * 
+ * The N/2 complex FFT of the packed input (x[2n] + j*x[2n+1]) is a double
+ * DFT scaled by 4/N, thus the split step below gives X[k] / (N/2), the
+ * documented arm_rfft_q15() output format. The split step uses the
+ * instance tables as arm_split_rfft_q15() does.
+ */
+void arm_rfft_q15(const arm_rfft_instance_q15 * S, q15_t * pSrc,
+                  q15_t * pDst)
+{
+    uint32_t n = S->fftLenReal / 2;
+    q15_t *pCoefA = S->pTwiddleAReal + 2 * S->twidCoefRModifier;
+    q15_t *pCoefB = S->pTwiddleBReal + 2 * S->twidCoefRModifier;
+    q15_t z[2 * n];
+    double re, im, w;
+    int32_t outR, outI;
+    uint32_t i, k;
+
+    for (k = 0; k < n; k++) {
+        re = 0.0;
+        im = 0.0;
+        for (i = 0; i < n; i++) {
+            w = 2.0 * M_PI * k * i / n;
+            re += pSrc[2 * i] * cos(w) + pSrc[2 * i + 1] * sin(w);
+            im += pSrc[2 * i + 1] * cos(w) - pSrc[2 * i] * sin(w);
+        }
+        z[2 * k] = (q15_t) lrint(re * 2.0 / n);
+        z[2 * k + 1] = (q15_t) lrint(im * 2.0 / n);
+    }
+
+    for (i = 1; i < n; i++) {
+        outR = z[2 * i] * pCoefA[0] - z[2 * i + 1] * pCoefA[1]
+            + z[2 * n - 2 * i] * pCoefB[0] + z[2 * n - 2 * i + 1] * pCoefB[1];
+        outI = z[2 * n - 2 * i] * pCoefB[1] - z[2 * n - 2 * i + 1] * pCoefB[0]
+            + z[2 * i + 1] * pCoefA[0] + z[2 * i] * pCoefA[1];
+
+        pDst[2 * i] = (q15_t) (outR >> 16);
+        pDst[2 * i + 1] = (q15_t) (outI >> 16);
+        pDst[4 * n - 2 * i] = (q15_t) (outR >> 16);
+        pDst[4 * n - 2 * i + 1] = (q15_t) - (outI >> 16);
+
+        pCoefA += 2 * S->twidCoefRModifier;
+        pCoefB += 2 * S->twidCoefRModifier;
+    }
+
+    pDst[2 * n] = (z[0] - z[1]) >> 1;
+    pDst[2 * n + 1] = 0;
+    pDst[0] = (z[0] + z[1]) >> 1;
+    pDst[1] = 0;
+}
+
+void arm_biquad_cascade_df1_init_q31(arm_biquad_casd_df1_inst_q31 * S,
+                                     uint8_t numStages, q31_t * pCoeffs,
+                                     q31_t * pState, int8_t postShift)
+{
+    S->numStages = numStages;
+    S->pCoeffs = pCoeffs;
+    S->pState = pState;
+    S->postShift = postShift;
+    memset(pState, 0, 4U * numStages * sizeof(q31_t));
+}
+
+void arm_biquad_cascade_df1_q31(const arm_biquad_casd_df1_inst_q31 * S,
+                                q31_t * pSrc, q31_t * pDst,
+                                uint32_t blockSize)
+{
+    q31_t *pIn = pSrc;
+    q31_t *pState = S->pState;
+    q31_t *pCoeffs = S->pCoeffs;
+    uint32_t lShift = 31U - S->postShift;
+    uint32_t stage = S->numStages;
+    q31_t b0, b1, b2, a1, a2;
+    q31_t xn1, xn2, yn1, yn2, xn, yn;
+    q63_t acc;
+    uint32_t i;
+
+    do {
+        b0 = *pCoeffs++;
+        b1 = *pCoeffs++;
+        b2 = *pCoeffs++;
+        a1 = *pCoeffs++;
+        a2 = *pCoeffs++;
+
+        xn1 = pState[0];
+        xn2 = pState[1];
+        yn1 = pState[2];
+        yn2 = pState[3];
+
+        for (i = 0; i < blockSize; i++) {
+            xn = pIn[i];
+            acc = (q63_t) b0 * xn + (q63_t) b1 * xn1 + (q63_t) b2 * xn2
+                + (q63_t) a1 * yn1 + (q63_t) a2 * yn2;
+            yn = (q31_t) (acc >> lShift);
+            xn2 = xn1;
+            xn1 = xn;
+            yn2 = yn1;
+            yn1 = yn;
+            pDst[i] = yn;
+        }
+
+        *pState++ = xn1;
+        *pState++ = xn2;
+        *pState++ = yn1;
+        *pState++ = yn2;
+
+        /* the next stage filters the output in place */
+        pIn = pDst;
+    } while (--stage > 0U);
+
+    if (stub_biquadHook != NULL) {
+        stub_biquadHook(S->numStages * blockSize, blockSize);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    stub_cmsis_gcc.h
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test stub: Cortex-M intrinsics without ARM assembly
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * Force-included (gcc -include) before the CMSIS headers: cmsis_gcc.h is
+ * skipped, as its intrinsics are ARM inline assembly.
+ */
+
+#ifndef __STUB_CMSIS_GCC_H
+#define __STUB_CMSIS_GCC_H
+
+#include <stdint.h>
+
+#define __CMSIS_GCC_H
+
+extern uint32_t stub_primask;   ///< PRIMASK register
+extern uint32_t stub_ipsr;      ///< IPSR register: exception number, 0 in thread mode
+extern void stub_wfi(void);     ///< Execute the pending IRQs
+
+static inline void __enable_irq(void)
+{
+    stub_primask = 0;
+}
+
+static inline void __disable_irq(void)
+{
+    stub_primask = 1;
+}
+
+static inline uint32_t __get_PRIMASK(void)
+{
+    return stub_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+    stub_primask = priMask;
+}
+
+static inline uint32_t __get_IPSR(void)
+{
+    return stub_ipsr;
+}
+
+static inline uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0) ? 32 : __builtin_clz(value);
+}
+
+static inline void __NOP(void)
+{
+}
+
+static inline void __WFI(void)
+{
+    stub_wfi();
+}
+
+static inline void __DSB(void)
+{
+}
+
+static inline void __ISB(void)
+{
+}
+
+static inline void __DMB(void)
+{
+}
+
+#endif                          /* __STUB_CMSIS_GCC_H */
@@ -0,0 +1,95 @@
+/**
+ * @file    stub_eeprom.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test stub: data EEPROM in RAM
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_eeprom.h"
+#include "stub.h"
+
+uint8_t stub_eeprom[STUB_EEPROM_LEN];
+uint32_t stub_eepromWrites = 0;
+int32_t stub_eepromFailAt = -1;
+
+static void stub_eepromCheck(uint32_t addr, uint32_t len)
+{
+    if ((addr + len) > STUB_EEPROM_LEN) {
+        printf("FAIL EEPROM access out of range: 0x%X + %u\n", addr, len);
+        exit(1);
+    }
+}
+
+ketCube_EEPROM_Error_t ketCube_EEPROM_ReadBuffer(uint32_t addr,
+                                                 uint8_t * data,
+                                                 uint8_t len)
+{
+    stub_eepromCheck(addr, len);
+    memcpy(data, &(stub_eeprom[addr]), len);
+
+    return KETCUBE_EEPROM_OK;
+}
+
+ketCube_EEPROM_Error_t ketCube_EEPROM_WriteBuffer(uint32_t addr,
+                                                  uint8_t * data,
+                                                  uint8_t len)
+{
+    stub_eepromCheck(addr, len);
+    if ((int32_t) stub_eepromWrites++ == stub_eepromFailAt) {
+        /* power loss during the write */
+        memcpy(&(stub_eeprom[addr]), data, len / 2);
+        return KETCUBE_EEPROM_ERROR;
+    }
+    memcpy(&(stub_eeprom[addr]), data, len);
+
+    return KETCUBE_EEPROM_OK;
+}
+
+ketCube_EEPROM_Error_t ketCube_EEPROM_Erase(uint32_t addr, uint8_t len)
+{
+    stub_eepromCheck(addr, len);
+    memset(&(stub_eeprom[addr]), 0, len);
+
+    return KETCUBE_EEPROM_OK;
+}
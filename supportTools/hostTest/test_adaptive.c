@@ -0,0 +1,455 @@
+/**
+ * @file    test_adaptive.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host simulation of the adaptive base period on signal traces
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * A week of a signal is sampled with the period requested by the adaptive
+ * sampling service: at each period, the module record is passed through
+ * ketCube_adaptive_Begin()/Update()/End() as by ketCube_modules.c and the
+ * next sample is taken after ketCube_modules_GetPeriod().
+ * 
+ * The signal is reconstructed from the samples by linear interpolation and
+ * compared with the true signal every 10 s. The number of samples and the
+ * reconstruction RMS error are compared with a fixed 10 s period and with
+ * a fixed period of the same sample count.
+ * 
+ * usage: test_adaptive [trace]
+ * 
+ * trace: recorded trace, one "seconds,value" line per sample, value in mV;
+ *        sampled (linear interpolation) with the ADC module deadband
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_adaptive.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_deadband.h"
+#include "ketCube_modules.h"
+#include "ketCube_terminal.h"
+#include "ketCube_tsCodec.h"
+#include "timeServer.h"
+
+#define SIM_DAY_S               (24 * 3600)
+#define SIM_SPAN_S              (7 * SIM_DAY_S)
+#define SIM_GRID_S              10              ///< Fixed period and reconstruction error grid
+#define SIM_MIN_PERIOD          10000           ///< adaptMinPeriod (ms)
+#define SIM_MAX_PERIOD          900000          ///< adaptMaxPeriod (ms)
+#define SIM_MAX_SAMPLES         (SIM_SPAN_S / (SIM_MIN_PERIOD / 1000) + 2)
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL adaptive %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+ketCube_coreCfg_t ketCube_coreCfg;
+
+static TimerTime_t now;                 ///< TimerGetCurrentTime() in ms
+static uint32_t periodRequest;          ///< ketCube_modules_SetPeriod() of the core
+static uint32_t periodLogs;             ///< period change log lines
+
+TimerTime_t TimerGetCurrentTime(void)
+{
+    return now;
+}
+
+uint32_t ketCube_RTC_GetSysTime(void)
+{
+    return now;
+}
+
+void ketCube_modules_SetPeriod(ketCube_cfg_moduleIDs_t modId, uint32_t period)
+{
+    check(modId == KETCUBE_LISTS_ID_CORE, "period requested by the core", modId);
+    periodRequest = period;
+}
+
+uint32_t ketCube_modules_GetPeriod(void)
+{
+    return (periodRequest != 0) ? periodRequest : ketCube_coreCfg.basePeriod;
+}
+
+void ketCube_terminal_CoreSeverityPrintln(ketCube_severity_t msgSeverity,
+                                          char *format, ...)
+{
+    if (strncmp(format, "Adaptive period", 15) == 0) {
+        periodLogs++;
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Traces                                                                 */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Signal trace
+*/
+typedef struct {
+    const char *name;
+    const char *unit;
+    double scale;                               /*!< field units per unit */
+    ketCube_cfg_moduleIDs_t modId;              /*!< module of the deadband */
+    ketCube_deadband_field_t *deadband;
+    double (*value)(double t);                  /*!< true value at t (s) */
+    double noise;                               /*!< sensor noise RMS in units */
+    int32_t offset;                             /*!< field value of 0 units */
+} trace_t;
+
+static ketCube_deadband_field_t hdcDeadband[] = {
+    { .field = 2, .absolute = 5 },              /* ketCube_hdcX080.c: temperature in 0.1 °C */
+};
+
+static ketCube_deadband_field_t adcDeadband[] = {
+    { .field = 2, .absolute = 10, .relative = 20 },     /* ketCube_adc.c: PA4 in mV */
+};
+
+/**
+ * @brief Uniform noise in <-1; 1> of a time slot; independent of sampling
+ */
+static double slotNoise(uint32_t slot)
+{
+    slot ^= slot >> 16;
+    slot *= 0x7FEB352DU;
+    slot ^= slot >> 15;
+    slot *= 0x846CA68BU;
+    slot ^= slot >> 16;
+
+    return 2.0 * slot / 4294967295.0 - 1.0;
+}
+
+/**
+ * @brief Smooth per-day random value in <0; 1>
+ */
+static double dayRandom(uint32_t day, uint32_t event)
+{
+    return (slotNoise(day * 131 + event) + 1.0) / 2.0;
+}
+
+/**
+ * @brief Event response: rise with tauUp from the start, decay with tauDown from the end
+ */
+static double event(double t, double start, double len, double tauUp, double tauDown)
+{
+    if (t < start) {
+        return 0.0;
+    }
+    if (t < start + len) {
+        return 1.0 - exp(-(t - start) / tauUp);
+    }
+
+    return (1.0 - exp(-len / tauUp)) * exp(-(t - start - len) / tauDown);
+}
+
+/**
+ * @brief Room temperature: diurnal swing, morning ventilation, evening cooking
+ */
+static double roomTemperature(double t)
+{
+    uint32_t day = (uint32_t) (t / SIM_DAY_S);
+    double d = day * (double) SIM_DAY_S;
+    double v = 21.5 + 1.2 * sin(2.0 * M_PI * (t - 9.0 * 3600) / SIM_DAY_S);
+    int k;
+
+    /* yesterday's events still decay */
+    for (k = 0; k < 2; k++, d -= SIM_DAY_S, day--) {
+        if (d < 0.0) {
+            break;
+        }
+        v -= 4.0 * event(t, d + 7.0 * 3600 + 1800 * dayRandom(day, 0), 600 + 900 * dayRandom(day, 1), 300, 1800);
+        v += 2.0 * event(t, d + 18.0 * 3600 + 3600 * dayRandom(day, 2), 1800, 900, 2700);
+    }
+
+    return v;
+}
+
+/**
+ * @brief ADC: quiet 1.5 V with bursts of a 2-minute swing
+ */
+static double burstyAdc(double t)
+{
+    uint32_t day = (uint32_t) (t / SIM_DAY_S);
+    double d = day * (double) SIM_DAY_S;
+    double v = 1500.0;
+    double start, len;
+    int k;
+
+    for (k = 0; k < 6; k++) {
+        start = d + (k + dayRandom(day, 10 + k)) * SIM_DAY_S / 6.0;
+        len = 300 + 900 * dayRandom(day, 20 + k);
+        if ((t >= start) && (t < start + len)) {
+            v += 400.0 * sin(2.0 * M_PI * (t - start) / 120.0) * sin(M_PI * (t - start) / len);
+        }
+    }
+
+    return v;
+}
+
+static double *recTime, *recValue;      ///< recorded trace
+static uint32_t recLen;
+
+/**
+ * @brief Recorded trace, linear interpolation
+ */
+static double recorded(double t)
+{
+    static uint32_t i = 0;
+
+    if ((i >= recLen) || (recTime[i] > t)) {
+        i = 0;
+    }
+    while ((i + 2 < recLen) && (recTime[i + 1] <= t)) {
+        i++;
+    }
+    if (t <= recTime[0]) {
+        return recValue[0];
+    }
+    if (t >= recTime[recLen - 1]) {
+        return recValue[recLen - 1];
+    }
+
+    return recValue[i] + (recValue[i + 1] - recValue[i]) * (t - recTime[i]) / (recTime[i + 1] - recTime[i]);
+}
+
+static int loadTrace(const char *file)
+{
+    FILE *f = fopen(file, "r");
+    uint32_t size = 1024;
+    double t, v;
+
+    if (f == NULL) {
+        return 0;
+    }
+
+    recTime = malloc(size * sizeof(double));
+    recValue = malloc(size * sizeof(double));
+    recLen = 0;
+    while (fscanf(f, "%lf,%lf", &t, &v) == 2) {
+        if ((recLen > 0) && (t <= recTime[recLen - 1])) {
+            continue;
+        }
+        if (recLen == size) {
+            size *= 2;
+            recTime = realloc(recTime, size * sizeof(double));
+            recValue = realloc(recValue, size * sizeof(double));
+        }
+        recTime[recLen] = t;
+        recValue[recLen] = v;
+        recLen++;
+    }
+    fclose(f);
+
+    return (recLen >= 2);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+static double sampleT[SIM_MAX_SAMPLES];
+static double sampleV[SIM_MAX_SAMPLES];
+
+/**
+ * @brief Sensor reading in units: noise and field quantization
+ */
+static double measure(const trace_t * tr, double t)
+{
+    double v = tr->value(t) + tr->noise * (slotNoise((uint32_t) t) + slotNoise((uint32_t) t + 0x9E3779B9U)) * 1.22;
+
+    return lround(v * tr->scale) / tr->scale;
+}
+
+/**
+ * @brief Reconstruction RMS error of linear interpolation of samples
+ */
+static double rmsError(const trace_t * tr, double span, uint32_t cnt)
+{
+    double sum = 0.0, t, e, v;
+    uint32_t i = 0, n = 0;
+
+    for (t = 0.0; t <= span; t += SIM_GRID_S, n++) {
+        while ((i + 2 < cnt) && (sampleT[i + 1] <= t)) {
+            i++;
+        }
+        if (t >= sampleT[cnt - 1]) {
+            v = sampleV[cnt - 1];
+        } else {
+            v = sampleV[i] + (sampleV[i + 1] - sampleV[i]) * (t - sampleT[i]) / (sampleT[i + 1] - sampleT[i]);
+        }
+        e = v - tr->value(t);
+        sum += e * e;
+    }
+
+    return sqrt(sum / n);
+}
+
+/**
+ * @brief Fixed period sampling
+ *
+ * @retval reconstruction RMS error
+ */
+static double fixedPeriod(const trace_t * tr, double span, double period)
+{
+    uint32_t cnt = 0;
+    double t;
+
+    for (t = 0.0; t <= span; t += period) {
+        sampleT[cnt] = t;
+        sampleV[cnt] = measure(tr, t);
+        cnt++;
+    }
+
+    return rmsError(tr, span, cnt);
+}
+
+/**
+ * @brief Adaptive sampling of a trace
+ */
+static void simulate(const trace_t * tr, double span, int step)
+{
+    uint8_t record[2];
+    uint32_t cnt = 0, period, prevPeriod = 0, changes = 0, minSeen = UINT32_MAX, maxSeen = 0;
+    uint32_t fixedCnt = (uint32_t) (span / SIM_GRID_S) + 1;
+    int32_t field;
+    double t = 0.0, rmsAdaptive, rmsFixed, rmsEqual;
+
+    ketCube_deadband_Declare(tr->modId, tr->deadband, 1);
+
+    /* disabled: the core request is withdrawn; resets the period of the previous trace */
+    ketCube_coreCfg.adaptMaxPeriod = 0;
+    ketCube_adaptive_Begin();
+    ketCube_adaptive_End();
+    check(periodRequest == 0, "disabled: period request withdrawn", step);
+
+    ketCube_coreCfg.basePeriod = SIM_GRID_S * 1000;
+    ketCube_coreCfg.adaptMinPeriod = SIM_MIN_PERIOD;
+    ketCube_coreCfg.adaptMaxPeriod = SIM_MAX_PERIOD;
+    periodLogs = 0;
+
+    while ((t <= span) && (cnt < SIM_MAX_SAMPLES)) {
+        now = (TimerTime_t) (t * 1000.0);
+
+        sampleT[cnt] = t;
+        sampleV[cnt] = measure(tr, t);
+        field = (int32_t) lround(sampleV[cnt] * tr->scale) + tr->offset;
+        record[0] = (uint8_t) (field >> 8);
+        record[1] = (uint8_t) field;
+        cnt++;
+
+        ketCube_adaptive_Begin();
+        ketCube_adaptive_Update(tr->modId, &(record[0]), sizeof(record));
+        ketCube_adaptive_End();
+
+        period = ketCube_modules_GetPeriod();
+        check((period >= SIM_MIN_PERIOD) && (period <= SIM_MAX_PERIOD), "period within limits", (int) t);
+        if (prevPeriod != 0) {
+            check(period <= prevPeriod * KETCUBE_ADAPTIVE_MAX_GROWTH, "period growth", (int) t);
+            if (period != prevPeriod) {
+                changes++;
+            }
+        }
+        minSeen = (period < minSeen) ? period : minSeen;
+        maxSeen = (period > maxSeen) ? period : maxSeen;
+        prevPeriod = period;
+
+        t += period / 1000.0;
+    }
+
+    check(changes + 1 >= periodLogs && periodLogs >= changes, "period changes logged", step);
+
+    rmsAdaptive = rmsError(tr, span, cnt);
+    rmsFixed = fixedPeriod(tr, span, SIM_GRID_S);
+    rmsEqual = fixedPeriod(tr, span, span / cnt);
+
+    printf("adaptive: %s: %u samples vs %u at a fixed %d s (%+.1f %%), period %u - %u s, %u changes\n",
+           tr->name, cnt, fixedCnt, SIM_GRID_S, 100.0 * ((double) cnt - fixedCnt) / fixedCnt,
+           minSeen / 1000, maxSeen / 1000, changes);
+    printf("adaptive: %s: RMS error %.3f %s adaptive, %.3f %s fixed %d s, %.3f %s fixed %.0f s (same count)\n",
+           tr->name, rmsAdaptive, tr->unit, rmsFixed, tr->unit, SIM_GRID_S, rmsEqual, tr->unit, span / cnt);
+
+    if (tr->value != &recorded) {
+        check(cnt * 10 < fixedCnt, "samples saved", step);
+        check(rmsAdaptive < rmsEqual, "adaptive beats the same count fixed period", step);
+        check(minSeen == SIM_MIN_PERIOD, "transients sampled at the min. period", step);
+        check(maxSeen == SIM_MAX_PERIOD, "quiet signal sampled at the max. period", step);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const trace_t room = { "room temperature", "C", 10.0, KETCUBE_LISTS_MODULEID_HDCX080, hdcDeadband, &roomTemperature, 0.03, 10000 };
+    static const trace_t adc = { "bursty ADC", "mV", 1.0, KETCUBE_LISTS_MODULEID_ADC, adcDeadband, &burstyAdc, 2.0, 0 };
+    static const trace_t rec = { "recorded trace", "mV", 1.0, KETCUBE_LISTS_MODULEID_ADC, adcDeadband, &recorded, 0.0, 0 };
+
+    if (argc > 1) {
+        if (loadTrace(argv[1]) == 0) {
+            printf("FAIL adaptive cannot read the trace from %s\n", argv[1]);
+            return 1;
+        }
+        simulate(&rec, recTime[recLen - 1] - recTime[0], 3);
+    } else {
+        simulate(&room, SIM_SPAN_S, 1);
+        simulate(&adc, SIM_SPAN_S, 2);
+    }
+
+    if (fails != 0) {
+        return 1;
+    }
+
+    printf("PASS adaptive\n");
+
+    return 0;
+}
@@ -0,0 +1,322 @@
+/**
+ * @file    test_batMeas.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the battery state of charge estimate with TX load compensation
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * A CR2032 at a constant state of charge powers a node sending an uplink
+ * every minute. After each TX the battery voltage sags and recovers
+ * exponentially; readings are noisy. batMeas samples the battery at the
+ * start of each period (ReadData()) and gets the TX loads from the LoRa
+ * module (AddLoad()); the LoRaMAC DevStatusAns asks for the level at
+ * arbitrary times (GetBatteryByte()).
+ * 
+ * The estimate is compared with the former behaviour (a fresh reading on
+ * every request, often just after TX) and with the estimate without load
+ * compensation.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ketCube_batMeas.h"
+#include "ketCube_batPolicy.h"
+#include "ketCube_deadband.h"
+#include "ketCube_terminal.h"
+#include "timeServer.h"
+
+#define SIM_SOC                 55.0            ///< True state of charge in %
+#define SIM_PERIOD_S            60              ///< Base period
+#define SIM_PERIODS             360             ///< 6 hours
+#define SIM_SETTLE_PERIODS      60              ///< Filter settling excluded from statistics
+#define SIM_TX_DELAY_S          1               ///< Uplink after the period start
+#define SIM_TX_MAS              8.8             ///< SF9 200 ms at 44 mA, as reported by ketCube_lora.c
+#define SIM_SAG_MV_PER_MAS      10.0            ///< TX voltage sag per charge: 88 mV
+#define SIM_SAG_TAU_S           43.0            ///< Sag recovery time constant
+#define SIM_NOISE_MV            10.0            ///< Reading noise (uniform)
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL batMeas %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+static double simTime;          ///< Simulation time in s
+static double sagMv;            ///< TX sag at sagTime
+static double sagTime = -1e6;
+static uint32_t noiseSeed = 1;
+static uint32_t adReads;        ///< ketCube_AD_GetBatLevelmV() calls
+static uint8_t policySoC;       ///< ketCube_batPolicy_Update() input
+
+TimerTime_t TimerGetCurrentTime(void)
+{
+    return (TimerTime_t) ((uint64_t) (simTime * 1000.0));
+}
+
+void ketCube_batPolicy_Update(uint8_t soc)
+{
+    policySoC = soc;
+}
+
+void ketCube_deadband_Declare(ketCube_cfg_moduleIDs_t modId,
+                              ketCube_deadband_field_t * fields,
+                              uint8_t fieldCnt)
+{
+}
+
+void ketCube_terminal_ModSeverityPrintln(ketCube_severity_t msgSeverity,
+                                         ketCube_cfg_moduleIDs_t modId,
+                                         char *format, va_list args)
+{
+}
+
+ketCube_cfg_DrvError_t ketCube_AD_Init(void)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief Light-load voltage of the true SoC on the discharge curve
+ */
+static double lightLoadMv(void)
+{
+    const uint16_t *curve = &(ketCube_batMeas_batList[KETCUBE_BATMEAS_BATLIST_CR2032].curve[0]);
+    int i = (int) ((100.0 - SIM_SOC) / 10.0);
+
+    return curve[i] - (curve[i] - curve[i + 1]) * ((100.0 - SIM_SOC) / 10.0 - i);
+}
+
+uint32_t ketCube_AD_GetBatLevelmV(void)
+{
+    double noise;
+
+    adReads++;
+    noiseSeed = noiseSeed * 1103515245U + 12345U;
+    noise = SIM_NOISE_MV * (2.0 * (noiseSeed >> 8) / 16777215.0 - 1.0);
+
+    return (uint32_t) lround(lightLoadMv() - sagMv * exp(-(simTime - sagTime) / SIM_SAG_TAU_S) + noise);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief SoC statistics after settling
+*/
+typedef struct {
+    double mean;
+    int min;
+    int max;
+} stats_t;
+
+static void statsAdd(stats_t * s, int soc, uint32_t n)
+{
+    if (n == 0) {
+        s->mean = 0.0;
+        s->min = soc;
+        s->max = soc;
+    }
+    s->mean += soc;
+    s->min = (soc < s->min) ? soc : s->min;
+    s->max = (soc > s->max) ? soc : s->max;
+}
+
+/**
+ * @brief Uplink; the LoRa module reports time on air x TX current
+ */
+static void transmit(void)
+{
+    sagMv = sagMv * exp(-(simTime - sagTime) / SIM_SAG_TAU_S) + SIM_SAG_MV_PER_MAS * SIM_TX_MAS;
+    sagTime = simTime;
+    ketCube_batMeas_AddLoad((uint32_t) lround(SIM_TX_MAS * 1000.0));
+}
+
+/**
+ * @brief Run the node
+ *
+ * @param compensate load compensation enabled (battery loadGain)
+ * @param s estimate statistics
+ * @param fresh former behaviour: SoC of a fresh reading 1 - 4 s after TX
+ */
+static void run(bool compensate, stats_t * s, stats_t * fresh)
+{
+    uint8_t buffer[4], len, level;
+    uint32_t p, n = 0, reads;
+    int step;
+
+    if (compensate == FALSE) {
+        ketCube_batMeas_batList[KETCUBE_BATMEAS_BATLIST_CR2032].loadGain = 0;
+    }
+    ketCube_batMeas_moduleCfg.selectedBattery = KETCUBE_BATMEAS_BATLIST_CR2032;
+    ketCube_batMeas_Init(NULL);
+
+    /* DevStatusAns before the first period: measured on request */
+    simTime = 0.0;
+    level = ketCube_batMeas_GetBatteryByte();
+    check((level != 0) && (adReads == 1), "first level measured on request", 0);
+
+    for (p = 0; p < SIM_PERIODS; p++) {
+        step = (int) p;
+        simTime = (double) p * SIM_PERIOD_S;
+
+        reads = adReads;
+        check(ketCube_batMeas_ReadData(&(buffer[0]), &len) == KETCUBE_CFG_MODULE_OK, "read", step);
+        check(len == 1, "record length", step);
+        check(adReads == reads + 1, "sampled at the period start", step);
+        check(policySoC == ketCube_batMeas_GetSoC(), "SoC fed to the policy", step);
+        check(buffer[0] == 1 + (ketCube_batMeas_GetSoC() * 253) / 100, "level byte of the SoC", step);
+
+        simTime += SIM_TX_DELAY_S;
+        transmit();
+
+        /* DevStatusAns and the former fresh reading shortly after TX */
+        simTime += 1 + (p % 4);
+        reads = adReads;
+        level = ketCube_batMeas_GetBatteryByte();
+        check(adReads == reads, "DevStatusAns does not convert", step);
+        check(level == buffer[0], "DevStatusAns returns the cached level", step);
+
+        /* a period restarted within the quiet time after TX keeps the estimate */
+        check(ketCube_batMeas_ReadData(&(buffer[0]), &len) == KETCUBE_CFG_MODULE_OK, "read after TX", step);
+        check((adReads == reads) && (buffer[0] == level), "not quiet: estimate kept", step);
+
+        if (p >= SIM_SETTLE_PERIODS) {
+            statsAdd(s, ketCube_batMeas_GetSoC(), n);
+            if (fresh != NULL) {
+                statsAdd(fresh, ketCube_batMeas_CurveSoC((uint16_t) ketCube_AD_GetBatLevelmV()), n);
+            }
+            n++;
+        }
+    }
+
+    s->mean /= n;
+    if (fresh != NULL) {
+        fresh->mean /= n;
+    }
+}
+
+/**
+ * @brief Run in a child process: batMeas starts from reset
+ */
+static void runIsolated(bool compensate, stats_t * s, stats_t * fresh)
+{
+    stats_t res[2];
+    int fd[2];
+    pid_t pid;
+    int status;
+
+    if ((pipe(fd) != 0) || ((pid = fork()) < 0)) {
+        check(0, "fork", compensate);
+        return;
+    }
+
+    if (pid == 0) {
+        close(fd[0]);
+        memset(res, 0, sizeof(res));
+        run(compensate, &(res[0]), &(res[1]));
+        if (write(fd[1], res, sizeof(res)) != sizeof(res)) {
+            fails++;
+        }
+        exit(fails != 0);
+    }
+
+    close(fd[1]);
+    check(read(fd[0], res, sizeof(res)) == sizeof(res), "result", compensate);
+    close(fd[0]);
+    waitpid(pid, &status, 0);
+    check(WIFEXITED(status) && (WEXITSTATUS(status) == 0), "run", compensate);
+
+    *s = res[0];
+    if (fresh != NULL) {
+        *fresh = res[1];
+    }
+}
+
+int main(void)
+{
+    stats_t est, fresh, noComp;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    /* curve interpolation */
+    check(ketCube_batMeas_CurveSoC(3400) == 100, "curve: above full", 0);
+    check(ketCube_batMeas_CurveSoC(2990) == 55, "curve: interpolation", 0);
+    check(ketCube_batMeas_CurveSoC(2900) == 0, "curve: empty", 0);
+    check(ketCube_batMeas_CurveSoC(2000) == 0, "curve: below empty", 0);
+
+    runIsolated(TRUE, &est, &fresh);
+    runIsolated(FALSE, &noComp, NULL);
+
+    printf("batMeas: true SoC %.0f %%; fresh reading after TX %.1f %% (%d - %d %%)\n",
+           SIM_SOC, fresh.mean, fresh.min, fresh.max);
+    printf("batMeas: estimate %.1f %% (%d - %d %%); without load compensation %.1f %% (%d - %d %%)\n",
+           est.mean, est.min, est.max, noComp.mean, noComp.min, noComp.max);
+
+    check(fabs(est.mean - SIM_SOC) <= 2.0, "estimate mean", (int) est.mean);
+    check((est.min >= SIM_SOC - 3) && (est.max <= SIM_SOC + 3), "estimate spread", est.max - est.min);
+    check(noComp.mean < SIM_SOC - 5.0, "load compensation needed", (int) noComp.mean);
+    check(fresh.mean < SIM_SOC - 20.0, "former fresh readings sag", (int) fresh.mean);
+
+    if (fails != 0) {
+        return 1;
+    }
+
+    printf("PASS batMeas: SoC %.1f %% (true %.0f %%)\n", est.mean, SIM_SOC);
+
+    return 0;
+}
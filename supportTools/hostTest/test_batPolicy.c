@@ -0,0 +1,370 @@
+/**
+ * @file    test_batPolicy.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host simulation of the node lifetime per battery policy tier
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * A node on a CR2032 is run until the battery is exhausted, one base
+ * period at a time: batMeas samples the battery at the start of the period
+ * and feeds the policy, optional sensing runs unless suspended, and an
+ * uplink is sent with the TX power and NbTrans caps of the current tier
+ * (as applied by ketCube_lora.c). The battery voltage follows the batMeas
+ * discharge curve of the true state of charge, sags after each TX and is
+ * read with noise.
+ * 
+ * The lifetime is simulated with the policy off and with the tiers enabled
+ * up to save, low and critical; a tier beyond the enabled ones behaves as
+ * the last enabled tier.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ketCube_batMeas.h"
+#include "ketCube_batPolicy.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_deadband.h"
+#include "ketCube_modules.h"
+#include "ketCube_terminal.h"
+#include "timeServer.h"
+
+#define SIM_CAPACITY_MAS        (220.0 * 3600)  ///< CR2032: 220 mAh
+#define SIM_PERIOD_S            300             ///< Base period
+#define SIM_SLEEP_UA            3.0             ///< Sleep current
+#define SIM_AD_MAS              0.1             ///< VREFINT conversion
+#define SIM_SENSING_MAS         2.0             ///< Optional sensing per period
+#define SIM_TOA_MS              200             ///< SF9 uplink time on air
+#define SIM_NBTRANS             2               ///< Network NbTrans
+#define SIM_TX_GAP_S            3               ///< Retransmission after the RX windows
+#define SIM_SAG_MV_PER_MAS      10.0            ///< TX voltage sag per charge
+#define SIM_SAG_TAU_S           43.0            ///< Sag recovery time constant
+#define SIM_NOISE_MV            10.0            ///< Reading noise (uniform)
+#define SIM_MAX_DAYS            3650
+
+#define SIM_SENSING_MODULE      KETCUBE_LISTS_MODULEID_HDCX080
+
+/**
+* @brief TX current (mA) by EU868 TX power index (2 dB steps)
+*/
+static const double txMa[] = { 44.0, 40.0, 36.0, 32.0, 28.0, 25.0, 22.0, 20.0 };
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL batPolicy %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+ketCube_coreCfg_t ketCube_coreCfg;
+
+static double simTime;          ///< Simulation time in s
+static double charge;           ///< Remaining battery charge in mAs
+static double sagMv;            ///< TX sag at sagTime
+static double sagTime;
+static uint32_t noiseSeed = 1;
+
+static uint8_t periodScale = 1;         ///< ketCube_modules_ScalePeriod()
+static uint32_t suspended = 0;          ///< ketCube_modules_Suspend()
+
+TimerTime_t TimerGetCurrentTime(void)
+{
+    return (TimerTime_t) ((uint64_t) (simTime * 1000.0));
+}
+
+void ketCube_modules_ScalePeriod(uint8_t scale)
+{
+    periodScale = scale;
+}
+
+void ketCube_modules_Suspend(uint32_t mask)
+{
+    suspended = mask;
+}
+
+void ketCube_deadband_Declare(ketCube_cfg_moduleIDs_t modId,
+                              ketCube_deadband_field_t * fields,
+                              uint8_t fieldCnt)
+{
+}
+
+void ketCube_terminal_CoreSeverityPrintln(ketCube_severity_t msgSeverity,
+                                          char *format, ...)
+{
+}
+
+void ketCube_terminal_ModSeverityPrintln(ketCube_severity_t msgSeverity,
+                                         ketCube_cfg_moduleIDs_t modId,
+                                         char *format, va_list args)
+{
+}
+
+ketCube_cfg_DrvError_t ketCube_AD_Init(void)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief Light-load voltage on the discharge curve of the true SoC
+ */
+static double curveMv(double socPct)
+{
+    const uint16_t *curve = &(ketCube_batMeas_batList[KETCUBE_BATMEAS_BATLIST_CR2032].curve[0]);
+    int i;
+
+    if (socPct >= 100.0) {
+        return curve[0];
+    }
+    if (socPct <= 0.0) {
+        return curve[KETCUBE_BATMEAS_CURVE_POINTS - 1];
+    }
+
+    i = (int) ((100.0 - socPct) / 10.0);
+
+    return curve[i] - (curve[i] - curve[i + 1]) * ((100.0 - socPct) / 10.0 - i);
+}
+
+static double trueSoC(void)
+{
+    return 100.0 * charge / SIM_CAPACITY_MAS;
+}
+
+uint32_t ketCube_AD_GetBatLevelmV(void)
+{
+    double noise;
+
+    noiseSeed = noiseSeed * 1103515245U + 12345U;
+    noise = SIM_NOISE_MV * (2.0 * (noiseSeed >> 8) / 16777215.0 - 1.0);
+    charge -= SIM_AD_MAS;
+
+    return (uint32_t) lround(curveMv(trueSoC())
+                             - sagMv * exp(-(simTime - sagTime) / SIM_SAG_TAU_S) + noise);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Result of a lifetime run
+*/
+typedef struct {
+    double days;
+    double tierDays[KETCUBE_BATPOLICY_TIER_CNT];        /*!< time spent in tiers */
+    double enterSoC[KETCUBE_BATPOLICY_TIER_CNT];        /*!< true SoC at tier entry */
+    uint32_t changes;
+} result_t;
+
+/**
+ * @brief Uplink transmission; the LoRa module reports the load to batMeas
+ */
+static void transmit(uint8_t txPower)
+{
+    double mAs = SIM_TOA_MS * txMa[txPower] / 1000.0;
+
+    charge -= mAs;
+    sagMv = sagMv * exp(-(simTime - sagTime) / SIM_SAG_TAU_S) + SIM_SAG_MV_PER_MAS * mAs;
+    sagTime = simTime;
+    ketCube_batMeas_AddLoad((uint32_t) lround(mAs * 1000.0));
+}
+
+/**
+ * @brief Run until the battery is exhausted
+ *
+ * @param tiers last enabled tier; -1 = policy off
+ */
+static void lifetime(int tiers, result_t * res)
+{
+    const ketCube_batPolicy_tier_t *tier;
+    ketCube_batPolicy_tierId_t id, prevId = KETCUBE_BATPOLICY_TIER_NORMAL;
+    uint8_t buffer[4], len, nbTrans, txPower, i;
+    double period;
+    int step = 0;
+
+    memset(res, 0, sizeof(result_t));
+    res->enterSoC[KETCUBE_BATPOLICY_TIER_NORMAL] = 100.0;
+
+    ketCube_coreCfg.batPolicy = (tiers >= 0);
+    /* batMeas is the policy input; it must never be suspended */
+    ketCube_coreCfg.batPolicyOptMods = (1UL << SIM_SENSING_MODULE) | (1UL << KETCUBE_LISTS_MODULEID_BATMEAS);
+    ketCube_batMeas_moduleCfg.selectedBattery = KETCUBE_BATMEAS_BATLIST_CR2032;
+    ketCube_batMeas_Init(NULL);
+
+    charge = SIM_CAPACITY_MAS;
+    simTime = 0.0;
+
+    while ((charge > 0.0) && (simTime < SIM_MAX_DAYS * 86400.0)) {
+        step++;
+        check(ketCube_batMeas_ReadData(&(buffer[0]), &len) == KETCUBE_CFG_MODULE_OK, "battery read", step);
+
+        tier = ketCube_batPolicy_GetTier();
+        id = (ketCube_batPolicy_tierId_t) (tier - &(ketCube_batPolicy_tiers[0]));
+        check((suspended & (1UL << KETCUBE_LISTS_MODULEID_BATMEAS)) == 0, "batMeas not suspended", step);
+        check(periodScale == tier->periodScale, "period scaled by the tier", step);
+        check(((suspended & (1UL << SIM_SENSING_MODULE)) != 0) == tier->suspendOptional, "optional modules suspended by the tier", step);
+
+        if (id != prevId) {
+            check(id == prevId + 1, "tiers entered in order", step);
+            res->changes++;
+            res->enterSoC[id] = trueSoC();
+            prevId = id;
+        }
+
+        /* tiers beyond the enabled ones behave as the last enabled tier */
+        if ((tiers >= 0) && (id > tiers)) {
+            tier = &(ketCube_batPolicy_tiers[tiers]);
+        }
+
+        if (tier->suspendOptional == FALSE) {
+            charge -= SIM_SENSING_MAS;
+        }
+
+        txPower = tier->txPowerMin;
+        nbTrans = SIM_NBTRANS;
+        if ((tier->nbTransMax != 0) && (nbTrans > tier->nbTransMax)) {
+            nbTrans = tier->nbTransMax;
+        }
+        for (i = 0; i < nbTrans; i++) {
+            simTime += (i == 0) ? 1 : SIM_TX_GAP_S;
+            transmit(txPower);
+        }
+
+        period = SIM_PERIOD_S * tier->periodScale;
+        charge -= SIM_SLEEP_UA * period / 1000.0;
+        res->tierDays[id] += period / 86400.0;
+        simTime += period - 1 - (nbTrans - 1) * SIM_TX_GAP_S;
+    }
+
+    res->days = simTime / 86400.0;
+}
+
+/**
+ * @brief Run in a child process: batMeas and the policy start from reset
+ */
+static void lifetimeRun(int tiers, result_t * res)
+{
+    int fd[2];
+    pid_t pid;
+    int status;
+
+    if ((pipe(fd) != 0) || ((pid = fork()) < 0)) {
+        check(0, "fork", tiers);
+        return;
+    }
+
+    if (pid == 0) {
+        close(fd[0]);
+        lifetime(tiers, res);
+        if (write(fd[1], res, sizeof(result_t)) != sizeof(result_t)) {
+            fails++;
+        }
+        exit(fails != 0);
+    }
+
+    close(fd[1]);
+    check(read(fd[0], res, sizeof(result_t)) == sizeof(result_t), "result", tiers);
+    close(fd[0]);
+    waitpid(pid, &status, 0);
+    check(WIFEXITED(status) && (WEXITSTATUS(status) == 0), "run", tiers);
+}
+
+int main(void)
+{
+    static const char *runName[] = { "off", "save", "save+low", "save+low+critical" };
+    result_t res[KETCUBE_BATPOLICY_TIER_CNT];
+    int k, t;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    for (k = 0; k < KETCUBE_BATPOLICY_TIER_CNT; k++) {
+        lifetimeRun((k == 0) ? -1 : k, &(res[k]));
+
+        printf("batPolicy: %-18s %5.0f d (%+4.0f %%); days in tiers:", runName[k], res[k].days,
+               100.0 * (res[k].days - res[0].days) / res[0].days);
+        for (t = 0; t < KETCUBE_BATPOLICY_TIER_CNT; t++) {
+            printf(" %s %.0f", ketCube_batPolicy_tiers[t].name, res[k].tierDays[t]);
+        }
+        printf("\n");
+
+        if (k == 0) {
+            check(res[k].changes == 0, "policy off: no tier change", k);
+            continue;
+        }
+
+        check(res[k].days > res[k - 1].days, "lifetime extended by the tier", k);
+        check(res[k].changes == KETCUBE_BATPOLICY_TIER_CNT - 1, "each tier entered once", k);
+
+        /* the estimated SoC follows the true SoC */
+        for (t = 1; t < KETCUBE_BATPOLICY_TIER_CNT; t++) {
+            check(fabs(res[k].enterSoC[t] - ketCube_batPolicy_tiers[t].socBelow) <= 3.0,
+                  "tier entered at its SoC", k * 10 + t);
+        }
+    }
+
+    printf("batPolicy: tier entry at true SoC:");
+    for (t = 1; t < KETCUBE_BATPOLICY_TIER_CNT; t++) {
+        printf(" %s %.1f %%", ketCube_batPolicy_tiers[t].name, res[KETCUBE_BATPOLICY_TIER_CNT - 1].enterSoC[t]);
+    }
+    printf("\n");
+
+    if (fails != 0) {
+        return 1;
+    }
+
+    printf("PASS batPolicy: %.0f d off, %.0f d with all tiers\n", res[0].days,
+           res[KETCUBE_BATPOLICY_TIER_CNT - 1].days);
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file    test_cfgMigrate.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the module configuration migration
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "ketCube_cfg.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_modules.h"
+#include "ketCube_lora.h"
+#include "stub.h"
+
+/**
+* @brief Module configurations stored by the firmware preceding KETCUBE_CORECFG_LAYOUT (10839a7)
+*
+* Laid out by ketCube_moduleList.c of 10839a7 using its configuration
+* structures: core (basePeriod 60 s, startDelay 5 s, repeatDelay 30 s,
+* volatile data filled), LoRa (OTAA, custom devEUI, appKey, DR5), other
+* modules store the cfg byte and a pattern.
+*/
+static const struct {
+    ketCube_moduleID_t id;
+    uint16_t offset;
+    uint8_t len;
+} legacyIndex[] = {
+    {KETCUBE_MODULEID_CORE_API,                0, 132},
+    {KETCUBE_MODULEID_LORA,                  132, 124},
+    {KETCUBE_MODULEID_HDCX080,               256,   8},
+    {KETCUBE_MODULEID_BATMEAS,               264,   2},
+    {KETCUBE_MODULEID_ADC,                   266,   1},
+    {KETCUBE_MODULEID_STARNET_CONCENTRATOR,  267,   1},
+    {KETCUBE_MODULEID_STARNET_NODE,          268,   1},
+    {KETCUBE_MODULEID_RXDISPLAY,             269,   1},
+    {KETCUBE_MODULEID_ASYNCTX,               270,   1},
+    {KETCUBE_MODULEID_TXDISPLAY,             271,   1},
+    {KETCUBE_MODULEID_BMEX80,                272,   1},
+    {KETCUBE_MODULEID_LIS2HH12,              273,   1},
+    {KETCUBE_MODULEID_ICS43432,              274,   1},
+    {KETCUBE_MODULEID_TEST_RADIO,            275,  12},
+    {KETCUBE_MODULEID_UART2WAN,              287,   1},
+};
+
+static const uint8_t legacyImage[] = {
+    0x03, 0x00, 0x00, 0x00, 0x60, 0xEA, 0x00, 0x00, 0x88, 0x13, 0x00, 0x00,
+    0x30, 0x75, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x03, 0x5B, 0x58, 0x59,
+    0x5E, 0x5F, 0x5C, 0x5D, 0x52, 0x53, 0x50, 0x51, 0x56, 0x57, 0x54, 0x55,
+    0x4A, 0x4B, 0x48, 0x49, 0x4E, 0x4F, 0x4C, 0x4D, 0x42, 0x43, 0x40, 0x41,
+    0x46, 0x47, 0x44, 0x45, 0x7A, 0x7B, 0x78, 0x79, 0x7E, 0x7F, 0x7C, 0x7D,
+    0x72, 0x73, 0x70, 0x71, 0x76, 0x77, 0x74, 0x75, 0x6A, 0x6B, 0x68, 0x69,
+    0x6E, 0x6F, 0x6C, 0x6D, 0x62, 0x63, 0x60, 0x61, 0x66, 0x67, 0x64, 0x65,
+    0x1A, 0x1B, 0x18, 0x19, 0x1E, 0x1F, 0x1C, 0x1D, 0x12, 0x13, 0x10, 0x11,
+    0x16, 0x17, 0x14, 0x15, 0x0A, 0x0B, 0x08, 0x09, 0x0E, 0x0F, 0x0C, 0x0D,
+    0x02, 0x03, 0x00, 0x01, 0x06, 0x07, 0x04, 0x05, 0x3A, 0x3B, 0x38, 0x39,
+    0x3E, 0x3F, 0x3C, 0x3D, 0x32, 0x33, 0x30, 0x31, 0x36, 0x37, 0x34, 0x00,
+    0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75,
+    0x76, 0x77, 0xD0, 0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0x2B, 0x3A,
+    0x09, 0x18, 0x6F, 0x7E, 0x4D, 0x5C, 0xA3, 0xB2, 0x81, 0x90, 0xE7, 0xF6,
+    0xC5, 0xD4, 0x2B, 0x3A, 0x09, 0x18, 0x6F, 0x7E, 0x4D, 0x5C, 0xA3, 0xB2,
+    0x81, 0x90, 0xE7, 0xF6, 0xC5, 0xD4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x05, 0x02, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x03, 0x84, 0x02, 0x03, 0x02, 0x03, 0x02, 0x03, 0x02, 0x03, 0x02, 0x03,
+    0x8E, 0x8F, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x02,
+};
+
+#define IMAGE_FILL    0xE5      ///< EEPROM content outside the legacy image
+
+static int fails = 0;
+
+static void check(int cond, const char *what, const char *module)
+{
+    if (!cond) {
+        printf("FAIL cfgMigrate %s (%s)\n", what, module);
+        fails++;
+    }
+}
+
+/**
+ * @brief Check whether the EEPROM range is cleared
+ */
+static int cleared(uint16_t addr, uint16_t len)
+{
+    while (len-- > 0) {
+        if (stub_eeprom[addr++] != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    static uint8_t before[STUB_EEPROM_LEN];
+    ketCube_coreCfg_t core;
+    ketCube_lora_moduleCfg_t lora;
+    uint16_t layout = 0;
+    uint16_t addr = KETCUBE_EEPROM_ALLOC_MODULES;
+    uint32_t writes;
+    uint8_t i, j;
+
+    memset(&(stub_eeprom[0]), IMAGE_FILL, sizeof(stub_eeprom));
+    memcpy(&(stub_eeprom[KETCUBE_EEPROM_ALLOC_MODULES]), &(legacyImage[0]), sizeof(legacyImage));
+
+    check(ketCube_modules_MigrateCfg() == KETCUBE_CFG_OK, "migration", "-");
+
+    memcpy(&layout, &(stub_eeprom[KETCUBE_EEPROM_ALLOC_MODULES + offsetof(ketCube_coreCfg_t, cfgLayout)]), sizeof(layout));
+    check(layout == KETCUBE_CORECFG_LAYOUT, "layout tag", "core");
+
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        const char *name = ketCube_modules_List[i].name;
+        uint8_t cfgLen = ketCube_modules_List[i].cfgLen;
+
+        for (j = 0; j < (sizeof(legacyIndex) / sizeof(legacyIndex[0])); j++) {
+            if (legacyIndex[j].id == ketCube_modules_List[i].id) {
+                break;
+            }
+        }
+
+        if (ketCube_modules_List[i].id == KETCUBE_MODULEID_CORE_API) {
+            memcpy(&core, &(stub_eeprom[addr]), sizeof(core));
+            check(sizeof(core) == cfgLen, "size", name);
+            check(memcmp(&core, &(legacyImage[legacyIndex[j].offset]), offsetof(ketCube_coreCfg_t, reportHeartbeat)) == 0, "kept fields", name);
+            check((core.basePeriod == 60000) && (core.startDelay == 5000) && (core.repeatDelay == 30000) && (core.coreCfg.enable == TRUE), "periods", name);
+            check(cleared(addr + offsetof(ketCube_coreCfg_t, reportHeartbeat), offsetof(ketCube_coreCfg_t, cfgLayout) - offsetof(ketCube_coreCfg_t, reportHeartbeat)), "new fields cleared", name);
+            check(cleared(addr + offsetof(ketCube_coreCfg_t, volatileData), sizeof(core.volatileData)), "volatile data cleared", name);
+        } else if (j == (sizeof(legacyIndex) / sizeof(legacyIndex[0]))) {
+            // module added after the legacy layout
+            check(cleared(addr, cfgLen), "new module cleared", name);
+        } else {
+            check(legacyIndex[j].len <= cfgLen, "size", name);
+            check(memcmp(&(stub_eeprom[addr]), &(legacyImage[legacyIndex[j].offset]), legacyIndex[j].len) == 0, "moved", name);
+            check(cleared(addr + legacyIndex[j].len, cfgLen - legacyIndex[j].len), "new fields cleared", name);
+        }
+
+        if (ketCube_modules_List[i].id == KETCUBE_MODULEID_LORA) {
+            memcpy(&lora, &(stub_eeprom[addr]), sizeof(lora));
+            check((lora.coreCfg.enable == TRUE) && (lora.cfg.connectionType == KETCUBE_LORA_SELCONNMETHOD_OTAA) && (lora.cfg.devEUIType == KETCUBE_LORA_SELDEVEUI_CUSTOM), "settings", name);
+            check((lora.devEUI[0] == 0xD0) && (lora.devEUI[KETCUBE_LORA_CFGLEN_DEVEUI - 1] == 0xD7) && (lora.appEUI[0] == 0x70), "EUIs", name);
+            check((lora.appKey[1] == (0x2B ^ 17)) && (lora.txDatarate == 5), "appKey, DR", name);
+            check((lora.batchSize == 0) && (lora.sfqPolicy == 0) && (lora.batchMaxDelay == 0), "new fields default", name);
+        }
+
+        addr += cfgLen;
+    }
+
+    for (i = 0; i < 16; i++) {
+        check(stub_eeprom[addr + i] == IMAGE_FILL, "no write beyond the configurations", "-");
+    }
+
+    /* migrated layout is kept */
+    memcpy(&(before[0]), &(stub_eeprom[0]), sizeof(before));
+    writes = stub_eepromWrites;
+    check(ketCube_modules_MigrateCfg() == KETCUBE_CFG_OK, "second migration", "-");
+    check((writes == stub_eepromWrites) && (memcmp(&(before[0]), &(stub_eeprom[0]), sizeof(before)) == 0), "second migration writes", "-");
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS cfgMigrate: %u B legacy image, %u B migrated\n", (unsigned) sizeof(legacyImage), (unsigned) (addr - KETCUBE_EEPROM_ALLOC_MODULES));
+
+    return 0;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file    test_dataLog.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the data logger: fill, wrap, power loss and range retrieval
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_coreCfg.h"
+#include "ketCube_dataLog.h"
+#include "stub.h"
+
+#define REF_LEN   40000     ///< Max. # of appended records
+
+/**
+* @brief Appended records
+*/
+static uint8_t refRecord[REF_LEN][KETCUBE_DATALOG_MAX_RECORD_LEN];
+static uint8_t refLen[REF_LEN];
+static uint32_t refTime[REF_LEN];
+static int refCnt = 0;
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL dataLog %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/**
+ * @brief Sensor-like record: temperature, humidity, counter and noise
+ */
+static uint8_t makeRecord(uint8_t * record)
+{
+    static int16_t temp = 200;
+    static uint8_t hum = 50;
+    static uint32_t counter = 1000;
+    uint8_t len = 8;
+    uint8_t i;
+
+    temp += rand() % 5 - 2;
+    hum += rand() % 3 - 1;
+    counter += 300 + rand() % 3;
+
+    record[0] = temp >> 8;
+    record[1] = temp;
+    record[2] = hum;
+    record[3] = counter >> 24;
+    record[4] = counter >> 16;
+    record[5] = counter >> 8;
+    record[6] = counter;
+    record[7] = rand();
+    if ((rand() % 20) == 0) {
+        len = 5;
+    } else if ((rand() % 50) == 0) {
+        /* the entry must fit into an empty block */
+        len = 16 + rand() % 24;
+        for (i = 8; i < len; i++) {
+            record[i] = rand();
+        }
+    }
+
+    return len;
+}
+
+static bool append(int step)
+{
+    uint8_t record[KETCUBE_DATALOG_MAX_RECORD_LEN];
+    uint8_t len = makeRecord(&(record[0]));
+    uint32_t now = ketCube_dataLog_Now();
+
+    if (ketCube_dataLog_Append(&(record[0]), len) != KETCUBE_CFG_MODULE_OK) {
+        return FALSE;
+    }
+    check(refCnt < REF_LEN, "reference full", step);
+    memcpy(&(refRecord[refCnt][0]), &(record[0]), len);
+    refLen[refCnt] = len;
+    refTime[refCnt] = now;
+    refCnt++;
+
+    return TRUE;
+}
+
+/**
+ * @brief Records in [from, to] must be the newest appended records in the range, in order
+ *
+ * @retval # of records read
+ */
+static int checkRange(uint32_t from, uint32_t to, int step)
+{
+    ketCube_dataLog_cursor_t cur;
+    uint8_t record[KETCUBE_DATALOG_MAX_RECORD_LEN];
+    uint8_t len;
+    uint32_t time;
+    int first = -1;
+    int last = -1;
+    int i, j;
+
+    for (i = 0; i < refCnt; i++) {
+        if ((refTime[i] >= from) && (refTime[i] <= to)) {
+            last = i;
+        }
+    }
+
+    ketCube_dataLog_Seek(&cur, from);
+    j = -1;
+    while (ketCube_dataLog_Read(&cur, &(record[0]), &len, &time) == KETCUBE_CFG_MODULE_OK) {
+        if (time < from) {
+            continue;
+        }
+        if (time > to) {
+            break;
+        }
+        if (j < 0) {
+            /* the oldest records may be overwritten: find the first one read */
+            for (j = 0; j < refCnt; j++) {
+                if ((refTime[j] == time) && (refLen[j] == len)
+                    && (memcmp(&(refRecord[j][0]), &(record[0]), len) == 0)) {
+                    break;
+                }
+            }
+            first = j;
+        } else {
+            j++;
+        }
+        check((j < refCnt) && (refTime[j] == time) && (refLen[j] == len)
+              && (memcmp(&(refRecord[j][0]), &(record[0]), len) == 0),
+              "record content", step);
+    }
+
+    check(j == last, "range end", step);
+
+    return (first < 0) ? 0 : (last - first + 1);
+}
+
+int main(void)
+{
+    uint8_t fields[KETCUBE_DATALOG_MAX_FIELDS] = { 0x1A, 0x11, 0x24, 0 };
+    uint8_t record[KETCUBE_DATALOG_MAX_RECORD_LEN];
+    int retained, maxRetained = 0;
+    int i;
+
+    srand(1);
+    memcpy(&(ketCube_coreCfg.logFields[0]), &(fields[0]), sizeof(fields));
+    ketCube_dataLog_Init();
+    check(ketCube_dataLog_Count() == 0, "empty log count", 0);
+    check(checkRange(0, 0xFFFFFFFF, 0) == 0, "empty log read", 0);
+
+    for (i = 0; i < 30000; i++) {
+        stub_time += 1 + rand() % 600;
+
+        if ((rand() % 300) == 0) {
+            /* power loss during one of the next EEPROM writes */
+            stub_eepromFailAt = stub_eepromWrites + rand() % 3;
+        }
+        if (append(i) == FALSE) {
+            check(stub_eepromFailAt >= 0, "append", i);
+        }
+        if ((int32_t) stub_eepromWrites > stub_eepromFailAt) {
+            if (stub_eepromFailAt >= 0) {
+                stub_eepromFailAt = -1;
+                if ((rand() % 2) == 0) {
+                    stub_time = rand() % 10;
+                    ketCube_dataLog_Init();
+                }
+            }
+        }
+
+        if ((rand() % 100) == 0) {
+            /* reset: the RTC restarts, the log clock continues */
+            stub_time = rand() % 10;
+            ketCube_dataLog_Init();
+            check(ketCube_dataLog_Now() == refTime[refCnt - 1], "log clock after reset", i);
+        }
+
+        if ((i % 97) == 0) {
+            retained = checkRange(0, 0xFFFFFFFF, i);
+            check(retained == ketCube_dataLog_Count(), "count", i);
+            if (retained > maxRetained) {
+                maxRetained = retained;
+            }
+            checkRange(refTime[refCnt - 1] - rand() % 100000, refTime[refCnt - 1] - rand() % 20000, i);
+        }
+    }
+
+    /* the log wrapped several times and kept close to its capacity */
+    check((refCnt / maxRetained) > 5, "wrap", 0);
+    check(maxRetained > ((KETCUBE_DATALOG_BLOCKS - 1) * KETCUBE_DATALOG_DATA_LEN / 16), "capacity", 0);
+
+    memset(&(record[0]), 0, sizeof(record));
+    check(ketCube_dataLog_Append(&(record[0]), KETCUBE_DATALOG_MAX_RECORD_LEN) == KETCUBE_CFG_MODULE_ERROR, "oversized record", 0);
+    check(checkRange(0, 0xFFFFFFFF, 0) == ketCube_dataLog_Count(), "count after oversized record", 0);
+
+    ketCube_dataLog_Clear();
+    check(ketCube_dataLog_Count() == 0, "clear", 0);
+    memset(&(record[0]), 1, 8);
+    check(ketCube_dataLog_Append(&(record[0]), 8) == KETCUBE_CFG_MODULE_OK, "append after clear", 0);
+    check(ketCube_dataLog_Count() == 1, "count after clear", 0);
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS dataLog: %d records appended, max. %d records retained\n", refCnt, maxRetained);
+
+    return 0;
+}
@@ -0,0 +1,401 @@
+/**
+ * @file    test_delay.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host simulation of the low-power delay: timing and run-current budget of driver waits
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * ketCube_delay runs on a simulated MCU: a microsecond clock drives the
+ * RTC timer (1024 ticks/s) and the wake-up timer (RTCCLK/16, the period
+ * is truncated as by the hardware counter). Code running between the
+ * low-power waits, incl. each poll of the RTC timer, is charged at the run
+ * current; ketCube_MCU_WaitForIrq() jumps to the next IRQ (wake-up timer
+ * or a terminal byte) at the low-power mode current plus the exit cost.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ketCube_delay.h"
+#include "ketCube_mcu.h"
+#include "ketCube_rtc.h"
+
+#define SIM_RUN_UA              4500.0  ///< Run mode, 32 MHz
+#define SIM_SLEEP_UA            1100.0  ///< Sleep mode, 32 MHz, peripherals gated
+#define SIM_STOP_UA             1.3     ///< Stop mode, RTC on LSE
+#define SIM_STOP_EXIT_US        150     ///< Stop mode exit: clock switch and drivers (run current)
+#define SIM_SLEEP_EXIT_US       10      ///< Sleep mode exit (run current)
+#define SIM_POLL_US             2       ///< One RTC timer poll (run current)
+#define SIM_IRQ_US              20      ///< Terminal byte IRQ (run current)
+
+#define SIM_WUT_HZ              2048    ///< Wake-up timer clock: LSE / 16
+#define SIM_DELAY_TOL_MS        3.5     ///< Max. delay extension: rounding up to RTC ticks, the partial start tick and the WUT in ms
+#define SIM_BUDGET_UAS          20.0    ///< Run-current budget of the driver waits of a period in stop mode
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL delay %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulated MCU                                                          */
+/* ---------------------------------------------------------------------- */
+
+uint32_t stub_primask = 0;
+uint32_t stub_ipsr = 0;
+
+static struct {
+    uint64_t us;                /*!< time */
+    double uAs;                 /*!< charge */
+    bool sleepEnabled;
+    ketCube_mcu_LPMode_t mode;
+    bool wutRunning;
+    bool wutElapsed;
+    uint64_t wutDeadline;
+    uint64_t nextByte;          /*!< next terminal byte; 0 = none */
+    uint32_t byteGapUs;         /*!< max. gap of terminal bytes; 0 = no terminal */
+    uint32_t bytes;             /*!< serviced terminal bytes */
+    uint32_t waits;             /*!< low-power mode entries */
+    bool disableSleepOnIrq;     /*!< the next IRQ disables low-power modes (timeServer alarm close) */
+    volatile bool *flag;        /*!< set by the IRQ at flagUs */
+    uint64_t flagUs;
+} mcu;
+
+static void run(uint32_t us)
+{
+    mcu.us += us;
+    mcu.uAs += SIM_RUN_UA * us / 1e6;
+}
+
+static void scheduleByte(void)
+{
+    mcu.nextByte = (mcu.byteGapUs == 0) ? 0 : mcu.us + 1 + rand() % mcu.byteGapUs;
+}
+
+/**
+ * @brief Service IRQs pending at the current time
+ */
+static void serviceIrqs(void)
+{
+    if ((mcu.nextByte != 0) && (mcu.us >= mcu.nextByte)) {
+        mcu.bytes++;
+        run(SIM_IRQ_US);
+        scheduleByte();
+        if (mcu.disableSleepOnIrq) {
+            mcu.sleepEnabled = FALSE;
+            mcu.disableSleepOnIrq = FALSE;
+        }
+    }
+    if ((mcu.flag != NULL) && (mcu.us >= mcu.flagUs)) {
+        *(mcu.flag) = TRUE;
+        mcu.flag = NULL;
+        run(SIM_IRQ_US);
+    }
+    if (mcu.wutRunning && (mcu.us >= mcu.wutDeadline)) {
+        mcu.wutRunning = FALSE;
+        mcu.wutElapsed = TRUE;
+    }
+}
+
+bool ketCube_MCU_IsSleepEnabled(void)
+{
+    return mcu.sleepEnabled;
+}
+
+void ketCube_MCU_WaitForIrq(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    check(stub_primask != 0, "low-power mode entered with IRQs enabled", mcu.waits);
+    mcu.waits++;
+
+    if (mcu.wutRunning) {
+        next = mcu.wutDeadline;
+    }
+    if ((mcu.nextByte != 0) && (mcu.nextByte < next)) {
+        next = mcu.nextByte;
+    }
+    if ((mcu.flag != NULL) && (mcu.flagUs < next)) {
+        next = mcu.flagUs;
+    }
+    if (next == UINT64_MAX) {
+        printf("FAIL delay low-power mode without a wake-up source\n");
+        exit(1);
+    }
+
+    if (next > mcu.us) {
+        mcu.uAs += ((mcu.mode == KETCUBE_MCU_LPMODE_SLEEP) ? SIM_SLEEP_UA : SIM_STOP_UA) * (next - mcu.us) / 1e6;
+        mcu.us = next;
+    }
+    run((mcu.mode == KETCUBE_MCU_LPMODE_SLEEP) ? SIM_SLEEP_EXIT_US : SIM_STOP_EXIT_US);
+
+    /* serviced when the caller restores PRIMASK */
+    serviceIrqs();
+}
+
+uint32_t ketCube_RTC_GetTimerValue(void)
+{
+    run(SIM_POLL_US);
+    if (stub_primask == 0) {
+        serviceIrqs();
+    }
+
+    return (uint32_t) ((mcu.us * 1024) / 1000000);
+}
+
+uint32_t ketCube_RTC_ms2Tick(TimerTime_t timeMicroSec)
+{
+    return (uint32_t) ((((uint64_t) timeMicroSec) * 1024) / 1000);
+}
+
+TimerTime_t ketCube_RTC_Tick2ms(uint32_t tick)
+{
+    return (TimerTime_t) ((((uint64_t) tick) * 1000) / 1024);
+}
+
+void ketCube_RTC_DelayMs(uint32_t delay)
+{
+    uint32_t start = ketCube_RTC_GetTimerValue();
+
+    while ((ketCube_RTC_GetTimerValue() - start) < ketCube_RTC_ms2Tick(delay));
+}
+
+void ketCube_RTC_StartWakeUpTimer(uint32_t delay)
+{
+    uint32_t counter;
+
+    if (delay > KETCUBE_RTC_WUT_MAX_MS) {
+        delay = KETCUBE_RTC_WUT_MAX_MS;
+    }
+    counter = (delay * SIM_WUT_HZ) / 1000;
+    if (counter > 0) {
+        counter--;
+    }
+
+    mcu.wutRunning = TRUE;
+    mcu.wutElapsed = FALSE;
+    mcu.wutDeadline = mcu.us + (((uint64_t) counter + 1) * 1000000) / SIM_WUT_HZ;
+}
+
+void ketCube_RTC_StopWakeUpTimer(void)
+{
+    mcu.wutRunning = FALSE;
+}
+
+bool ketCube_RTC_IsWakeUpTimerElapsed(void)
+{
+    return mcu.wutElapsed;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Tests                                                                  */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Wait result
+*/
+typedef struct {
+    double ms;                  /*!< duration */
+    double uAs;                 /*!< charge */
+    uint32_t waits;             /*!< low-power mode entries */
+} waitResult_t;
+
+static waitResult_t measure(uint32_t delay)
+{
+    uint64_t us = mcu.us;
+    double uAs = mcu.uAs;
+    uint32_t waits = mcu.waits;
+
+    ketCube_delay_LowPower(delay);
+
+    return (waitResult_t) { (mcu.us - us) / 1000.0, mcu.uAs - uAs, mcu.waits - waits };
+}
+
+/**
+ * @brief The delay is kept with terminal bytes arriving during it
+ */
+static void testTiming(void)
+{
+    static const uint32_t delays[] = { 2, 3, 5, 10, 50, 100, 1000, 45000 };
+    waitResult_t r;
+    int i, k;
+
+    for (k = 0; k < 3; k++) {
+        mcu.mode = (k == 2) ? KETCUBE_MCU_LPMODE_SLEEP : KETCUBE_MCU_LPMODE_STOP;
+        mcu.byteGapUs = (k == 0) ? 0 : 4000;
+        scheduleByte();
+        for (i = 0; i < (sizeof(delays) / sizeof(delays[0])); i++) {
+            r = measure(delays[i]);
+            check((r.ms >= delays[i]) && (r.ms < delays[i] + SIM_DELAY_TOL_MS), "delay", 10 * k + i);
+            check(r.waits > 0, "low-power mode", 10 * k + i);
+            check(!mcu.wutRunning, "wake-up timer stopped", 10 * k + i);
+        }
+    }
+    check(mcu.bytes > 0, "terminal bytes serviced", 0);
+    mcu.byteGapUs = 0;
+    scheduleByte();
+}
+
+/**
+ * @brief Short delays, IRQ context, critical sections and disabled low-power modes busy-wait
+ */
+static void testBusy(void)
+{
+    waitResult_t r;
+
+    mcu.mode = KETCUBE_MCU_LPMODE_STOP;
+
+    r = measure(KETCUBE_DELAY_LP_MIN_MS - 1);
+    check((r.waits == 0) && (r.ms >= KETCUBE_DELAY_LP_MIN_MS - 1), "short delay", 0);
+
+    stub_ipsr = 16 + 5;
+    r = measure(10);
+    check((r.waits == 0) && (r.ms >= 10), "IRQ context", 0);
+    stub_ipsr = 0;
+
+    stub_primask = 1;
+    r = measure(10);
+    check((r.waits == 0) && (r.ms >= 10), "critical section", 0);
+    stub_primask = 0;
+
+    mcu.sleepEnabled = FALSE;
+    r = measure(10);
+    check((r.waits == 0) && (r.ms >= 10), "low-power modes disabled", 0);
+    mcu.sleepEnabled = TRUE;
+
+    /* disabled by an IRQ during the wait: the rest is busy-waited */
+    mcu.byteGapUs = 3000;
+    scheduleByte();
+    mcu.disableSleepOnIrq = TRUE;
+    r = measure(20);
+    check((r.waits == 1) && (r.ms >= 20) && (r.ms < 20 + SIM_DELAY_TOL_MS), "low-power modes disabled during the wait", 0);
+    check(!mcu.wutRunning, "wake-up timer stopped", 0);
+    mcu.sleepEnabled = TRUE;
+    mcu.byteGapUs = 0;
+    scheduleByte();
+}
+
+/**
+ * @brief The wait for an IRQ-signalled event ends with the event
+ */
+static void testUntil(void)
+{
+    volatile bool flag = FALSE;
+    uint64_t us;
+
+    mcu.mode = KETCUBE_MCU_LPMODE_STOP;
+
+    mcu.flag = &flag;
+    mcu.flagUs = mcu.us + 5300;
+    us = mcu.us;
+    check(ketCube_delay_LowPowerUntil(100, &flag) == TRUE, "event", 0);
+    check((mcu.us - us >= 5300) && (mcu.us - us < 5300 + SIM_STOP_EXIT_US + 100), "wait ended by the event", 0);
+    check(!mcu.wutRunning, "wake-up timer stopped", 0);
+
+    flag = FALSE;
+    us = mcu.us;
+    check(ketCube_delay_LowPowerUntil(30, &flag) == FALSE, "timeout", 0);
+    check((mcu.us - us >= 30000) && (mcu.us - us < 30000 + 1000 * SIM_DELAY_TOL_MS), "timeout length", 0);
+
+    /* event before the wait */
+    flag = TRUE;
+    us = mcu.us;
+    check(ketCube_delay_LowPowerUntil(30, &flag) == TRUE, "event already signalled", 0);
+    check(mcu.us - us < 1000, "no wait", 0);
+}
+
+/**
+ * @brief Charge of the fixed driver waits of a sensing period
+ */
+static void testBudget(void)
+{
+    /* TI register read, HDC1080 and HDC2080 conversion, BME280 forced measurement, starNet TX retry */
+    static const uint32_t waits[] = { 50, 10, 2, 10, 10 };
+    static const ketCube_mcu_LPMode_t modes[] = { KETCUBE_MCU_LPMODE_SLEEP, KETCUBE_MCU_LPMODE_STOP };
+    double busy = 0, uAs[2], ms = 0;
+    waitResult_t r;
+    int i, m;
+
+    for (i = 0; i < (sizeof(waits) / sizeof(waits[0])); i++) {
+        busy += SIM_RUN_UA * waits[i] / 1000.0;
+    }
+
+    for (m = 0; m < 2; m++) {
+        mcu.mode = modes[m];
+        uAs[m] = 0;
+        for (i = 0; i < (sizeof(waits) / sizeof(waits[0])); i++) {
+            r = measure(waits[i]);
+            uAs[m] += r.uAs;
+            ms += (m == 0) ? r.ms : 0;
+        }
+    }
+
+    printf("  driver waits of a period (%.1f ms): busy %.1f uAs, sleep %.1f uAs, stop %.1f uAs\n",
+           ms, busy, uAs[0], uAs[1]);
+    check(uAs[0] < 0.35 * busy, "sleep mode charge", 0);
+    check(uAs[1] < SIM_BUDGET_UAS, "stop mode run-current budget", 0);
+}
+
+int main(void)
+{
+    srand(27);
+    mcu.sleepEnabled = TRUE;
+    mcu.us = 1000000;
+
+    testTiming();
+    testBusy();
+    testUntil();
+    testBudget();
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS delay: %u low-power mode entries, %u terminal bytes\n", mcu.waits, mcu.bytes);
+
+    return 0;
+}
@@ -0,0 +1,594 @@
+/**
+ * @file    test_i2c_busClear.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the I2C driver recovery: stuck slave, bus clear and poll set
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * The driver runs on a simulated bus: SCL and SDA are wired-AND of the
+ * master (GPIO or the I2C peripheral) and of a slave, which may be stuck
+ * in the middle of a transmitted byte or latched up. The HAL transactions
+ * fail as on the target when the bus is held or the slave does not
+ * respond; queued transactions complete in stub_wfi() as in IRQ context.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_i2c.h"
+#include "ketCube_gpio.h"
+#include "ketCube_mainBoard.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_terminal.h"
+
+#define SLAVE_ADDR      (0x76 << 1)
+#define ABSENT_ADDR     (0x19 << 1)
+
+extern I2C_HandleTypeDef KETCUBE_I2C_Handle;
+
+static I2C_TypeDef i2cRegs;     ///< I2C1 registers
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL i2c_busClear %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Bus and slave model                                                    */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Simulated bus
+*/
+static struct {
+    bool gpioMode;      /*!< SCL/SDA driven as GPIO (bus clear), else by the peripheral */
+    bool sclOut;        /*!< master SCL output (open drain) */
+    bool sdaOut;        /*!< master SDA output (open drain) */
+    bool inIrq;         /*!< executing stub_wfi() */
+    int clocks;         /*!< SCL pulses of the running bus clear */
+    int maxClocks;      /*!< max. SCL pulses of a bus clear */
+    int busClears;      /*!< # of bus clear sequences */
+    int stops;          /*!< # of STOP conditions seen */
+    int halCalls;       /*!< # of started HAL transactions */
+    int errorMsgs;      /*!< # of error messages of the driver */
+} bus;
+
+/**
+* @brief Simulated slave
+*/
+static struct {
+    bool transmitting;  /*!< the slave shifts out txByte */
+    bool latched;       /*!< the slave holds SDA low regardless of SCL */
+    bool nacked;        /*!< the master did not acknowledge the byte */
+    uint8_t txByte;
+    uint8_t bit;        /*!< 0 ... 7: data bit, 8: acknowledge */
+    uint8_t glitchBits; /*!< > 0: the next transaction leaves the slave after glitchBits - 1 bits */
+} slave;
+
+static bool slaveSdaLow(void)
+{
+    if (slave.latched) {
+        return TRUE;
+    }
+
+    return (slave.transmitting && (slave.bit < 8)
+            && ((slave.txByte & (0x80 >> slave.bit)) == 0));
+}
+
+static bool sdaLine(void)
+{
+    return (bus.sdaOut && !slaveSdaLow());
+}
+
+static void sclEdge(bool rising)
+{
+    if (rising) {
+        bus.clocks++;
+        if (slave.transmitting && (slave.bit == 8)) {
+            /* the master acknowledges by SDA low */
+            slave.nacked = bus.sdaOut;
+        }
+    } else if (slave.transmitting) {
+        slave.bit++;
+        if (slave.bit > 8) {
+            slave.bit = 0;
+            slave.transmitting = !slave.nacked;
+        }
+    }
+}
+
+/**
+ * @brief Blocking or queued transaction on the bus
+ */
+static HAL_StatusTypeDef busXfer(I2C_HandleTypeDef * hi2c, uint16_t addr)
+{
+    bus.halCalls++;
+    check(hi2c == &KETCUBE_I2C_Handle, "I2C handle", 0);
+    check(!bus.gpioMode && ((i2cRegs.CR1 & I2C_CR1_PE) != 0), "transaction without the peripheral", bus.halCalls);
+
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    if (slaveSdaLow() || slave.transmitting) {
+        /* BUSY flag stays set */
+        return HAL_TIMEOUT;
+    }
+    if (addr != SLAVE_ADDR) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        return HAL_ERROR;
+    }
+    if (slave.glitchBits > 0) {
+        /* misplaced START/STOP: the slave keeps shifting out its byte */
+        slave.transmitting = TRUE;
+        slave.nacked = FALSE;
+        slave.bit = slave.glitchBits - 1;
+        slave.glitchBits = 0;
+        hi2c->ErrorCode = HAL_I2C_ERROR_BERR;
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/* ---------------------------------------------------------------------- */
+/* HAL stubs                                                              */
+/* ---------------------------------------------------------------------- */
+
+static struct {
+    bool active;
+    bool memRead;
+    uint16_t addr;
+} pending;      ///< Queued transaction in progress
+
+uint32_t stub_primask = 0;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef * hi2c)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef * hi2c)
+{
+    return HAL_OK;
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef * hi2c)
+{
+    /* the peripheral is set up by main(), ketCube_I2C_Init() only registers the driver */
+    return HAL_I2C_STATE_READY;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef * hi2c)
+{
+    return hi2c->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return busXfer(hi2c, DevAddress);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return busXfer(hi2c, DevAddress);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                          uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return busXfer(hi2c, DevAddress);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                         uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return busXfer(hi2c, DevAddress);
+}
+
+static HAL_StatusTypeDef queueXfer(uint16_t addr, bool memRead)
+{
+    check(!pending.active, "queued transaction started twice", 0);
+    pending.active = TRUE;
+    pending.memRead = memRead;
+    pending.addr = addr;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t * pData, uint16_t Size)
+{
+    return queueXfer(DevAddress, TRUE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t * pData, uint16_t Size)
+{
+    return queueXfer(DevAddress, TRUE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t * pData, uint16_t Size)
+{
+    return queueXfer(DevAddress, FALSE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                            uint8_t * pData, uint16_t Size)
+{
+    return queueXfer(DevAddress, FALSE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                             uint8_t * pData, uint16_t Size)
+{
+    return queueXfer(DevAddress, FALSE);
+}
+
+/**
+ * @brief Core sleep: the I2C IRQ completes the queued transaction
+ */
+void stub_wfi(void)
+{
+    HAL_StatusTypeDef status;
+
+    if (!pending.active) {
+        printf("FAIL i2c_busClear core sleep without a pending transaction\n");
+        exit(1);
+    }
+
+    bus.inIrq = TRUE;
+    pending.active = FALSE;
+    status = busXfer(&KETCUBE_I2C_Handle, pending.addr);
+    if (status == HAL_OK) {
+        if (pending.memRead) {
+            HAL_I2C_MemRxCpltCallback(&KETCUBE_I2C_Handle);
+        } else {
+            HAL_I2C_MasterTxCpltCallback(&KETCUBE_I2C_Handle);
+        }
+    } else {
+        if (status == HAL_TIMEOUT) {
+            KETCUBE_I2C_Handle.ErrorCode = HAL_I2C_ERROR_TIMEOUT;
+        }
+        HAL_I2C_ErrorCallback(&KETCUBE_I2C_Handle);
+    }
+    bus.inIrq = FALSE;
+}
+
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef * hi2c)
+{
+}
+
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef * hi2c)
+{
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef * hdma)
+{
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+}
+
+/* ---------------------------------------------------------------------- */
+/* KETCube stubs                                                          */
+/* ---------------------------------------------------------------------- */
+
+volatile uint8_t ketCube_pwrMan_activeMask = 0xFF;
+
+void ketCube_pwrMan_Register(ketCube_pwrMan_periph_t periph,
+                             ketCube_pwrMan_fn_t fnAcquire,
+                             ketCube_pwrMan_fn_t fnRelease)
+{
+}
+
+void ketCube_pwrMan_UnRegister(ketCube_pwrMan_periph_t periph)
+{
+}
+
+void ketCube_pwrMan_Restore(ketCube_pwrMan_periph_t periph)
+{
+}
+
+void ketCube_pwrMan_SetBusy(ketCube_pwrMan_periph_t periph, bool busy)
+{
+}
+
+void ketCube_delay_LowPower(uint32_t delay)
+{
+}
+
+void ketCube_terminal_DriverSeverityPrintln(const char *drvName, ketCube_severity_t msgSeverity,
+                                            char *format, ...)
+{
+    if (msgSeverity == KETCUBE_CFG_SEVERITY_ERROR) {
+        bus.errorMsgs++;
+    }
+}
+
+static char termOut[1024];      ///< ketCube_terminal_UsartPrint() output
+
+void ketCube_terminal_UsartPrint(char *format, ...)
+{
+    size_t len = strlen(termOut);
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(&(termOut[len]), sizeof(termOut) - len, format, args);
+    va_end(args);
+}
+
+static bool isBusPin(ketCube_gpio_port_t port, uint16_t pin)
+{
+    return (port == KETCUBE_MAIN_BOARD_PIN_SCL_PORT)
+        && ((pin == KETCUBE_MAIN_BOARD_PIN_SCL_PIN) || (pin == KETCUBE_MAIN_BOARD_PIN_SDA_PIN));
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_Init(ketCube_gpio_port_t port, uint16_t pin,
+                                         GPIO_InitTypeDef * initStruct)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_ReInit(ketCube_gpio_port_t port, uint16_t pin,
+                                           GPIO_InitTypeDef * initStruct)
+{
+    bool gpioMode = (initStruct->Mode == GPIO_MODE_OUTPUT_OD);
+
+    check(isBusPin(port, pin), "GPIO pin", 0);
+    check(!bus.inIrq, "bus clear in IRQ context", 0);
+    check(gpioMode || ((initStruct->Mode == GPIO_MODE_AF_OD) && (initStruct->Alternate == GPIO_AF4_I2C1)),
+          "bus pin mode", 0);
+    check((i2cRegs.CR1 & I2C_CR1_PE) == 0, "pin mode changed with the peripheral enabled", 0);
+
+    /* both pins switch together, SDA last */
+    if (pin == KETCUBE_MAIN_BOARD_PIN_SDA_PIN) {
+        if (gpioMode && !bus.gpioMode) {
+            bus.busClears++;
+            bus.clocks = 0;
+        } else if (!gpioMode && bus.gpioMode && (bus.clocks > bus.maxClocks)) {
+            bus.maxClocks = bus.clocks;
+        }
+        bus.gpioMode = gpioMode;
+    }
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_Release(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+void ketCube_GPIO_Write(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin, bool bit)
+{
+    bool sda;
+
+    check(isBusPin(port, pin), "GPIO pin", 0);
+    check(!bus.inIrq, "bus clear in IRQ context", 0);
+
+    if (pin == KETCUBE_MAIN_BOARD_PIN_SCL_PIN) {
+        if (bit != bus.sclOut) {
+            bus.sclOut = bit;
+            sclEdge(bit);
+        }
+    } else {
+        sda = sdaLine();
+        bus.sdaOut = bit;
+        if (bus.sclOut && (sda != sdaLine())) {
+            /* START or STOP resets the slave */
+            bus.stops += sdaLine() ? 1 : 0;
+            slave.transmitting = FALSE;
+        }
+    }
+}
+
+bool ketCube_GPIO_Read(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin)
+{
+    check(bus.gpioMode, "bus line read in peripheral mode", 0);
+
+    return (pin == KETCUBE_MAIN_BOARD_PIN_SDA_PIN) ? sdaLine() : bus.sclOut;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Tests                                                                  */
+/* ---------------------------------------------------------------------- */
+
+/**
+ * @brief Slave stuck after any number of bits of any byte is freed by the bus clear
+ */
+static void testStuckSlave(void)
+{
+    uint8_t buf[2];
+    int byte, bits, step = 0;
+    int clears, stops;
+
+    for (byte = 0; byte < 256; byte++) {
+        for (bits = 0; bits < 8; bits++, step++) {
+            slave.txByte = byte;
+            slave.glitchBits = bits + 1;
+            clears = bus.busClears;
+            stops = bus.stops;
+
+            check(ketCube_I2C_ReadData(SLAVE_ADDR, 0xD0, &(buf[0]), 1) == KETCUBE_CFG_DRV_ERROR, "bus error", step);
+            check(bus.busClears == clears + 1, "bus clear after bus error", step);
+            check(bus.stops == stops + 1, "STOP after bus clear", step);
+            check(!slave.transmitting && sdaLine(), "slave released", step);
+            check((i2cRegs.CR1 & I2C_CR1_PE) != 0, "peripheral enabled after bus clear", step);
+            check(ketCube_I2C_ReadData(SLAVE_ADDR, 0xD0, &(buf[0]), 2) == KETCUBE_CFG_DRV_OK, "access after bus clear", step);
+        }
+    }
+    check(bus.maxClocks <= KETCUBE_I2C_BUS_CLEAR_CLOCKS, "bus clear clocks", bus.maxClocks);
+    check(bus.errorMsgs == 0, "bus clear failure reported", bus.errorMsgs);
+}
+
+/**
+ * @brief NACK is a device error: no bus clear
+ */
+static void testNack(void)
+{
+    uint8_t buf[1];
+    int clears = bus.busClears;
+
+    check(ketCube_I2C_ReadData(ABSENT_ADDR, 0x0F, &(buf[0]), 1) == KETCUBE_CFG_DRV_ERROR, "NACK", 0);
+    check(ketCube_I2C_WriteRawData(ABSENT_ADDR, &(buf[0]), 1) == KETCUBE_CFG_DRV_ERROR, "NACK", 1);
+    check(bus.busClears == clears, "bus clear after NACK", 0);
+}
+
+/**
+ * @brief Latched-up slave: the device leaves the poll set and is re-probed
+ */
+static void testLatchedSlave(void)
+{
+    uint8_t buf[1];
+    int calls, i;
+
+    ketCube_I2C_ClearStats();
+    slave.latched = TRUE;
+
+    for (i = 0; i < KETCUBE_I2C_DEV_MAX_FAILS; i++) {
+        calls = bus.halCalls;
+        check(ketCube_I2C_ReadData(SLAVE_ADDR, 0xD0, &(buf[0]), 1) == KETCUBE_CFG_DRV_ERROR, "latched slave", i);
+        check(bus.halCalls == calls + 1, "access before removal", i);
+    }
+    check(bus.errorMsgs == KETCUBE_I2C_DEV_MAX_FAILS, "bus clear failure reported", bus.errorMsgs);
+
+    /* removed: accesses fail without the bus, every n-th re-probes */
+    for (i = 1; i <= 2 * KETCUBE_I2C_DEV_REPROBE_CNT; i++) {
+        calls = bus.halCalls;
+        check(ketCube_I2C_ReadData(SLAVE_ADDR, 0xD0, &(buf[0]), 1) == KETCUBE_CFG_DRV_ERROR, "removed device", i);
+        check(bus.halCalls == calls + (((i % KETCUBE_I2C_DEV_REPROBE_CNT) == 0) ? 1 : 0), "removed device access", i);
+    }
+
+    termOut[0] = '\0';
+    ketCube_I2C_PrintStats();
+    check(strstr(termOut, "0x76: ok 0; NACK 0; timeout 10; error 0; skipped 32; removed from poll set") != NULL,
+          "statistics", 0);
+
+    /* recovered slave returns to the poll set on the next re-probe */
+    slave.latched = FALSE;
+    for (i = 1; i <= KETCUBE_I2C_DEV_REPROBE_CNT; i++) {
+        check(ketCube_I2C_ReadData(SLAVE_ADDR, 0xD0, &(buf[0]), 1)
+              == ((i == KETCUBE_I2C_DEV_REPROBE_CNT) ? KETCUBE_CFG_DRV_OK : KETCUBE_CFG_DRV_ERROR), "re-probe", i);
+    }
+    check(ketCube_I2C_ReadData(SLAVE_ADDR, 0xD0, &(buf[0]), 1) == KETCUBE_CFG_DRV_OK, "device back in poll set", 0);
+}
+
+/**
+ * @brief Queued transaction error: the bus is cleared by the next access, outside IRQ context
+ */
+static void testQueued(void)
+{
+    uint8_t buf[8];
+    uint16_t len;
+    int clears;
+
+    for (len = 1; len <= sizeof(buf); len++) {
+        slave.txByte = 0x00;
+        slave.glitchBits = 1 + len % 8;
+        clears = bus.busClears;
+
+        check(ketCube_I2C_ReadDataQueued(SLAVE_ADDR, 0xD0, &(buf[0]), len) == KETCUBE_CFG_DRV_ERROR, "queued bus error", len);
+        check((bus.busClears == clears) && slaveSdaLow(), "bus clear in IRQ context", len);
+
+        check(ketCube_I2C_ReadDataQueued(SLAVE_ADDR, 0xD0, &(buf[0]), len) == KETCUBE_CFG_DRV_OK, "queued access after bus error", len);
+        check(bus.busClears == clears + 1, "pending bus clear", len);
+        check(!ketCube_I2C_IsBusy(), "queue idle", len);
+    }
+}
+
+int main(void)
+{
+    /* I2C1 as after HAL_I2C_Init() */
+    KETCUBE_I2C_Handle.Instance = &i2cRegs;
+    KETCUBE_I2C_Handle.Init.Timing = KETCUBE_I2C_SPEED_100KHZ;
+    i2cRegs.TIMINGR = KETCUBE_I2C_SPEED_100KHZ;
+    i2cRegs.CR1 = I2C_CR1_PE;
+    bus.sclOut = TRUE;
+    bus.sdaOut = TRUE;
+
+    check(ketCube_I2C_Init() == KETCUBE_CFG_DRV_OK, "init", 0);
+
+    testStuckSlave();
+    testNack();
+    testLatchedSlave();
+    testQueued();
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS i2c_busClear: %d bus clears, max. %d clocks\n", bus.busClears, bus.maxClocks);
+
+    return 0;
+}
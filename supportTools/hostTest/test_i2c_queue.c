@@ -0,0 +1,790 @@
+/**
+ * @file    test_i2c_queue.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the I2C transaction queue: chaining, IRQ/DMA selection, bus speeds, full queue and timeout
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * The queued engine of the driver runs against virtual devices. The HAL
+ * _IT/_DMA functions only latch the transaction; stub_wfi() executes it
+ * as the I2C or DMA IRQ would: the device register file is read or written
+ * and the HAL callback is called, a NACK calls the error callback and a
+ * device holding SCL low sets the TIMEOUT flag, which the HAL ignores.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_i2c.h"
+#include "ketCube_gpio.h"
+#include "ketCube_mainBoard.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_terminal.h"
+
+#define DEV_A_ADDR      (0x76 << 1)
+#define DEV_B_ADDR      (0x1E << 1)
+#define STUCK_ADDR      (0x40 << 1)
+#define ABSENT_ADDR     (0x19 << 1)
+
+#define TRACE_LEN       64
+
+extern I2C_HandleTypeDef KETCUBE_I2C_Handle;
+
+static I2C_TypeDef i2cRegs;     ///< I2C1 registers
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL i2c_queue %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Virtual devices                                                        */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Virtual device: register file with auto-increment; the first byte of a raw write is the register pointer
+*/
+typedef struct {
+    uint8_t addr;
+    bool sclLow;        /*!< the device holds SCL low */
+    uint8_t reg;        /*!< register pointer of raw transactions */
+    uint8_t regs[256];
+} vDev_t;
+
+static vDev_t devs[] = {
+    {.addr = DEV_A_ADDR},
+    {.addr = DEV_B_ADDR},
+    {.addr = STUCK_ADDR},
+};
+
+static vDev_t *findDev(uint16_t addr)
+{
+    uint8_t i;
+
+    for (i = 0; i < (sizeof(devs) / sizeof(devs[0])); i++) {
+        if (devs[i].addr == addr) {
+            return &(devs[i]);
+        }
+    }
+
+    return NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+/* HAL stubs                                                              */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Latched HAL transaction
+*/
+typedef struct {
+    bool active;
+    bool dma;           /*!< started by a _DMA function */
+    bool mem;           /*!< register (Mem) transaction */
+    bool read;
+    uint16_t addr;
+    uint8_t reg;
+    uint8_t *pBuffer;
+    uint16_t size;
+    uint32_t timing;    /*!< TIMINGR at the start */
+} halXfer_t;
+
+static halXfer_t pending;               ///< Transaction in progress
+static halXfer_t trace[TRACE_LEN];      ///< Started transactions
+static int traceCnt = 0;
+
+static struct {
+    bool inIrq;         /*!< executing stub_wfi() */
+    int irqs;           /*!< # of executed IRQs */
+    int dmaAborts;      /*!< # of HAL_DMA_Abort() calls */
+    int busClears;      /*!< # of bus clear sequences */
+    int blocking;       /*!< # of blocking HAL calls */
+} sim;
+
+uint32_t stub_primask = 0;
+
+/**
+ * @brief Write-1-to-clear ICR: apply the driver writes to ISR
+ */
+static void applyIcr(void)
+{
+    i2cRegs.ISR &= ~(i2cRegs.ICR);
+    i2cRegs.ICR = 0;
+}
+
+static HAL_StatusTypeDef startXfer(I2C_HandleTypeDef * hi2c, uint16_t addr, bool mem, uint16_t reg,
+                                   bool read, uint8_t * pData, uint16_t size, bool dma)
+{
+    applyIcr();
+
+    check(hi2c == &KETCUBE_I2C_Handle, "I2C handle", traceCnt);
+    check(!pending.active, "transaction started twice", traceCnt);
+    check((i2cRegs.CR1 & I2C_CR1_PE) != 0, "transaction without the peripheral", traceCnt);
+    check((i2cRegs.ISR & I2C_ISR_TIMEOUT) == 0, "stale timeout flag", traceCnt);
+
+    if ((hi2c->State != HAL_I2C_STATE_READY) || (hi2c->Lock == HAL_LOCKED)) {
+        return HAL_BUSY;
+    }
+
+    pending = (halXfer_t) {
+        .active = TRUE,
+        .dma = dma,
+        .mem = mem,
+        .read = read,
+        .addr = addr,
+        .reg = (uint8_t) reg,
+        .pBuffer = pData,
+        .size = size,
+        .timing = i2cRegs.TIMINGR,
+    };
+    if (traceCnt < TRACE_LEN) {
+        trace[traceCnt] = pending;
+    }
+    traceCnt++;
+
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->State = read ? HAL_I2C_STATE_BUSY_RX : HAL_I2C_STATE_BUSY_TX;
+    hi2c->Mode = mem ? HAL_I2C_MODE_MEM : HAL_I2C_MODE_MASTER;
+    i2cRegs.CR1 |= I2C_CR1_ERRIE | I2C_CR1_NACKIE | (dma ? I2C_CR1_RXDMAEN : (I2C_CR1_TCIE | I2C_CR1_STOPIE));
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Execute the latched transaction on the device
+ */
+static void devXfer(halXfer_t * xfer, vDev_t * dev)
+{
+    uint16_t i = 0;
+
+    if (xfer->mem) {
+        dev->reg = xfer->reg;
+    } else if (!xfer->read && (xfer->size > 0)) {
+        dev->reg = xfer->pBuffer[0];
+        i = 1;
+    }
+    for (; i < xfer->size; i++, dev->reg++) {
+        if (xfer->read) {
+            xfer->pBuffer[i] = dev->regs[dev->reg];
+        } else {
+            dev->regs[dev->reg] = xfer->pBuffer[i];
+        }
+    }
+}
+
+static void xferDone(I2C_HandleTypeDef * hi2c, halXfer_t * xfer)
+{
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->Mode = HAL_I2C_MODE_NONE;
+    i2cRegs.CR1 &= ~(I2C_CR1_ERRIE | I2C_CR1_NACKIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_RXDMAEN);
+
+    if (xfer->mem) {
+        if (xfer->read) {
+            HAL_I2C_MemRxCpltCallback(hi2c);
+        } else {
+            HAL_I2C_MemTxCpltCallback(hi2c);
+        }
+    } else {
+        if (xfer->read) {
+            HAL_I2C_MasterRxCpltCallback(hi2c);
+        } else {
+            HAL_I2C_MasterTxCpltCallback(hi2c);
+        }
+    }
+}
+
+static halXfer_t irqXfer;       ///< Transaction executed by the IRQ
+
+/**
+ * @brief Core sleep: the I2C or DMA IRQ finishes the transaction
+ */
+void stub_wfi(void)
+{
+    vDev_t *dev;
+
+    if (!pending.active) {
+        printf("FAIL i2c_queue core sleep without a pending transaction\n");
+        exit(1);
+    }
+
+    sim.inIrq = TRUE;
+    sim.irqs++;
+    irqXfer = pending;
+    pending.active = FALSE;
+    dev = findDev(irqXfer.addr);
+
+    if ((dev != NULL) && dev->sclLow) {
+        /* TIMEOUTA elapsed */
+        i2cRegs.ISR |= I2C_ISR_TIMEOUT;
+        I2C1_IRQHandler();
+        applyIcr();
+        check((i2cRegs.ISR & I2C_ISR_TIMEOUT) == 0, "timeout flag cleared", sim.irqs);
+    } else if ((dev != NULL) && irqXfer.dma) {
+        devXfer(&irqXfer, dev);
+        DMA1_Channel2_3_IRQHandler();
+    } else {
+        if (dev != NULL) {
+            devXfer(&irqXfer, dev);
+        }
+        I2C1_IRQHandler();
+    }
+    sim.inIrq = FALSE;
+}
+
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef * hi2c)
+{
+    /* TIMEOUT is handled in SMBus mode only */
+    if ((i2cRegs.ISR & I2C_ISR_TIMEOUT) != 0) {
+        return;
+    }
+
+    if (findDev(irqXfer.addr) == NULL) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        hi2c->State = HAL_I2C_STATE_READY;
+        hi2c->Mode = HAL_I2C_MODE_NONE;
+        i2cRegs.CR1 &= ~(I2C_CR1_ERRIE | I2C_CR1_NACKIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_RXDMAEN);
+        HAL_I2C_ErrorCallback(hi2c);
+    } else {
+        xferDone(hi2c, &irqXfer);
+    }
+}
+
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef * hi2c)
+{
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef * hdma)
+{
+    check(irqXfer.dma && ((i2cRegs.CR1 & I2C_CR1_RXDMAEN) != 0), "DMA IRQ", sim.irqs);
+    xferDone(&KETCUBE_I2C_Handle, &irqXfer);
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef * hdma)
+{
+    check((i2cRegs.CR1 & I2C_CR1_RXDMAEN) == 0, "DMA request disabled before abort", sim.irqs);
+    sim.dmaAborts++;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t * pData, uint16_t Size)
+{
+    return startXfer(hi2c, DevAddress, TRUE, MemAddress, TRUE, pData, Size, FALSE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t * pData, uint16_t Size)
+{
+    return startXfer(hi2c, DevAddress, TRUE, MemAddress, TRUE, pData, Size, TRUE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t * pData, uint16_t Size)
+{
+    return startXfer(hi2c, DevAddress, TRUE, MemAddress, FALSE, pData, Size, FALSE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                            uint8_t * pData, uint16_t Size)
+{
+    return startXfer(hi2c, DevAddress, FALSE, 0, TRUE, pData, Size, FALSE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                             uint8_t * pData, uint16_t Size)
+{
+    return startXfer(hi2c, DevAddress, FALSE, 0, FALSE, pData, Size, FALSE);
+}
+
+static HAL_StatusTypeDef blockingXfer(void)
+{
+    sim.blocking++;
+
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return blockingXfer();
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef * hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return blockingXfer();
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                          uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return blockingXfer();
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef * hi2c, uint16_t DevAddress,
+                                         uint8_t * pData, uint16_t Size, uint32_t Timeout)
+{
+    return blockingXfer();
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef * hi2c)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef * hi2c)
+{
+    return HAL_OK;
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef * hi2c)
+{
+    /* the peripheral is set up by main(), ketCube_I2C_Init() only registers the driver */
+    return HAL_I2C_STATE_READY;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef * hi2c)
+{
+    return hi2c->ErrorCode;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+}
+
+/* ---------------------------------------------------------------------- */
+/* KETCube stubs                                                          */
+/* ---------------------------------------------------------------------- */
+
+volatile uint8_t ketCube_pwrMan_activeMask = 0xFF;
+
+void ketCube_pwrMan_Register(ketCube_pwrMan_periph_t periph,
+                             ketCube_pwrMan_fn_t fnAcquire,
+                             ketCube_pwrMan_fn_t fnRelease)
+{
+}
+
+void ketCube_pwrMan_UnRegister(ketCube_pwrMan_periph_t periph)
+{
+}
+
+void ketCube_pwrMan_Restore(ketCube_pwrMan_periph_t periph)
+{
+}
+
+void ketCube_pwrMan_SetBusy(ketCube_pwrMan_periph_t periph, bool busy)
+{
+}
+
+void ketCube_delay_LowPower(uint32_t delay)
+{
+}
+
+void ketCube_terminal_DriverSeverityPrintln(const char *drvName, ketCube_severity_t msgSeverity,
+                                            char *format, ...)
+{
+}
+
+static char termOut[1024];      ///< ketCube_terminal_UsartPrint() output
+
+void ketCube_terminal_UsartPrint(char *format, ...)
+{
+    size_t len = strlen(termOut);
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(&(termOut[len]), sizeof(termOut) - len, format, args);
+    va_end(args);
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_Init(ketCube_gpio_port_t port, uint16_t pin,
+                                         GPIO_InitTypeDef * initStruct)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_ReInit(ketCube_gpio_port_t port, uint16_t pin,
+                                           GPIO_InitTypeDef * initStruct)
+{
+    check(!sim.inIrq, "bus clear in IRQ context", sim.irqs);
+    if ((pin == KETCUBE_MAIN_BOARD_PIN_SDA_PIN) && (initStruct->Mode == GPIO_MODE_OUTPUT_OD)) {
+        sim.busClears++;
+    }
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_Release(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+void ketCube_GPIO_Write(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin, bool bit)
+{
+}
+
+bool ketCube_GPIO_Read(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin)
+{
+    /* SDA released */
+    return TRUE;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Tests                                                                  */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Completion log
+*/
+static struct {
+    int cnt;
+    int okCnt;
+    uint8_t order[TRACE_LEN];   /*!< transaction ids in completion order */
+    ketCube_cfg_DrvError_t result[TRACE_LEN];
+} done;
+
+static uint8_t xferId[TRACE_LEN];       ///< Callback contexts
+
+static void clearLog(void)
+{
+    memset(&done, 0, sizeof(done));
+    memset(&pending, 0, sizeof(pending));
+    traceCnt = 0;
+}
+
+static void logCb(ketCube_cfg_DrvError_t result, void *context)
+{
+    uint8_t id = *((uint8_t *) context);
+
+    check(sim.inIrq, "callback in IRQ context", id);
+    if (done.cnt < TRACE_LEN) {
+        done.order[done.cnt] = id;
+        done.result[done.cnt] = result;
+    }
+    done.cnt++;
+    done.okCnt += (result == KETCUBE_CFG_DRV_OK) ? 1 : 0;
+}
+
+static ketCube_cfg_DrvError_t submit(ketCube_I2C_XferType_t type, uint8_t addr, uint8_t reg,
+                                     uint8_t * pBuffer, uint16_t size, ketCube_I2C_XferCb_t fnCallback,
+                                     uint8_t id)
+{
+    ketCube_I2C_Xfer_t xfer = {
+        .type = type,
+        .addr = addr,
+        .reg = reg,
+        .pBuffer = pBuffer,
+        .size = size,
+        .fnCallback = fnCallback,
+        .context = &(xferId[id]),
+    };
+
+    return ketCube_I2C_Submit(&xfer);
+}
+
+static bool statsContain(const char *expected)
+{
+    termOut[0] = '\0';
+    ketCube_I2C_PrintStats();
+
+    return (strstr(termOut, expected) != NULL);
+}
+
+#define CHAIN_LEN       24
+#define CHAIN_DEPTH     3
+
+static uint8_t chainBuf[CHAIN_LEN][2];
+static int chainNext;
+
+/**
+ * @brief Completion callback submits the next transaction of the chain
+ */
+static void chainCb(ketCube_cfg_DrvError_t result, void *context)
+{
+    logCb(result, context);
+
+    if (chainNext < CHAIN_LEN) {
+        check(submit(KETCUBE_I2C_XFER_MEM_READ, DEV_A_ADDR, 2 * chainNext, &(chainBuf[chainNext][0]), 2,
+                     &chainCb, chainNext) == KETCUBE_CFG_DRV_OK, "chained submit", chainNext);
+        chainNext++;
+    }
+}
+
+/**
+ * @brief Transactions submitted from completion callbacks run back-to-back in FIFO order
+ */
+static void testChain(void)
+{
+    int i, irqs = sim.irqs;
+
+    clearLog();
+    for (chainNext = 0; chainNext < CHAIN_DEPTH; chainNext++) {
+        check(submit(KETCUBE_I2C_XFER_MEM_READ, DEV_A_ADDR, 2 * chainNext, &(chainBuf[chainNext][0]), 2,
+                     &chainCb, chainNext) == KETCUBE_CFG_DRV_OK, "submit", chainNext);
+    }
+    check(ketCube_I2C_IsBusy(), "queue busy", 0);
+    ketCube_I2C_Flush();
+
+    check(!ketCube_I2C_IsBusy(), "queue idle", 0);
+    check((done.cnt == CHAIN_LEN) && (done.okCnt == CHAIN_LEN), "chain completed", done.cnt);
+    check(sim.irqs - irqs == CHAIN_LEN, "one IRQ per transaction", sim.irqs - irqs);
+    for (i = 0; i < CHAIN_LEN; i++) {
+        check(done.order[i] == i, "FIFO order", i);
+        check((trace[i].reg == 2 * i) && (trace[i].addr == DEV_A_ADDR), "started transaction", i);
+        check((chainBuf[i][0] == devs[0].regs[2 * i]) && (chainBuf[i][1] == devs[0].regs[2 * i + 1]), "read data", i);
+    }
+}
+
+/**
+ * @brief Register reads of KETCUBE_I2C_DMA_MIN_LEN bytes and more use DMA, other transactions IRQ
+ */
+static void testDmaSwitch(void)
+{
+    uint8_t buf[16], wr[16];
+    uint16_t len;
+    int i;
+
+    for (len = 1; len <= sizeof(buf); len++) {
+        clearLog();
+        memset(buf, 0, sizeof(buf));
+        check(submit(KETCUBE_I2C_XFER_MEM_READ, DEV_B_ADDR, 0x28, &(buf[0]), len, &logCb, 0) == KETCUBE_CFG_DRV_OK,
+              "submit read", len);
+        ketCube_I2C_Flush();
+        check((traceCnt == 1) && (trace[0].dma == (len >= KETCUBE_I2C_DMA_MIN_LEN)), "read DMA by length", len);
+        check((done.cnt == 1) && (done.result[0] == KETCUBE_CFG_DRV_OK), "read completed", len);
+        check(memcmp(buf, &(devs[1].regs[0x28]), len) == 0, "read data", len);
+    }
+
+    for (i = 0; i < sizeof(wr); i++) {
+        wr[i] = 0xA0 + i;
+    }
+    clearLog();
+    submit(KETCUBE_I2C_XFER_MEM_WRITE, DEV_B_ADDR, 0x20, &(wr[0]), sizeof(wr), &logCb, 0);
+    submit(KETCUBE_I2C_XFER_RAW_WRITE, DEV_B_ADDR, 0, &(wr[0]), 1, &logCb, 1);
+    submit(KETCUBE_I2C_XFER_RAW_READ, DEV_B_ADDR, 0, &(buf[0]), sizeof(buf), &logCb, 2);
+    ketCube_I2C_Flush();
+
+    check((traceCnt == 3) && !trace[0].dma && !trace[1].dma && !trace[2].dma, "write and raw transactions by IRQ", traceCnt);
+    check(done.okCnt == 3, "completed", done.okCnt);
+    check(memcmp(&(devs[1].regs[0x20]), wr, sizeof(wr)) == 0, "register write", 0);
+    check(memcmp(&(devs[1].regs[0xA0]), buf, sizeof(buf)) == 0, "raw read from the raw write pointer", 0);
+}
+
+/**
+ * @brief Each transaction runs at the speed of its device
+ */
+static void testSpeed(void)
+{
+    static const uint8_t addr[] = { DEV_A_ADDR, DEV_B_ADDR, DEV_B_ADDR, ABSENT_ADDR, DEV_A_ADDR, DEV_B_ADDR };
+    uint8_t buf[sizeof(addr)][2];
+    uint32_t timing;
+    int i;
+
+    check(ketCube_I2C_SetDeviceSpeed(DEV_B_ADDR, KETCUBE_I2C_SPEED_400KHZ) == KETCUBE_CFG_DRV_OK, "set speed", 0);
+
+    clearLog();
+    for (i = 0; i < sizeof(addr); i++) {
+        submit(KETCUBE_I2C_XFER_MEM_READ, addr[i], 0, &(buf[i][0]), 2, &logCb, i);
+    }
+    ketCube_I2C_Flush();
+
+    check(traceCnt == sizeof(addr), "started", traceCnt);
+    check(done.okCnt == sizeof(addr) - 1, "completed", done.okCnt);
+    check(done.result[3] == KETCUBE_CFG_DRV_ERROR, "NACK", 3);
+    for (i = 0; i < sizeof(addr); i++) {
+        timing = (addr[i] == DEV_B_ADDR) ? KETCUBE_I2C_SPEED_400KHZ : KETCUBE_I2C_SPEED_100KHZ;
+        check(trace[i].timing == timing, "TIMINGR", i);
+    }
+    check(KETCUBE_I2C_Handle.Init.Timing == i2cRegs.TIMINGR, "Init.Timing follows TIMINGR", 0);
+
+    /* speed table */
+    check(ketCube_I2C_SetDeviceSpeed(DEV_B_ADDR, KETCUBE_I2C_SPEED_400KHZ) == KETCUBE_CFG_DRV_OK, "update speed", 0);
+    for (i = 1; i < KETCUBE_I2C_DEV_SPEED_CNT; i++) {
+        check(ketCube_I2C_SetDeviceSpeed((0x50 + i) << 1, KETCUBE_I2C_SPEED_400KHZ) == KETCUBE_CFG_DRV_OK, "speed table", i);
+    }
+    check(ketCube_I2C_SetDeviceSpeed(0x60 << 1, KETCUBE_I2C_SPEED_400KHZ) == KETCUBE_CFG_DRV_ERROR, "speed table full", 0);
+}
+
+/**
+ * @brief KETCUBE_I2C_QUEUE_LEN transactions (the running one included) are accepted, no more
+ */
+static void testFull(void)
+{
+    uint8_t buf[KETCUBE_I2C_QUEUE_LEN + 1][4];
+    int i;
+
+    clearLog();
+    for (i = 0; i < KETCUBE_I2C_QUEUE_LEN; i++) {
+        check(submit(KETCUBE_I2C_XFER_MEM_READ, DEV_A_ADDR, i, &(buf[i][0]), 1 + i % 4, &logCb, i)
+              == KETCUBE_CFG_DRV_OK, "submit", i);
+    }
+    check(submit(KETCUBE_I2C_XFER_MEM_READ, DEV_A_ADDR, 0, &(buf[i][0]), 1, &logCb, i)
+          == KETCUBE_CFG_DRV_ERROR, "queue full", i);
+    check((traceCnt == 1) && ketCube_I2C_IsBusy(), "one transaction running", traceCnt);
+
+    ketCube_I2C_Flush();
+    check(done.okCnt == KETCUBE_I2C_QUEUE_LEN, "completed", done.okCnt);
+    for (i = 0; i < KETCUBE_I2C_QUEUE_LEN; i++) {
+        check(done.order[i] == i, "FIFO order", i);
+    }
+
+    /* space again */
+    check(submit(KETCUBE_I2C_XFER_MEM_READ, DEV_A_ADDR, 0, &(buf[0][0]), 1, &logCb, 0) == KETCUBE_CFG_DRV_OK,
+          "submit after flush", 0);
+    ketCube_I2C_Flush();
+    check(done.okCnt == KETCUBE_I2C_QUEUE_LEN + 1, "completed after flush", done.okCnt);
+}
+
+/**
+ * @brief Device holding SCL low: the SCL low timeout ends queued transactions
+ */
+static void testTimeout(void)
+{
+    uint8_t buf[4][8];
+    int clears = sim.busClears;
+
+    check((i2cRegs.TIMEOUTR & I2C_TIMEOUTR_TIMOUTEN) != 0, "timeout enabled", 0);
+    ketCube_I2C_ClearStats();
+    devs[2].sclLow = TRUE;
+
+    /* DMA and IRQ transactions in the middle of the queue */
+    clearLog();
+    submit(KETCUBE_I2C_XFER_MEM_READ, DEV_A_ADDR, 0, &(buf[0][0]), 1, &logCb, 0);
+    submit(KETCUBE_I2C_XFER_MEM_READ, STUCK_ADDR, 0, &(buf[1][0]), 8, &logCb, 1);
+    submit(KETCUBE_I2C_XFER_MEM_WRITE, STUCK_ADDR, 0, &(buf[2][0]), 2, &logCb, 2);
+    submit(KETCUBE_I2C_XFER_MEM_READ, DEV_B_ADDR, 0, &(buf[3][0]), 2, &logCb, 3);
+    ketCube_I2C_Flush();
+
+    check((done.cnt == 4) && (done.okCnt == 2), "completed", done.cnt);
+    check((done.result[1] == KETCUBE_CFG_DRV_ERROR) && (done.result[2] == KETCUBE_CFG_DRV_ERROR), "timeout is an error", 0);
+    check((traceCnt == 4) && trace[1].dma && !trace[2].dma, "started", traceCnt);
+    check(sim.dmaAborts == 1, "DMA aborted", sim.dmaAborts);
+    check(statsContain("0x40: ok 0; NACK 0; timeout 2; error 0;"), "timeout statistics", 0);
+    check(sim.busClears == clears, "bus clear in IRQ context", 0);
+
+    /* the last transaction times out: the peripheral is idle */
+    clearLog();
+    submit(KETCUBE_I2C_XFER_MEM_READ, STUCK_ADDR, 0, &(buf[1][0]), 8, &logCb, 0);
+    ketCube_I2C_Flush();
+    check((done.cnt == 1) && (done.result[0] == KETCUBE_CFG_DRV_ERROR), "timeout", 0);
+    check((i2cRegs.CR1 & (I2C_CR1_ERRIE | I2C_CR1_RXDMAEN | I2C_CR1_TCIE | I2C_CR1_STOPIE)) == 0, "interrupts disabled", 0);
+    check(((i2cRegs.CR1 & I2C_CR1_PE) != 0) && (KETCUBE_I2C_Handle.State == HAL_I2C_STATE_READY)
+          && (KETCUBE_I2C_Handle.Lock == HAL_UNLOCKED), "peripheral ready", 0);
+
+    /* waited-for access returns instead of sleeping forever */
+    check(ketCube_I2C_ReadDataQueued(STUCK_ADDR, 0, &(buf[1][0]), 2) == KETCUBE_CFG_DRV_ERROR, "waited-for timeout", 0);
+    check(sim.busClears == clears + 1, "bus clear before the next access", sim.busClears - clears);
+    check(statsContain("0x40: ok 0; NACK 0; timeout 4; error 0;"), "timeout statistics", 1);
+
+    /* released device; the stale flag of a blocking transaction is ignored */
+    devs[2].sclLow = FALSE;
+    i2cRegs.ISR |= I2C_ISR_TIMEOUT;
+    check(ketCube_I2C_ReadDataQueued(STUCK_ADDR, 0, &(buf[1][0]), 2) == KETCUBE_CFG_DRV_OK, "access after timeout", 0);
+    check(sim.busClears == clears + 2, "bus clear before the next access", sim.busClears - clears);
+    check(statsContain("0x40: ok 1; NACK 0; timeout 4; error 0;"), "timeout statistics", 2);
+}
+
+int main(void)
+{
+    int d, r;
+
+    for (d = 0; d < (sizeof(devs) / sizeof(devs[0])); d++) {
+        for (r = 0; r < 256; r++) {
+            devs[d].regs[r] = (uint8_t) (r * 7 + d * 31 + 1);
+        }
+    }
+    for (r = 0; r < TRACE_LEN; r++) {
+        xferId[r] = r;
+    }
+
+    /* I2C1 as after ketCube_I2C_Init() */
+    KETCUBE_I2C_Handle.Instance = &i2cRegs;
+    KETCUBE_I2C_Handle.Init.Timing = KETCUBE_I2C_SPEED_100KHZ;
+    KETCUBE_I2C_Handle.State = HAL_I2C_STATE_READY;
+    i2cRegs.TIMINGR = KETCUBE_I2C_SPEED_100KHZ;
+    i2cRegs.TIMEOUTR = I2C_TIMEOUTR_TIMOUTEN | KETCUBE_I2C_SCL_LOW_TIMEOUT;
+    i2cRegs.CR1 = I2C_CR1_PE;
+
+    check(ketCube_I2C_Init() == KETCUBE_CFG_DRV_OK, "init", 0);
+
+    testChain();
+    testDmaSwitch();
+    testSpeed();
+    testFull();
+    testTimeout();
+
+    check(sim.blocking == 0, "blocking HAL call", sim.blocking);
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS i2c_queue: %d transactions\n", sim.irqs);
+
+    return 0;
+}
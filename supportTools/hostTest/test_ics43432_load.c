@@ -0,0 +1,458 @@
+/**
+ * @file    test_ics43432_load.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host simulation of the ICS43432 capture CPU load and energy from PCM
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * PCM (recorded or generated) is fed through the real I2S driver and the
+ * ICS43432 module: the DMA model fills the halves of the circular buffer
+ * and raises the DMA IRQ, the driver measures the block processing time
+ * by SysTick and the module reports CPU load and energy by ReadData().
+ * 
+ * SysTick is advanced by a Cortex-M0+ cycle model of the processing: the
+ * CMSIS-DSP biquad stub reports the filtered stage-samples; M0+ has no
+ * long multiply, thus each 32x32->64 product is a library call. The
+ * reported load is compared with the model and with the interrupt
+ * overhead of the former per-half-word SPI2 IRQ capture.
+ * 
+ * usage: test_ics43432_load [pcm]
+ * 
+ * pcm: raw mono 32 kHz signed 32-bit little-endian samples, 24-bit
+ *      left-justified, e.g. arecord -f S32_LE -r 32000 -c 1 -t raw;
+ *      a generated 1 kHz tone in noise is used if omitted
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "ketCube_i2s.h"
+#include "ketCube_gpio.h"
+#include "ketCube_ics43432.h"
+#include "ketCube_ics43432_spl.h"
+#include "ketCube_pwrMan.h"
+#include "ketCube_terminal.h"
+#include "stub.h"
+
+#define SIM_CORE_CLOCK          32000000        ///< MSI/PLL run clock
+#define SIM_GEN_SECONDS         10              ///< Generated signal length
+#define SIM_BLOCK_CYCLES        (KETCUBE_I2S_BLOCK_LEN * (SIM_CORE_CLOCK / KETCUBE_I2S_SAMPLE_RATE))
+
+/* Cortex-M0+ cycle model */
+#define CYC_MUL64               30      ///< 32x32->64 multiply: __aeabi_lmul, four 16x16 MULS
+#define CYC_BIQUAD              (5 * CYC_MUL64 + 20)    ///< Stage-sample: 5 products, 64-bit adds, state shift
+#define CYC_SQUARE              (CYC_MUL64 + 6)         ///< Mean square: product and 64-bit add per sample
+#define CYC_CONVERT             8       ///< Frame to Q31 input sample
+#define CYC_FILTER_CALL         60      ///< Filter call: coefficients and state load/store
+#define CYC_SHORT_LEVEL         1500    ///< Short interval level (2x log2) and LED write
+#define CYC_IRQ                 150     ///< DMA IRQ entry/exit and HAL dispatch; not measured by the driver
+#define CYC_OLD_IRQ             70      ///< Former SPI2 IRQ per half-word: entry/exit and handler
+
+#define SIM_LOAD_LIMIT          800     ///< Real-time limit (per mille): headroom for the radio IRQs
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL ics43432_load %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+uint32_t SystemCoreClock = SIM_CORE_CLOCK;
+uint32_t stub_primask = 0;
+uint32_t stub_ipsr = 0;
+
+void stub_wfi(void)
+{
+}
+
+static char termOut[4096];      ///< terminal output of the module
+
+void ketCube_terminal_ModSeverityPrintln(ketCube_severity_t msgSeverity,
+                                         ketCube_cfg_moduleIDs_t modId,
+                                         char *format, va_list args)
+{
+    size_t len = strlen(termOut);
+
+    vsnprintf(&(termOut[len]), sizeof(termOut) - len - 1, format, args);
+    strcat(termOut, "\n");
+}
+
+void ketCube_pwrMan_SetBusy(ketCube_pwrMan_periph_t periph, bool busy)
+{
+}
+
+ketCube_cfg_DrvError_t ketCube_GPIO_ReInit(ketCube_gpio_port_t port,
+                                           uint16_t pin,
+                                           GPIO_InitTypeDef * initStruct)
+{
+    return KETCUBE_CFG_DRV_OK;
+}
+
+/**
+ * @brief Called by the module once per short interval
+ */
+void ketCube_GPIO_Write(ketCube_gpio_port_t port, ketCube_gpio_pin_t pin,
+                        bool bit)
+{
+    SysTick->VAL = (SysTick->VAL - CYC_SHORT_LEVEL) & KETCUBE_PWRMAN_CYCLES_MASK;
+}
+
+static HAL_I2S_StateTypeDef i2sState = HAL_I2S_STATE_RESET;
+
+HAL_I2S_StateTypeDef HAL_I2S_GetState(I2S_HandleTypeDef * hi2s)
+{
+    return i2sState;
+}
+
+HAL_StatusTypeDef HAL_I2S_Init(I2S_HandleTypeDef * hi2s)
+{
+    i2sState = HAL_I2S_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2S_DeInit(I2S_HandleTypeDef * hi2s)
+{
+    i2sState = HAL_I2S_STATE_RESET;
+    return HAL_OK;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef * GPIOx, GPIO_InitTypeDef * GPIO_Init)
+{
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef * hdma)
+{
+    return HAL_OK;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority,
+                          uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+}
+
+/**
+* @brief DMA model: circular transfer into the double buffer
+*/
+static struct {
+    uint16_t *buffer;           /*!< NULL if stopped */
+    uint16_t slots;             /*!< 32-bit slots */
+    uint16_t pos;               /*!< next half-word */
+    bool blockStart;            /*!< no filter run in the current block yet */
+} dma;
+
+HAL_StatusTypeDef HAL_I2S_Receive_DMA(I2S_HandleTypeDef * hi2s,
+                                      uint16_t * pData, uint16_t Size)
+{
+    dma.buffer = pData;
+    dma.slots = Size;
+    dma.pos = 0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2S_DMAStop(I2S_HandleTypeDef * hi2s)
+{
+    dma.buffer = NULL;
+    return HAL_OK;
+}
+
+/**
+ * @brief Half/full transfer event: one block has been received
+ */
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef * hdma)
+{
+    SysTick->VAL = (SysTick->VAL - CYC_IRQ) & KETCUBE_PWRMAN_CYCLES_MASK;
+    dma.blockStart = TRUE;
+
+    if (dma.pos == dma.slots) {
+        HAL_I2S_RxHalfCpltCallback(NULL);
+    } else {
+        HAL_I2S_RxCpltCallback(NULL);
+        dma.pos = 0;
+    }
+}
+
+/**
+ * @brief Block processing time: filters and mean squares; the first filter
+ *        call of a block also converts the frames
+ */
+static void biquadCycles(uint32_t stageSamples, uint32_t samples)
+{
+    uint32_t cycles = CYC_FILTER_CALL + stageSamples * CYC_BIQUAD + samples * CYC_SQUARE;
+
+    if (dma.blockStart == TRUE) {
+        cycles += samples * CYC_CONVERT;
+        dma.blockStart = FALSE;
+    }
+
+    SysTick->VAL = (SysTick->VAL - cycles) & KETCUBE_PWRMAN_CYCLES_MASK;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+static int32_t *pcm;            ///< S32 samples
+static uint32_t pcmLen;
+static int pcmLeq = -1;         ///< Expected LAeq (0.1 dB); -1 = unknown
+
+static uint32_t lcg = 12345;
+
+/**
+ * @brief White noise, about -53 dBFS RMS
+ */
+static int32_t noise(void)
+{
+    lcg = lcg * 1103515245U + 12345U;
+    return ((int32_t) lcg) >> 8;
+}
+
+/**
+ * @brief 1 kHz tone at -30 dBFS in white noise
+ */
+static void generate(void)
+{
+    uint32_t i;
+
+    pcmLen = SIM_GEN_SECONDS * KETCUBE_I2S_SAMPLE_RATE;
+    pcmLeq = KETCUBE_ICS43432_SPL_FS_LEVEL - 300;
+    pcm = malloc(pcmLen * sizeof(int32_t));
+
+    for (i = 0; i < pcmLen; i++) {
+        pcm[i] = ((int32_t) (0.0316 * INT32_MAX * sin(2.0 * M_PI * 1000.0 * i / KETCUBE_I2S_SAMPLE_RATE))
+                  + noise()) & ~0xFF;
+    }
+}
+
+static int load(const char *file)
+{
+    FILE *f = fopen(file, "rb");
+    long size;
+
+    if (f == NULL) {
+        return 0;
+    }
+
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    pcmLen = size / sizeof(int32_t);
+    pcm = malloc(pcmLen * sizeof(int32_t));
+    pcmLen = fread(pcm, sizeof(int32_t), pcmLen, f);
+    fclose(f);
+
+    return (pcmLen >= KETCUBE_I2S_BLOCK_LEN);
+}
+
+/**
+ * @brief Modelled processing cycles of a block
+ */
+static uint32_t blockCycles(bool bands)
+{
+    uint32_t n = KETCUBE_I2S_BLOCK_LEN;
+    uint32_t cycles;
+
+    /* conversion, A-weighting cascade (3 stages), one octave band in turn */
+    cycles = n * CYC_CONVERT + CYC_FILTER_CALL + 3 * n * CYC_BIQUAD + n * CYC_SQUARE;
+    if (bands == TRUE) {
+        cycles += CYC_FILTER_CALL + n * CYC_BIQUAD + n * CYC_SQUARE;
+    }
+
+    return cycles;
+}
+
+/**
+ * @brief Capture the whole PCM and read the module report
+ *
+ * @retval load reported load (per mille); -1 on failure
+ */
+static int capture(bool bands, int step)
+{
+    uint8_t buffer[32];
+    uint8_t len;
+    uint32_t i, blocks = pcmLen / KETCUBE_I2S_BLOCK_LEN;
+    uint64_t cycles;
+    int loadPm, loadFrac, energy, leq;
+    uint32_t expLoad, expUA;
+    char *line;
+
+    ketCube_ics43432_moduleCfg.bands = bands;
+    check(ketCube_ics43432_Init(NULL) == KETCUBE_CFG_MODULE_OK, "init", step);
+    check(dma.buffer != NULL, "DMA started", step);
+    check(dma.slots == KETCUBE_I2S_BUFFER_LEN / 2, "DMA length in 32-bit slots", step);
+
+    /* discard statistics of a previous run */
+    ketCube_ics43432_ReadData(buffer, &len);
+    termOut[0] = '\0';
+
+    for (i = 0; i < blocks * KETCUBE_I2S_BLOCK_LEN; i++) {
+        /* left slot: MSB half-word first; right slot is empty */
+        dma.buffer[dma.pos++] = (uint16_t) (((uint32_t) pcm[i]) >> 16);
+        dma.buffer[dma.pos++] = (uint16_t) pcm[i];
+        dma.buffer[dma.pos++] = 0;
+        dma.buffer[dma.pos++] = 0;
+
+        if ((dma.pos == dma.slots) || (dma.pos == 2 * dma.slots)) {
+            /* the core sleeps until the DMA IRQ */
+            SysTick->VAL = (SysTick->VAL - SIM_BLOCK_CYCLES) & KETCUBE_PWRMAN_CYCLES_MASK;
+            DMA1_Channel4_5_6_7_IRQHandler();
+        }
+    }
+
+    check(ketCube_ics43432_ReadData(buffer, &len) == KETCUBE_CFG_MODULE_OK, "read", step);
+    check(len == (bands ? 20 : 6), "payload length", step);
+    check(ketCube_ics43432_UnInit() == KETCUBE_CFG_MODULE_OK, "uninit", step);
+    check(dma.buffer == NULL, "DMA stopped", step);
+
+    /* frames are packed as received from the microphone */
+    line = strstr(termOut, "LAeq: ");
+    if ((line == NULL) || (sscanf(line, "LAeq: %d", &leq) != 1)) {
+        check(0, "level report", step);
+    } else if (pcmLeq >= 0) {
+        check(abs(leq - pcmLeq) <= 5, "LAeq of the generated signal", leq);
+    }
+
+    line = strstr(termOut, "CPU load: ");
+    if ((line == NULL)
+        || (sscanf(line, "CPU load: %d.%d %%; energy: %d uJ", &loadPm, &loadFrac, &energy) != 3)) {
+        check(0, "load report", step);
+        return -1;
+    }
+    loadPm = loadPm * 10 + loadFrac;
+
+    /* the model: the driver measures the block processing only */
+    cycles = (uint64_t) blocks * blockCycles(bands)
+        + (uint64_t) (blocks / KETCUBE_ICS43432_SPL_SHORT_BLOCKS) * CYC_SHORT_LEVEL;
+    expLoad = (uint32_t) (cycles * 1000 / ((uint64_t) blocks * SIM_BLOCK_CYCLES));
+    expUA = KETCUBE_ICS43432_MIC_UA + KETCUBE_ICS43432_MCU_SLEEP_UA
+        + (expLoad * (KETCUBE_ICS43432_MCU_RUN_UA - KETCUBE_ICS43432_MCU_SLEEP_UA)) / 1000;
+
+    check(loadPm == (int) expLoad, "load equals the cycle model", step);
+    check(energy == (int) (expUA * KETCUBE_ICS43432_SUPPLY_MV / 1000), "energy", step);
+
+    printf("ics43432_load: %s: %u blocks, %llu cycles/block, CPU load %d.%d %%, %d uJ per second\n",
+           bands ? "LAeq + octave bands" : "LAeq", blocks,
+           (unsigned long long) (cycles / blocks), loadPm / 10, loadPm % 10, energy);
+
+    return loadPm;
+}
+
+int main(int argc, char *argv[])
+{
+    int loadA, loadBands;
+    uint32_t irqNew, irqOld;
+    uint32_t uaOld;
+
+    /* System Control Space (SysTick) and RCC as plain memory */
+    if ((mmap((void *) SCS_BASE, 0x1000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+              -1, 0) != (void *) SCS_BASE)
+        || (mmap((void *) RCC_BASE, 0x1000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                 -1, 0) != (void *) RCC_BASE)) {
+        printf("FAIL ics43432_load cannot map SysTick and RCC\n");
+        return 1;
+    }
+    SysTick->VAL = KETCUBE_PWRMAN_CYCLES_MASK;
+
+    if (argc > 1) {
+        if (load(argv[1]) == 0) {
+            printf("FAIL ics43432_load cannot read PCM from %s\n", argv[1]);
+            return 1;
+        }
+    } else {
+        generate();
+    }
+
+    stub_biquadHook = &biquadCycles;
+
+    loadA = capture(FALSE, 1);
+    loadBands = capture(TRUE, 2);
+
+    check((loadA > 0) && (loadA <= SIM_LOAD_LIMIT), "LAeq capture runs in real time", loadA);
+    check((loadBands > loadA) && (loadBands <= SIM_LOAD_LIMIT), "octave band capture runs in real time", loadBands);
+
+    /* interrupt entry/exit per second: DMA per block vs. SPI2 per half-word */
+    irqNew = (KETCUBE_I2S_SAMPLE_RATE / KETCUBE_I2S_BLOCK_LEN) * CYC_IRQ;
+    irqOld = KETCUBE_I2S_SAMPLE_RATE * KETCUBE_I2S_FRAME_LEN * CYC_OLD_IRQ;
+    uaOld = KETCUBE_ICS43432_MIC_UA + KETCUBE_ICS43432_MCU_SLEEP_UA
+        + (uint32_t) (((uint64_t) irqOld * (KETCUBE_ICS43432_MCU_RUN_UA - KETCUBE_ICS43432_MCU_SLEEP_UA)) / SIM_CORE_CLOCK);
+
+    check(irqNew * 100 < SIM_CORE_CLOCK, "DMA IRQ overhead below 1 %", 0);
+
+    printf("ics43432_load: IRQ overhead: DMA blocks %u.%02u %%, former SPI2 per half-word %u.%u %% (%u uJ per second before any processing)\n",
+           irqNew * 100 / SIM_CORE_CLOCK, (irqNew * 10000 / SIM_CORE_CLOCK) % 100,
+           irqOld / (SIM_CORE_CLOCK / 100), (irqOld / (SIM_CORE_CLOCK / 1000)) % 10,
+           uaOld * KETCUBE_ICS43432_SUPPLY_MV / 1000);
+
+    if (fails != 0) {
+        return 1;
+    }
+
+    printf("PASS ics43432_load: LAeq %d.%d %%, with octave bands %d.%d %% CPU load\n",
+           loadA / 10, loadA % 10, loadBands / 10, loadBands % 10);
+
+    return 0;
+}
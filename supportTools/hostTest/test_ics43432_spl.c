@@ -0,0 +1,244 @@
+/**
+ * @file    test_ics43432_spl.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the ICS43432 sound level meter: golden tones and pink noise
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_ics43432_spl.h"
+
+#define FS              KETCUBE_ICS43432_SPL_FS
+#define BLOCK           KETCUBE_ICS43432_SPL_MAX_BLOCK
+#define SETTLE_BLOCKS   (FS / BLOCK / 2)    ///< Filter settling discarded: 0.5 s
+#define MAX_TONES       120
+
+/**
+* @brief Octave band centres
+*/
+static const double bandCentre[KETCUBE_ICS43432_SPL_BANDS] = { 125, 250, 500, 1000, 2000, 4000, 8000 };
+
+static int fails = 0;
+
+static void check(int cond, const char *what, double got, double expected)
+{
+    if (!cond) {
+        printf("FAIL ics43432_spl %s: %.1f dB (expected %.1f dB)\n", what, got, expected);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/**
+ * @brief IEC 61672 A-weighting in dB
+ */
+static double aWeighting(double f)
+{
+    double f2 = f * f;
+    double ra = (12194.0 * 12194.0 * f2 * f2)
+        / ((f2 + 20.6 * 20.6) * sqrt((f2 + 107.7 * 107.7) * (f2 + 737.9 * 737.9))
+           * (f2 + 12194.0 * 12194.0));
+
+    return 20.0 * log10(ra) + 2.0;
+}
+
+/**
+ * @brief Level (dB) of a sine of the given amplitude; full-scale sine = KETCUBE_ICS43432_SPL_FS_LEVEL
+ */
+static double sineLevel(double power)
+{
+    return KETCUBE_ICS43432_SPL_FS_LEVEL / 10.0 + 10.0 * log10(power / 0.5);
+}
+
+/**
+ * @brief Measure a sum of sines (random phases); the amplitude is switched to amp2 after the half of the time
+ */
+static void measure(int cnt, const double *f, const double *amp,
+                    double amp2, double secs, ketCube_ics43432_spl_levels_t * levels)
+{
+    static double phase[MAX_TONES];
+    ketCube_ics43432_spl_acc_t acc;
+    int32_t x[BLOCK];
+    long blocks = (long) (secs * FS / BLOCK);
+    long b, n = 0;
+    double s, gain = 1.0;
+    long v;
+    int i, t;
+
+    for (t = 0; t < cnt; t++) {
+        phase[t] = 2.0 * M_PI * rand() / RAND_MAX;
+    }
+
+    ketCube_ics43432_spl_Init(true);
+    ketCube_ics43432_spl_Reset(&acc);
+    for (b = 0; b < blocks; b++) {
+        if (b == (SETTLE_BLOCKS + (blocks - SETTLE_BLOCKS) / 2)) {
+            gain = amp2;
+        }
+        for (i = 0; i < BLOCK; i++, n++) {
+            s = 0.0;
+            for (t = 0; t < cnt; t++) {
+                s += gain * amp[t] * sin(2.0 * M_PI * f[t] * n / FS + phase[t]);
+            }
+            /* 24-bit I2S sample, left-aligned as by the driver */
+            v = lround(s * 8388607.0);
+            v = (v > 8388607) ? 8388607 : ((v < -8388608) ? -8388608 : v);
+            x[i] = (int32_t) ((uint32_t) v << KETCUBE_ICS43432_SPL_INPUT_SHIFT);
+        }
+        if (b == SETTLE_BLOCKS) {
+            ketCube_ics43432_spl_Reset(&acc);
+        }
+        ketCube_ics43432_spl_AddBlock(&acc, &(x[0]), BLOCK);
+    }
+    ketCube_ics43432_spl_Levels(&acc, levels);
+}
+
+static double amplitude(double level)
+{
+    return pow(10.0, (level - KETCUBE_ICS43432_SPL_FS_LEVEL / 10.0) / 20.0);
+}
+
+/**
+ * @brief 94 dB tones: LAeq follows the A-weighting curve, the tone falls into its octave band
+ */
+static void testTones(void)
+{
+    static const double tones[] = { 31.5, 63, 125, 250, 500, 1000, 2000, 4000, 8000, 10000 };
+    ketCube_ics43432_spl_levels_t levels;
+    double amp = amplitude(94.0);
+    double expected;
+    unsigned i, k;
+
+    for (i = 0; i < (sizeof(tones) / sizeof(tones[0])); i++) {
+        measure(1, &(tones[i]), &amp, 1.0, 2.0, &levels);
+        expected = 94.0 + aWeighting(tones[i]);
+        check(fabs(levels.leq / 10.0 - expected) <= 0.3, "tone LAeq", levels.leq / 10.0, expected);
+
+        for (k = 0; k < KETCUBE_ICS43432_SPL_BANDS; k++) {
+            if (fabs(tones[i] - bandCentre[k]) < 1.0) {
+                check(fabs(levels.bands[k] / 10.0 - 94.0) <= 0.5, "tone band level", levels.bands[k] / 10.0, 94.0);
+            } else if ((tones[i] > (bandCentre[k] * 4.0)) || (tones[i] < (bandCentre[k] / 4.0))) {
+                /* two octaves away */
+                check(levels.bands[k] / 10.0 < 94.0 - 20.0, "tone out of band", levels.bands[k] / 10.0, 94.0 - 20.0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 1 kHz level linearity; LAmax/LAmin of a level step
+ */
+static void testLinearity(void)
+{
+    static const double levelList[] = { 40.0, 60.0, 94.0, 110.0 };
+    ketCube_ics43432_spl_levels_t levels;
+    double f = 1000.0;
+    double amp, expected;
+    unsigned i;
+
+    for (i = 0; i < (sizeof(levelList) / sizeof(levelList[0])); i++) {
+        amp = amplitude(levelList[i]);
+        measure(1, &f, &amp, 1.0, 1.5, &levels);
+        check(fabs(levels.leq / 10.0 - levelList[i]) <= 0.2, "1 kHz LAeq", levels.leq / 10.0, levelList[i]);
+    }
+
+    /* 94 dB, then 74 dB for the same time */
+    amp = amplitude(94.0);
+    measure(1, &f, &amp, 0.1, 2.5, &levels);
+    check(fabs(levels.max / 10.0 - 94.0) <= 0.3, "LAmax", levels.max / 10.0, 94.0);
+    check(fabs(levels.min / 10.0 - 74.0) <= 0.3, "LAmin", levels.min / 10.0, 74.0);
+    expected = 10.0 * log10((pow(10.0, 9.4) + pow(10.0, 7.4)) / 2.0);
+    check(fabs(levels.leq / 10.0 - expected) <= 0.3, "level step LAeq", levels.leq / 10.0, expected);
+}
+
+/**
+ * @brief Pink noise: equal power per log-spaced tone, 25 Hz - 12 kHz
+ */
+static void testPinkNoise(void)
+{
+    static double f[MAX_TONES], amp[MAX_TONES];
+    ketCube_ics43432_spl_levels_t levels;
+    double powerA = 0.0, band[KETCUBE_ICS43432_SPL_BANDS] = { 0 };
+    double expected;
+    unsigned i, k;
+
+    for (i = 0; i < MAX_TONES; i++) {
+        f[i] = 25.0 * pow(12000.0 / 25.0, (double) i / (MAX_TONES - 1));
+        amp[i] = amplitude(80.0) / sqrt(MAX_TONES);
+        powerA += amp[i] * amp[i] / 2.0 * pow(10.0, aWeighting(f[i]) / 10.0);
+        for (k = 0; k < KETCUBE_ICS43432_SPL_BANDS; k++) {
+            if ((f[i] >= bandCentre[k] / M_SQRT2) && (f[i] < bandCentre[k] * M_SQRT2)) {
+                band[k] += amp[i] * amp[i] / 2.0;
+            }
+        }
+    }
+
+    measure(MAX_TONES, &(f[0]), &(amp[0]), 1.0, 3.0, &levels);
+    expected = sineLevel(powerA);
+    check(fabs(levels.leq / 10.0 - expected) <= 0.3, "pink noise LAeq", levels.leq / 10.0, expected);
+    for (k = 0; k < KETCUBE_ICS43432_SPL_BANDS; k++) {
+        /* octave filters read broadband noise up to ~2 dB high; the 8 kHz band
+         * edge approaches Nyquist and reads ~0.8 dB low */
+        expected = sineLevel(band[k]);
+        check((levels.bands[k] / 10.0 >= expected - 1.0) && (levels.bands[k] / 10.0 <= expected + 2.5),
+              "pink noise band level", levels.bands[k] / 10.0, expected);
+    }
+}
+
+int main(void)
+{
+    srand(1);
+
+    testTones();
+    testLinearity();
+    testPinkNoise();
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS ics43432_spl: RAM %u B\n", ketCube_ics43432_spl_RamSize());
+
+    return 0;
+}
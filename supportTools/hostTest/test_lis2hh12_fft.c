@@ -0,0 +1,209 @@
+/**
+ * @file    test_lis2hh12_fft.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the LIS2HH12 vibration spectrum: peak bins and band energies
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_lis2hh12_fft.h"
+
+#define N               KETCUBE_LIS2HH12_FFT_LEN
+#define BLOCKS          8
+#define GRAVITY         16393       ///< 1 g at +-2 g full scale (0.061 mg/LSB)
+
+static int fails = 0;
+
+/**
+* @brief Test signal: up to three sines (frequency in bins) on the gravity offset
+*/
+typedef struct {
+    double bin[3];
+    double amp[3];
+    double noise;       /*!< uniform noise amplitude */
+} signal_t;
+
+static void fail(const char *what, double got, double expected)
+{
+    printf("FAIL lis2hh12_fft %s: %.1f (expected %.1f)\n", what, got, expected);
+    if (++fails > 10) {
+        exit(1);
+    }
+}
+
+static void measure(const signal_t * sig, ketCube_lis2hh12_fft_acc_t * acc)
+{
+    int16_t block[N];
+    double s;
+    long n = 0;
+    int b, i, t;
+
+    ketCube_lis2hh12_fft_Reset(acc);
+    for (b = 0; b < BLOCKS; b++) {
+        for (i = 0; i < N; i++, n++) {
+            s = GRAVITY;
+            for (t = 0; t < 3; t++) {
+                s += sig->amp[t] * sin(2.0 * M_PI * sig->bin[t] * n / N + t);
+            }
+            s += sig->noise * (2.0 * rand() / RAND_MAX - 1.0);
+            block[i] = (int16_t) lrint(s);
+        }
+        ketCube_lis2hh12_fft_AddBlock(acc, &(block[0]));
+    }
+}
+
+/**
+ * @brief Peaks of on-bin sines sorted by amplitude; mean square of each band
+ */
+static void testOnBin(void)
+{
+    static const signal_t sig = { {5.0, 20.0, 12.0}, {1000.0, 300.0, 600.0}, 0.0 };
+    ketCube_lis2hh12_fft_acc_t acc;
+    uint8_t bins[KETCUBE_LIS2HH12_FFT_PEAKS];
+    uint32_t meanSq[KETCUBE_LIS2HH12_FFT_BANDS];
+    double expected[KETCUBE_LIS2HH12_FFT_BANDS] = { 0 };
+    int i;
+
+    measure(&sig, &acc);
+    ketCube_lis2hh12_fft_Peaks(&acc, &(bins[0]), KETCUBE_LIS2HH12_FFT_PEAKS);
+    if ((bins[0] != 5) || (bins[1] != 12) || (bins[2] != 20)) {
+        printf("FAIL lis2hh12_fft peaks: %u %u %u (expected 5 12 20)\n", bins[0], bins[1], bins[2]);
+        fails++;
+    }
+
+    /* bands: bins 1-7, 8-15, 16-23, 24-31 */
+    for (i = 0; i < 3; i++) {
+        expected[(int) (sig.bin[i] / 8)] += sig.amp[i] * sig.amp[i] / 2.0;
+    }
+    ketCube_lis2hh12_fft_Bands(&acc, &(meanSq[0]), KETCUBE_LIS2HH12_FFT_BANDS);
+    for (i = 0; i < KETCUBE_LIS2HH12_FFT_BANDS; i++) {
+        if (fabs(meanSq[i] - expected[i]) > (0.01 * expected[i] + 10.0)) {
+            fail("on-bin band mean square", meanSq[i], expected[i]);
+        }
+    }
+}
+
+/**
+ * @brief Off-bin sine: leakage stays around the nearest bin, the energy is kept
+ */
+static void testLeakage(void)
+{
+    static const double binList[] = { 3.3, 7.5, 9.8, 17.25, 29.6 };
+    ketCube_lis2hh12_fft_acc_t acc;
+    uint8_t bins[KETCUBE_LIS2HH12_FFT_PEAKS];
+    uint32_t meanSq[1];
+    signal_t sig = { {0.0, 0.0, 0.0}, {2000.0, 0.0, 0.0}, 0.0 };
+    double expected;
+    unsigned i;
+
+    for (i = 0; i < (sizeof(binList) / sizeof(binList[0])); i++) {
+        sig.bin[0] = binList[i];
+        measure(&sig, &acc);
+
+        ketCube_lis2hh12_fft_Peaks(&acc, &(bins[0]), KETCUBE_LIS2HH12_FFT_PEAKS);
+        if (fabs(bins[0] - binList[i]) > 0.5) {
+            fail("off-bin peak", bins[0], binList[i]);
+        }
+
+        /* the whole spectrum as a single band; leakage to DC and the
+         * (not reported) Nyquist bin is lost, at most ~10 % for these bins */
+        ketCube_lis2hh12_fft_Bands(&acc, &(meanSq[0]), 1);
+        expected = sig.amp[0] * sig.amp[0] / 2.0;
+        if ((meanSq[0] > 1.02 * expected) || (meanSq[0] < 0.85 * expected)) {
+            fail("off-bin mean square", meanSq[0], expected);
+        }
+    }
+}
+
+/**
+ * @brief Full-scale vibration does not wrap; a small sine is found in noise
+ */
+static void testRange(void)
+{
+    signal_t loud = { {8.0, 0.0, 0.0}, {16000.0, 0.0, 0.0}, 0.0 };
+    signal_t noisy = { {23.0, 0.0, 0.0}, {200.0, 0.0, 0.0}, 200.0 };
+    ketCube_lis2hh12_fft_acc_t acc;
+    uint8_t bins[KETCUBE_LIS2HH12_FFT_PEAKS];
+    uint32_t meanSq[KETCUBE_LIS2HH12_FFT_BANDS];
+    double expected;
+
+    /* 16000 + 1 g fits to int16_t; the block mean is removed before the FFT */
+    measure(&loud, &acc);
+    ketCube_lis2hh12_fft_Bands(&acc, &(meanSq[0]), KETCUBE_LIS2HH12_FFT_BANDS);
+    expected = loud.amp[0] * loud.amp[0] / 2.0;
+    if (fabs(meanSq[1] - expected) > 0.01 * expected) {
+        fail("full-scale mean square", meanSq[1], expected);
+    }
+
+    measure(&noisy, &acc);
+    ketCube_lis2hh12_fft_Peaks(&acc, &(bins[0]), KETCUBE_LIS2HH12_FFT_PEAKS);
+    if (bins[0] != 23) {
+        fail("sine in noise peak", bins[0], 23.0);
+    }
+
+    /* empty spectrum: no peaks, zero bands */
+    ketCube_lis2hh12_fft_Reset(&acc);
+    ketCube_lis2hh12_fft_Peaks(&acc, &(bins[0]), KETCUBE_LIS2HH12_FFT_PEAKS);
+    ketCube_lis2hh12_fft_Bands(&acc, &(meanSq[0]), KETCUBE_LIS2HH12_FFT_BANDS);
+    if ((bins[0] != 0) || (meanSq[0] != 0) || (meanSq[3] != 0)) {
+        fail("empty spectrum", bins[0] + meanSq[0] + meanSq[3], 0.0);
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    ketCube_lis2hh12_fft_Init();
+
+    testOnBin();
+    testLeakage();
+    testRange();
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS lis2hh12_fft: RAM %u B\n", ketCube_lis2hh12_fft_RamSize());
+
+    return 0;
+}
@@ -0,0 +1,398 @@
+/**
+ * @file    test_modules.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the module retries and record insertion order
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * Sensor modules fail GetSensorData() at random; the core retries only the
+ * failed modules after repeatDelay, at most retryCount times and within
+ * the base period, and inserts the retried records in module order
+ * (ketCube_modules_Rotate()). Some periods are cut short by the next
+ * period before the retries finish.
+ * 
+ * The record passed to SendData() is compared with the records of the
+ * successful attempts in module order followed by the status bitmap; the
+ * attempts of each module are compared with the retry budget.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_adaptive.h"
+#include "ketCube_coreCfg.h"
+#include "ketCube_deadband.h"
+#include "ketCube_modules.h"
+#include "ketCube_oversample.h"
+#include "ketCube_timeSync.h"
+#include "timeServer.h"
+
+#define SIM_PERIODS             20000
+#define SIM_MODULES             6               ///< Sensor modules
+#define SIM_MAX_LEN             24              ///< Max. record length
+#define SIM_FAIL_PERMIL         300             ///< GetSensorData() failure rate
+#define SIM_CUT_PERMIL          100             ///< Periods started before the retries finish
+#define SIM_REPEAT_DELAY        5000
+#define SIM_MAX_ATTEMPTS        8
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL modules %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+static TimerTime_t simTime;     ///< ms
+static TimerEvent_t *retryTimer;
+
+void TimerStart(TimerEvent_t * obj)
+{
+    obj->IsStarted = true;
+    obj->Timestamp = simTime;
+    retryTimer = obj;
+}
+
+void TimerStop(TimerEvent_t * obj)
+{
+    obj->IsStarted = false;
+}
+
+void TimerSetValue(TimerEvent_t * obj, uint32_t value)
+{
+    obj->ReloadValue = value;
+}
+
+TimerTime_t TimerGetCurrentTime(void)
+{
+    return simTime;
+}
+
+TimerTime_t TimerGetElapsedTime(TimerTime_t savedTime)
+{
+    return simTime - savedTime;
+}
+
+void ketCube_timeSync_Stamp(void)
+{
+}
+
+void ketCube_adaptive_Begin(void)
+{
+}
+
+void ketCube_adaptive_Update(ketCube_cfg_moduleIDs_t modId, const uint8_t * data, uint8_t len)
+{
+}
+
+void ketCube_adaptive_End(void)
+{
+}
+
+uint8_t ketCube_oversample_Summarize(ketCube_cfg_moduleIDs_t modId,
+                                     uint8_t * buffer, uint8_t len,
+                                     uint8_t maxLen)
+{
+    return len;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulated modules                                                      */
+/* ---------------------------------------------------------------------- */
+
+static const uint8_t simId[SIM_MODULES] = { 2, 3, 5, 8, 9, 12 };  ///< Module IDs of the sensor modules
+static const uint8_t sendId = 1;                                   ///< Module ID of the communication module
+
+static ketCube_cfg_ModuleCfgByte_t cfgOn = {.enable = TRUE };
+static ketCube_cfg_ModuleCfgByte_t cfgOff = {.enable = FALSE };
+
+static uint32_t rnd = 1;
+static uint32_t period;
+static uint8_t attempts[SIM_MODULES];                    ///< GetSensorData() calls in this period
+static bool ok[SIM_MODULES];                             ///< Record acquired in this period
+static uint8_t record[SIM_MODULES][SIM_MAX_LEN];         ///< Record of the successful attempt
+static uint8_t recordLen[SIM_MODULES];
+static uint8_t retryCount;                               ///< Effective retryCount of this period
+static uint8_t rounds;                                   ///< Retry rounds allowed in this period
+static bool reported;                                    ///< SendData() executed for this period
+static bool pending;                                     ///< Period cut short, not reported yet
+static uint8_t nextRetryCount;                           ///< retryCount of the period sampled next
+static uint8_t nextRounds;                               ///< Retry rounds of the period sampled next
+static uint32_t commits;                                 ///< ketCube_deadband_Commit() calls
+static uint32_t totalAttempts, totalRetries, totalMissing;
+
+static uint32_t simRandom(uint32_t n)
+{
+    rnd = rnd * 1103515245U + 12345U;
+
+    return (rnd >> 8) % n;
+}
+
+/**
+ * @brief GetSensorData() of a simulated module
+ *
+ * The record holds the module index, period and attempt; its length
+ * differs in each attempt.
+ */
+static ketCube_cfg_ModError_t simGet(uint8_t m, uint8_t * buffer, uint8_t * len)
+{
+    uint8_t i;
+
+    attempts[m]++;
+    check(ok[m] == FALSE, "successful module sampled again", (int) period);
+
+    if (simRandom(1000) < SIM_FAIL_PERMIL) {
+        /* a failing driver may leave garbage */
+        memset(buffer, 0xEE, SIM_MAX_LEN);
+        return KETCUBE_CFG_MODULE_ERROR;
+    }
+
+    *len = 1 + simRandom(SIM_MAX_LEN);
+    for (i = 0; i < *len; i++) {
+        buffer[i] = (uint8_t) ((m << 5) + (attempts[m] << 2) + period + i);
+    }
+    memcpy(&(record[m][0]), buffer, *len);
+    recordLen[m] = *len;
+    ok[m] = TRUE;
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+#define SIM_GET_FN(m) \
+    static ketCube_cfg_ModError_t simGet ## m(uint8_t * buffer, uint8_t * len) \
+    { \
+        return simGet(m, buffer, len); \
+    }
+
+SIM_GET_FN(0)
+SIM_GET_FN(1)
+SIM_GET_FN(2)
+SIM_GET_FN(3)
+SIM_GET_FN(4)
+SIM_GET_FN(5)
+
+static const ketCube_cfg_ModDataFn_t simGetFn[SIM_MODULES] = {
+    &simGet0, &simGet1, &simGet2, &simGet3, &simGet4, &simGet5
+};
+
+/**
+ * @brief Reset the expected state for the period sampled next
+ */
+static void simPeriodBegin(void)
+{
+    memset(attempts, 0, sizeof(attempts));
+    memset(ok, FALSE, sizeof(ok));
+    reported = FALSE;
+    commits = 0;
+    retryCount = nextRetryCount;
+    rounds = nextRounds;
+}
+
+/**
+ * @brief Check the retries of the period
+ *
+ * A module failing in every attempt is retried until the retry budget,
+ * the base period or the period cut is exhausted.
+ */
+static void checkAttempts(void)
+{
+    uint8_t m;
+
+    for (m = 0; m < SIM_MODULES; m++) {
+        totalAttempts += attempts[m];
+        totalRetries += attempts[m] - 1;
+        if (ok[m] == TRUE) {
+            check(attempts[m] <= 1 + retryCount, "retry budget", (int) period);
+        } else {
+            check(attempts[m] == 1 + ((retryCount < rounds) ? retryCount : rounds), "retried until exhausted", (int) period);
+        }
+    }
+}
+
+/**
+ * @brief SendData() of the communication module: check the reported record
+ *
+ * The records of the successful attempts are expected in module order,
+ * followed by the status bitmap.
+ */
+static ketCube_cfg_ModError_t simSend(uint8_t * buffer, uint8_t * len)
+{
+    uint8_t expect[UINT8_MAX];
+    uint8_t expectLen = 0;
+    uint8_t status = 0;
+    uint8_t m;
+
+    for (m = 0; m < SIM_MODULES; m++) {
+        if (ok[m] == TRUE) {
+            memcpy(&(expect[expectLen]), &(record[m][0]), recordLen[m]);
+            expectLen += recordLen[m];
+        } else {
+            status |= 1 << m;
+            totalMissing++;
+        }
+    }
+    expect[expectLen++] = status;
+
+    check(reported == FALSE, "reported once", (int) period);
+    check(*len == expectLen, "record length", (int) period);
+    check(memcmp(buffer, &(expect[0]), expectLen) == 0, "records in module order, status bitmap", (int) period);
+    checkAttempts();
+    reported = TRUE;
+
+    return KETCUBE_CFG_MODULE_OK;
+}
+
+void ketCube_deadband_Commit(ketCube_cfg_moduleIDs_t modId, const uint8_t * data, uint8_t len)
+{
+    uint8_t m;
+
+    for (m = 0; m < SIM_MODULES; m++) {
+        if (simId[m] == modId) {
+            check((ok[m] == TRUE) && (len == recordLen[m]) && (memcmp(data, &(record[m][0]), len) == 0),
+                  "deadband record of the module", (int) period);
+        }
+    }
+    commits++;
+}
+
+void ketCube_deadband_Reported(void)
+{
+    uint8_t m;
+    uint32_t okCnt = 0;
+
+    for (m = 0; m < SIM_MODULES; m++) {
+        okCnt += (ok[m] == TRUE);
+    }
+    check(commits == okCnt, "deadband records", (int) period);
+
+    /* the cut period is reported by ExecutePeriodic() before the next period samples */
+    if (pending == TRUE) {
+        pending = FALSE;
+        simPeriodBegin();
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+int main(void)
+{
+    uint32_t basePeriod, cuts = 0;
+    uint8_t cutRound, done, m, i;
+    bool cut;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    for (i = 0; i < ketCube_modules_CNT; i++) {
+        ketCube_modules_List[i].cfgPtr = &cfgOff;
+        ketCube_modules_List[i].fnGetSensorData = NULL;
+        ketCube_modules_List[i].fnSendData = NULL;
+        ketCube_modules_List[i].fnReceiveData = NULL;
+    }
+    for (m = 0; m < SIM_MODULES; m++) {
+        ketCube_modules_List[simId[m]].cfgPtr = &cfgOn;
+        ketCube_modules_List[simId[m]].fnGetSensorData = simGetFn[m];
+    }
+    ketCube_modules_List[sendId].cfgPtr = &cfgOn;
+    ketCube_modules_List[sendId].fnSendData = &simSend;
+
+    ketCube_coreCfg.repeatDelay = SIM_REPEAT_DELAY;
+
+    for (period = 0; period < SIM_PERIODS; period++) {
+        /* base period of 1 - 8 retry delays, retryCount 0 - 5 */
+        basePeriod = SIM_REPEAT_DELAY * (1 + simRandom(SIM_MAX_ATTEMPTS)) + simRandom(SIM_REPEAT_DELAY);
+        ketCube_coreCfg.basePeriod = basePeriod;
+        ketCube_coreCfg.retryCount = simRandom(6);
+        nextRetryCount = (ketCube_coreCfg.retryCount == 0) ? 1 : ketCube_coreCfg.retryCount;
+        nextRounds = (basePeriod - 1) / SIM_REPEAT_DELAY;
+        cut = (simRandom(1000) < SIM_CUT_PERMIL) && (period < SIM_PERIODS - 1);
+        cutRound = simRandom(SIM_MAX_ATTEMPTS);
+
+        if (pending == FALSE) {
+            simPeriodBegin();
+        }
+
+        ketCube_modules_ExecutePeriodic();
+        check(pending == FALSE, "cut period reported first", (int) period);
+
+        /* main loop: the retry timer fires after repeatDelay */
+        done = 0;
+        while ((retryTimer != NULL) && (retryTimer->IsStarted == true) && (reported == FALSE)) {
+            check(retryTimer->ReloadValue == SIM_REPEAT_DELAY, "retry delay", (int) period);
+            if ((cut == TRUE) && (done == cutRound)) {
+                /* the next period starts before the retry */
+                rounds = (rounds < done) ? rounds : done;
+                pending = TRUE;
+                cuts++;
+                break;
+            }
+            simTime += retryTimer->ReloadValue;
+            retryTimer->IsStarted = false;
+            ketCube_modules_ExecuteRetry();
+            done++;
+        }
+        check(done <= rounds, "retries within the base period", (int) period);
+        check((reported == TRUE) || (pending == TRUE), "reported", (int) period);
+
+        simTime += basePeriod;
+    }
+
+    printf("modules: %u periods (%u cut), %u GetSensorData() calls, %u retries, %u records missing\n",
+           SIM_PERIODS, cuts, totalAttempts, totalRetries, totalMissing);
+
+    if (fails != 0) {
+        return 1;
+    }
+
+    printf("PASS modules\n");
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file    test_oversample.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the oversampling summary encoder
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ketCube_coreCfg.h"
+#include "ketCube_oversample.h"
+
+#define MOD_ID       1      ///< Module index in ketCube_modules_List
+#define REC_LEN      8      ///< Record: int16, int32, uint8 fields and a trailing status byte
+#define FIELD_CNT    3
+#define SUMMARY_LEN  (REC_LEN + KETCUBE_OVERSAMPLE_COUNT_LEN + 3 * (2 + 4 + 1))
+
+static ketCube_oversample_field_t fields[FIELD_CNT] = {
+    {.field = 2 | KETCUBE_TSCODEC_FIELD_SIGNED},
+    {.field = 4 | KETCUBE_TSCODEC_FIELD_SIGNED},
+    {.field = 1},
+};
+static const uint8_t width[FIELD_CNT] = { 2, 4, 1 };
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL oversample %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+static void putField(uint8_t * data, int32_t value, uint8_t len)
+{
+    while (len-- > 0) {
+        data[len] = (uint8_t) value;
+        value >>= 8;
+    }
+}
+
+static int32_t clip(int32_t value, int32_t min, int32_t max)
+{
+    return (value < min) ? min : ((value > max) ? max : value);
+}
+
+/**
+ * @brief Sample a period of n samples, compare the summary with the double-precision reference
+ */
+static void period(int n, int noise, int step)
+{
+    uint8_t record[SUMMARY_LEN];
+    int32_t base[FIELD_CNT], value[FIELD_CNT], min[FIELD_CNT], max[FIELD_CNT];
+    int32_t got, sdMax;
+    double sum[FIELD_CNT] = { 0 }, sum2[FIELD_CNT] = { 0 };
+    double mean, sd;
+    uint8_t len, pos, i;
+    int k;
+
+    base[0] = rand() % 60000 - 30000;
+    base[1] = rand() - RAND_MAX / 2;
+    base[2] = rand() % 256;
+
+    for (k = 0; k < n; k++) {
+        value[0] = clip(base[0] + rand() % (1 + 2 * 200 * noise) - 200 * noise, INT16_MIN, INT16_MAX);
+        value[1] = base[1] + rand() % (1 + 2 * 50000 * noise) - 50000 * noise;
+        value[2] = clip(base[2] + rand() % (1 + 2 * 5 * noise) - 5 * noise, 0, UINT8_MAX);
+
+        pos = 0;
+        for (i = 0; i < FIELD_CNT; i++) {
+            putField(&(record[pos]), value[i], width[i]);
+            pos += width[i];
+            /* relative to base: keep the double sums exact */
+            sum[i] += value[i] - base[i];
+            sum2[i] += (double) (value[i] - base[i]) * (value[i] - base[i]);
+            if ((k == 0) || (value[i] < min[i])) {
+                min[i] = value[i];
+            }
+            if ((k == 0) || (value[i] > max[i])) {
+                max[i] = value[i];
+            }
+        }
+        record[REC_LEN - 1] = 0xA5;
+
+        if (k < (n - 1)) {
+            /* sub-periodic samples; the base period sample is summarized */
+            ketCube_oversample_Accumulate(MOD_ID, &(record[0]), REC_LEN);
+        }
+    }
+
+    len = ketCube_oversample_Summarize(MOD_ID, &(record[0]), REC_LEN, sizeof(record));
+    check(len == SUMMARY_LEN, "summary length", step);
+    check(record[REC_LEN - 1] == 0xA5, "undeclared bytes", step);
+    check(ketCube_tsCodec_GetField(&(record[REC_LEN]), KETCUBE_OVERSAMPLE_COUNT_LEN) == n, "sample count", step);
+
+    pos = 0;
+    for (i = 0; i < FIELD_CNT; i++) {
+        mean = sum[i] / n;
+        sd = sqrt(fmax(0.0, sum2[i] / n - mean * mean));
+        mean += base[i];
+        sdMax = (width[i] == 4) ? INT32_MAX : ((1 << (8 * width[i])) - 1);
+
+        got = ketCube_tsCodec_GetField(&(record[pos]), fields[i].field);
+        check(fabs(got - mean) <= 1.0, "mean", step);
+        pos += width[i];
+
+        got = ketCube_tsCodec_GetField(&(record[REC_LEN + KETCUBE_OVERSAMPLE_COUNT_LEN + 3 * (pos - width[i])]),
+                                       fields[i].field);
+        check(got == min[i], "min", step);
+        got = ketCube_tsCodec_GetField(&(record[REC_LEN + KETCUBE_OVERSAMPLE_COUNT_LEN + 3 * (pos - width[i]) + width[i]]),
+                                       fields[i].field);
+        check(got == max[i], "max", step);
+        got = ketCube_tsCodec_GetField(&(record[REC_LEN + KETCUBE_OVERSAMPLE_COUNT_LEN + 3 * (pos - width[i]) + 2 * width[i]]),
+                                       width[i]);
+        check(fabs(got - fmin(sd, sdMax)) <= 1.0 + sd * 1e-3, "standard deviation", step);
+    }
+}
+
+int main(void)
+{
+    uint8_t record[SUMMARY_LEN] = { 0 };
+    int step;
+
+    srand(1);
+    ketCube_coreCfg.oversamplePeriod = 1000;
+    ketCube_oversample_Declare(MOD_ID, &(fields[0]), FIELD_CNT);
+    check(ketCube_oversample_Declared(MOD_ID) == TRUE, "declared", 0);
+
+    for (step = 0; step < 20000; step++) {
+        period(1 + rand() % 600, rand() % 4, step);
+    }
+
+    /* single sample: no spread */
+    period(1, 3, -1);
+
+    /* the summary does not fit: the record is kept as it is */
+    ketCube_oversample_Accumulate(MOD_ID, &(record[0]), REC_LEN);
+    check(ketCube_oversample_Summarize(MOD_ID, &(record[0]), REC_LEN, SUMMARY_LEN - 1) == REC_LEN, "summary does not fit", 0);
+
+    /* short record: not accumulated */
+    ketCube_oversample_Accumulate(MOD_ID, &(record[0]), 2);
+    check(ketCube_oversample_Summarize(MOD_ID, &(record[0]), REC_LEN, SUMMARY_LEN) == SUMMARY_LEN, "short record", 0);
+    check(ketCube_tsCodec_GetField(&(record[REC_LEN]), KETCUBE_OVERSAMPLE_COUNT_LEN) == 1, "short record count", 0);
+
+    /* oversampling disabled */
+    ketCube_coreCfg.oversamplePeriod = 0;
+    check(ketCube_oversample_Declared(MOD_ID) == FALSE, "disabled", 0);
+    check(ketCube_oversample_Summarize(MOD_ID, &(record[0]), REC_LEN, SUMMARY_LEN) == REC_LEN, "disabled summary", 0);
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS oversample: %d periods\n", step);
+
+    return 0;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file    test_pwrMan.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host simulation of the peripheral power manager: wake-to-sleep time saved per wake-up class
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * A day of wake-ups of a sensing LoRa node is replayed through the power
+ * manager. Each wake-up executes a handler, which uses some peripherals;
+ * the registered restore hooks advance the SysTick cycle counter by the
+ * restoration cost of the peripheral. The wake-to-sleep time of the lazy
+ * restoration is compared with the eager one (all peripherals restored
+ * on every low-power mode exit) and with the savings reported by pwrMan.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "ketCube_pwrMan.h"
+#include "ketCube_terminal.h"
+
+#define SIM_CORE_CLOCK          32000000        ///< MSI/PLL run clock
+#define SIM_DAY_S               (24 * 3600)
+#define SIM_PERIOD_S            300             ///< Sensing and uplink period
+#define SIM_TIMER_S             60              ///< Housekeeping timer
+#define SIM_SENSOR_IRQ_S        120             ///< Mean period of the accelerometer IRQ
+#define SIM_TERMINAL_BYTES      300             ///< Terminal bytes per day
+
+#define P(periph)               (1 << KETCUBE_PWRMAN_PERIPH_ ## periph)
+
+/**
+* @brief Restoration cost of the registered peripherals (us)
+*/
+static const uint32_t restoreUs[KETCUBE_PWRMAN_PERIPH_CNT] = {
+    [KETCUBE_PWRMAN_PERIPH_SPI] = 40,       /* HAL_SPI_Init(), AF pins */
+    [KETCUBE_PWRMAN_PERIPH_RADIO] = 150,    /* SX1276 board IO and DIO EXTIs */
+    [KETCUBE_PWRMAN_PERIPH_I2C] = 5,        /* clock and PE */
+    [KETCUBE_PWRMAN_PERIPH_AD] = 2000,      /* VREFINT start-up */
+};
+
+/**
+* @brief Wake-up handler
+*/
+typedef struct {
+    const char *name;
+    ketCube_pwrMan_wakeClass_t wakeClass;
+    uint8_t used;               /*!< peripherals used by the handler */
+    uint32_t runUs;             /*!< handler run time, restorations excluded */
+} handler_t;
+
+static const handler_t hSensing = { "sensing and uplink", KETCUBE_PWRMAN_WAKE_RTC, P(I2C) | P(AD) | P(SPI) | P(RADIO), 25000 };
+static const handler_t hRxWindow = { "RX window", KETCUBE_PWRMAN_WAKE_RTC, P(SPI) | P(RADIO), 300 };
+static const handler_t hRadioIrq = { "radio DIO", KETCUBE_PWRMAN_WAKE_EXTI, P(SPI) | P(RADIO), 400 };
+static const handler_t hTimer = { "housekeeping timer", KETCUBE_PWRMAN_WAKE_RTC, 0, 30 };
+static const handler_t hSensorIrq = { "accelerometer IRQ", KETCUBE_PWRMAN_WAKE_EXTI, P(I2C), 600 };
+static const handler_t hTerminal = { "terminal byte", KETCUBE_PWRMAN_WAKE_UART, 0, 20 };
+static const handler_t hUnknown = { "no IRQ", KETCUBE_PWRMAN_WAKE_OTHER, 0, 10 };
+
+static const char *className[KETCUBE_PWRMAN_WAKE_CNT] = { "RTC", "UART", "EXTI", "OTHER" };
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL pwrMan %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+uint32_t SystemCoreClock = SIM_CORE_CLOCK;
+uint32_t stub_primask = 0;
+
+void stub_wfi(void)
+{
+}
+
+static char termOut[2048];      ///< ketCube_terminal_UsartPrint() output
+
+void ketCube_terminal_UsartPrint(char *format, ...)
+{
+    size_t len = strlen(termOut);
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(&(termOut[len]), sizeof(termOut) - len, format, args);
+    va_end(args);
+}
+
+static struct {
+    uint32_t restores[KETCUBE_PWRMAN_PERIPH_CNT];
+    uint32_t releases[KETCUBE_PWRMAN_PERIPH_CNT];
+    uint8_t restoredMask;       /*!< restored in the current window */
+} hooks;
+
+/**
+ * @brief Restoration takes restoreUs; SysTick counts down
+ */
+static ketCube_cfg_DrvError_t restore(ketCube_pwrMan_periph_t periph)
+{
+    check((hooks.restoredMask & (1 << periph)) == 0, "restored twice in a window", periph);
+    hooks.restoredMask |= (1 << periph);
+    hooks.restores[periph]++;
+    SysTick->VAL = (SysTick->VAL - restoreUs[periph] * (SIM_CORE_CLOCK / 1000000)) & KETCUBE_PWRMAN_CYCLES_MASK;
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+static ketCube_cfg_DrvError_t release(ketCube_pwrMan_periph_t periph)
+{
+    hooks.releases[periph]++;
+
+    return KETCUBE_CFG_DRV_OK;
+}
+
+static ketCube_cfg_DrvError_t spiAcquire(void) { return restore(KETCUBE_PWRMAN_PERIPH_SPI); }
+static ketCube_cfg_DrvError_t radioAcquire(void) { return restore(KETCUBE_PWRMAN_PERIPH_RADIO); }
+static ketCube_cfg_DrvError_t i2cAcquire(void) { return restore(KETCUBE_PWRMAN_PERIPH_I2C); }
+static ketCube_cfg_DrvError_t adAcquire(void) { return restore(KETCUBE_PWRMAN_PERIPH_AD); }
+static ketCube_cfg_DrvError_t spiRelease(void) { return release(KETCUBE_PWRMAN_PERIPH_SPI); }
+static ketCube_cfg_DrvError_t i2cRelease(void) { return release(KETCUBE_PWRMAN_PERIPH_I2C); }
+static ketCube_cfg_DrvError_t adRelease(void) { return release(KETCUBE_PWRMAN_PERIPH_AD); }
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+/**
+* @brief Wake-to-sleep time per wake-up class
+*/
+static struct {
+    uint32_t wakeCnt;
+    uint64_t eagerUs;           /*!< all peripherals restored on exit */
+    uint64_t lazyUs;            /*!< peripherals restored on first use */
+    uint64_t savedUs;           /*!< expected pwrMan savings */
+} sim[KETCUBE_PWRMAN_WAKE_CNT];
+
+static uint8_t measuredMask = 0;        ///< pwrMan knows the restoration cost
+
+static uint32_t sumUs(uint8_t mask)
+{
+    uint32_t us = 0;
+    uint8_t i;
+
+    for (i = 0; i < KETCUBE_PWRMAN_PERIPH_CNT; i++) {
+        if ((mask & (1 << i)) != 0) {
+            us += restoreUs[i];
+        }
+    }
+
+    return us;
+}
+
+/**
+ * @brief Low-power mode exit, handler and low-power mode entry
+ */
+static void wakeUp(const handler_t * h, int step)
+{
+    const uint8_t registered = P(SPI) | P(RADIO) | P(I2C) | P(AD);
+    uint8_t i;
+
+    hooks.restoredMask = 0;
+
+    ketCube_pwrMan_SleepExit();
+    /* the wake-up IRQ is serviced after the exit (IRQs masked in low-power mode) */
+    if (h->wakeClass != KETCUBE_PWRMAN_WAKE_OTHER) {
+        ketCube_pwrMan_WakeEvent(h->wakeClass);
+    }
+    for (i = 0; i < KETCUBE_PWRMAN_PERIPH_CNT; i++) {
+        if ((h->used & (1 << i)) != 0) {
+            /* every bus access acquires the peripheral */
+            ketCube_pwrMan_Acquire((ketCube_pwrMan_periph_t) i);
+            ketCube_pwrMan_Acquire((ketCube_pwrMan_periph_t) i);
+        }
+    }
+    ketCube_pwrMan_SleepEnter();
+
+    check(hooks.restoredMask == h->used, "restored peripherals", step);
+    check(ketCube_pwrMan_activeMask == 0, "released before sleep", step);
+
+    sim[h->wakeClass].wakeCnt++;
+    sim[h->wakeClass].eagerUs += h->runUs + sumUs(registered);
+    sim[h->wakeClass].lazyUs += h->runUs + sumUs(h->used);
+    sim[h->wakeClass].savedUs += sumUs(registered & ~(h->used) & measuredMask);
+    measuredMask |= h->used;
+}
+
+/**
+ * @brief Reported statistics of the wake-up class
+ */
+static void reported(ketCube_pwrMan_wakeClass_t wakeClass, uint32_t * wakeCnt, uint32_t * savedUs)
+{
+    char prefix[16];
+    char *line;
+
+    termOut[0] = '\0';
+    ketCube_pwrMan_PrintStats();
+    snprintf(prefix, sizeof(prefix), "%-6s: ", className[wakeClass]);
+    line = strstr(termOut, prefix);
+    check((line != NULL) && (sscanf(line + strlen(prefix), "%u wake-ups; %*u restorations avoided; %u us saved",
+                                    wakeCnt, savedUs) == 2), "statistics output", wakeClass);
+}
+
+int main(void)
+{
+    uint32_t t, next;
+    uint32_t wakeCnt, savedUs;
+    int step = 0;
+    uint8_t i;
+
+    /* System Control Space (SysTick) as plain memory */
+    if (mmap((void *) SCS_BASE, 0x1000, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+             -1, 0) != (void *) SCS_BASE) {
+        printf("FAIL pwrMan cannot map SysTick\n");
+        return 1;
+    }
+
+    ketCube_pwrMan_Init();
+    check(SysTick->LOAD == KETCUBE_PWRMAN_CYCLES_MASK, "SysTick free-running", 0);
+
+    /* drivers initialized at start-up; I2C and AD are gated in low-power modes */
+    ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_SPI, &spiAcquire, &spiRelease);
+    ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_RADIO, &radioAcquire, NULL);
+    ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_I2C, &i2cAcquire, &i2cRelease);
+    ketCube_pwrMan_Register(KETCUBE_PWRMAN_PERIPH_AD, &adAcquire, &adRelease);
+    ketCube_pwrMan_SleepEnter();
+
+    srand(26);
+    for (t = 0, next = 0; t < SIM_DAY_S; t++) {
+        if ((t % SIM_PERIOD_S) == 0) {
+            /* uplink, TX done, RX1 and RX2 windows with timeouts */
+            wakeUp(&hSensing, step++);
+            wakeUp(&hRadioIrq, step++);
+            wakeUp(&hRxWindow, step++);
+            wakeUp(&hRadioIrq, step++);
+            wakeUp(&hRxWindow, step++);
+            wakeUp(&hRadioIrq, step++);
+        }
+        if ((t % SIM_TIMER_S) == 7) {
+            wakeUp(&hTimer, step++);
+        }
+        if ((rand() % SIM_SENSOR_IRQ_S) == 0) {
+            wakeUp(&hSensorIrq, step++);
+        }
+        if (t == next) {
+            /* terminal commands: bursts of 15 bytes */
+            for (i = 0; i < 15; i++) {
+                wakeUp(&hTerminal, step++);
+            }
+            next = t + 1 + rand() % (2 * SIM_DAY_S * 15 / SIM_TERMINAL_BYTES);
+        }
+        if ((rand() % 3600) == 0) {
+            wakeUp(&hUnknown, step++);
+        }
+    }
+
+    for (i = 0; i < KETCUBE_PWRMAN_WAKE_CNT; i++) {
+        reported((ketCube_pwrMan_wakeClass_t) i, &wakeCnt, &savedUs);
+        check(wakeCnt == sim[i].wakeCnt, "wake-up count", i);
+        check(savedUs == sim[i].savedUs, "time saved", i);
+        /* all costs are measured by the first wake-up, which uses all peripherals */
+        check(sim[i].eagerUs - sim[i].lazyUs == sim[i].savedUs, "eager - lazy", i);
+        printf("  %-5s: %6u wake-ups, wake-to-sleep %8.1f us eager, %8.1f us lazy (%5.1f %% saved)\n",
+               className[i], sim[i].wakeCnt,
+               (double) sim[i].eagerUs / sim[i].wakeCnt, (double) sim[i].lazyUs / sim[i].wakeCnt,
+               100.0 * (sim[i].eagerUs - sim[i].lazyUs) / sim[i].eagerUs);
+    }
+
+    /* terminal bytes and timers do not touch any peripheral */
+    check(sim[KETCUBE_PWRMAN_WAKE_UART].lazyUs * 50 < sim[KETCUBE_PWRMAN_WAKE_UART].eagerUs, "UART wake-up saving", 0);
+    check(hooks.restores[KETCUBE_PWRMAN_PERIPH_AD] == SIM_DAY_S / SIM_PERIOD_S, "ADC restored per period", 0);
+    check(hooks.releases[KETCUBE_PWRMAN_PERIPH_AD] == hooks.restores[KETCUBE_PWRMAN_PERIPH_AD] + 1, "ADC released", 0);
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS pwrMan: %d wake-ups\n", step);
+
+    return 0;
+}
@@ -0,0 +1,338 @@
+/**
+ * @file    test_sfQueue.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the store-and-forward queue: link outages, resets and power loss
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_sfQueue.h"
+#include "stub.h"
+
+#define SIM_TIME        (30 * 24 * 3600)    ///< Simulated time in seconds
+#define PERIOD          60                  ///< Record period in seconds
+#define DRAIN_PERIOD    10                  ///< Queued uplink period in seconds
+#define RECORDS         (SIM_TIME / PERIOD + 1)
+#define PORT            5
+#define FULL_PORT       15                  ///< Port of the full-frame records
+#define SLOT_PARTS(len) (((len) > KETCUBE_SFQUEUE_SLOT_DATA_LEN) ? (((len) + KETCUBE_SFQUEUE_SLOT_DATA_LEN - 1) / KETCUBE_SFQUEUE_SLOT_DATA_LEN) : 1)
+
+/**
+* @brief Record fate
+*/
+typedef enum {
+    FATE_NONE = 0,
+    FATE_SENT,          /*!< sent without queueing */
+    FATE_QUEUED,        /*!< stored into the queue */
+    FATE_REJECTED,      /*!< full queue, KETCUBE_SFQUEUE_POLICY_DROP_NEWEST */
+    FATE_TORN,          /*!< power loss during the push */
+    FATE_RECEIVED,      /*!< queued and sent */
+} fate_t;
+
+/**
+* @brief Reference of generated records
+*/
+static struct {
+    uint8_t fate;
+    uint32_t time;      /*!< acquisition time */
+    uint32_t lag;       /*!< queue clock lag at the push */
+} ref[RECORDS];
+
+static uint32_t realTime;       ///< Simulated real time
+static uint32_t bootTime;       ///< Real time of the last reset
+static uint32_t lag;            ///< Queue clock lag caused by resets
+static uint32_t newest;         ///< Acquisition time of the newest queued record
+static uint32_t newestLag;      ///< Queue clock lag at the push of the newest queued record
+
+static int fails = 0;
+
+static void check(int cond, const char *what, uint32_t id)
+{
+    if (!cond) {
+        printf("FAIL sfQueue %s (record %u, t = %u s)\n", what, id, realTime);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/**
+ * @brief Record length: every 8th record is a full-frame batch, others take 1 - 3 slots
+ */
+static uint8_t recordLen(uint32_t id)
+{
+    if ((id % 8) == 0) {
+        return KETCUBE_SFQUEUE_DATA_LEN;
+    }
+    return 8 + (id * 37) % (3 * KETCUBE_SFQUEUE_SLOT_DATA_LEN - 8);
+}
+
+static void makeRecord(uint32_t id, uint8_t * data)
+{
+    uint8_t i;
+
+    memcpy(data, &id, sizeof(id));
+    for (i = sizeof(id); i < recordLen(id); i++) {
+        data[i] = (uint8_t) (id * 7 + i);
+    }
+}
+
+/**
+ * @brief Reset: the RTC restarts, the queue clock continues from the newest record
+ */
+static void reset(void)
+{
+    if (ketCube_sfQueue_Count() > 0) {
+        lag = newestLag + (realTime - newest);
+    }
+    bootTime = realTime;
+    stub_time = 0;
+    ketCube_sfQueue_Init();
+}
+
+/**
+ * @brief Send the oldest queued record and check it
+ */
+static void drain(uint32_t * lastId)
+{
+    ketCube_sfQueue_record_t rec;
+    uint8_t expected[KETCUBE_SFQUEUE_DATA_LEN];
+    uint32_t id, age;
+
+    check(ketCube_sfQueue_Peek(&rec) == KETCUBE_CFG_MODULE_OK, "peek", 0);
+    memcpy(&id, &(rec.data[0]), sizeof(id));
+    check(id < RECORDS, "record id", id);
+    if (id >= RECORDS) {
+        exit(1);
+    }
+
+    makeRecord(id, &(expected[0]));
+    check((rec.port == PORT) && (rec.len == recordLen(id))
+          && (memcmp(&(rec.data[0]), &(expected[0]), rec.len) == 0), "record content", id);
+    check(ref[id].fate == FATE_QUEUED, "record not queued or duplicated", id);
+    check((*lastId == UINT32_MAX) || (id > *lastId), "record order", id);
+
+    /* resets during the queueing shorten the age by the clock lag */
+    age = ketCube_sfQueue_Now() - rec.timestamp;
+    check(age == (realTime - ref[id].time) - (lag - ref[id].lag), "record age", id);
+
+    ref[id].fate = FATE_RECEIVED;
+    *lastId = id;
+    ketCube_sfQueue_Pop();
+}
+
+static void simulate(ketCube_sfQueue_policy_t policy)
+{
+    uint8_t data[KETCUBE_SFQUEUE_DATA_LEN];
+    uint32_t id = 0, lastId = UINT32_MAX;
+    uint32_t nextToggle = 3600, nextReset = 5000, nextDrain = 0;
+    uint32_t dropped = 0, resets = 0, cnt[FATE_RECEIVED + 1] = { 0 };
+    uint32_t delay, i;
+    uint8_t before;
+    bool up = TRUE;
+    bool stored;
+
+    memset(&(stub_eeprom[0]), 0, STUB_EEPROM_LEN);
+    memset(&(ref[0]), 0, sizeof(ref));
+    realTime = 0;
+    reset();
+    lag = 0;
+
+    for (realTime = 0; realTime <= SIM_TIME; realTime++, stub_time++) {
+        /* coverage gaps of 10 min ... 3 h */
+        if (realTime == nextToggle) {
+            up = !up;
+            nextToggle = realTime + 600 + rand() % (up ? 7200 : 3 * 3600);
+        }
+
+        if (realTime == nextReset) {
+            resets++;
+            reset();
+            nextReset = realTime + 1000 + rand() % 30000;
+        }
+
+        if ((realTime % PERIOD) == 0) {
+            makeRecord(id, &(data[0]));
+            ref[id].time = realTime;
+            ref[id].lag = lag;
+
+            if (up && (ketCube_sfQueue_Count() == 0)) {
+                ref[id].fate = FATE_SENT;
+            } else {
+                /* records acquired before a failed uplink are pushed later */
+                delay = (rand() % 4 == 0) ? rand() % 30 : 0;
+                ref[id].time -= delay;
+                if ((rand() % 200) == 0) {
+                    /* power loss during one of the EEPROM writes of the push */
+                    stub_eepromFailAt = stub_eepromWrites + rand() % (SLOT_PARTS(recordLen(id)) + 2);
+                }
+                before = ketCube_sfQueue_Count();
+                stored = (ketCube_sfQueue_Push(PORT, &(data[0]), recordLen(id), delay, policy) == KETCUBE_CFG_MODULE_OK);
+                if (stored) {
+                    ref[id].fate = FATE_QUEUED;
+                    newest = ref[id].time;
+                    newestLag = ref[id].lag;
+                }
+                /* the oldest records are dropped to free the slots for the push */
+                dropped += before + (stored ? 1 : 0) - ketCube_sfQueue_Count();
+
+                if ((stub_eepromFailAt >= 0) && ((int32_t) stub_eepromWrites > stub_eepromFailAt)) {
+                    if (!stored) {
+                        ref[id].fate = FATE_TORN;
+                    }
+                    resets++;
+                    reset();
+                } else if (!stored) {
+                    check(policy == KETCUBE_SFQUEUE_POLICY_DROP_NEWEST, "push", id);
+                    ref[id].fate = FATE_REJECTED;
+                }
+                stub_eepromFailAt = -1;
+            }
+            id++;
+        }
+
+        if (up && (realTime >= nextDrain) && (ketCube_sfQueue_Count() > 0)) {
+            drain(&lastId);
+            nextDrain = realTime + DRAIN_PERIOD;
+        }
+    }
+
+    /* flush */
+    while (ketCube_sfQueue_Count() > 0) {
+        drain(&lastId);
+    }
+
+    for (i = 0; i < id; i++) {
+        cnt[ref[i].fate]++;
+    }
+    /* the dropped records are the only queued ones never received */
+    check(cnt[FATE_QUEUED] == dropped, "lost records", cnt[FATE_QUEUED]);
+    check((policy == KETCUBE_SFQUEUE_POLICY_DROP_OLDEST) || (dropped == 0), "dropped records", dropped);
+
+    /* no EEPROM write outside the queue */
+    for (i = 0; i < STUB_EEPROM_LEN; i++) {
+        if ((i < KETCUBE_SFQUEUE_EEPROM_ADDR) || (i >= KETCUBE_SFQUEUE_EEPROM_ADDR + KETCUBE_SFQUEUE_EEPROM_LEN)) {
+            check(stub_eeprom[i] == 0, "EEPROM write outside the queue", i);
+        }
+    }
+
+    printf("sfQueue policy %d: %u records, %u sent, %u queued and sent, %u dropped, %u rejected, %u torn, %u resets\n",
+           policy, id, cnt[FATE_SENT], cnt[FATE_RECEIVED], dropped,
+           cnt[FATE_REJECTED], cnt[FATE_TORN], resets);
+}
+
+/**
+ * @brief Full-frame records (max. LoRaWAN payload, e.g. a full batch) take several slots
+ */
+static void fullFrame(void)
+{
+    ketCube_sfQueue_record_t rec;
+    uint8_t data[KETCUBE_SFQUEUE_DATA_LEN];
+    uint8_t parts = SLOT_PARTS(KETCUBE_SFQUEUE_DATA_LEN);
+    uint32_t i, n;
+
+    realTime = 0;
+    stub_time = 1000;
+    memset(&(stub_eeprom[0]), 0, STUB_EEPROM_LEN);
+    ketCube_sfQueue_Init();
+
+    /* start near the queue end, so the records wrap */
+    for (i = 0; i < KETCUBE_SFQUEUE_SLOTS - 2; i++) {
+        check(ketCube_sfQueue_Push(PORT, &(data[0]), 4, 0, KETCUBE_SFQUEUE_POLICY_DROP_OLDEST) == KETCUBE_CFG_MODULE_OK, "full frame: fill", i);
+    }
+    ketCube_sfQueue_Clear();
+
+    for (n = 0; n < KETCUBE_SFQUEUE_SLOTS / parts; n++) {
+        for (i = 0; i < KETCUBE_SFQUEUE_DATA_LEN; i++) {
+            data[i] = (uint8_t) (n * 31 + i);
+        }
+        check(ketCube_sfQueue_Push(FULL_PORT, &(data[0]), KETCUBE_SFQUEUE_DATA_LEN, KETCUBE_SFQUEUE_SLOTS / parts - 1 - n, KETCUBE_SFQUEUE_POLICY_DROP_NEWEST) == KETCUBE_CFG_MODULE_OK, "full frame: push", n);
+    }
+    check(ketCube_sfQueue_Push(FULL_PORT, &(data[0]), KETCUBE_SFQUEUE_DATA_LEN, 0, KETCUBE_SFQUEUE_POLICY_DROP_NEWEST) != KETCUBE_CFG_MODULE_OK, "full frame: reject", n);
+
+    /* recovered after reset; the oldest ones make space for small records */
+    ketCube_sfQueue_Init();
+    check(ketCube_sfQueue_Count() == n, "full frame: count after reset", n);
+    for (i = 0; i < KETCUBE_SFQUEUE_SLOTS % parts + 1; i++) {
+        check(ketCube_sfQueue_Push(PORT, &(data[0]), 4, 0, KETCUBE_SFQUEUE_POLICY_DROP_OLDEST) == KETCUBE_CFG_MODULE_OK, "full frame: small push", i);
+    }
+    check(ketCube_sfQueue_Count() == n - 1 + i, "full frame: dropped", i);
+
+    for (n = 1; n < KETCUBE_SFQUEUE_SLOTS / parts; n++) {
+        check(ketCube_sfQueue_Peek(&rec) == KETCUBE_CFG_MODULE_OK, "full frame: peek", n);
+        for (i = 0; i < KETCUBE_SFQUEUE_DATA_LEN; i++) {
+            data[i] = (uint8_t) (n * 31 + i);
+        }
+        check((rec.port == FULL_PORT) && (rec.len == KETCUBE_SFQUEUE_DATA_LEN)
+              && (memcmp(&(rec.data[0]), &(data[0]), KETCUBE_SFQUEUE_DATA_LEN) == 0), "full frame: content", n);
+        check(ketCube_sfQueue_Now() - rec.timestamp == KETCUBE_SFQUEUE_SLOTS / parts - 1 - n, "full frame: age", n);
+        ketCube_sfQueue_Pop();
+    }
+    check((ketCube_sfQueue_Peek(&rec) == KETCUBE_CFG_MODULE_OK) && (rec.port == PORT) && (rec.len == 4), "full frame: small record", 0);
+    ketCube_sfQueue_Clear();
+}
+
+int main(void)
+{
+    ketCube_sfQueue_record_t rec;
+    uint8_t data[KETCUBE_SFQUEUE_DATA_LEN + 1] = { 0 };
+
+    srand(1);
+
+    simulate(KETCUBE_SFQUEUE_POLICY_DROP_OLDEST);
+    simulate(KETCUBE_SFQUEUE_POLICY_DROP_NEWEST);
+    fullFrame();
+
+    /* disabled queue, oversized record */
+    ketCube_sfQueue_Clear();
+    check(ketCube_sfQueue_Push(PORT, &(data[0]), 4, 0, KETCUBE_SFQUEUE_POLICY_DISABLED) != KETCUBE_CFG_MODULE_OK, "disabled push", 0);
+    check(ketCube_sfQueue_Push(PORT, &(data[0]), KETCUBE_SFQUEUE_DATA_LEN + 1, 0, KETCUBE_SFQUEUE_POLICY_DROP_OLDEST) != KETCUBE_CFG_MODULE_OK, "oversized push", 0);
+    check((ketCube_sfQueue_Count() == 0) && (ketCube_sfQueue_Peek(&rec) != KETCUBE_CFG_MODULE_OK), "empty queue", 0);
+
+    if (fails > 0) {
+        return 1;
+    }
+    printf("PASS sfQueue\n");
+
+    return 0;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file    test_timeSync.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host test of the drift-corrected local time and network time calibration
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+/*
+ * The RTC of a node runs slow by a known drift plus the crystal
+ * temperature term of a daily temperature cycle. The node requests the
+ * network time (LoRaWAN DeviceTimeReq) before uplinks when
+ * ketCube_timeSync_RequestDue() says so; some requests are not answered,
+ * answers carry latency jitter. The answer is applied as by the MAC
+ * (SysTimeSet()) and reported by ketCube_timeSync_Update().
+ * 
+ * The learned drift is compared with the known drift and the network time
+ * of the local time with the true time.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ketCube_coreCfg.h"
+#include "ketCube_timeSync.h"
+#include "systime.h"
+
+#define SIM_UNIX_BASE           1800000000.0    ///< Network time at the simulation start in s
+#define SIM_STEP_S              600             ///< Uplink period
+#define SIM_DAYS                30
+#define SIM_SYNC_PERIOD_S       86400           ///< timeSyncPeriod
+#define SIM_LOSS_PERMIL         200             ///< Unanswered time requests
+#define SIM_JITTER_MS           20.0            ///< Answer latency jitter (uniform)
+#define SIM_TEMP_MEAN           25.0            ///< Crystal temperature: daily cycle
+#define SIM_TEMP_AMPL           10.0
+#define SIM_TEMP_COEF_PPB       35.0            ///< Crystal slows down by 35 ppb/degC^2 off the turnover
+#define SIM_SETTLE_DAYS         10              ///< Calibration settling excluded from statistics
+#define SIM_DRIFT_TOL_PPB       1000            ///< Learned drift tolerance
+#define SIM_TIME_TOL_MS         2000            ///< Network time tolerance, incl. the truncations of the local and network time to s
+
+static int fails = 0;
+
+static void check(int cond, const char *what, int step)
+{
+    if (!cond) {
+        printf("FAIL timeSync %s (step %d)\n", what, step);
+        if (++fails > 10) {
+            exit(1);
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+/* Stubs                                                                  */
+/* ---------------------------------------------------------------------- */
+
+ketCube_coreCfg_t ketCube_coreCfg;
+
+static double mcuMs;            ///< RTC calendar in ms
+static int64_t sysOffsetMs;     ///< SysTime to RTC calendar offset in ms
+static uint32_t rnd = 1;
+
+static SysTime_t simSysTime(int64_t ms)
+{
+    SysTime_t t;
+
+    t.Seconds = (uint32_t) (ms / 1000);
+    t.SubSeconds = (int16_t) (ms % 1000);
+
+    return t;
+}
+
+SysTime_t SysTimeGetMcuTime(void)
+{
+    return simSysTime((int64_t) mcuMs);
+}
+
+SysTime_t SysTimeGet(void)
+{
+    return simSysTime(((int64_t) mcuMs) + sysOffsetMs);
+}
+
+void SysTimeSet(SysTime_t sysTime)
+{
+    sysOffsetMs = ((int64_t) sysTime.Seconds) * 1000 + sysTime.SubSeconds - (int64_t) mcuMs;
+}
+
+/**
+ * @brief Uniform random number 0 - 1
+ */
+static double simRandom(void)
+{
+    rnd = rnd * 1103515245U + 12345U;
+
+    return (rnd >> 8) / 16777215.0;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Simulation                                                             */
+/* ---------------------------------------------------------------------- */
+
+/**
+ * @brief Crystal temperature
+ */
+static double simTemperature(double t)
+{
+    return SIM_TEMP_MEAN + SIM_TEMP_AMPL * sin(2.0 * M_PI * t / 86400.0);
+}
+
+/**
+ * @brief Run the node
+ *
+ * @param driftPpb RTC drift at the turnover temperature; positive if the RTC runs slow
+ * @param expectPpb expected calibration term
+ * @param name run name
+ *
+ * @retval max. network time error after settling in ms
+ */
+static double run(int32_t driftPpb, int32_t expectPpb, const char *name)
+{
+    double t = 0.0, temp, errMs, tolMs, answerT = 0.0, maxErrMs = 0.0, maxRtcErrMs = 0.0, maxDriftErr = 0.0;
+    int64_t netMs;
+    uint32_t now, last = 0, unixTime, answers = 0, requests = 0;
+    int32_t drift;
+    int step;
+
+    mcuMs = 0.0;
+    sysOffsetMs = 0;
+    ketCube_coreCfg.timeSyncPeriod = SIM_SYNC_PERIOD_S;
+    ketCube_timeSync_Init();
+    check(ketCube_timeSync_ToUnix(0, &unixTime) == FALSE, "no network time before the first answer", 0);
+
+    for (step = 0; step < SIM_DAYS * 86400 / SIM_STEP_S; step++) {
+        /* the RTC calendar advances at the crystal rate */
+        temp = simTemperature(t);
+        mcuMs += SIM_STEP_S * 1000.0
+            * (1.0 - (driftPpb + SIM_TEMP_COEF_PPB * (temp - SIM_TEMP_MEAN) * (temp - SIM_TEMP_MEAN)) / 1e9);
+        t += SIM_STEP_S;
+
+        /* uplink: the temperature is reported first */
+        ketCube_timeSync_SetTemperature((int8_t) lround(simTemperature(t)));
+
+        now = ketCube_timeSync_Now();
+        check(now >= last, "local time never steps back", step);
+        check(now - last <= SIM_STEP_S + 1, "local time never steps forward", step);
+        last = now;
+
+        if (ketCube_timeSync_RequestDue() == TRUE) {
+            requests++;
+            if (simRandom() * 1000.0 >= SIM_LOSS_PERMIL) {
+                netMs = (int64_t) ((SIM_UNIX_BASE + t) * 1000.0 + SIM_JITTER_MS * (2.0 * simRandom() - 1.0));
+                SysTimeSet(simSysTime(netMs));
+                ketCube_timeSync_Update();
+                answers++;
+                answerT = t;
+
+                /* the MAC reports again without a new answer */
+                drift = ketCube_timeSync_GetDrift();
+                ketCube_timeSync_Update();
+                check(ketCube_timeSync_GetDrift() == drift, "repeated update ignored", step);
+            }
+        }
+
+        if ((answers == 0) || (t < SIM_SETTLE_DAYS * 86400.0)) {
+            continue;
+        }
+
+        check(ketCube_timeSync_ToUnix(now, &unixTime) == TRUE, "network time known", step);
+        errMs = ((double) unixTime) * 1000.0 - (SIM_UNIX_BASE + t) * 1000.0;
+        maxErrMs = (fabs(errMs) > maxErrMs) ? fabs(errMs) : maxErrMs;
+        /* a clamped calibration leaves the rest of the drift since the last answer */
+        tolMs = SIM_TIME_TOL_MS + abs(driftPpb - expectPpb) * (t - answerT) / 1e6;
+        check(fabs(errMs) <= tolMs, "network time of the local time", step);
+
+        /* the temperature term is applied separately: the calibration learns the drift */
+        temp = (double) lround(simTemperature(t)) - SIM_TEMP_MEAN;
+        errMs = ketCube_timeSync_GetDrift() - SIM_TEMP_COEF_PPB * temp * temp - expectPpb;
+        maxDriftErr = (fabs(errMs) > maxDriftErr) ? fabs(errMs) : maxDriftErr;
+        check(fabs(errMs) <= SIM_DRIFT_TOL_PPB, "learned drift", step);
+
+        /* uncorrected RTC since the last answer */
+        errMs = (mcuMs + sysOffsetMs) - (SIM_UNIX_BASE + t) * 1000.0;
+        maxRtcErrMs = (fabs(errMs) > maxRtcErrMs) ? fabs(errMs) : maxRtcErrMs;
+    }
+
+    check(requests > answers, "requests retried", (int) requests);
+    check(answers >= SIM_DAYS - 1, "daily answers", (int) answers);
+
+    printf("timeSync: %s: drift %d ppb, calibration %d ppb learned within %d ppb; max. network time error %.0f ms (1 s resolution), SysTime without drift correction %.0f ms; %u requests, %u answers\n",
+           name, driftPpb, expectPpb, (int) lround(maxDriftErr), maxErrMs, maxRtcErrMs, requests, answers);
+
+    return maxErrMs;
+}
+
+int main(void)
+{
+    uint32_t unixTime;
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    run(20000, 20000, "20 ppm slow");
+    run(-50000, -50000, "50 ppm fast");
+    run(0, 0, "no drift");
+    run(300000, KETCUBE_TIMESYNC_MAX_PPB, "300 ppm slow (clamped)");
+
+    /* disabled */
+    ketCube_coreCfg.timeSyncPeriod = 0;
+    ketCube_timeSync_Init();
+    check(ketCube_timeSync_RequestDue() == FALSE, "disabled", 0);
+    check(ketCube_timeSync_ToUnix(0, &unixTime) == FALSE, "disabled: no network time", 0);
+
+    if (fails != 0) {
+        return 1;
+    }
+
+    printf("PASS timeSync\n");
+
+    return 0;
+}
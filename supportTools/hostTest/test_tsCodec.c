@@ -0,0 +1,230 @@
+/**
+ * @file    test_tsCodec.c
+ * @author  Jan Belohoubek
+ * @version 0.2
+ * @date    2026-10-18
+ * @brief   Host fuzz test of the tsCodec batch encoder; records and frames are checked by test_tsCodec.py
+ *
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+ * All rights reserved.</center></h2>
+ *
+ * Developed by:
+ * The SmartCampus Team
+ * Department of Technologies and Measurement
+ * www.smartcampus.cz | www.zcu.cz
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy 
+ * of this software and associated documentation files (the "Software"), 
+ * to deal with the Software without restriction, including without limitation 
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ * and/or sell copies of the Software, and to permit persons to whom the Software 
+ * is furnished to do so, subject to the following conditions:
+ *
+ *    - Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimers.
+ *    
+ *    - Redistributions in binary form must reproduce the above copyright notice, 
+ *      this list of conditions and the following disclaimers in the documentation 
+ *      and/or other materials provided with the distribution.
+ *    
+ *    - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+ *      and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+ *      nor the names of its contributors may be used to endorse or promote products 
+ *      derived from this Software without specific prior written permission. 
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+ * OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE. 
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ketCube_tsCodec.h"
+#include "ketCube_lora.h"
+
+/**
+ * @brief Max. LoRaWAN payload lengths used as batch limits (EU868 DR0, DR3, DR5)
+ */
+static const uint8_t limits[] = { 51, 115, 222 };
+
+static uint32_t seed;
+
+static uint32_t rnd(void)
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static void printHex(const char *tag, uint32_t time, const uint8_t * data,
+                     uint8_t len)
+{
+    uint8_t i;
+
+    printf("%s %u ", tag, time);
+    for (i = 0; i < len; i++) {
+        printf("%02X", data[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Batch state; mirrors ketCube_lora_Batch()
+ */
+static ketCube_tsCodec_t codec;
+static uint8_t buffer[KETCUBE_LORA_BATCH_BUFFER_LEN];
+static uint8_t len;
+static uint8_t cnt;
+static uint8_t recLen;
+static uint32_t first;
+static uint32_t last;
+
+static void flush(uint32_t now)
+{
+    uint8_t age[KETCUBE_LORA_BATCH_AGE_LEN];
+    uint8_t start, n;
+
+    n = ketCube_tsCodec_PutVarint(&(age[0]), KETCUBE_LORA_BATCH_AGE_LEN,
+                                  now - first);
+    start = KETCUBE_LORA_BATCH_AGE_LEN - n;
+    buffer[start] = cnt;
+    buffer[start + 1] = recLen;
+    memcpy(&(buffer[start + KETCUBE_LORA_BATCH_HEADER_LEN]), &(age[0]), n);
+
+    printHex("B", now, &(buffer[start]), len - start);
+
+    len = KETCUBE_LORA_BATCH_DATA_OFFSET;
+    cnt = 0;
+    ketCube_tsCodec_Reset(&codec);
+}
+
+static uint8_t encode(const uint8_t * record, uint32_t time, uint8_t limit)
+{
+    uint8_t n, m;
+
+    if (len >= limit) {
+        return 0;
+    }
+    n = ketCube_tsCodec_PutVarint(&(buffer[len]), limit - len,
+                                  (cnt > 0) ? time - last : 0);
+    if ((n == 0) || ((len + n) >= limit)) {
+        return 0;
+    }
+    m = ketCube_tsCodec_Encode(&codec, record, recLen, &(buffer[len + n]),
+                               limit - len - n);
+    if (m == 0) {
+        return 0;
+    }
+
+    return n + m;
+}
+
+/**
+ * @brief Random field descriptor list; 0 terminates the list
+ */
+static void randomFields(uint8_t * fields, uint8_t * width)
+{
+    uint8_t cntFields = rnd() % (KETCUBE_TSCODEC_MAX_FIELDS + 1);
+    uint8_t i;
+
+    *width = 0;
+    memset(fields, 0, KETCUBE_TSCODEC_MAX_FIELDS);
+    for (i = 0; i < cntFields; i++) {
+        fields[i] = (uint8_t) (1 + rnd() % 4);
+        *width += fields[i];
+        if ((rnd() % 2) == 0) {
+            fields[i] |= KETCUBE_TSCODEC_FIELD_SIGNED;
+        }
+        fields[i] |= (uint8_t) ((rnd() % 3) << KETCUBE_TSCODEC_FIELD_CODEC_SHIFT);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t fields[KETCUBE_TSCODEC_MAX_FIELDS];
+    uint8_t record[KETCUBE_LORA_BATCH_BUFFER_LEN];
+    uint8_t width, limit, batchSize, mode, n;
+    uint32_t now = 0;
+    int runs, run, recCnt, r, i;
+
+    seed = (argc > 1) ? atoi(argv[1]) : 1;
+    runs = (argc > 2) ? atoi(argv[2]) : 500;
+
+    for (run = 0; run < runs; run++) {
+        randomFields(&(fields[0]), &width);
+        ketCube_tsCodec_Init(&codec, &(fields[0]), KETCUBE_TSCODEC_MAX_FIELDS);
+
+        /* records shorter/longer than the described fields are valid too */
+        recLen = width + rnd() % 4;
+        if ((width > 0) && ((rnd() % 5) == 0)) {
+            recLen = width - 1;
+        }
+        if (recLen == 0) {
+            recLen = 1;
+        }
+        limit = limits[rnd() % sizeof(limits)];
+        batchSize = 1 + rnd() % 40;
+        mode = rnd() % 3;
+
+        len = KETCUBE_LORA_BATCH_DATA_OFFSET;
+        cnt = 0;
+        for (i = 0; i < recLen; i++) {
+            record[i] = rnd();
+        }
+
+        printf("F 0 ");
+        for (i = 0; i < KETCUBE_TSCODEC_MAX_FIELDS; i++) {
+            printf("%02X", fields[i]);
+        }
+        printf("\n");
+
+        recCnt = 1 + rnd() % 100;
+        for (r = 0; r < recCnt; r++) {
+            /* 0: white noise; 1: random walk; 2: slow counter */
+            for (i = 0; i < recLen; i++) {
+                if (mode == 0) {
+                    record[i] = rnd();
+                } else if ((mode == 1) && ((rnd() % 4) == 0)) {
+                    record[i] += (int) (rnd() % 5) - 2;
+                } else if ((mode == 2) && (i == recLen - 1)) {
+                    record[i] += 1;
+                }
+            }
+            now += rnd() % 3600;
+
+            n = encode(&(record[0]), now, limit);
+            if ((n == 0) && (cnt > 0)) {
+                flush(now);
+                n = encode(&(record[0]), now, limit);
+            }
+            if (n == 0) {
+                /* the record does not fit into an empty batch */
+                printHex("X", now, &(record[0]), recLen);
+                continue;
+            }
+            printHex("R", now, &(record[0]), recLen);
+            if (cnt == 0) {
+                first = now;
+            }
+            last = now;
+            len += n;
+            cnt++;
+
+            if (cnt >= batchSize) {
+                flush(now);
+            }
+        }
+        if (cnt > 0) {
+            now += rnd() % 600;
+            flush(now);
+        }
+    }
+
+    return 0;
+}
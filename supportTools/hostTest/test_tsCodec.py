@@ -0,0 +1,110 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+#
+
+## @file test_tsCodec.py
+#
+# @author Jan Belohoubek
+# @version 0.2
+# @date    2026-10-18
+# @brief   Round-trip check: records batched by test_tsCodec are decoded by tsDecode.py
+#
+# @note Requirements:
+#    Standard Python3 installation (Tested Fedora ...)
+#
+# @attention
+# 
+#  <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+#  All rights reserved.</center></h2>
+# 
+#  Developed by:
+#  The SmartCampus Team
+#  Department of Technologies and Measurement
+#  www.smartcampus.cz | www.zcu.cz
+# 
+#  Permission is hereby granted, free of charge, to any person obtaining a copy 
+#  of this software and associated documentation files (the “Software”), 
+#  to deal with the Software without restriction, including without limitation 
+#  the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+#  and/or sell copies of the Software, and to permit persons to whom the Software 
+#  is furnished to do so, subject to the following conditions:
+# 
+#     - Redistributions of source code must retain the above copyright notice,
+#       this list of conditions and the following disclaimers.
+#     
+#     - Redistributions in binary form must reproduce the above copyright notice, 
+#       this list of conditions and the following disclaimers in the documentation 
+#       and/or other materials provided with the distribution.
+#     
+#     - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+#       and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+#       nor the names of its contributors may be used to endorse or promote products 
+#       derived from this Software without specific prior written permission. 
+# 
+#  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+#  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+#  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+#  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+
+# Imports
+import os
+import sys
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import tsDecode
+
+## Check the frames of a single generator run
+#
+# @param lines generator output
+#
+# @return (frames, records) checked
+#
+def check(lines):
+    fields = b""
+    pending = []
+    frames = 0
+    records = 0
+    for line in lines:
+        if line == "":
+            continue
+        (tag, time, data) = line.split(" ")
+        time = int(time)
+        data = bytes.fromhex(data)
+        if tag == "F":
+            fields = data
+            pending = []
+        elif tag == "R":
+            pending.append((time, data))
+        elif tag == "B":
+            decoded = tsDecode.decodeBatch(data, fields)
+            expected = [(time - t, rec) for (t, rec) in pending]
+            if decoded != expected:
+                raise AssertionError("fields " + fields.hex() + " payload " + data.hex()
+                                     + "\n  decoded  " + str(decoded)
+                                     + "\n  expected " + str(expected))
+            frames = frames + 1
+            records = records + len(decoded)
+            pending = []
+    if pending:
+        raise AssertionError("records left out of frames: " + str(len(pending)))
+    return (frames, records)
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("usage: test_tsCodec.py <test_tsCodec binary> [seeds]")
+        sys.exit(2)
+    seeds = int(sys.argv[2]) if len(sys.argv) > 2 else 20
+    frames = 0
+    records = 0
+    for seed in range(1, seeds + 1):
+        out = subprocess.run([sys.argv[1], str(seed)], stdout=subprocess.PIPE,
+                             universal_newlines=True, check=True).stdout
+        try:
+            (f, r) = check(out.split("\n"))
+        except (AssertionError, ValueError) as e:
+            print("FAIL tsCodec seed " + str(seed) + ": " + str(e))
+            sys.exit(1)
+        frames = frames + f
+        records = records + r
+    print("PASS tsCodec: " + str(records) + " records in " + str(frames) + " frames")
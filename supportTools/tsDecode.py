@@ -0,0 +1,264 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+#
+
+## @file tsDecode.py
+#
+# @author Jan Belohoubek
+# @version 0.2
+# @date    2026-10-18
+# @brief   The KETCube batched-record (tsCodec) decoder
+#
+# @note Requirements:
+#    Standard Python3 installation (Tested Fedora ...)
+#
+# @attention
+# 
+#  <h2><center>&copy; Copyright (c) 2026 University of West Bohemia in Pilsen
+#  All rights reserved.</center></h2>
+# 
+#  Developed by:
+#  The SmartCampus Team
+#  Department of Technologies and Measurement
+#  www.smartcampus.cz | www.zcu.cz
+# 
+#  Permission is hereby granted, free of charge, to any person obtaining a copy 
+#  of this software and associated documentation files (the “Software”), 
+#  to deal with the Software without restriction, including without limitation 
+#  the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+#  and/or sell copies of the Software, and to permit persons to whom the Software 
+#  is furnished to do so, subject to the following conditions:
+# 
+#     - Redistributions of source code must retain the above copyright notice,
+#       this list of conditions and the following disclaimers.
+#     
+#     - Redistributions in binary form must reproduce the above copyright notice, 
+#       this list of conditions and the following disclaimers in the documentation 
+#       and/or other materials provided with the distribution.
+#     
+#     - Neither the names of The SmartCampus Team, Department of Technologies and Measurement
+#       and Faculty of Electrical Engineering University of West Bohemia in Pilsen, 
+#       nor the names of its contributors may be used to endorse or promote products 
+#       derived from this Software without specific prior written permission. 
+# 
+#  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+#  INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+#  PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE CONTRIBUTORS OR COPYRIGHT HOLDERS 
+#  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+#  TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE 
+#  OR THE USE OR OTHER DEALINGS WITH THE SOFTWARE.
+
+# Imports
+import sys
+import argparse
+
+# Field descriptor, see ketCube_tsCodec.h
+FIELD_WIDTH_MASK  = 0x07
+FIELD_SIGNED      = 0x08
+FIELD_CODEC_SHIFT = 4
+FIELD_CODEC_MASK  = 0x30
+
+CODEC_RAW   = 0
+CODEC_DELTA = 1
+CODEC_DOD   = 2
+
+BATCH_HEADER_LEN = 2
+
+MASK32 = 0xFFFFFFFF
+
+## Parse field descriptor list as stored in KETCube (zero-terminated)
+#
+# @param fields iterable of descriptor bytes
+#
+def parseFields(fields):
+    result = []
+    for f in fields:
+        width = f & FIELD_WIDTH_MASK
+        if (width == 0) or (width > 4):
+            break
+        result.append(f)
+    return result
+
+## Read LEB128 varint
+#
+# @param data input bytes
+# @param pos position
+#
+# @return (value, new position)
+#
+def getVarint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("Truncated varint")
+        b = data[pos]
+        pos = pos + 1
+        value = value | ((b & 0x7F) << shift)
+        shift = shift + 7
+        if (b & 0x80) == 0:
+            return (value & MASK32, pos)
+        if shift > 28:
+            raise ValueError("Varint too long")
+
+## Zig-zag decode
+def unZigZag(value):
+    return ((value >> 1) ^ (-(value & 1))) & MASK32
+
+## Sign/zero extend MSB-first field to 32 bits
+def getField(data, descr):
+    width = descr & FIELD_WIDTH_MASK
+    value = int.from_bytes(data[:width], "big")
+    if (descr & FIELD_SIGNED) and (width < 4) and (value & (0x80 << ((width - 1) * 8))):
+        value = value | ((MASK32 << (width * 8)) & MASK32)
+    return value
+
+## tsCodec decoder state
+class Decoder:
+    def __init__(self, fields):
+        self.fields = parseFields(fields)
+        self.reset()
+
+    def reset(self):
+        self.prev = [0] * len(self.fields)
+        self.prevDelta = [0] * len(self.fields)
+
+    ## Decode single record
+    #
+    # @param data input bytes
+    # @param pos position of the record
+    # @param recLen original record length
+    #
+    # @return (record bytes, new position)
+    #
+    def decode(self, data, pos, recLen):
+        rec = bytearray()
+        i = 0
+        while (i < len(self.fields)) and (len(rec) < recLen):
+            descr = self.fields[i]
+            width = descr & FIELD_WIDTH_MASK
+            if len(rec) + width > recLen:
+                break
+            codec = (descr & FIELD_CODEC_MASK) >> FIELD_CODEC_SHIFT
+            if codec == CODEC_DELTA:
+                (code, pos) = getVarint(data, pos)
+                delta = unZigZag(code)
+                value = (self.prev[i] + delta) & MASK32
+            elif codec == CODEC_DOD:
+                (code, pos) = getVarint(data, pos)
+                delta = (self.prevDelta[i] + unZigZag(code)) & MASK32
+                value = (self.prev[i] + delta) & MASK32
+            else:
+                if pos + width > len(data):
+                    raise ValueError("Truncated field")
+                value = getField(data[pos:pos + width], descr)
+                delta = (value - self.prev[i]) & MASK32
+                pos = pos + width
+            self.prev[i] = value
+            self.prevDelta[i] = delta
+            rec += (value & ((1 << (8 * width)) - 1)).to_bytes(width, "big")
+            i = i + 1
+        rest = recLen - len(rec)
+        if pos + rest > len(data):
+            raise ValueError("Truncated record")
+        rec += data[pos:pos + rest]
+        return (bytes(rec), pos + rest)
+
+## Decode a batch uplink payload (LoRa port 15)
+#
+# @param payload uplink payload
+# @param fields field descriptors (as set by "set LoRa batchFields")
+#
+# @return list of (age in seconds, record), records as they were produced into SensorBuffer
+#
+def decodeBatch(payload, fields):
+    if len(payload) < BATCH_HEADER_LEN:
+        raise ValueError("Batch header missing")
+    count = payload[0]
+    recLen = payload[1]
+    dec = Decoder(fields)
+    records = []
+    (age, pos) = getVarint(payload, BATCH_HEADER_LEN)
+    for n in range(count):
+        (dt, pos) = getVarint(payload, pos)
+        age = age - dt
+        (rec, pos) = dec.decode(payload, pos, recLen)
+        records.append((age, rec))
+    if pos != len(payload):
+        raise ValueError("Trailing bytes in batch")
+    return records
+
+## Decode a logged-record uplink payload (LoRa port 17)
+#
+# @param payload uplink payload
+# @param fields field descriptors (as set by "set core logFields")
+#
+# @return (more records follow, list of (age in seconds, record))
+#
+def decodeLog(payload, fields):
+    if len(payload) < 1:
+        raise ValueError("Log header missing")
+    count = payload[0] & 0x7F
+    more = (payload[0] & 0x80) != 0
+    dec = Decoder(fields)
+    records = []
+    pos = 1
+    if count > 0:
+        (age, pos) = getVarint(payload, pos)
+    for n in range(count):
+        if pos >= len(payload):
+            raise ValueError("Truncated record")
+        recLen = payload[pos]
+        (dt, pos) = getVarint(payload, pos + 1)
+        age = age - dt
+        (rec, pos) = dec.decode(payload, pos, recLen)
+        records.append((age, rec))
+    if pos != len(payload):
+        raise ValueError("Trailing bytes in log uplink")
+    return (more, records)
+
+## Format record fields as numbers
+def formatRecord(rec, fields):
+    out = []
+    pos = 0
+    for descr in parseFields(fields):
+        width = descr & FIELD_WIDTH_MASK
+        if pos + width > len(rec):
+            break
+        value = getField(rec[pos:pos + width], descr)
+        if (descr & FIELD_SIGNED) and (value & 0x80000000):
+            value = value - (1 << 32)
+        out.append(str(value))
+        pos = pos + width
+    if pos < len(rec):
+        out.append(rec[pos:].hex().upper())
+    return " ".join(out)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Decode KETCube batched records (LoRa port 15) or logged records (LoRa port 17)")
+    parser.add_argument("-f", "--fields", required=True,
+                        help="field descriptors as HEX string, e.g. 2A22 (see \"show LoRa batchFields\" or \"show core logFields\")")
+    parser.add_argument("-l", "--log", action="store_true",
+                        help="payload is a logged-record uplink (LoRa port 17)")
+    parser.add_argument("payload", help="uplink payload as HEX string")
+    args = parser.parse_args()
+
+    fields = bytes.fromhex(args.fields)
+    try:
+        if args.log:
+            (more, logged) = decodeLog(bytes.fromhex(args.payload), fields)
+        else:
+            records = decodeBatch(bytes.fromhex(args.payload), fields)
+    except ValueError as e:
+        print("Decoding failed: " + str(e))
+        sys.exit(1)
+
+    if args.log:
+        for (age, rec) in logged:
+            print("-" + str(age) + " s " + rec.hex().upper() + " : " + formatRecord(rec, fields))
+        if more:
+            print("(more records follow)")
+        sys.exit(0)
+
+    for (age, rec) in records:
+        print("-" + str(age) + " s " + rec.hex().upper() + " : " + formatRecord(rec, fields))